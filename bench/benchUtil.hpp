@@ -0,0 +1,192 @@
+/**
+ * benchUtil - 性能测试公共工具
+ * 计时、峰值内存、命令行参数与结果输出，供 bench/ 下所有测试程序共享
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+namespace bench {
+
+/** @brief 单调时钟计时器 */
+class Stopwatch {
+public:
+    /** @brief 构造时开始计时 */
+    Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+    /** @brief 重新开始计时 */
+    void reset() { m_start = std::chrono::steady_clock::now(); }
+
+    /** @brief 已经过的秒数 */
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start; // 开始时间
+};
+
+/**
+ * @brief 重置进程峰值 RSS 统计（Linux 写 /proc/self/clear_refs，其他平台无效果）
+ * @return 重置成功返回 true，此后 peakRssKb 返回的是重置后的峰值
+ */
+inline bool resetPeakRss() {
+    FILE* fp = std::fopen("/proc/self/clear_refs", "w");
+    if (!fp) return false;
+    bool ok = std::fputs("5", fp) >= 0;
+    std::fclose(fp);
+    return ok;
+}
+
+/**
+ * @brief 读取进程峰值 RSS（KB）
+ * 优先读 /proc/self/status 的 VmHWM（可被 resetPeakRss 重置），否则回退 getrusage
+ */
+inline long peakRssKb() {
+    if (FILE* fp = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), fp)) {
+            if (std::strncmp(line, "VmHWM:", 6) == 0) {
+                std::fclose(fp);
+                return std::strtol(line + 6, nullptr, 10);
+            }
+        }
+        std::fclose(fp);
+    }
+
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+/** @brief 简单的 --key=value / --flag 命令行解析 */
+class Args {
+public:
+    /**
+     * @brief 解析命令行参数
+     * @param argc 参数数量
+     * @param argv 参数数组
+     */
+    Args(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) m_args.emplace_back(argv[i]);
+    }
+
+    /**
+     * @brief 读取字符串参数
+     * @param key 参数名（不含 --）
+     * @param defaultVal 缺省值
+     */
+    std::string get(const std::string& key, const std::string& defaultVal = "") const {
+        std::string prefix = "--" + key + "=";
+        for (const auto& arg : m_args) {
+            if (arg.compare(0, prefix.size(), prefix) == 0) return arg.substr(prefix.size());
+        }
+        return defaultVal;
+    }
+
+    /**
+     * @brief 读取浮点参数
+     * @param key 参数名（不含 --）
+     * @param defaultVal 缺省值
+     */
+    double getDouble(const std::string& key, double defaultVal) const {
+        std::string val = get(key);
+        return val.empty() ? defaultVal : std::strtod(val.c_str(), nullptr);
+    }
+
+    /**
+     * @brief 是否带有开关参数
+     * @param key 参数名（不含 --）
+     */
+    bool has(const std::string& key) const {
+        std::string flag = "--" + key;
+        for (const auto& arg : m_args) {
+            if (arg == flag) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 逗号分隔的过滤列表是否包含指定名称（列表为空视为全部包含）
+     * @param key 参数名（不含 --）
+     * @param name 待检查的名称
+     */
+    bool selected(const std::string& key, const std::string& name) const {
+        std::string list = get(key);
+        if (list.empty()) return true;
+        size_t start = 0;
+        while (start <= list.size()) {
+            size_t end = list.find(',', start);
+            if (end == std::string::npos) end = list.size();
+            if (list.compare(start, end - start, name) == 0) return true;
+            start = end + 1;
+        }
+        return false;
+    }
+
+private:
+    std::vector<std::string> m_args; // 原始参数
+};
+
+/** @brief 简单的 JSON 结果写出器（每条结果一个对象，便于跨提交比对） */
+class JsonReport {
+public:
+    /** @brief 开始一条记录 */
+    void begin() {
+        m_out += m_records++ ? ",\n  {" : "  {";
+        m_fields = 0;
+    }
+
+    /** @brief 写入字符串字段 */
+    void field(const char* key, const std::string& val) {
+        sep();
+        m_out += "\"" + std::string(key) + "\": \"" + val + "\"";
+    }
+
+    /** @brief 写入数值字段 */
+    void field(const char* key, double val) {
+        sep();
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.3f", val);
+        m_out += "\"" + std::string(key) + "\": " + buf;
+    }
+
+    /** @brief 结束当前记录 */
+    void end() { m_out += "}"; }
+
+    /**
+     * @brief 写出到文件
+     * @param path 输出路径，为空时不写
+     */
+    bool write(const std::string& path) const {
+        if (path.empty()) return true;
+        FILE* fp = std::fopen(path.c_str(), "w");
+        if (!fp) return false;
+        std::fprintf(fp, "[\n%s\n]\n", m_out.c_str());
+        std::fclose(fp);
+        return true;
+    }
+
+private:
+    void sep() {
+        if (m_fields++) m_out += ", ";
+    }
+
+    std::string m_out;  // 已写出的记录
+    int m_records = 0;  // 记录数量
+    int m_fields = 0;   // 当前记录字段数量
+};
+
+} // namespace bench
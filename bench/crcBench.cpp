@@ -0,0 +1,145 @@
+/**
+ * crcBench - CRC32 计算性能测试
+ * 内存吞吐：同一缓冲区上对比各实现（结果须一致）
+ *   bytewise      - 逐字节查表（对照）
+ *   slicing-by-8  - crc::software，主机端 crc::fromBuffer 使用的实现
+ *   miniz         - mz_crc32（旧版主机端实现）
+ *   Switch 端 fromBuffer 走 libnx 硬件 crc32CalculateWithSeed，不在主机端测试
+ *
+ * 文件吞吐：在生成的一批文件上对比
+ *   serial        - 逐个 crc::fromFile，64KB 缓冲区（旧版调用方式）
+ *   batch-xN      - crc::fromFiles，N 个并发（含调用线程），每线程 1MB 对齐缓冲区
+ *
+ * 用法：
+ *   crcBench [--root=/tmp/nxmm-bench-crc] [--mb=64] [--files=400] [--fileKb=256]
+ *            [--rounds=5] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "utils/crc32.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <miniz.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;   // 用例名称
+    double ms = 0;      // 平均耗时
+    double mbps = 0;    // 吞吐（MB/s）
+    uint32_t crc = 0;   // 结果（内存用例）或全部文件 CRC 的异或（文件用例）
+};
+
+/** @brief 多轮取平均，返回毫秒 */
+template <typename Fn>
+double timeMs(int rounds, Fn&& fn) {
+    bench::Stopwatch watch;
+    for (int r = 0; r < rounds; ++r) fn();
+    return watch.seconds() * 1000.0 / rounds;
+}
+
+double toMbps(double bytes, double ms) {
+    return ms > 0 ? bytes / (1024.0 * 1024.0) / (ms / 1000.0) : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-crc");
+    size_t bufMb = static_cast<size_t>(args.getDouble("mb", 64));
+    int fileCount = static_cast<int>(args.getDouble("files", 400));
+    size_t fileKb = static_cast<size_t>(args.getDouble("fileKb", 256));
+    int rounds = static_cast<int>(args.getDouble("rounds", 5));
+    std::string jsonOut = args.get("json");
+
+    std::vector<CaseResult> results;
+    std::mt19937 rng(42);
+
+    // 内存吞吐
+    {
+        std::vector<uint8_t> data(bufMb * 1024 * 1024);
+        for (auto& b : data) b = static_cast<uint8_t>(rng());
+        const double bytes = static_cast<double>(data.size());
+
+        uint32_t crc = 0;
+        double ms = timeMs(rounds, [&] { crc = crc::bytewise(0, data.data(), data.size()); });
+        results.push_back({"bytewise", ms, toMbps(bytes, ms), crc});
+
+        ms = timeMs(rounds, [&] { crc = crc::software(0, data.data(), data.size()); });
+        results.push_back({"slicing-by-8", ms, toMbps(bytes, ms), crc});
+
+        ms = timeMs(rounds, [&] { crc = static_cast<uint32_t>(mz_crc32(0, data.data(), data.size())); });
+        results.push_back({"miniz", ms, toMbps(bytes, ms), crc});
+    }
+
+    // 文件吞吐
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+
+    std::vector<crc::FileTask> tasks;
+    {
+        std::vector<uint8_t> content(fileKb * 1024);
+        char path[64];
+        for (int i = 0; i < fileCount; ++i) {
+            for (auto& b : content) b = static_cast<uint8_t>(rng());
+            std::snprintf(path, sizeof(path), "/file%04d.bin", i);
+            fs::writeFile(path, content.data(), content.size());
+            tasks.push_back({path});
+        }
+    }
+    const double totalBytes = static_cast<double>(fileCount) * fileKb * 1024;
+
+    {
+        std::vector<uint8_t> buf(64 * 1024);
+        uint32_t combined = 0;
+        double ms = timeMs(rounds, [&] {
+            combined = 0;
+            for (const auto& task : tasks) combined ^= static_cast<uint32_t>(crc::fromFile(task.path.c_str(), buf.data(), buf.size()));
+        });
+        results.push_back({"serial", ms, toMbps(totalBytes, ms), combined});
+    }
+
+    std::stop_source stop;
+    for (int workers : {1, 2, 3, 4, 6}) {
+        uint32_t combined = 0;
+        double ms = timeMs(rounds, [&] {
+            crc::fromFiles(tasks, stop.get_token(), workers);
+            combined = 0;
+            for (const auto& task : tasks) combined ^= static_cast<uint32_t>(task.crc);
+        });
+        results.push_back({"batch-x" + std::to_string(workers), ms, toMbps(totalBytes, ms), combined});
+    }
+
+    bench::JsonReport report;
+    std::printf("%-13s %10s %10s %10s\n", "case", "time(ms)", "MB/s", "crc");
+    for (const auto& r : results) {
+        std::printf("%-13s %10.2f %10.1f   %08x\n", r.name.c_str(), r.ms, r.mbps, r.crc);
+        report.begin();
+        report.field("case", r.name);
+        report.field("ms", r.ms);
+        report.field("mbps", r.mbps);
+        report.end();
+    }
+
+    std::filesystem::remove_all(root, ec);
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * crcVerifyBench - 下载时计算 CRC32 并核对商店给出的值
+ * 在 127.0.0.1 上启动本地文件服务（见 fileServer.hpp），单连接限速 --conn-rate MB/s、总带宽 --link-rate MB/s，
+ * 用 segmentDownload::toFile 以 --connections 个连接下载 --size MB 的随机内容，依次运行：
+ *   reread      - 不核对，下载后重新读取文件计算 CRC32（原来 ModList 补全元数据的方式）
+ *   inline      - 带期望 CRC32 下载，由各分段边写边算的 CRC32 合并得到整个文件的 CRC32
+ *   corrupt     - 首个响应中翻转一个字节：第一次调用拒绝并删除文件与记录，第二次调用下载成功
+ *   drop+flip   - 前 2 次响应断开且第 1 次响应带损坏字节：损坏的内容被续传保留，合并后的 CRC32 仍能发现
+ *   no-range    - 服务器忽略 Range 且首个响应损坏：单连接下载同样被拒绝
+ *   stale       - 期望 CRC32 与文件不符（商店记录过期）：每次都拒绝，不保留文件
+ * 报告每个用例的调用次数、第一次调用是否发现损坏、最终结果是否正确（CRC32 与服务器内容一致、
+ * 被拒绝时文件与记录已删除）与耗时；reread 额外报告重新读取文件的耗时。
+ *
+ * 用法：
+ *   crcVerifyBench [--root=/tmp/nxmm-bench-crc-verify] [--size=64] [--connections=4]
+ *                  [--conn-rate=16] [--link-rate=48] [--seed=1] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+#include "fileServer.hpp"
+
+#include "api/utils.hpp"
+#include "utils/crc32.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/http.hpp"
+#include "utils/segmentDownload.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* downloadPath = "/download/payload.zip"; // 下载路径
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;         // 用例名称
+    int calls = 0;            // toFile 调用次数
+    bool detected = false;    // 第一次调用因 CRC32 不符被拒绝
+    bool ok = false;          // 最终结果符合预期
+    int segments = 0;         // 最后一次调用的分段数
+    double seconds = 0;       // 下载总耗时
+    double rereadSeconds = 0; // 重新读取文件计算 CRC32 的耗时
+};
+
+/** @brief 下载文件和续传记录都已删除 */
+bool leftNothing() {
+    return !fs::fileExists(downloadPath) && !fs::fileExists(downloadJournal::pathOf(downloadPath));
+}
+
+/**
+ * @brief 运行一个用例
+ * @param expectedCrc 传给下载器的期望 CRC32，0 表示不核对
+ * @param expectReject 第一次调用应因 CRC32 不符被拒绝
+ * @param maxCalls 最多调用次数（被拒绝后重新下载）
+ * @param reread 下载后重新读取文件计算 CRC32
+ */
+CaseResult runCase(bench::FileServer& server, const std::string& name, const bench::ServerConfig& config, uint32_t expectedCrc, bool expectReject, int maxCalls, int connections, bool reread) {
+    CaseResult result{name};
+    server.reset(config);
+    if (fs::fileExists(downloadPath)) fs::deleteFile(downloadPath);
+    downloadJournal::remove(downloadPath);
+
+    const auto& payload = server.current();
+    uint32_t serverCrc = crc::fromBuffer(0, payload.data(), payload.size());
+
+    bench::Stopwatch watch;
+    http::Response response;
+    segmentDownload::Stats stats;
+    bool rejectedClean = true;
+    while (result.calls < maxCalls) {
+        result.calls++;
+        http::Request request;
+        request.url = server.url();
+        stats = {};
+        response = segmentDownload::toFile(request, downloadPath, connections, &stats, nullptr, expectedCrc);
+        if (api::utils::isOk(response)) break;
+
+        bool rejected = response.networkCode == segmentDownload::checksumMismatch;
+        if (result.calls == 1) result.detected = rejected;
+        rejectedClean = rejectedClean && rejected && leftNothing();
+    }
+    result.seconds = watch.seconds();
+    result.segments = stats.segments;
+
+    bool success = api::utils::isOk(response);
+    bool crcOk = success && stats.crc32 == serverCrc;
+    if (reread && success) {
+        bench::Stopwatch rereadWatch;
+        std::vector<char> buf(64 * 1024);
+        int64_t crc = crc::fromFile(downloadPath, buf.data(), buf.size());
+        result.rereadSeconds = rereadWatch.seconds();
+        crcOk = crcOk && crc == static_cast<int64_t>(serverCrc);
+    }
+
+    // 期望值正确时最终应下载成功，期望值过期时每次都应被拒绝；被拒绝时不留下文件和记录
+    bool staleExpected = expectedCrc != 0 && expectedCrc != serverCrc;
+    bool finalOk = staleExpected ? !success : crcOk;
+    result.ok = finalOk && rejectedClean && result.detected == expectReject;
+    return result;
+}
+
+std::vector<uint8_t> makePayload(size_t size, uint32_t seed) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 random(seed);
+    for (auto& byte : data) byte = static_cast<uint8_t>(random());
+    return data;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-crc-verify");
+    size_t size = static_cast<size_t>(args.getDouble("size", 64) * 1024 * 1024);
+    int connections = static_cast<int>(args.getDouble("connections", segmentDownload::defaultConnections));
+    double connRate = args.getDouble("conn-rate", 16) * 1024 * 1024;
+    double linkRate = args.getDouble("link-rate", 48) * 1024 * 1024;
+    uint32_t seed = static_cast<uint32_t>(args.getDouble("seed", 1));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    fs::ensureDir("/download");
+    http::init();
+
+    auto payload = makePayload(size, seed);
+    uint32_t payloadCrc = crc::fromBuffer(0, payload.data(), payload.size());
+    bench::FileServer server(payload, payload, seed);
+    if (!server.start()) {
+        std::fprintf(stderr, "无法启动本地 HTTP 服务\n");
+        return 1;
+    }
+
+    bench::ServerConfig limited;
+    limited.connectionRate = connRate;
+    limited.linkRate = linkRate;
+    bench::ServerConfig corrupt = limited;
+    corrupt.corruptions = 1;
+    bench::ServerConfig dropFlip = corrupt;
+    dropFlip.drops = 2;
+    bench::ServerConfig noRange = corrupt;
+    noRange.ignoreRange = true;
+
+    std::vector<CaseResult> results;
+    results.push_back(runCase(server, "reread", limited, 0, false, 1, connections, true));
+    results.push_back(runCase(server, "inline", limited, payloadCrc, false, 1, connections, false));
+    results.push_back(runCase(server, "corrupt", corrupt, payloadCrc, true, 2, connections, false));
+    results.push_back(runCase(server, "drop+flip", dropFlip, payloadCrc, true, 2, connections, false));
+    results.push_back(runCase(server, "no-range", noRange, payloadCrc, true, 2, connections, false));
+    results.push_back(runCase(server, "stale", limited, payloadCrc ^ 1, true, 2, connections, false));
+    server.stop();
+    http::cleanup();
+
+    bool allOk = true;
+    bench::JsonReport report;
+    std::printf("size=%.1fMB connections=%d conn-rate=%.1fMB/s link-rate=%.1fMB/s\n", size / 1048576.0, connections, connRate / 1048576.0, linkRate / 1048576.0);
+    std::printf("%-10s %5s %8s %8s %8s %9s %4s\n", "case", "calls", "detected", "segments", "time(s)", "reread(s)", "ok");
+    for (const auto& r : results) {
+        allOk = allOk && r.ok;
+        std::printf("%-10s %5d %8s %8d %8.2f %9.3f %4s\n", r.name.c_str(), r.calls, r.detected ? "yes" : "no", r.segments, r.seconds, r.rereadSeconds, r.ok ? "yes" : "NO");
+        report.begin();
+        report.field("case", r.name);
+        report.field("calls", r.calls);
+        report.field("detected", r.detected);
+        report.field("segments", r.segments);
+        report.field("seconds", r.seconds);
+        report.field("rereadSeconds", r.rereadSeconds);
+        report.field("ok", r.ok);
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,267 @@
+/**
+ * fileServer - 下载测试用的本地 HTTP 文件服务
+ * 在 127.0.0.1 的随机端口上只服务一个文件：支持 Range（bytes=起点-、bytes=起点-终点 或 bytes=-尾部长度）/ If-Range，带 ETag，
+ * 每个连接一个线程、一个请求。可模拟：
+ *   - 前几次响应在随机位置断开
+ *   - 忽略 Range（总是返回 200 和完整内容）
+ *   - 第一次断开后内容和 ETag 变化
+ *   - 前几次响应的前 1MB 内随机翻转一个字节（传输中损坏；分段下载从当前位置之后至少 4MB 处拆分，这部分总会被接收）
+ *   - 单连接限速与所有连接共享的总带宽（模拟单条 TCP 流的上限和链路容量）
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <netinet/in.h>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace bench {
+
+/** @brief 本地文件服务的行为设置 */
+struct ServerConfig {
+    int drops = 0;                // 前几次响应在随机位置断开
+    bool ignoreRange = false;     // 忽略 Range，总是返回完整内容
+    bool changeAfterDrop = false; // 第一次断开后换成新内容和新 ETag
+    double connectionRate = 0;    // 单连接限速（字节/秒），0 表示不限
+    double linkRate = 0;          // 所有连接共享的总带宽（字节/秒），0 表示不限
+    int corruptions = 0;          // 前几次响应在前 1MB 内随机翻转一个字节
+};
+
+class FileServer {
+public:
+    /**
+     * @brief 创建服务
+     * @param payload 文件内容
+     * @param changed 内容变化后的文件内容
+     * @param seed 断开位置的随机种子
+     */
+    FileServer(std::vector<uint8_t> payload, std::vector<uint8_t> changed, uint32_t seed)
+        : m_payload(std::move(payload)), m_changed(std::move(changed)), m_random(seed) {}
+
+    ~FileServer() { stop(); }
+
+    /** @brief 监听随机端口并启动接收线程 */
+    bool start() {
+        m_listen = socket(AF_INET, SOCK_STREAM, 0);
+        if (m_listen < 0) return false;
+        int reuse = 1;
+        setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (bind(m_listen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(m_listen, 16) != 0) return false;
+
+        socklen_t len = sizeof(addr);
+        getsockname(m_listen, reinterpret_cast<sockaddr*>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+        m_acceptThread = std::thread([this] { acceptLoop(); });
+        return true;
+    }
+
+    /** @brief 关闭监听并等待所有线程退出 */
+    void stop() {
+        if (m_listen < 0) return;
+        m_stopping = true;
+        shutdown(m_listen, SHUT_RDWR);
+        close(m_listen);
+        m_listen = -1;
+        if (m_acceptThread.joinable()) m_acceptThread.join();
+        for (auto& thread : m_connections) thread.join();
+        m_connections.clear();
+    }
+
+    /** @brief 开始一个新用例（须在没有进行中的请求时调用） */
+    void reset(const ServerConfig& config) {
+        std::lock_guard lock(m_mutex);
+        m_config = config;
+        m_changedActive = false;
+        m_requests = 0;
+        m_bytesSent = 0;
+        m_naiveBytes = 0;
+        m_linkNext = Clock::now();
+    }
+
+    /** @brief 文件地址 */
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(m_port) + "/payload.zip"; }
+
+    /** @brief 当前的文件内容 */
+    const std::vector<uint8_t>& current() const { return m_changedActive ? m_changed : m_payload; }
+
+    /** @brief 收到的请求数 */
+    int requests() const { return m_requests; }
+
+    /** @brief 实际发出的响应体字节数 */
+    uint64_t bytesSent() const { return m_bytesSent; }
+
+    /** @brief 每次断开后都从头下载时需要传输的字节数 */
+    uint64_t naiveBytes() const { return m_naiveBytes + current().size(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int m_listen = -1;                      // 监听 socket
+    int m_port = 0;                         // 监听端口
+    std::thread m_acceptThread;             // 接收线程
+    std::vector<std::thread> m_connections; // 连接线程
+    std::atomic<bool> m_stopping{false};    // 正在停止
+    std::mutex m_mutex;                     // 保护以下状态
+    std::vector<uint8_t> m_payload;         // 文件内容
+    std::vector<uint8_t> m_changed;         // 变化后的文件内容
+    std::mt19937 m_random;                  // 断开位置
+    ServerConfig m_config;                  // 当前设置
+    bool m_changedActive = false;           // 已换成新内容
+    std::atomic<int> m_requests{0};         // 请求数
+    std::atomic<uint64_t> m_bytesSent{0};   // 发出的响应体字节数
+    uint64_t m_naiveBytes = 0;              // 断开位置之和
+    Clock::time_point m_linkNext;           // 共享带宽下一次可发送的时间
+
+    void acceptLoop() {
+        while (!m_stopping) {
+            int client = accept(m_listen, nullptr, nullptr);
+            if (client < 0) continue;
+            m_connections.emplace_back([this, client] {
+                handle(client);
+                close(client);
+            });
+        }
+    }
+
+    /** @brief 读取请求头，取出 Range 起点、终点（没有时为 0）、尾部长度（bytes=-N，没有时为 0）和 If-Range */
+    static bool readRequest(int client, uint64_t& rangeStart, uint64_t& rangeLast, uint64_t& suffix, bool& hasRange, std::string& ifRange) {
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = recv(client, buf, sizeof(buf), 0);
+            if (n <= 0) return false;
+            request.append(buf, n);
+        }
+
+        hasRange = false;
+        size_t pos = 0;
+        while ((pos = request.find("\r\n", pos)) != std::string::npos) {
+            pos += 2;
+            size_t end = request.find("\r\n", pos);
+            std::string line = request.substr(pos, end - pos);
+            unsigned long long start = 0, last = 0, tail = 0;
+            int fields = std::sscanf(line.c_str(), "Range: bytes=%llu-%llu", &start, &last);
+            if (std::sscanf(line.c_str(), "Range: bytes=-%llu", &tail) == 1) {
+                suffix = tail;
+                hasRange = true;
+            } else if (fields >= 1) {
+                rangeStart = start;
+                rangeLast = fields == 2 ? last : 0;
+                hasRange = true;
+            } else if (line.rfind("If-Range: ", 0) == 0) {
+                ifRange = line.substr(10);
+            }
+        }
+        return true;
+    }
+
+    /** @brief 按单连接限速和共享带宽等待发送一块数据的时机 */
+    void throttle(Clock::time_point& connectionNext, size_t bytes, const ServerConfig& config) {
+        Clock::time_point sendAt = Clock::now();
+        if (config.connectionRate > 0) {
+            sendAt = std::max(sendAt, connectionNext);
+            connectionNext = sendAt + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(bytes / config.connectionRate));
+        }
+        if (config.linkRate > 0) {
+            std::lock_guard lock(m_mutex);
+            sendAt = std::max(sendAt, m_linkNext);
+            m_linkNext = sendAt + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(bytes / config.linkRate));
+        }
+        std::this_thread::sleep_until(sendAt);
+    }
+
+    void handle(int client) {
+        uint64_t rangeStart = 0, rangeLast = 0, suffix = 0;
+        bool hasRange = false;
+        std::string ifRange;
+        if (!readRequest(client, rangeStart, rangeLast, suffix, hasRange, ifRange)) return;
+        m_requests++;
+
+        ServerConfig config;
+        const std::vector<uint8_t>* data;
+        std::string etag;
+        bool drop;
+        uint64_t start, length, limit;
+        uint64_t corruptAt = UINT64_MAX;
+        {
+            std::lock_guard lock(m_mutex);
+            config = m_config;
+            data = &current();
+            etag = m_changedActive ? "\"v2\"" : "\"v1\"";
+
+            bool partial = hasRange && !config.ignoreRange && (ifRange.empty() || ifRange == etag);
+            if (suffix > 0) rangeStart = suffix < data->size() ? data->size() - suffix : 0;
+            if (partial && rangeStart >= data->size()) {
+                std::string head = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+                send(client, head.data(), head.size(), MSG_NOSIGNAL);
+                return;
+            }
+            start = partial ? rangeStart : 0;
+            uint64_t last = partial && rangeLast > 0 ? std::min<uint64_t>(rangeLast, data->size() - 1) : data->size() - 1;
+            length = last + 1 - start;
+
+            std::string head = partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+            head += "Content-Type: application/zip\r\nConnection: close\r\n";
+            if (!config.ignoreRange) head += "Accept-Ranges: bytes\r\n";
+            head += "ETag: " + etag + "\r\n";
+            head += "Content-Length: " + std::to_string(length) + "\r\n";
+            if (partial) head += "Content-Range: bytes " + std::to_string(start) + "-" + std::to_string(last) + "/" + std::to_string(data->size()) + "\r\n";
+            head += "\r\n";
+            if (send(client, head.data(), head.size(), MSG_NOSIGNAL) < 0) return;
+
+            // 在剩余内容的随机位置断开
+            drop = m_config.drops > 0 && length > 1;
+            limit = length;
+            if (drop) {
+                m_config.drops--;
+                limit = std::uniform_int_distribution<uint64_t>(1, length - 1)(m_random);
+                m_naiveBytes += start + limit;
+                if (m_config.changeAfterDrop) {
+                    m_changedActive = true;
+                    m_config.changeAfterDrop = false;
+                }
+            }
+            if (m_config.corruptions > 0) {
+                m_config.corruptions--;
+                corruptAt = std::uniform_int_distribution<uint64_t>(0, std::min<uint64_t>(limit, 1024 * 1024) - 1)(m_random);
+            }
+        }
+
+        // 换成新内容后旧内容仍然有效，本连接继续发送旧内容直到断开
+        Clock::time_point connectionNext = Clock::now();
+        uint64_t sent = 0;
+        while (sent < limit && !m_stopping) {
+            size_t chunk = static_cast<size_t>(std::min<uint64_t>(16 * 1024, limit - sent));
+            throttle(connectionNext, chunk, config);
+            const uint8_t* from = data->data() + start + sent;
+            uint8_t corrupted[16 * 1024];
+            if (corruptAt >= sent && corruptAt < sent + chunk) {
+                std::copy(from, from + chunk, corrupted);
+                corrupted[corruptAt - sent] ^= 0x5A;
+                from = corrupted;
+            }
+            ssize_t n = send(client, from, chunk, MSG_NOSIGNAL);
+            if (n <= 0) break;
+            sent += n;
+            m_bytesSent += n;
+        }
+    }
+};
+
+} // namespace bench
@@ -0,0 +1,225 @@
+/**
+ * installBench - 模组安装 / 卸载吞吐性能测试
+ * 在 POSIX 文件系统后端上生成合成模组，依次测量：
+ *   install   - 全新安装
+ *   uninstall - 卸载（引用计数归零，真实删除）
+ *   reinstall - 已安装状态下再次安装同一模组（CRC 全部命中跳过）
+ *
+ * 用法：
+ *   installBench [--root=/tmp/nxmm-bench] [--scale=1.0] [--shape=tiny,huge,...]
+ *                [--kind=zip,dir] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+#include "modGenerator.hpp"
+
+#include "common/gameInfo.hpp"
+#include "common/modInfo.hpp"
+#include "core/modGameType.hpp"
+#include "core/modInstaller/install.hpp"
+#include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* markerFile = "/.nxmm-bench"; // 沙盒标记，防止误删非测试目录
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string shape;          // 模组形态
+    std::string kind;           // zip / dir
+    std::string name;           // install / uninstall / reinstall
+    bool success = false;       // 安装器是否返回成功
+    std::string errorMsg;       // 失败原因
+    int files = 0;              // 文件数量
+    int64_t bytes = 0;          // 解压后总字节数
+    double seconds = 0;         // 总耗时
+    long peakRssKb = 0;         // 用例期间峰值 RSS
+    ModInstaller::PhaseTimes phases; // 安装器各阶段耗时
+};
+
+/**
+ * @brief 准备沙盒根目录：不存在则创建，存在时必须为空或带有标记文件
+ * @param root 主机上的沙盒目录
+ */
+bool prepareSandbox(const std::string& root) {
+    namespace stdfs = std::filesystem;
+    std::error_code ec;
+    stdfs::create_directories(root, ec);
+    if (ec) return false;
+
+    fs::setRootDir(root);
+    bool empty = stdfs::is_empty(root, ec);
+    if (!empty && !fs::fileExists(markerFile)) {
+        std::fprintf(stderr, "拒绝使用非空且不含 %s 标记的目录：%s\n", markerFile + 1, root.c_str());
+        return false;
+    }
+
+    if (!fs::removeDirContents("/")) return false;
+    return fs::writeFile(markerFile, "", 0) == 0;
+}
+
+/** @brief 清空沙盒内容（保留标记文件），并建立与真机 SD 卡一致的 atmosphere 目录 */
+void wipeSandbox() {
+    fs::removeDirContents("/");
+    fs::writeFile(markerFile, "", 0);
+    fs::ensureDir("/atmosphere/contents");
+}
+
+/**
+ * @brief 运行单个安装 / 卸载用例并记录测量值
+ * @param out 用例结果（shape/kind/name/files/bytes 由调用方预先填写）
+ * @param fn 执行安装或卸载，返回是否成功，失败时填写 errorMsg
+ */
+template <typename Fn>
+void measure(CaseResult& out, Fn&& fn) {
+    bench::resetPeakRss();
+    bench::Stopwatch watch;
+    out.success = fn(out);
+    out.seconds = watch.seconds();
+    out.peakRssKb = bench::peakRssKb();
+}
+
+void printHeader() {
+    std::printf("%-11s %-4s %-10s %7s %9s %9s %10s %9s %8s | %9s %9s %9s %9s %9s\n",
+        "shape", "kind", "case", "files", "MB", "time(ms)", "files/s", "MB/s", "RSS(MB)",
+        "scan", "conflict", "mkdir", "write", "save");
+}
+
+void printRow(const CaseResult& r) {
+    double mb = r.bytes / (1024.0 * 1024.0);
+    double secs = r.seconds > 0 ? r.seconds : 1e-9;
+    std::printf("%-11s %-4s %-10s %7d %9.1f %9.1f %10.0f %9.1f %8.1f | %9.1f %9.1f %9.1f %9.1f %9.1f%s%s\n",
+        r.shape.c_str(), r.kind.c_str(), r.name.c_str(), r.files, mb, r.seconds * 1000.0,
+        r.files / secs, mb / secs, r.peakRssKb / 1024.0,
+        r.phases.scan / 1000.0, r.phases.conflict / 1000.0, r.phases.mkdir / 1000.0,
+        r.phases.write / 1000.0, r.phases.save / 1000.0,
+        r.success ? "" : "  FAILED: ", r.success ? "" : r.errorMsg.c_str());
+}
+
+void addJson(bench::JsonReport& report, const CaseResult& r) {
+    report.begin();
+    report.field("shape", r.shape);
+    report.field("kind", r.kind);
+    report.field("case", r.name);
+    report.field("success", r.success ? 1.0 : 0.0);
+    report.field("files", static_cast<double>(r.files));
+    report.field("bytes", static_cast<double>(r.bytes));
+    report.field("ms", r.seconds * 1000.0);
+    report.field("peakRssKb", static_cast<double>(r.peakRssKb));
+    report.field("scanMs", r.phases.scan / 1000.0);
+    report.field("conflictMs", r.phases.conflict / 1000.0);
+    report.field("mkdirMs", r.phases.mkdir / 1000.0);
+    report.field("writeMs", r.phases.write / 1000.0);
+    report.field("saveMs", r.phases.save / 1000.0);
+    report.end();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench");
+    double scale = args.getDouble("scale", 1.0);
+    std::string jsonPath = args.get("json");
+
+    if (!prepareSandbox(root)) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+
+    bench::JsonReport report;
+    bool allOk = true;
+    printHeader();
+
+    for (const auto& shapeInfo : bench::allShapes()) {
+        if (!args.selected("shape", shapeInfo.name)) continue;
+        auto files = bench::planFiles(shapeInfo.shape, scale);
+
+        for (bool asZip : {true, false}) {
+            const char* kind = asZip ? "zip" : "dir";
+            if (!args.selected("kind", kind)) continue;
+
+            wipeSandbox();
+
+            GameInfo game;
+            game.appId = shapeInfo.appId;
+            game.version = shapeInfo.gameVersion;
+            game.displayName = "Bench";
+            game.dirPath = std::string("/mods2/Bench/") + format::appIdHex(game.appId);
+
+            ModInfo mod;
+            mod.dirName = std::string("bench-") + shapeInfo.name;
+            mod.displayName = mod.dirName;
+            mod.path = game.dirPath + "/" + mod.dirName;
+            mod.isZip = asZip;
+
+            auto generated = bench::generateMod(files, mod.path, mod.dirName, asZip);
+            if (!generated.success) {
+                std::fprintf(stderr, "生成模组失败：%s (%s)\n", shapeInfo.name, kind);
+                allOk = false;
+                continue;
+            }
+
+            ModGameType gameType = modGameType::detect(game.appId);
+            std::vector<ModInfo> allMods{mod};
+
+            auto install = [&](CaseResult& r) {
+                auto res = ModInstaller::install(mod, game, gameType, allMods);
+                r.phases = res.phases;
+                r.errorMsg = res.errorMsg;
+                return res.success;
+            };
+            auto uninstall = [&](CaseResult& r) {
+                auto res = ModInstaller::uninstall(mod, game, gameType);
+                r.phases = res.phases;
+                r.errorMsg = res.errorMsg;
+                return res.success;
+            };
+
+            CaseResult base;
+            base.shape = shapeInfo.name;
+            base.kind = kind;
+            base.files = generated.fileCount;
+            base.bytes = generated.totalBytes;
+
+            CaseResult installCase = base;
+            installCase.name = "install";
+            measure(installCase, install);
+
+            CaseResult uninstallCase = base;
+            uninstallCase.name = "uninstall";
+            measure(uninstallCase, uninstall);
+
+            // 重新装好一份，再测覆盖安装
+            mod.isInstalled = true;
+            allMods[0].isInstalled = true;
+            CaseResult setup = base;
+            install(setup);
+
+            CaseResult reinstallCase = base;
+            reinstallCase.name = "reinstall";
+            measure(reinstallCase, install);
+
+            for (const auto* r : {&installCase, &uninstallCase, &reinstallCase}) {
+                printRow(*r);
+                addJson(report, *r);
+                allOk = allOk && r->success;
+            }
+            std::fflush(stdout);
+        }
+    }
+
+    wipeSandbox();
+
+    if (!report.write(jsonPath)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonPath.c_str());
+        return 1;
+    }
+    return allOk ? 0 : 2;
+}
@@ -0,0 +1,242 @@
+/**
+ * jsonFileBench - JsonFile 大文件加载 / 保存性能测试
+ * 生成约 --mb 大小的旧版引用计数 JSON（"refCount" → 路径 → 计数，缩进格式），对比：
+ *   legacy-load     - 旧版：整体解析后复制为可变文档
+ *   load            - 原地解析为不可变文档（不复制）
+ *   load+keys       - 加载并枚举全部键（只读路径，不转换）
+ *   legacy-update   - 旧版：加载、修改少量条目、整体以缩进格式重写
+ *   update-pretty   - 加载、修改少量条目（首次写入时转换）、缩进格式保存
+ *   update-compact  - 同上，紧凑格式保存（文件另存，不影响其他用例）
+ *   save-unchanged  - 加载、写入与原值相同的条目后保存（不重写文件）
+ * 每个用例在独立子进程中运行，报告平均总耗时、其中写文件（序列化 + 写出）的耗时、
+ * 子进程峰值 RSS（含与父进程共享的基线）与用例结束后的文件大小。
+ * 修改类用例的总耗时大部分是 yyjson 对象按键线性查找，与存储方式无关。
+ *
+ * 用法：
+ *   jsonFileBench [--root=/tmp/nxmm-bench-jsonfile] [--mb=10] [--ops=200] [--rounds=5] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "utils/fsHelper.hpp"
+#include "utils/jsonFile.hpp"
+#include "yyjson.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr const char* prettyPath = "/modFileRefCount.json";          // 缩进格式文件
+constexpr const char* compactPath = "/modFileRefCount.compact.json"; // 紧凑格式文件
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;   // 用例名称
+    double ms = 0;      // 平均总耗时
+    double saveMs = 0;  // 其中写文件的平均耗时
+    long peakKb = 0;    // 用例期间峰值 RSS
+    int64_t fileKb = 0; // 用例结束后文件大小
+};
+
+/** @brief 生成与真实安装路径形态相近的目标文件路径 */
+std::string makePath(int i) {
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "/atmosphere/contents/0100000000B00000/romfs/data/dir%03d/sub%02d/file%06d.bin", i % 397, i % 23, i);
+    return buf;
+}
+
+int64_t fileKb(const char* path) {
+    int64_t size = fs::getFileSize(path);
+    return size < 0 ? 0 : size / 1024;
+}
+
+/** @brief 旧版加载：整体读入、解析、复制为可变文档 */
+yyjson_mut_doc* legacyLoad(const char* path) {
+    FILE* file = std::fopen(fs::nativePath(path).c_str(), "rb");
+    if (!file) return nullptr;
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    std::vector<char> buffer(size + 1);
+    size_t readSize = std::fread(buffer.data(), 1, size, file);
+    std::fclose(file);
+    yyjson_doc* doc = yyjson_read(buffer.data(), readSize, 0);
+    if (!doc) return nullptr;
+    yyjson_mut_doc* mut = yyjson_doc_mut_copy(doc, nullptr);
+    yyjson_doc_free(doc);
+    return mut;
+}
+
+/** @brief 旧版保存：缩进格式整体重写 */
+void legacySave(yyjson_mut_doc* doc, const char* path) {
+    size_t len = 0;
+    char* json = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, &len);
+    FILE* file = std::fopen(fs::nativePath(path).c_str(), "wb");
+    if (file) {
+        std::fwrite(json, 1, len, file);
+        std::fclose(file);
+    }
+    std::free(json);
+}
+
+/**
+ * @brief 在子进程中运行用例：多轮取平均，记录峰值 RSS（fn 返回其中写文件的秒数）
+ * 每个用例独立进程，峰值不受前一用例遗留的堆内存影响
+ */
+template <typename Fn>
+CaseResult runCase(const std::string& name, int rounds, const char* path, Fn&& fn) {
+    CaseResult result{name};
+    int fds[2];
+    if (pipe(fds) != 0) return result;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        bench::Stopwatch watch;
+        double saveSeconds = 0;
+        for (int r = 0; r < rounds; ++r) saveSeconds += fn(r);
+        double values[3] = {watch.seconds() * 1000.0 / rounds, saveSeconds * 1000.0 / rounds, static_cast<double>(bench::peakRssKb())};
+        ssize_t written = write(fds[1], values, sizeof(values));
+        _exit(written == sizeof(values) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    double values[3] = {};
+    if (pid > 0 && read(fds[0], values, sizeof(values)) == sizeof(values)) {
+        result.ms = values[0];
+        result.saveMs = values[1];
+        result.peakKb = static_cast<long>(values[2]);
+    }
+    close(fds[0]);
+    if (pid > 0) waitpid(pid, nullptr, 0);
+    result.fileKb = fileKb(path);
+    return result;
+}
+
+/** @brief 计时执行保存，返回秒数 */
+template <typename Fn>
+double timeSave(Fn&& fn) {
+    bench::Stopwatch watch;
+    fn();
+    return watch.seconds();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-jsonfile");
+    double mb = args.getDouble("mb", 10);
+    int ops = static_cast<int>(args.getDouble("ops", 200));
+    int rounds = static_cast<int>(args.getDouble("rounds", 5));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+
+    // 直接拼出缩进格式的旧版文件（每条约 110 字节）
+    int entries = static_cast<int>(mb * 1024 * 1024 / 110);
+    {
+        std::string text = "{\n    \"refCount\": {\n";
+        for (int i = 0; i < entries; ++i) {
+            text += "        \"" + makePath(i) + "\": \"1\"";
+            text += i + 1 < entries ? ",\n" : "\n";
+        }
+        text += "    }\n}";
+        fs::writeFile(prettyPath, text.data(), text.size());
+    }
+    std::vector<std::string> updated;
+    for (int i = 0; i < ops; ++i) updated.push_back(makePath((i * 7919) % entries));
+
+    std::vector<CaseResult> results;
+
+    results.push_back(runCase("legacy-load", rounds, prettyPath, [](int) {
+        yyjson_mut_doc_free(legacyLoad(prettyPath));
+        return 0.0;
+    }));
+
+    results.push_back(runCase("load", rounds, prettyPath, [](int) {
+        JsonFile json;
+        json.load(prettyPath);
+        return 0.0;
+    }));
+
+    results.push_back(runCase("load+keys", rounds, prettyPath, [&](int) {
+        JsonFile json;
+        json.load(prettyPath);
+        if (json.getKeys("refCount").size() != static_cast<size_t>(entries)) std::fprintf(stderr, "键数量不符\n");
+        return 0.0;
+    }));
+
+    results.push_back(runCase("legacy-update", rounds, prettyPath, [&](int r) {
+        yyjson_mut_doc* doc = legacyLoad(prettyPath);
+        yyjson_mut_val* obj = yyjson_mut_obj_get(yyjson_mut_doc_get_root(doc), "refCount");
+        std::string value = std::to_string(r + 2);
+        for (const auto& path : updated) {
+            yyjson_mut_obj_put(obj, yyjson_mut_strcpy(doc, path.c_str()), yyjson_mut_strcpy(doc, value.c_str()));
+        }
+        double seconds = timeSave([&] { legacySave(doc, prettyPath); });
+        yyjson_mut_doc_free(doc);
+        return seconds;
+    }));
+
+    results.push_back(runCase("update-pretty", rounds, prettyPath, [&](int r) {
+        JsonFile json;
+        json.load(prettyPath);
+        for (const auto& path : updated) json.setString("refCount", path, std::to_string(r + 100));
+        return timeSave([&] { json.save(); });
+    }));
+
+    {
+        std::error_code copyEc;
+        std::filesystem::copy_file(fs::nativePath(prettyPath), fs::nativePath(compactPath), copyEc);
+    }
+    results.push_back(runCase("update-compact", rounds, compactPath, [&](int r) {
+        JsonFile json(JsonFile::Format::Compact);
+        json.load(compactPath);
+        for (const auto& path : updated) json.setString("refCount", path, std::to_string(r + 100));
+        return timeSave([&] { json.save(); });
+    }));
+
+    // 写入与当前内容相同的值：不转换、不重写
+    results.push_back(runCase("save-unchanged", rounds, prettyPath, [&](int) {
+        JsonFile json;
+        json.load(prettyPath);
+        for (const auto& path : updated) json.setString("refCount", path, json.getString("refCount", path));
+        return timeSave([&] { json.save(); });
+    }));
+
+    bench::JsonReport report;
+    std::printf("entries=%d\n", entries);
+    std::printf("%-15s %10s %10s %10s %9s\n", "case", "time(ms)", "save(ms)", "peak(KB)", "file(KB)");
+    for (const auto& r : results) {
+        std::printf("%-15s %10.2f %10.2f %10ld %9lld\n", r.name.c_str(), r.ms, r.saveMs, r.peakKb, static_cast<long long>(r.fileKb));
+        report.begin();
+        report.field("case", r.name);
+        report.field("entries", static_cast<double>(entries));
+        report.field("ms", r.ms);
+        report.field("saveMs", r.saveMs);
+        report.field("peakKb", static_cast<double>(r.peakKb));
+        report.field("fileKb", static_cast<double>(r.fileKb));
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * libraryBench - 游戏库启动加载性能测试
+ * 在生成的 /mods2/ 游戏库上测量 Home 首屏之前的 GameManager 构造耗时，以及后台核对耗时：
+ *   scan            - 无快照：同步扫描全部游戏目录并写出快照（首次启动）
+ *   snapshot        - 有快照：直接读取快照构建列表（之后的启动）
+ *   reconcile       - 后台重新扫描并与列表核对（无变化）
+ *   reconcile-diff  - 同上，期间新增 / 删除了部分游戏目录
+ *   lookup-linear   - 卡片加载阶段每张卡片的查找（findAllByAppId + findByDirPath），按旧版线性扫描
+ *   lookup-indexed  - 同上，使用 GameManager 的哈希索引
+ *   sort-name / sort-modcount / sort-recent - 各排序模式下翻转升降序重排整个列表（预计算排序键）
+ *
+ * 用法：
+ *   libraryBench [--root=/tmp/nxmm-bench-library] [--games=500] [--mods=3] [--changes=10]
+ *                [--rounds=10] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "common/config.hpp"
+#include "core/gameLibrary.hpp"
+#include "core/gameManager.hpp"
+#include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;  // 用例名称
+    int games = 0;     // 结束时的游戏数
+    double ms = 0;     // 平均耗时
+    std::string note;  // 备注：核对差异（新增 / 删除 / 变化）或查找命中数
+};
+
+/** @brief 第 i 个游戏的 appId（满足 format::appIdIsValid） */
+uint64_t appIdOf(int i) {
+    return 0x0100000000000000ULL | (static_cast<uint64_t>(i + 1) << 13);
+}
+
+/** @brief 创建一个游戏项目目录及其 MOD 子目录 */
+void makeGame(int i, int mods) {
+    char dirName[32];
+    std::snprintf(dirName, sizeof(dirName), "Game%05d", i);
+    std::string tidPath = std::string(config::modsRoot) + dirName + "/" + format::appIdHex(appIdOf(i));
+    for (int m = 0; m < mods; ++m) fs::ensureDir(tidPath + "/mod" + std::to_string(m));
+}
+
+void removeGame(int i) {
+    char dirName[32];
+    std::snprintf(dirName, sizeof(dirName), "Game%05d", i);
+    fs::removeDirAll(std::string(config::modsRoot) + dirName);
+}
+
+/** @brief 多轮取平均，返回毫秒 */
+template <typename Fn>
+double timeMs(int rounds, Fn&& fn) {
+    bench::Stopwatch watch;
+    for (int r = 0; r < rounds; ++r) fn();
+    return watch.seconds() * 1000.0 / rounds;
+}
+
+std::string diffText(const GameManager::LibraryDiff& diff) {
+    return "+" + std::to_string(diff.added) + " -" + std::to_string(diff.removed) + " ~" + std::to_string(diff.changed);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-library");
+    int gameCount = static_cast<int>(args.getDouble("games", 500));
+    int mods = static_cast<int>(args.getDouble("mods", 3));
+    int changes = static_cast<int>(args.getDouble("changes", 10));
+    int rounds = static_cast<int>(args.getDouble("rounds", 10));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+
+    for (int i = 0; i < gameCount; ++i) makeGame(i, mods);
+
+    std::vector<CaseResult> results;
+
+    double scanMs = timeMs(rounds, [] {
+        fs::deleteFile(config::gameLibraryPath);
+        GameManager manager;
+    });
+    results.push_back({"scan", gameCount, scanMs, ""});
+
+    double snapshotMs = timeMs(rounds, [] { GameManager manager; });
+    results.push_back({"snapshot", gameCount, snapshotMs, ""});
+
+    {
+        GameManager manager;
+        GameManager::LibraryDiff diff;
+        double ms = timeMs(rounds, [&] { diff = manager.applyScan(manager.libraryVersion(), gameLibrary::scan()); });
+        results.push_back({"reconcile", static_cast<int>(manager.games().size()), ms, diffText(diff)});
+    }
+
+    // 卡片加载：每张卡片按 appId 找全部同 ID 项目、按路径找焦点项目
+    {
+        GameManager manager;
+        const auto& games = manager.games();
+        size_t hits = 0;
+        double linearMs = timeMs(rounds, [&] {
+            for (const auto& game : games) {
+                std::vector<int> indices;
+                for (int i = 0; i < static_cast<int>(games.size()); i++) {
+                    if (games[i].appId == game.appId) indices.push_back(i);
+                }
+                for (int i = 0; i < static_cast<int>(games.size()); i++) {
+                    if (games[i].dirPath == game.dirPath) { hits += indices.size(); break; }
+                }
+            }
+        });
+        results.push_back({"lookup-linear", static_cast<int>(games.size()), linearMs, std::to_string(hits / rounds) + " hits"});
+
+        hits = 0;
+        double indexedMs = timeMs(rounds, [&] {
+            for (const auto& game : games) {
+                const auto& indices = manager.findAllByAppId(game.appId);
+                if (manager.findByDirPath(game.dirPath) >= 0) hits += indices.size();
+            }
+        });
+        results.push_back({"lookup-indexed", static_cast<int>(games.size()), indexedMs, std::to_string(hits / rounds) + " hits"});
+    }
+
+    // 重排：每轮翻转一次升降序，排序键首轮之后复用
+    {
+        GameManager manager;
+        const std::pair<const char*, SortMode> modes[] = {
+            {"sort-name", SortMode::Name}, {"sort-modcount", SortMode::ModCount}, {"sort-recent", SortMode::RecentPlay}};
+        for (const auto& [name, mode] : modes) {
+            manager.setSortMode(mode);
+            manager.sort();
+            double ms = timeMs(rounds, [&] { manager.toggleSortAsc(); });
+            results.push_back({name, static_cast<int>(manager.games().size()), ms, ""});
+        }
+    }
+
+    {
+        GameManager manager;
+        for (int i = 0; i < changes; ++i) {
+            removeGame(i);
+            makeGame(gameCount + i, mods);
+        }
+        bench::Stopwatch watch;
+        auto diff = manager.applyScan(manager.libraryVersion(), gameLibrary::scan());
+        results.push_back({"reconcile-diff", static_cast<int>(manager.games().size()), watch.seconds() * 1000.0, diffText(diff)});
+    }
+
+    bench::JsonReport report;
+    std::printf("%-15s %7s %10s  %s\n", "case", "games", "time(ms)", "note");
+    for (const auto& r : results) {
+        std::printf("%-15s %7d %10.2f  %s\n", r.name.c_str(), r.games, r.ms, r.note.c_str());
+        report.begin();
+        report.field("case", r.name);
+        report.field("games", static_cast<double>(r.games));
+        report.field("ms", r.ms);
+        report.field("note", r.note);
+        report.end();
+    }
+
+    std::filesystem::remove_all(root, ec);
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * modGenerator - 合成测试模组生成器实现
+ */
+
+#include "modGenerator.hpp"
+
+#include "utils/fsHelper.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <miniz.h>
+
+namespace bench {
+
+namespace {
+
+    constexpr int64_t KB = 1024;
+    constexpr int64_t MB = 1024 * 1024;
+
+    /** @brief xorshift64* 伪随机数，保证同种子输出一致 */
+    struct Rng {
+        uint64_t state;
+
+        explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+        uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1DULL;
+        }
+    };
+
+    /**
+     * @brief 填充约 50% 可压缩的伪随机数据（奇数 256 字节块为重复图案）
+     * @param out 输出缓冲区
+     * @param seed 内容种子
+     */
+    void fillBinary(std::vector<uint8_t>& out, uint64_t seed) {
+        Rng rng(seed);
+        size_t pos = 0;
+        while (pos < out.size()) {
+            size_t chunk = std::min<size_t>(256, out.size() - pos);
+            bool pattern = (pos / 256) & 1;
+            for (size_t i = 0; i < chunk; i += 8) {
+                uint64_t v = pattern ? 0x0101010101010101ULL * ((pos / 256) & 0xFF) : rng.next();
+                size_t n = std::min<size_t>(8, chunk - i);
+                for (size_t b = 0; b < n; ++b) out[pos + i + b] = static_cast<uint8_t>(v >> (b * 8));
+            }
+            pos += chunk;
+        }
+    }
+
+    /**
+     * @brief 生成 pchtxt 文本（nsobid 由种子决定，补丁行数由目标大小决定）
+     * @param out 输出缓冲区
+     * @param size 目标大小
+     * @param seed 内容种子
+     */
+    void fillPchtxt(std::vector<uint8_t>& out, int64_t size, uint64_t seed) {
+        Rng rng(seed);
+        char line[96];
+        std::string text;
+        text.reserve(static_cast<size_t>(size) + 128);
+
+        std::snprintf(line, sizeof(line), "@nsobid-%016llX%016llX%08X\n\n@enabled\n",
+            static_cast<unsigned long long>(rng.next()), static_cast<unsigned long long>(rng.next()), static_cast<unsigned>(seed));
+        text += line;
+
+        uint32_t offset = 0x1000;
+        while (static_cast<int64_t>(text.size()) < size) {
+            offset += 4 + static_cast<uint32_t>(rng.next() % 64) * 4;
+            std::snprintf(line, sizeof(line), "%08X %08X\n", offset, static_cast<uint32_t>(rng.next()));
+            text += line;
+        }
+        text += "@stop\n";
+        out.assign(text.begin(), text.end());
+    }
+
+    void fillContent(const SynthFile& file, std::vector<uint8_t>& out) {
+        if (file.isPchtxt) {
+            fillPchtxt(out, file.size, file.seed);
+            return;
+        }
+        out.resize(static_cast<size_t>(file.size));
+        fillBinary(out, file.seed);
+    }
+
+    /** @brief 按种子在 [minSize, maxSize] 内取文件大小 */
+    int64_t sizeBetween(uint64_t seed, int64_t minSize, int64_t maxSize) {
+        Rng rng(seed);
+        return minSize + static_cast<int64_t>(rng.next() % static_cast<uint64_t>(maxSize - minSize + 1));
+    }
+
+    int scaled(int base, double scale) {
+        return std::max(1, static_cast<int>(base * scale));
+    }
+
+} // namespace
+
+const std::vector<ShapeInfo>& allShapes() {
+    static const std::vector<ShapeInfo> shapes = {
+        {ModShape::TinyFiles, "tiny", 0x0100000000B00000ULL, "v1.0.0"},
+        {ModShape::HugeFiles, "huge", 0x0100000000B01000ULL, "v1.0.0"},
+        {ModShape::DeepTree, "deep", 0x0100000000B02000ULL, "v1.0.0"},
+        {ModShape::Pchtxt, "pchtxt", 0x0100000000B03000ULL, "v1.0.0"},
+        {ModShape::MHRisePak, "mhrise", 0x0100559011740000ULL, "v16.0.0"},
+        {ModShape::DontStarveBm, "dontstarve", 0x0100751007ADA000ULL, "v1.0.0"},
+    };
+    return shapes;
+}
+
+std::vector<SynthFile> planFiles(ModShape shape, double scale) {
+    std::vector<SynthFile> files;
+    char path[256];
+
+    switch (shape) {
+        case ModShape::TinyFiles: {
+            int count = scaled(20000, scale);
+            for (int i = 0; i < count; ++i) {
+                std::snprintf(path, sizeof(path), "romfs/data/d%02d/f%05d.bin", i % 64, i);
+                files.push_back({path, sizeBetween(i, 512, 4 * KB), static_cast<uint64_t>(i), false});
+            }
+            break;
+        }
+
+        case ModShape::HugeFiles: {
+            int64_t size = std::max<int64_t>(MB, static_cast<int64_t>(64 * MB * scale));
+            for (int i = 0; i < 3; ++i) {
+                std::snprintf(path, sizeof(path), "romfs/movie/big%d.bin", i);
+                files.push_back({path, size, static_cast<uint64_t>(i + 1000), false});
+            }
+            break;
+        }
+
+        case ModShape::DeepTree: {
+            constexpr int depth = 24;
+            int count = scaled(2000, scale);
+            for (int i = 0; i < count; ++i) {
+                std::string rel = "romfs/deep/c" + std::to_string(i % 100);
+                for (int level = 1; level <= depth; ++level) rel += "/s" + std::to_string(level);
+                rel += "/f" + std::to_string(i) + ".bin";
+                files.push_back({rel, sizeBetween(i + 2000, 1 * KB, 16 * KB), static_cast<uint64_t>(i + 2000), false});
+            }
+            break;
+        }
+
+        case ModShape::Pchtxt: {
+            int count = scaled(100, scale);
+            for (int i = 0; i < count; ++i) {
+                std::snprintf(path, sizeof(path), "exefs_patches/bench/p%03d.pchtxt", i);
+                files.push_back({path, 16 * KB, static_cast<uint64_t>(i + 3000), true});
+            }
+            break;
+        }
+
+        case ModShape::MHRisePak: {
+            // v16.0.0 起始编号 15，上限 99：安装 + 覆盖安装共用编号，每个模组最多 40 个 pak
+            int64_t size = std::max<int64_t>(256 * KB, static_cast<int64_t>(8 * MB * scale));
+            for (int i = 0; i < 40; ++i) {
+                std::snprintf(path, sizeof(path), "romfs/re_chunk_000.pak.patch_%03d.pak", i + 1);
+                files.push_back({path, size, static_cast<uint64_t>(i + 4000), false});
+            }
+            files.push_back({"romfs/natives/stm/bench.user.2", 64 * KB, 4999, false});
+            break;
+        }
+
+        case ModShape::DontStarveBm: {
+            int mods = scaled(60, scale);
+            for (int m = 0; m < mods; ++m) {
+                for (int f = 0; f < 20; ++f) {
+                    std::snprintf(path, sizeof(path), "romfs/mods/workshop-%05d/scripts/s%02d.lua", m, f);
+                    uint64_t seed = static_cast<uint64_t>(m * 100 + f + 5000);
+                    files.push_back({path, sizeBetween(seed, 1 * KB, 32 * KB), seed, false});
+                }
+            }
+            break;
+        }
+    }
+
+    return files;
+}
+
+GeneratedMod generateMod(const std::vector<SynthFile>& files, const std::string& modPath, const std::string& modDirName, bool asZip) {
+    GeneratedMod result;
+    if (!fs::ensureDir(modPath)) return result;
+
+    std::vector<uint8_t> data;
+
+    if (asZip) {
+        std::string zipPath = fs::nativePath(modPath + "/" + modDirName + ".zip");
+        mz_zip_archive zip{};
+        if (!mz_zip_writer_init_file(&zip, zipPath.c_str(), 0)) return result;
+
+        for (const auto& file : files) {
+            fillContent(file, data);
+            if (!mz_zip_writer_add_mem(&zip, file.relPath.c_str(), data.data(), data.size(), MZ_BEST_SPEED)) {
+                mz_zip_writer_end(&zip);
+                return result;
+            }
+            ++result.fileCount;
+            result.totalBytes += static_cast<int64_t>(data.size());
+        }
+
+        bool ok = mz_zip_writer_finalize_archive(&zip);
+        mz_zip_writer_end(&zip);
+        result.success = ok;
+        return result;
+    }
+
+    for (const auto& file : files) {
+        std::string target = modPath + "/" + file.relPath;
+        if (!fs::ensureDir(target.substr(0, target.rfind('/')))) return result;
+
+        fillContent(file, data);
+        if (fs::writeFile(target, data.data(), data.size()) != 0) return result;
+        ++result.fileCount;
+        result.totalBytes += static_cast<int64_t>(data.size());
+    }
+
+    result.success = true;
+    return result;
+}
+
+} // namespace bench
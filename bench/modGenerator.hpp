@@ -0,0 +1,66 @@
+/**
+ * modGenerator - 合成测试模组生成器
+ * 按固定随机种子生成可复现的 ZIP / 目录模组，覆盖安装器的典型负载形态
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/** @brief 合成模组形态 */
+enum class ModShape {
+    TinyFiles,    // 大量小文件（romfs 贴图/脚本类）
+    HugeFiles,    // 少量超大文件（视频/整包替换类）
+    DeepTree,     // 深层目录树
+    Pchtxt,       // 大量 pchtxt 补丁
+    MHRisePak,    // 怪物猎人 崛起 pak 补丁
+    DontStarveBm, // 饥荒 romfs/mods 子目录（BM 重命名）
+};
+
+/** @brief 模组形态描述 */
+struct ShapeInfo {
+    ModShape shape;          // 形态
+    const char* name;        // 命令行与报告中使用的名称
+    uint64_t appId;          // 对应游戏 appId（决定 ModGameType）
+    const char* gameVersion; // 游戏版本（怪猎规则需要）
+};
+
+/** @brief 单个合成文件 */
+struct SynthFile {
+    std::string relPath; // 模组内相对路径
+    int64_t size;        // 文件大小
+    uint64_t seed;       // 内容种子
+    bool isPchtxt;       // 是否为 pchtxt 文本
+};
+
+/** @brief 生成结果统计 */
+struct GeneratedMod {
+    bool success = false;  // 是否生成成功
+    int fileCount = 0;     // 文件数量
+    int64_t totalBytes = 0; // 解压后总字节数
+};
+
+/** @brief 全部模组形态 */
+const std::vector<ShapeInfo>& allShapes();
+
+/**
+ * @brief 按形态与规模列出合成文件
+ * @param shape 模组形态
+ * @param scale 规模系数（1.0 为默认规模）
+ */
+std::vector<SynthFile> planFiles(ModShape shape, double scale);
+
+/**
+ * @brief 生成模组到 SD 路径下
+ * @param files 合成文件列表
+ * @param modPath 模组目录（SD 内路径）
+ * @param modDirName 模组目录名（ZIP 文件名使用）
+ * @param asZip true 时写为 modPath/modDirName.zip，否则直接展开到 modPath
+ */
+GeneratedMod generateMod(const std::vector<SynthFile>& files, const std::string& modPath, const std::string& modDirName, bool asZip);
+
+} // namespace bench
@@ -0,0 +1,150 @@
+/**
+ * persistBench - 元数据保存的界面耗时与写文件次数
+ * 生成 --games 个游戏的 gameInfo.json（紧凑格式），模拟用户每隔 --interval 毫秒点击一次收藏，
+ * 共 --clicks 次，对比：
+ *   sync      - 每次点击 save()，在调用线程等待写出（旧行为）
+ *   deferred  - 每次点击 saveDeferred()，由 persistQueue 合并后在后台写出
+ * 报告单次点击在调用线程上的平均 / 最大耗时，以及实际写出文件的次数。
+ * 最后检查延迟写入期间重新 load() 能读到最新内容、写出后文件内容正确。
+ *
+ * 用法：
+ *   persistBench [--root=/tmp/nxmm-bench-persist] [--games=300] [--clicks=20] [--interval=50] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "utils/fsHelper.hpp"
+#include "utils/jsonFile.hpp"
+#include "utils/persistQueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr const char* jsonPath = "/gameInfo.json"; // 测试文件
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;   // 用例名称
+    double avgMs = 0;   // 单次点击平均耗时
+    double maxMs = 0;   // 单次点击最大耗时
+    double totalMs = 0; // 从第一次点击到全部写出的耗时
+    int writes = 0;     // 写出文件的次数
+};
+
+std::string gameKey(int i) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "0100%08X000", i);
+    return buf;
+}
+
+/** @brief 生成测试文件 */
+void prepare(int games) {
+    JsonFile json(JsonFile::Format::Compact);
+    json.load(jsonPath);
+    for (int i = 0; i < games; ++i) {
+        std::string key = gameKey(i);
+        json.setString(key, "gameName", "Game " + std::to_string(i));
+        json.setString(key, "version", "1.0." + std::to_string(i % 10));
+        json.setBool(key, "favorite", false);
+    }
+    json.save();
+}
+
+template <typename Save>
+CaseResult runCase(const std::string& name, int clicks, int intervalMs, Save&& save) {
+    CaseResult result{name};
+    JsonFile json(JsonFile::Format::Compact);
+    json.load(jsonPath);
+    int writesBefore = persistQueue::writeCount();
+
+    bench::Stopwatch total;
+    double sum = 0;
+    for (int i = 0; i < clicks; ++i) {
+        bench::Stopwatch click;
+        // 每次点击都切换一个收藏状态
+        json.setBool(gameKey(i % 7), "favorite", (i / 7) % 2 == 0);
+        save(json);
+        double ms = click.seconds() * 1000.0;
+        sum += ms;
+        result.maxMs = std::max(result.maxMs, ms);
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    persistQueue::flush();
+    result.totalMs = total.seconds() * 1000.0;
+    result.avgMs = sum / clicks;
+    result.writes = persistQueue::writeCount() - writesBefore;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-persist");
+    int games = static_cast<int>(args.getDouble("games", 300));
+    int clicks = static_cast<int>(args.getDouble("clicks", 20));
+    int intervalMs = static_cast<int>(args.getDouble("interval", 50));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    prepare(games);
+
+    CaseResult results[] = {
+        runCase("sync", clicks, intervalMs, [](JsonFile& json) { json.save(); }),
+        runCase("deferred", clicks, intervalMs, [](JsonFile& json) { json.saveDeferred(); }),
+    };
+
+    // 读己之写：写出前重新加载应读到队列中的内容
+    bool consistent = true;
+    {
+        JsonFile json(JsonFile::Format::Compact);
+        json.load(jsonPath);
+        json.setString(gameKey(0), "displayName", "pending");
+        json.saveDeferred();
+
+        JsonFile reload;
+        reload.load(jsonPath);
+        consistent = reload.getString(gameKey(0), "displayName") == "pending";
+        persistQueue::shutdown();
+
+        JsonFile written;
+        written.load(jsonPath);
+        consistent = consistent && written.getString(gameKey(0), "displayName") == "pending" &&
+                     !fs::fileExists(persistQueue::tempPath(jsonPath));
+    }
+
+    bench::JsonReport report;
+    std::printf("games=%d clicks=%d interval=%dms\n", games, clicks, intervalMs);
+    std::printf("%-9s %10s %10s %10s %7s\n", "case", "avg(ms)", "max(ms)", "total(ms)", "writes");
+    for (const auto& r : results) {
+        std::printf("%-9s %10.3f %10.3f %10.1f %7d\n", r.name.c_str(), r.avgMs, r.maxMs, r.totalMs, r.writes);
+        report.begin();
+        report.field("case", r.name);
+        report.field("clicks", static_cast<double>(clicks));
+        report.field("avgMs", r.avgMs);
+        report.field("maxMs", r.maxMs);
+        report.field("totalMs", r.totalMs);
+        report.field("writes", static_cast<double>(r.writes));
+        report.end();
+    }
+    std::printf("read-your-writes / final content: %s\n", consistent ? "ok" : "MISMATCH");
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return consistent ? 0 : 1;
+}
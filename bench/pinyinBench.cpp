@@ -0,0 +1,162 @@
+/**
+ * pinyinBench - 拼音转换缓存性能测试
+ * 在一批中英混合名称上测量：
+ *   convert      - 直接转换：每个名称取排序键 + 搜索 token（无缓存时每次启动的开销）
+ *   cache-miss   - 无缓存文件：经 pinYinCache 转换并写出缓存文件（首次启动）
+ *   cache-file   - 有缓存文件：读取文件后查询全部名称（之后的启动）
+ *   cache-hit    - 内存命中：再次查询全部名称
+ *   sort-cold    - 启动后首次拼音排序（读取缓存文件 + 排序）
+ *   search-first - 启动后首次按键搜索（读取缓存文件 + 建立索引 + 全表匹配）
+ *
+ * 说明：主机端 cpp-pinyin 若为替身实现，convert / cache-miss 只反映缓存本身的开销，
+ *       真机上转换耗时显著更高，缓存收益随之放大。
+ *
+ * 用法：
+ *   pinyinBench [--root=/tmp/nxmm-bench-pinyin] [--names=1000] [--rounds=10] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "utils/fsHelper.hpp"
+#include "utils/pinYinCache.hpp"
+#include "utils/pinYinCvt.hpp"
+#include "utils/searchEngine.hpp"
+#include "utils/strSort.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;    // 用例名称
+    double ms = 0;       // 平均耗时
+    size_t checksum = 0; // 结果校验（排序键 / token 总长度或命中数）
+};
+
+/** @brief 多轮取平均，返回毫秒 */
+template <typename Fn>
+double timeMs(int rounds, Fn&& fn) {
+    bench::Stopwatch watch;
+    for (int r = 0; r < rounds; ++r) fn();
+    return watch.seconds() * 1000.0 / rounds;
+}
+
+/** @brief 生成中英混合的游戏 / MOD 名称 */
+std::vector<std::string> makeNames(int count) {
+    static const char* words[] = {"塞尔达", "传说", "王国之泪", "宝可梦", "朱", "紫", "异度神剑", "马力欧", "赛车",
+                                  "Zelda", "Xenoblade", "Mario", "Kart", "Splatoon", "HD", "Texture", "Pack", "60FPS"};
+    constexpr int wordCount = sizeof(words) / sizeof(words[0]);
+    std::mt19937 rng(42);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string name;
+        int parts = 2 + static_cast<int>(rng() % 3);
+        for (int p = 0; p < parts; ++p) {
+            if (!name.empty()) name += ' ';
+            name += words[rng() % wordCount];
+        }
+        names.push_back(name + " " + std::to_string(i));
+    }
+    return names;
+}
+
+size_t lookupAll(const std::vector<std::string>& names) {
+    size_t total = 0;
+    for (const auto& name : names) {
+        const auto& entry = pinYinCache::get(name);
+        total += entry.sortKey.size() + entry.tokens.size();
+    }
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-pinyin");
+    int nameCount = static_cast<int>(args.getDouble("names", 1000));
+    int rounds = static_cast<int>(args.getDouble("rounds", 10));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    pinYinCvt::init();
+
+    const std::string cachePath = "/pinyinCache.bin";
+    pinYinCache::setPath(cachePath);
+    auto names = makeNames(nameCount);
+    std::vector<CaseResult> results;
+
+    size_t checksum = 0;
+    double ms = timeMs(rounds, [&] {
+        checksum = 0;
+        for (const auto& name : names) checksum += pinYinCvt::getSortKey(name).size() + pinYinCvt::toPinyin(name).size();
+    });
+    results.push_back({"convert", ms, checksum});
+
+    ms = timeMs(rounds, [&] {
+        pinYinCache::unload();
+        fs::deleteFile(cachePath);
+        checksum = lookupAll(names);
+        pinYinCache::flush();
+    });
+    results.push_back({"cache-miss", ms, checksum});
+
+    ms = timeMs(rounds, [&] {
+        pinYinCache::unload();
+        checksum = lookupAll(names);
+    });
+    results.push_back({"cache-file", ms, checksum});
+
+    ms = timeMs(rounds, [&] { checksum = lookupAll(names); });
+    results.push_back({"cache-hit", ms, checksum});
+
+    ms = timeMs(rounds, [&] {
+        pinYinCache::unload();
+        auto sorted = names;
+        strSort::sortAZ(sorted, [](const std::string& name) -> const std::string& { return name; });
+        checksum = sorted.front().size();
+    });
+    results.push_back({"sort-cold", ms, checksum});
+
+    ms = timeMs(rounds, [&] {
+        pinYinCache::unload();
+        SearchEngine engine;
+        engine.setItems(names);
+        checksum = engine.search("ZX", -1).size();
+    });
+    results.push_back({"search-first", ms, checksum});
+
+    bench::JsonReport report;
+    std::printf("%-13s %7s %10s %10s\n", "case", "names", "time(ms)", "checksum");
+    for (const auto& r : results) {
+        std::printf("%-13s %7d %10.3f %10zu\n", r.name.c_str(), nameCount, r.ms, r.checksum);
+        report.begin();
+        report.field("case", r.name);
+        report.field("names", static_cast<double>(nameCount));
+        report.field("ms", r.ms);
+        report.field("checksum", static_cast<double>(r.checksum));
+        report.end();
+    }
+
+    pinYinCache::unload();
+    std::filesystem::remove_all(root, ec);
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * refCountBench - 共享文件引用计数存储性能测试
+ * 在同一组路径上对比旧版 JSON（JsonFile 整体解析 / 整体重写）与二进制存储：
+ *   json-load     - 加载旧版 modFileRefCount.json
+ *   json-update   - 旧版：加载、修改少量条目、整体重写
+ *   migrate       - 首次加载旧版 JSON 并写出二进制快照
+ *   bin-load      - 加载二进制快照
+ *   bin-update    - 加载、修改少量条目、追加日志
+ *   bin-load+log  - 加载快照并重放累积的日志
+ *   bin-compact   - 日志超过快照大小后触发的全量压缩
+ *
+ * 用法：
+ *   refCountBench [--root=/tmp/nxmm-bench-refcount] [--entries=50000] [--ops=200]
+ *                 [--rounds=20] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "core/modInstaller/modFileRefCount.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/jsonFile.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* binPath = "/modFileRefCount.bin";   // 二进制存储路径
+constexpr const char* jsonPath = "/modFileRefCount.json"; // 旧版 JSON 路径
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;     // 用例名称
+    int entries = 0;      // 表内条目数
+    int ops = 0;          // 本次修改条目数
+    double ms = 0;        // 平均耗时
+    int64_t fileKb = 0;   // 用例结束后文件大小
+};
+
+/** @brief 生成与真实安装路径形态相近的目标文件路径 */
+std::vector<std::string> makePaths(int count) {
+    std::vector<std::string> paths;
+    paths.reserve(count);
+    char buf[160];
+    for (int i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "/atmosphere/contents/0100000000B00000/romfs/data/dir%03d/sub%02d/file%06d.bin", i % 397, i % 23, i);
+        paths.emplace_back(buf);
+    }
+    return paths;
+}
+
+/** @brief 多轮取平均，返回毫秒 */
+template <typename Fn>
+double timeMs(int rounds, Fn&& fn) {
+    bench::Stopwatch watch;
+    for (int r = 0; r < rounds; ++r) fn(r);
+    return watch.seconds() * 1000.0 / rounds;
+}
+
+int64_t fileKb(const char* path) {
+    int64_t size = fs::getFileSize(path);
+    return size < 0 ? 0 : size / 1024;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-refcount");
+    int entries = static_cast<int>(args.getDouble("entries", 50000));
+    int ops = static_cast<int>(args.getDouble("ops", 200));
+    int rounds = static_cast<int>(args.getDouble("rounds", 20));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+
+    auto paths = makePaths(entries);
+    std::vector<CaseResult> results;
+
+    // 旧版 JSON：与迁移前 ModFileRefCount 相同的读写方式
+    {
+        JsonFile json;
+        json.load(jsonPath);
+        for (const auto& path : paths) json.setString("refCount", path, "1");
+        json.save();
+
+        double loadMs = timeMs(rounds, [](int) {
+            JsonFile j;
+            j.load(jsonPath);
+        });
+        results.push_back({"json-load", entries, 0, loadMs, fileKb(jsonPath)});
+
+        double saveMs = timeMs(rounds, [&](int r) {
+            JsonFile j;
+            j.load(jsonPath);
+            for (int i = 0; i < ops; ++i) j.setString("refCount", paths[(r * ops + i) % entries], "2");
+            j.save();
+        });
+        results.push_back({"json-update", entries, ops, saveMs, fileKb(jsonPath)});
+    }
+
+    // 迁移：加载 JSON 并写出二进制快照
+    {
+        ModFileRefCount refCount;
+        bench::Stopwatch watch;
+        refCount.load(binPath);
+        refCount.save();
+        results.push_back({"migrate", entries, 0, watch.seconds() * 1000.0, fileKb(binPath)});
+    }
+
+    // 二进制：加载、增量追加保存、压缩
+    {
+        double loadMs = timeMs(rounds, [](int) {
+            ModFileRefCount refCount;
+            refCount.load(binPath);
+        });
+        results.push_back({"bin-load", entries, 0, loadMs, fileKb(binPath)});
+
+        double updateMs = timeMs(rounds, [&](int r) {
+            ModFileRefCount refCount;
+            refCount.load(binPath);
+            for (int i = 0; i < ops; ++i) refCount.increment(paths[(r * ops + i) % entries]);
+            refCount.save();
+        });
+        results.push_back({"bin-update", entries, ops, updateMs, fileKb(binPath)});
+
+        double journalLoadMs = timeMs(rounds, [](int) {
+            ModFileRefCount refCount;
+            refCount.load(binPath);
+        });
+        results.push_back({"bin-load+log", entries, 0, journalLoadMs, fileKb(binPath)});
+
+        // 一次修改全部条目，日志超过快照触发压缩
+        ModFileRefCount refCount;
+        refCount.load(binPath);
+        for (const auto& path : paths) refCount.increment(path);
+        bench::Stopwatch watch;
+        refCount.save();
+        results.push_back({"bin-compact", entries, entries, watch.seconds() * 1000.0, fileKb(binPath)});
+    }
+
+    bench::JsonReport report;
+    std::printf("%-13s %8s %6s %10s %9s\n", "case", "entries", "ops", "time(ms)", "file(KB)");
+    for (const auto& r : results) {
+        std::printf("%-13s %8d %6d %10.2f %9lld\n", r.name.c_str(), r.entries, r.ops, r.ms, static_cast<long long>(r.fileKb));
+        report.begin();
+        report.field("case", r.name);
+        report.field("entries", static_cast<double>(r.entries));
+        report.field("ops", static_cast<double>(r.ops));
+        report.field("ms", r.ms);
+        report.field("fileKb", static_cast<double>(r.fileKb));
+        report.end();
+    }
+
+    std::filesystem::remove_all(root, ec);
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
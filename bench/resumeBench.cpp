@@ -0,0 +1,143 @@
+/**
+ * resumeBench - 断点续传下载在连接中断时的重传量与正确性
+ * 在 127.0.0.1 上启动本地文件服务（见 fileServer.hpp），用 segmentDownload::toFile
+ * 以 --connections 个连接（默认 1，只看续传）下载 --size MB 的随机内容，依次运行：
+ *   clean     - 不中断：一次完成
+ *   drop      - 前 3 次响应在随机位置断开：同一次调用内自动续传
+ *   drop-many - 前 6 次响应断开：第一次调用重试用尽后保留记录，第二次调用续传完成
+ *   no-range  - 服务器忽略 Range，每次返回完整内容，前 2 次断开：退回从头下载
+ *   changed   - 第一次断开后服务器内容和 ETag 变化：If-Range 不匹配，重新下载新内容
+ * 每个用例校验最终文件的 CRC32，报告调用次数、请求次数、实际传输字节数、
+ * 不续传（每次断开后从头下载）时需要传输的字节数与耗时（含重试等待）。
+ *
+ * 用法：
+ *   resumeBench [--root=/tmp/nxmm-bench-resume] [--size=16] [--connections=1] [--seed=1] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+#include "fileServer.hpp"
+
+#include "api/utils.hpp"
+#include "utils/crc32.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/http.hpp"
+#include "utils/segmentDownload.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* downloadPath = "/download/payload.zip"; // 下载路径
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;         // 用例名称
+    int calls = 0;            // downloadToFile 调用次数
+    int requests = 0;         // 服务器收到的请求数
+    uint64_t wireBytes = 0;   // 实际传输的响应体字节数
+    uint64_t naiveBytes = 0;  // 不续传时需要传输的字节数
+    double seconds = 0;       // 总耗时
+    bool crcOk = false;       // 最终文件 CRC32 与服务器内容一致
+    bool journalGone = false; // 完成后续传记录已删除
+};
+
+CaseResult runCase(bench::FileServer& server, const std::string& name, const bench::ServerConfig& config, int maxCalls, int connections) {
+    CaseResult result{name};
+    server.reset(config);
+    if (fs::fileExists(downloadPath)) fs::deleteFile(downloadPath);
+    downloadJournal::remove(downloadPath);
+
+    bench::Stopwatch watch;
+    http::Response response;
+    while (result.calls < maxCalls) {
+        result.calls++;
+        http::Request request;
+        request.url = server.url();
+        response = segmentDownload::toFile(request, downloadPath, connections);
+        if (api::utils::isOk(response)) break;
+    }
+    result.seconds = watch.seconds();
+    result.requests = server.requests();
+    result.wireBytes = server.bytesSent();
+    result.naiveBytes = server.naiveBytes();
+
+    auto data = fs::readFile(downloadPath);
+    const auto& expected = server.current();
+    result.crcOk = api::utils::isOk(response) && data.size() == expected.size() &&
+                   crc::fromBuffer(0, data.data(), data.size()) == crc::fromBuffer(0, expected.data(), expected.size());
+    result.journalGone = !fs::fileExists(downloadJournal::pathOf(downloadPath));
+    return result;
+}
+
+std::vector<uint8_t> makePayload(size_t size, uint32_t seed) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 random(seed);
+    for (auto& byte : data) byte = static_cast<uint8_t>(random());
+    return data;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-resume");
+    size_t size = static_cast<size_t>(args.getDouble("size", 16) * 1024 * 1024);
+    int connections = static_cast<int>(args.getDouble("connections", 1));
+    uint32_t seed = static_cast<uint32_t>(args.getDouble("seed", 1));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    http::init();
+
+    bench::FileServer server(makePayload(size, seed), makePayload(size, seed + 1), seed);
+    if (!server.start()) {
+        std::fprintf(stderr, "无法启动本地 HTTP 服务\n");
+        return 1;
+    }
+
+    std::vector<CaseResult> results;
+    results.push_back(runCase(server, "clean", {}, 1, connections));
+    results.push_back(runCase(server, "drop", {3, false, false}, 1, connections));
+    results.push_back(runCase(server, "drop-many", {6, false, false}, 2, connections));
+    results.push_back(runCase(server, "no-range", {2, true, false}, 1, connections));
+    results.push_back(runCase(server, "changed", {1, false, true}, 1, connections));
+    server.stop();
+    http::cleanup();
+
+    bool allOk = true;
+    bench::JsonReport report;
+    std::printf("size=%.1fMB\n", size / 1048576.0);
+    std::printf("%-10s %5s %8s %10s %11s %8s %4s\n", "case", "calls", "requests", "wire(MB)", "naive(MB)", "time(s)", "ok");
+    for (const auto& r : results) {
+        bool ok = r.crcOk && r.journalGone;
+        allOk = allOk && ok;
+        std::printf("%-10s %5d %8d %10.2f %11.2f %8.2f %4s\n", r.name.c_str(), r.calls, r.requests, r.wireBytes / 1048576.0, r.naiveBytes / 1048576.0, r.seconds, ok ? "yes" : "NO");
+        report.begin();
+        report.field("case", r.name);
+        report.field("calls", r.calls);
+        report.field("requests", r.requests);
+        report.field("wireBytes", static_cast<double>(r.wireBytes));
+        report.field("naiveBytes", static_cast<double>(r.naiveBytes));
+        report.field("seconds", r.seconds);
+        report.field("ok", ok);
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return allOk ? 0 : 1;
+}
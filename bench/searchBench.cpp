@@ -0,0 +1,162 @@
+/**
+ * searchBench - 搜索引擎性能测试
+ * 在生成的名称语料上逐字符输入若干关键词（每次按键搜索一次，取前 6 条），对比：
+ *   legacy-type   - 旧版：每次按键全表扫描，临时转大写 + 递归回溯匹配，凑满 6 条即停止
+ *   indexed-type  - SearchEngine：预建索引，续写时只复查上一次的命中项，结果按匹配质量排序
+ *   indexed-erase - 输入完整关键词后逐字符删除（取回之前的命中结果）
+ *   index-build   - setItems 建立索引（拼音 token 已在缓存中）
+ * 时间为单次按键平均耗时；hits 为最后一次按键的全部命中数（legacy 为截断后的条数）。
+ *
+ * 用法：
+ *   searchBench [--names=10000] [--rounds=5] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "utils/pinYinCache.hpp"
+#include "utils/pinYinCvt.hpp"
+#include "utils/searchEngine.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;  // 用例名称
+    double us = 0;     // 平均耗时（微秒）
+    size_t hits = 0;   // 命中数
+};
+
+/** @brief 生成中英混合的游戏名称语料 */
+std::vector<std::string> makeNames(int count) {
+    static const char* words[] = {"Zelda", "Tears", "Kingdom", "Xenoblade", "Chronicles", "Mario", "Kart", "Party",
+                                  "Splatoon", "Pokemon", "Scarlet", "Violet", "Fire", "Emblem", "Metroid", "Dread",
+                                  "Kirby", "Pikmin", "Animal", "Crossing", "Smash", "Bros", "Deluxe", "Odyssey",
+                                  "塞尔达", "传说", "宝可梦", "异度神剑", "马力欧", "HD", "60FPS", "Remastered"};
+    constexpr int wordCount = sizeof(words) / sizeof(words[0]);
+    std::mt19937 rng(7);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string name;
+        int parts = 2 + static_cast<int>(rng() % 3);
+        for (int p = 0; p < parts; ++p) {
+            if (!name.empty()) name += ' ';
+            name += words[rng() % wordCount];
+        }
+        names.push_back(name + " " + std::to_string(i));
+    }
+    return names;
+}
+
+// ── 旧版实现（对照） ──
+
+bool legacyMixedMatch(const std::string& keyword, const std::vector<std::string>& tokens, size_t keywordPos, size_t tokenPos) {
+    if (keywordPos >= keyword.size()) return true;
+    if (tokenPos >= tokens.size()) return false;
+    const std::string& token = tokens[tokenPos];
+    if (keyword[keywordPos] == token[0] && legacyMixedMatch(keyword, tokens, keywordPos + 1, tokenPos + 1)) return true;
+    if (keyword.size() - keywordPos >= token.size() && keyword.compare(keywordPos, token.size(), token) == 0) {
+        if (legacyMixedMatch(keyword, tokens, keywordPos + token.size(), tokenPos + 1)) return true;
+    }
+    return false;
+}
+
+size_t legacySearch(const std::string& keyword, const std::vector<std::string>& items, size_t maxResults) {
+    auto upper = [](std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char ch) { return std::toupper(ch); });
+        return text;
+    };
+    std::string upperKeyword = upper(keyword);
+    std::string pinyinKeyword;
+    for (char ch : pinYinCvt::toPinyin(keyword)) {
+        if (std::isalnum(static_cast<unsigned char>(ch))) pinyinKeyword += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+
+    size_t results = 0;
+    for (const auto& name : items) {
+        if (name.empty()) continue;
+        bool matched = upper(name).find(upperKeyword) != std::string::npos;
+        if (!matched && !pinyinKeyword.empty()) {
+            const auto& tokens = pinYinCache::tokens(name);
+            for (size_t start = 0; start < tokens.size() && !matched; ++start) {
+                matched = legacyMixedMatch(pinyinKeyword, tokens, 0, start);
+            }
+        }
+        if (matched && ++results >= maxResults) break;
+    }
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    int nameCount = static_cast<int>(args.getDouble("names", 10000));
+    int rounds = static_cast<int>(args.getDouble("rounds", 5));
+    std::string jsonOut = args.get("json");
+
+    pinYinCvt::init();
+    auto names = makeNames(nameCount);
+    // 关键词：原文、首字母、首字母 + 全拼混合、不存在的词
+    const std::vector<std::string> queries = {"zelda tears", "mkp", "xenobladec", "smashbrosd", "nothing here"};
+    int keystrokes = 0;
+    for (const auto& query : queries) keystrokes += static_cast<int>(query.size());
+    keystrokes *= rounds;
+
+    std::vector<CaseResult> results;
+    SearchEngine engine;
+
+    bench::Stopwatch watch;
+    for (int r = 0; r < rounds; ++r) engine.setItems(names);
+    results.push_back({"index-build", watch.seconds() * 1e6 / rounds, names.size()});
+
+    size_t hits = 0;
+    watch.reset();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& query : queries) {
+            for (size_t len = 1; len <= query.size(); ++len) hits = legacySearch(query.substr(0, len), names, 6);
+        }
+    }
+    results.push_back({"legacy-type", watch.seconds() * 1e6 / keystrokes, hits});
+
+    double typeSeconds = 0, eraseSeconds = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& query : queries) {
+            engine.setItems(names);
+            watch.reset();
+            for (size_t len = 1; len <= query.size(); ++len) hits = engine.search(query.substr(0, len), 6).size();
+            typeSeconds += watch.seconds();
+
+            watch.reset();
+            for (size_t len = query.size(); len >= 1; --len) engine.search(query.substr(0, len), 6);
+            eraseSeconds += watch.seconds();
+        }
+    }
+    results.push_back({"indexed-type", typeSeconds * 1e6 / keystrokes, hits});
+    results.push_back({"indexed-erase", eraseSeconds * 1e6 / keystrokes, hits});
+
+    bench::JsonReport report;
+    std::printf("%-14s %7s %12s %8s\n", "case", "names", "time(us)", "hits");
+    for (const auto& r : results) {
+        std::printf("%-14s %7d %12.1f %8zu\n", r.name.c_str(), nameCount, r.us, r.hits);
+        report.begin();
+        report.field("case", r.name);
+        report.field("names", static_cast<double>(nameCount));
+        report.field("us", r.us);
+        report.field("hits", static_cast<double>(r.hits));
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * segmentBench - 分段并发下载的吞吐与连接数自适应
+ * 在 127.0.0.1 上启动本地文件服务（见 fileServer.hpp），单连接限速 --conn-rate MB/s、
+ * 总带宽 --link-rate MB/s（模拟 Wi-Fi 下单条 TCP 流跑不满链路），下载 --size MB 的随机内容，依次运行：
+ *   single    - 只用单连接（原来的下载方式）
+ *   segmented - 最多 --connections 个连接，按吞吐逐个增加
+ *   no-range  - 服务器不支持 Range：退回单连接
+ *   drop      - 分段下载中前 3 次响应在随机位置断开：各连接续传
+ * 每个用例校验最终文件的 CRC32，报告耗时、吞吐、最大并发连接数、请求数与最终分段数。
+ *
+ * 用法：
+ *   segmentBench [--root=/tmp/nxmm-bench-segment] [--size=48] [--conn-rate=3] [--link-rate=8]
+ *                [--connections=4] [--seed=1] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+#include "fileServer.hpp"
+
+#include "utils/crc32.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/http.hpp"
+#include "utils/segmentDownload.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* downloadPath = "/download/payload.zip"; // 下载路径
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;             // 用例名称
+    double seconds = 0;           // 耗时
+    double mbps = 0;              // 吞吐（MB/s）
+    segmentDownload::Stats stats; // 连接与请求统计
+    bool ok = false;              // 下载成功且 CRC32 一致
+};
+
+CaseResult runCase(bench::FileServer& server, const std::string& name, const bench::ServerConfig& config, int connections) {
+    CaseResult result;
+    result.name = name;
+    server.reset(config);
+    if (fs::fileExists(downloadPath)) fs::deleteFile(downloadPath);
+    downloadJournal::remove(downloadPath);
+
+    http::Request request;
+    request.url = server.url();
+    bench::Stopwatch watch;
+    auto response = segmentDownload::toFile(request, downloadPath, connections, &result.stats);
+    result.seconds = watch.seconds();
+
+    auto data = fs::readFile(downloadPath);
+    const auto& expected = server.current();
+    result.mbps = data.size() / 1048576.0 / result.seconds;
+    result.ok = response.networkCode == 0 && response.statusCode / 100 == 2 && data.size() == expected.size() &&
+                crc::fromBuffer(0, data.data(), data.size()) == crc::fromBuffer(0, expected.data(), expected.size());
+    return result;
+}
+
+std::vector<uint8_t> makePayload(size_t size, uint32_t seed) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 random(seed);
+    for (auto& byte : data) byte = static_cast<uint8_t>(random());
+    return data;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-segment");
+    size_t size = static_cast<size_t>(args.getDouble("size", 48) * 1024 * 1024);
+    double connRate = args.getDouble("conn-rate", 3) * 1024 * 1024;
+    double linkRate = args.getDouble("link-rate", 8) * 1024 * 1024;
+    int connections = static_cast<int>(args.getDouble("connections", segmentDownload::defaultConnections));
+    uint32_t seed = static_cast<uint32_t>(args.getDouble("seed", 1));
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    http::init();
+
+    bench::FileServer server(makePayload(size, seed), makePayload(size, seed + 1), seed);
+    if (!server.start()) {
+        std::fprintf(stderr, "无法启动本地 HTTP 服务\n");
+        return 1;
+    }
+
+    bench::ServerConfig limited;
+    limited.connectionRate = connRate;
+    limited.linkRate = linkRate;
+    bench::ServerConfig noRange = limited;
+    noRange.ignoreRange = true;
+    bench::ServerConfig drop = limited;
+    drop.drops = 3;
+
+    std::vector<CaseResult> results;
+    results.push_back(runCase(server, "single", limited, 1));
+    results.push_back(runCase(server, "segmented", limited, connections));
+    results.push_back(runCase(server, "no-range", noRange, connections));
+    results.push_back(runCase(server, "drop", drop, connections));
+    server.stop();
+    http::cleanup();
+
+    bool allOk = true;
+    bench::JsonReport report;
+    std::printf("size=%.1fMB conn-rate=%.1fMB/s link-rate=%.1fMB/s\n", size / 1048576.0, connRate / 1048576.0, linkRate / 1048576.0);
+    std::printf("%-10s %8s %7s %11s %8s %8s %4s\n", "case", "time(s)", "MB/s", "connections", "requests", "segments", "ok");
+    for (const auto& r : results) {
+        allOk = allOk && r.ok;
+        std::printf("%-10s %8.2f %7.2f %11d %8d %8d %4s\n", r.name.c_str(), r.seconds, r.mbps, r.stats.connections, r.stats.requests, r.stats.segments, r.ok ? "yes" : "NO");
+        report.begin();
+        report.field("case", r.name);
+        report.field("seconds", r.seconds);
+        report.field("mbps", r.mbps);
+        report.field("connections", r.stats.connections);
+        report.field("requests", r.stats.requests);
+        report.field("segments", r.stats.segments);
+        report.field("ok", r.ok);
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,357 @@
+/**
+ * storeCatalogBench - 商店目录缓存与本地搜索性能测试
+ * 在本机起一个最小 HTTP 替身服务（返回与商店 API 相同结构的 JSON，可模拟网络延迟），对比：
+ *   refresh-full   - 空目录首次刷新（游戏列表全部分页 + 全部游戏的 MOD 列表）
+ *   refresh-incr   - 服务器上少量游戏更新 / 新增后再次刷新（只重新拉取变化游戏的 MOD 列表）
+ *   load           - 从文件读取目录并建立倒排索引（冷启动）
+ *   local-search   - 本地倒排索引搜索，单次查询平均耗时
+ *   server-search  - 经替身服务的搜索请求，单次查询平均耗时（含模拟延迟）
+ *   offline-search - 替身服务停止后的本地搜索（仍可作答）
+ * requests 为发出的 HTTP 请求数，items 为刷新后的游戏数或一轮查询的命中总数。
+ *
+ * 用法：
+ *   storeCatalogBench [--games=2000] [--latency=20] [--rounds=20] [--root=/tmp/nxmm-bench-catalog] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+
+#include "api/game.hpp"
+#include "api/mod.hpp"
+#include "core/storeCatalog.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/http.hpp"
+#include "utils/pinYinCvt.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;  // 用例名称
+    double ms = 0;     // 耗时（毫秒）
+    int requests = 0;  // HTTP 请求数
+    size_t items = 0;  // 游戏数或命中数
+};
+
+/** @brief 替身服务中的 MOD */
+struct FakeMod {
+    int modId;          // 模组 ID
+    std::string name;   // 名称
+    std::string type;   // 类型
+    std::string author; // 作者
+};
+
+/** @brief 替身服务中的游戏 */
+struct FakeGame {
+    std::string tid;           // 游戏 TID
+    std::string name;          // 名称
+    std::string lastUpdate;    // 最后更新时间
+    std::vector<FakeMod> mods; // MOD 列表
+};
+
+/** @brief 生成中英混合的商店目录 */
+std::vector<FakeGame> makeCatalog(int count) {
+    static const char* words[] = {"Zelda", "Tears", "Kingdom", "Xenoblade", "Chronicles", "Mario", "Kart", "Party",
+                                  "Splatoon", "Pokemon", "Scarlet", "Violet", "Fire", "Emblem", "Metroid", "Dread",
+                                  "塞尔达", "传说", "宝可梦", "异度神剑", "马力欧", "HD", "Deluxe", "Odyssey"};
+    static const char* modWords[] = {"60FPS", "Dynamic", "Resolution", "Uncapped", "Shadows", "Bloom", "Chinese", "Patch"};
+    static const char* types[] = {"performance", "graphics", "translation", "cheat"};
+    static const char* authors[] = {"ChucksFeedAndSeed", "theboy181", "Hazerou", "Fl4sh", "StevenM", "小明"};
+    constexpr int wordCount = sizeof(words) / sizeof(words[0]);
+    constexpr int modWordCount = sizeof(modWords) / sizeof(modWords[0]);
+
+    std::mt19937 rng(11);
+    std::vector<FakeGame> games;
+    int modId = 1;
+    for (int i = 0; i < count; ++i) {
+        FakeGame game;
+        char tid[17];
+        std::snprintf(tid, sizeof(tid), "0100%08X0000", 0x10000 + i);
+        game.tid = tid;
+        int parts = 2 + static_cast<int>(rng() % 2);
+        for (int p = 0; p < parts; ++p) {
+            if (!game.name.empty()) game.name += ' ';
+            game.name += words[rng() % wordCount];
+        }
+        game.name += " " + std::to_string(i);
+        game.lastUpdate = "2026-01-01 00:00:00";
+        int modCount = static_cast<int>(rng() % 8);
+        for (int m = 0; m < modCount; ++m) {
+            FakeMod mod;
+            mod.modId = modId++;
+            mod.name = std::string(modWords[rng() % modWordCount]) + " " + modWords[rng() % modWordCount];
+            mod.type = types[rng() % 4];
+            mod.author = authors[rng() % 6];
+            game.mods.push_back(std::move(mod));
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+/** @brief 取查询串中的参数值 */
+std::string queryParam(const std::string& path, const std::string& key) {
+    size_t pos = path.find(key + "=");
+    if (pos == std::string::npos) return "";
+    pos += key.size() + 1;
+    size_t end = path.find('&', pos);
+    return path.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+/** @brief 最小 HTTP 替身服务：单线程、每个连接一个请求 */
+class FakeStoreServer {
+public:
+    FakeStoreServer(std::vector<FakeGame> games, int latencyMs) : m_games(std::move(games)), m_latencyMs(latencyMs) {
+        m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+        listen(m_listenFd, 16);
+        m_thread = std::thread([this] { serve(); });
+    }
+
+    ~FakeStoreServer() { stop(); }
+
+    /** @brief 停止服务（之后的请求全部连接失败） */
+    void stop() {
+        if (m_listenFd < 0) return;
+        m_stopped = true;
+        shutdown(m_listenFd, SHUT_RDWR);
+        m_thread.join();
+        close(m_listenFd);
+        m_listenFd = -1;
+    }
+
+    /** @brief 服务地址前缀 */
+    std::string baseUrl() const { return "http://127.0.0.1:" + std::to_string(m_port); }
+
+    /** @brief 修改服务端数据（测试增量刷新） */
+    template <typename Fn>
+    void mutate(Fn&& fn) {
+        std::lock_guard lock(m_mutex);
+        fn(m_games);
+    }
+
+private:
+    std::vector<FakeGame> m_games; // 服务端目录
+    int m_latencyMs;               // 每个请求的模拟延迟
+    int m_listenFd = -1;           // 监听 socket
+    int m_port = 0;                // 监听端口
+    std::atomic<bool> m_stopped{false}; // 是否已停止
+    std::mutex m_mutex;            // 保护 m_games
+    std::thread m_thread;          // 服务线程
+
+    void serve() {
+        while (!m_stopped) {
+            int fd = accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0) break;
+            std::string request;
+            char buf[4096];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                ssize_t n = read(fd, buf, sizeof(buf));
+                if (n <= 0) break;
+                request.append(buf, n);
+            }
+            size_t start = request.find(' ') + 1;
+            std::string path = request.substr(start, request.find(' ', start) - start);
+            std::string body = handle(path);
+            if (m_latencyMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+
+            std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                                   std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+            for (size_t sent = 0; sent < response.size();) {
+                ssize_t n = write(fd, response.data() + sent, response.size() - sent);
+                if (n <= 0) break;
+                sent += n;
+            }
+            close(fd);
+        }
+    }
+
+    /** @brief /games?page&limit[&keyword]、/mods?tid&page&limit */
+    std::string handle(const std::string& path) {
+        std::lock_guard lock(m_mutex);
+        int page = std::max(1, std::atoi(queryParam(path, "page").c_str()));
+        int limit = std::max(1, std::atoi(queryParam(path, "limit").c_str()));
+        std::string json;
+
+        if (path.rfind("/mods", 0) == 0) {
+            std::string tid = queryParam(path, "tid");
+            const FakeGame* game = nullptr;
+            for (const auto& g : m_games) {
+                if (g.tid == tid) game = &g;
+            }
+            size_t total = game ? game->mods.size() : 0;
+            json = "{\"data\":{\"total\":" + std::to_string(total) + ",\"list\":[";
+            for (size_t i = (page - 1) * limit, n = 0; game && i < total && n < static_cast<size_t>(limit); ++i, ++n) {
+                const auto& mod = game->mods[i];
+                if (n > 0) json += ',';
+                json += "{\"mod_id\":" + std::to_string(mod.modId) + ",\"mod_name\":\"" + mod.name + "\",\"mod_type\":\"" +
+                        mod.type + "\",\"author\":\"" + mod.author + "\"}";
+            }
+            return json + "]}}";
+        }
+
+        // 服务端搜索：名称子串匹配（不区分大小写）
+        std::string keyword = queryParam(path, "keyword");
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::toupper);
+        std::vector<const FakeGame*> matched;
+        for (const auto& game : m_games) {
+            std::string upper = game.name;
+            std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+            if (keyword.empty() || upper.find(keyword) != std::string::npos) matched.push_back(&game);
+        }
+        json = "{\"data\":{\"total\":" + std::to_string(matched.size()) + ",\"list\":[";
+        for (size_t i = (page - 1) * limit, n = 0; i < matched.size() && n < static_cast<size_t>(limit); ++i, ++n) {
+            const auto& game = *matched[i];
+            if (n > 0) json += ',';
+            json += "{\"game_tid\":\"" + game.tid + "\",\"game_name\":\"" + game.name + "\",\"mod_count\":" +
+                    std::to_string(game.mods.size()) + ",\"last_update\":\"" + game.lastUpdate + "\"}";
+        }
+        return json + "]}}";
+    }
+};
+
+/** @brief 指向替身服务的数据源 */
+StoreCatalog::Source makeSource(const std::string& baseUrl) {
+    StoreCatalog::Source source;
+    source.fetchGames = [baseUrl](int page, int limit, std::stop_token token) {
+        http::Request request;
+        request.url = baseUrl + "/games?page=" + std::to_string(page) + "&limit=" + std::to_string(limit);
+        request.token = token;
+        return api::game::parseGameList(http::requestToMemory(request));
+    };
+    source.fetchMods = [baseUrl](const std::string& gameTid, int page, int limit, std::stop_token token) {
+        http::Request request;
+        request.url = baseUrl + "/mods?tid=" + gameTid + "&page=" + std::to_string(page) + "&limit=" + std::to_string(limit);
+        request.token = token;
+        return api::mod::parseModList(http::requestToMemory(request));
+    };
+    source.lang = "zh-Hans";
+    return source;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    int gameCount = static_cast<int>(args.getDouble("games", 2000));
+    int latencyMs = static_cast<int>(args.getDouble("latency", 20));
+    int rounds = static_cast<int>(args.getDouble("rounds", 20));
+    std::string root = args.get("root", "/tmp/nxmm-bench-catalog");
+    std::string jsonOut = args.get("json");
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root, ec);
+    if (ec) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+    fs::setRootDir(root);
+    pinYinCvt::init();
+    http::init();
+
+    const std::string path = "/storeCatalog.bin";
+
+    FakeStoreServer server(makeCatalog(gameCount), latencyMs);
+    auto source = makeSource(server.baseUrl());
+    const std::vector<std::string> queries = {"zelda", "sel da", "bkm", "xenoblade 12", "60fps", "theboy", "nothing"};
+    std::vector<CaseResult> results;
+    bench::Stopwatch watch;
+
+    // 首次刷新：MOD 预算不限，一次同步全部游戏
+    StoreCatalog catalog;
+    catalog.load(path);
+    auto stats = catalog.refresh(source, {}, gameCount);
+    results.push_back({"refresh-full", watch.seconds() * 1e3, stats.requests, static_cast<size_t>(stats.games)});
+
+    // 服务端 5% 游戏更新、新增 20 个游戏后再次刷新
+    server.mutate([](std::vector<FakeGame>& games) {
+        for (size_t i = 0; i < games.size(); i += 20) {
+            games[i].lastUpdate = "2026-02-01 00:00:00";
+            games[i].mods.push_back({900000 + static_cast<int>(i), "Fresh Patch", "performance", "newcomer"});
+        }
+        auto extra = makeCatalog(static_cast<int>(games.size()) + 20);
+        games.insert(games.end(), extra.end() - 20, extra.end());
+    });
+    watch.reset();
+    stats = catalog.refresh(source, {}, gameCount);
+    results.push_back({"refresh-incr", watch.seconds() * 1e3, stats.requests, static_cast<size_t>(stats.games)});
+
+    StoreCatalog loaded;
+    watch.reset();
+    loaded.load(path);
+    results.push_back({"load", watch.seconds() * 1e3, 0, loaded.gameCount()});
+
+    size_t hits = 0;
+    watch.reset();
+    for (int r = 0; r < rounds; ++r) {
+        hits = 0;
+        for (const auto& query : queries) hits += loaded.search(query, "zh-Hans").size();
+    }
+    results.push_back({"local-search", watch.seconds() * 1e3 / (rounds * queries.size()), 0, hits});
+
+    int serverRounds = std::max(1, rounds / 10);
+    watch.reset();
+    for (int r = 0; r < serverRounds; ++r) {
+        hits = 0;
+        for (const auto& query : queries) {
+            http::Request request;
+            request.url = server.baseUrl() + "/games?page=1&limit=20&keyword=" + http::escape(query);
+            hits += api::game::parseGameList(http::requestToMemory(request)).list.size();
+        }
+    }
+    results.push_back({"server-search", watch.seconds() * 1e3 / (serverRounds * queries.size()),
+                       static_cast<int>(serverRounds * queries.size()), hits});
+
+    server.stop();
+    watch.reset();
+    for (int r = 0; r < rounds; ++r) {
+        hits = 0;
+        for (const auto& query : queries) hits += loaded.search(query, "zh-Hans").size();
+    }
+    results.push_back({"offline-search", watch.seconds() * 1e3 / (rounds * queries.size()), 0, hits});
+
+    bench::JsonReport report;
+    std::printf("%-15s %7s %11s %9s %7s\n", "case", "games", "time(ms)", "requests", "items");
+    for (const auto& r : results) {
+        std::printf("%-15s %7d %11.3f %9d %7zu\n", r.name.c_str(), gameCount, r.ms, r.requests, r.items);
+        report.begin();
+        report.field("case", r.name);
+        report.field("games", static_cast<double>(gameCount));
+        report.field("ms", r.ms);
+        report.field("requests", static_cast<double>(r.requests));
+        report.field("items", static_cast<double>(r.items));
+        report.end();
+    }
+
+    http::cleanup();
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return 0;
+}
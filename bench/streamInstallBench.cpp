@@ -0,0 +1,241 @@
+/**
+ * streamInstallBench - 边下载边安装与“下载完再安装”的总耗时对比
+ * 用 modGenerator 生成 --shape 形态、--scale 规模的 ZIP 模组，由本地文件服务（见 fileServer.hpp）提供，
+ * 单连接限速 --conn-rate MB/s、总带宽 --link-rate MB/s，依次运行：
+ *   download  - 只下载（参考：边下载边安装的理想耗时）
+ *   serial    - 下载完成后再用 ModInstaller::install 安装（原来的方式）
+ *   streaming - zipStream 先取回中央目录，安装与下载同时进行
+ *   drop      - 边下载边安装，前 3 次响应在随机位置断开
+ *   no-range  - 服务器不支持 Range：不边下载边安装，下载完成后安装
+ * 每个安装用例比较安装后 atmosphere 目录树（路径 + 内容 CRC32）与 serial 的结果，
+ * 报告总耗时、相对只下载的额外耗时与是否边下载边安装。
+ *
+ * 用法：
+ *   streamInstallBench [--root=/tmp/nxmm-bench-stream] [--shape=huge] [--scale=0.5]
+ *                      [--conn-rate=3] [--link-rate=8] [--connections=4] [--seed=1] [--json=result.json]
+ */
+
+#include "benchUtil.hpp"
+#include "fileServer.hpp"
+#include "modGenerator.hpp"
+
+#include "common/gameInfo.hpp"
+#include "common/modInfo.hpp"
+#include "core/modGameType.hpp"
+#include "core/modInstaller/install.hpp"
+#include "utils/async.hpp"
+#include "utils/crc32.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/http.hpp"
+#include "utils/segmentDownload.hpp"
+#include "utils/zipStream.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* markerFile = "/.nxmm-bench"; // 沙盒标记，防止误删非测试目录
+
+/** @brief 单个测试用例的测量结果 */
+struct CaseResult {
+    std::string name;       // 用例名称
+    double seconds = 0;     // 下载 + 安装总耗时
+    bool streamed = false;  // 是否边下载边安装
+    bool installed = false; // 安装器是否返回成功
+    uint32_t digest = 0;    // 安装后目录树摘要
+    std::string errorMsg;   // 失败原因
+};
+
+/** @brief 测试用的游戏与模组 */
+struct Target {
+    GameInfo game;             // 游戏信息
+    ModInfo mod;               // 模组信息
+    ModGameType gameType;      // MOD 适配类型
+    std::string zipPath;       // 模组 ZIP 路径
+};
+
+bool prepareSandbox(const std::string& root) {
+    namespace stdfs = std::filesystem;
+    std::error_code ec;
+    stdfs::create_directories(root, ec);
+    if (ec) return false;
+
+    fs::setRootDir(root);
+    bool empty = stdfs::is_empty(root, ec);
+    if (!empty && !fs::fileExists(markerFile)) {
+        std::fprintf(stderr, "拒绝使用非空且不含 %s 标记的目录：%s\n", markerFile + 1, root.c_str());
+        return false;
+    }
+
+    if (!fs::removeDirContents("/")) return false;
+    return fs::writeFile(markerFile, "", 0) == 0;
+}
+
+/** @brief 清空沙盒内容（保留标记文件），建立 atmosphere 与模组目录 */
+void wipeSandbox(const Target& target) {
+    fs::removeDirContents("/");
+    fs::writeFile(markerFile, "", 0);
+    fs::ensureDir("/atmosphere/contents");
+    fs::ensureDir(target.mod.path);
+}
+
+/** @brief atmosphere 目录树摘要：按路径排序后依次累加相对路径与文件内容的 CRC32 */
+uint32_t treeDigest(const std::string& root) {
+    namespace stdfs = std::filesystem;
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (auto it = stdfs::recursive_directory_iterator(root + "/atmosphere", ec); !ec && it != stdfs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file()) files.push_back(it->path().string().substr(root.size()));
+    }
+    std::sort(files.begin(), files.end());
+
+    uint32_t digest = 0;
+    for (const auto& file : files) {
+        digest = crc::fromBuffer(digest, file.data(), file.size());
+        auto data = fs::readFile(file);
+        digest = crc::fromBuffer(digest, data.data(), data.size());
+    }
+    return digest;
+}
+
+CaseResult runCase(bench::FileServer& server, const std::string& root, const Target& target, const std::string& name, const bench::ServerConfig& config, int connections, bool install, bool stream) {
+    CaseResult result;
+    result.name = name;
+    wipeSandbox(target);
+    server.reset(config);
+    std::vector<ModInfo> allMods{target.mod};
+
+    http::Request request;
+    request.url = server.url();
+    bench::Stopwatch watch;
+
+    ModInstaller::InstallResult installResult;
+    util::AsyncFurture<void> installTask;
+    http::Response response;
+    if (stream) {
+        response = zipStream::toFile(request, target.zipPath, [&](std::shared_ptr<PartialFile> file) {
+            result.streamed = true;
+            installTask = util::async([&, file](std::stop_token token) {
+                installResult = ModInstaller::installStreaming(target.mod, target.game, target.gameType, allMods, file, nullptr, token);
+            });
+        }, connections);
+        if (installTask.valid()) installTask.get();
+    } else {
+        response = segmentDownload::toFile(request, target.zipPath, connections);
+    }
+
+    bool downloaded = response.networkCode == 0 && response.statusCode / 100 == 2;
+    if (install && downloaded && !result.streamed) installResult = ModInstaller::install(target.mod, target.game, target.gameType, allMods);
+    result.seconds = watch.seconds();
+
+    result.installed = install ? installResult.success : downloaded;
+    result.errorMsg = downloaded ? installResult.errorMsg : "download failed";
+    if (install && result.installed) result.digest = treeDigest(root);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Args args(argc, argv);
+    std::string root = args.get("root", "/tmp/nxmm-bench-stream");
+    std::string shapeName = args.get("shape", "huge");
+    double scale = args.getDouble("scale", 0.5);
+    double connRate = args.getDouble("conn-rate", 3) * 1024 * 1024;
+    double linkRate = args.getDouble("link-rate", 8) * 1024 * 1024;
+    int connections = static_cast<int>(args.getDouble("connections", segmentDownload::defaultConnections));
+    uint32_t seed = static_cast<uint32_t>(args.getDouble("seed", 1));
+    std::string jsonOut = args.get("json");
+
+    if (!prepareSandbox(root)) {
+        std::fprintf(stderr, "无法准备沙盒目录：%s\n", root.c_str());
+        return 1;
+    }
+
+    const bench::ShapeInfo* shape = nullptr;
+    for (const auto& info : bench::allShapes()) {
+        if (shapeName == info.name) shape = &info;
+    }
+    if (!shape) {
+        std::fprintf(stderr, "未知的模组形态：%s\n", shapeName.c_str());
+        return 1;
+    }
+
+    Target target;
+    target.game.appId = shape->appId;
+    target.game.version = shape->gameVersion;
+    target.game.displayName = "Bench";
+    target.game.dirPath = std::string("/mods2/Bench/") + format::appIdHex(target.game.appId);
+    target.mod.dirName = std::string("bench-") + shape->name;
+    target.mod.displayName = target.mod.dirName;
+    target.mod.path = target.game.dirPath + "/" + target.mod.dirName;
+    target.mod.isZip = true;
+    target.gameType = modGameType::detect(target.game.appId);
+    target.zipPath = target.mod.path + "/" + target.mod.dirName + ".zip";
+
+    // 生成一次模组 ZIP，读入内存作为服务器内容
+    wipeSandbox(target);
+    auto generated = bench::generateMod(bench::planFiles(shape->shape, scale), target.mod.path, target.mod.dirName, true);
+    auto payload = fs::readFile(target.zipPath);
+    if (!generated.success || payload.empty()) {
+        std::fprintf(stderr, "生成模组失败：%s\n", shape->name);
+        return 1;
+    }
+
+    http::init();
+    bench::FileServer server(payload, payload, seed);
+    if (!server.start()) {
+        std::fprintf(stderr, "无法启动本地 HTTP 服务\n");
+        return 1;
+    }
+
+    bench::ServerConfig limited;
+    limited.connectionRate = connRate;
+    limited.linkRate = linkRate;
+    bench::ServerConfig drop = limited;
+    drop.drops = 3;
+    bench::ServerConfig noRange = limited;
+    noRange.ignoreRange = true;
+
+    std::vector<CaseResult> results;
+    results.push_back(runCase(server, root, target, "download", limited, connections, false, false));
+    results.push_back(runCase(server, root, target, "serial", limited, connections, true, false));
+    results.push_back(runCase(server, root, target, "streaming", limited, connections, true, true));
+    results.push_back(runCase(server, root, target, "drop", drop, connections, true, true));
+    results.push_back(runCase(server, root, target, "no-range", noRange, connections, true, true));
+    server.stop();
+    http::cleanup();
+
+    double downloadSeconds = results[0].seconds;
+    uint32_t expected = results[1].digest;
+    bool allOk = true;
+    bench::JsonReport report;
+    std::printf("shape=%s zip=%.1fMB files=%d unpacked=%.1fMB conn-rate=%.1fMB/s link-rate=%.1fMB/s\n", shape->name, payload.size() / 1048576.0,
+                generated.fileCount, generated.totalBytes / 1048576.0, connRate / 1048576.0, linkRate / 1048576.0);
+    std::printf("%-10s %8s %9s %8s %4s\n", "case", "time(s)", "extra(s)", "streamed", "ok");
+    for (const auto& r : results) {
+        bool installCase = r.name != "download";
+        bool ok = r.installed && (!installCase || (r.digest != 0 && r.digest == expected));
+        allOk = allOk && ok;
+        std::printf("%-10s %8.2f %9.2f %8s %4s%s%s\n", r.name.c_str(), r.seconds, r.seconds - downloadSeconds, r.streamed ? "yes" : "no", ok ? "yes" : "NO",
+                    r.errorMsg.empty() ? "" : "  ", r.errorMsg.c_str());
+        report.begin();
+        report.field("case", r.name);
+        report.field("seconds", r.seconds);
+        report.field("extraSeconds", r.seconds - downloadSeconds);
+        report.field("streamed", r.streamed);
+        report.field("ok", ok);
+        report.end();
+    }
+
+    if (!report.write(jsonOut)) {
+        std::fprintf(stderr, "写出 JSON 结果失败：%s\n", jsonOut.c_str());
+        return 1;
+    }
+    return allOk ? 0 : 1;
+}
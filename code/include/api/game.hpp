@@ -12,6 +12,8 @@
 #include <string>
 #include <vector>
 
+namespace http { struct Response; }
+
 namespace api::game {
 
 /** @brief 游戏名称查询结果 */
@@ -45,6 +47,13 @@ struct GameListResult : api::ApiResult {
     std::vector<GameList> list; // 当前页的游戏列表
 };
 
+/**
+ * @brief 解析游戏列表响应（fetchGameList / fetchInstalledGameList 共用，也供本地替身服务复用）
+ * @param resp HTTP 响应
+ * @return GameListResult 包含成功/失败状态和游戏列表
+ */
+GameListResult parseGameList(const http::Response& resp);
+
 /**
  * @brief 获取商店游戏列表
  * @param page 页码（从 1 开始）
@@ -9,10 +9,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include <stop_token>
 
+namespace http { struct Response; }
+class PartialFile;
+
 namespace api::mod {
 
 /** @brief 商店模组列表中的单个模组条目 */
@@ -42,6 +46,13 @@ struct ModListResult : api::ApiResult {
     std::vector<ModList> list; // 当前页的模组列表
 };
 
+/**
+ * @brief 解析模组列表响应（也供本地替身服务复用）
+ * @param resp HTTP 响应
+ * @return ModListResult 包含成功、失败状态和模组列表
+ */
+ModListResult parseModList(const http::Response& resp);
+
 /**
  * @brief 获取商店模组列表
  * @param gameTid 游戏 TID
@@ -138,15 +149,33 @@ struct DownloadInfoResult : api::ApiResult {
  */
 DownloadInfoResult fetchDownloadInfo(int modId, std::stop_token token = {});
 
+/** @brief 模组文件下载结果 */
+struct DownloadResult : api::ApiResult {
+    std::string fileCrc32; // 成功时下载内容的 CRC32（8 位小写十六进制，边下载边计算）
+};
+
 /**
- * @brief 下载模组文件到指定路径
+ * @brief 下载模组文件到指定路径，下载过程中计算 CRC32 并与商店给出的值核对
  * @param modId 模组 ID
  * @param path 保存路径
+ * @param expectedCrc32 商店给出的 CRC32（十六进制），为空时不核对
  * @param progress 进度回调 (total, now)，返回 false 可中断
  * @param token 用于取消请求的停止令牌
- * @return ApiResult 包含成功、失败状态和错误信息
+ * @return DownloadResult 包含成功、失败状态、错误信息和文件 CRC32
+ */
+DownloadResult download(int modId, const std::string& path, const std::string& expectedCrc32, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {});
+
+/**
+ * @brief 下载模组文件到指定路径，取得 ZIP 中央目录后立即回调，供边下载边安装
+ * @param modId 模组 ID
+ * @param path 保存路径
+ * @param expectedCrc32 商店给出的 CRC32（十六进制），为空时不核对；不一致时读取方按下载失败处理
+ * @param onOpened 取得中央目录后的回调（在下载线程中调用，服务器不支持 Range 时不调用）
+ * @param progress 进度回调 (total, now)，返回 false 可中断
+ * @param token 用于取消请求的停止令牌
+ * @return DownloadResult 包含成功、失败状态、错误信息和文件 CRC32
  */
-api::ApiResult download(int modId, const std::string& path, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {});
+DownloadResult downloadStreaming(int modId, const std::string& path, const std::string& expectedCrc32, const std::function<void(std::shared_ptr<PartialFile> file)>& onOpened, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {});
 
 /** @brief 模组更新检查结果 */
 struct ModUpdateCheckResult : api::ApiResult {
@@ -50,6 +50,7 @@ namespace mod {
 
 namespace app {
     inline std::string latest() { return base; }
+    inline std::string versionHistory() { return base; }
     inline std::string download() { return base; }
 }
 
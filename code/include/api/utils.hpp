@@ -5,6 +5,7 @@
 #pragma once
 
 #include "utils/http.hpp"
+#include "utils/zipStream.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -83,14 +84,29 @@ void setTextBody(http::Request& request, const std::string& body, const std::str
 http::Response downloadBytes(const std::string& url, const std::vector<http::Header>& headers = {}, std::stop_token token = {});
 
 /**
- * @brief 下载文件到指定路径，失败时删除不完整文件
+ * @brief 下载文件到指定路径，大文件分段并发下载，支持断点续传（见 segmentDownload）
+ * 重试用尽或取消时保留不完整文件和记录，以相同地址再次调用时继续。
+ * 服务器不支持续传或没有写入任何内容时删除不完整文件
  * @param url 下载地址
  * @param path 保存路径
+ * @param progress 下载进度回调（所有连接合并后的进度，在调用线程中执行）
+ * @param token 取消令牌
+ * @param expectedCrc 期望的 CRC32，0 表示不核对；不一致时删除文件，networkCode 为 segmentDownload::checksumMismatch
+ * @param crc32 可选，成功时输出边下载边计算的 CRC32
+ * @return HTTP 响应结果
+ */
+http::Response downloadToFile(const std::string& url, const std::string& path, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {}, uint32_t expectedCrc = 0, uint32_t* crc32 = nullptr);
+
+/**
+ * @brief 下载 ZIP 到指定路径，先取回中央目录供边下载边读取（见 zipStream），其余同 downloadToFile
+ * @param url 下载地址
+ * @param path 保存路径
+ * @param onOpened 取得中央目录后的回调（服务器不支持 Range 时不调用）
  * @param progress 下载进度回调
  * @param token 取消令牌
  * @return HTTP 响应结果
  */
-http::Response downloadToFile(const std::string& url, const std::string& path, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {});
+http::Response downloadZipToFile(const std::string& url, const std::string& path, const zipStream::OpenedCallback& onOpened, std::function<bool(size_t total, size_t now)> progress = {}, std::stop_token token = {}, uint32_t expectedCrc = 0, uint32_t* crc32 = nullptr);
 
 /**
  * @brief 向 header 列表追加一项，name 为空时不追加
@@ -16,17 +16,26 @@ namespace config {
     constexpr const char* modsRoot     = "/mods2/";
     constexpr const char* gameInfoPath = "/mods2/gameInfo.json";
     constexpr const char* modInfoFile       = "/modInfo.json";
-    constexpr const char* refCountFile      = "/modFileRefCount.json";
+    constexpr const char* refCountFile      = "/modFileRefCount.bin";   // 旧版 modFileRefCount.json 首次加载时自动迁移
     constexpr const char* mhriseInstallMapFile = "/mhriseInstallMap.json";
     constexpr const char* dontStarveInstallMapFile = "/dontStarveInstallMap.json";
+    constexpr const char* installManifestExt = ".manifest";   // {游戏目录}/{MOD 目录名}.manifest
+    constexpr const char* installedIndexFile = "/installedFiles.idx"; // {游戏目录}/installedFiles.idx
+    constexpr const char* crcCacheFile = "/crcCache.bin";              // {游戏目录}/crcCache.bin
     constexpr const char* transitDir        = "/mods2/!temp_mods/";
 
     // ── 配置文件路径 ──
 
     constexpr const char* settingsPath       = "/config/NX-Mod-Manager/setting.json";
+    constexpr const char* gameLibraryPath    = "/config/NX-Mod-Manager/gameLibrary.bin"; // 游戏库启动快照
+    constexpr const char* pinyinCachePath    = "/config/NX-Mod-Manager/pinyinCache.bin"; // 拼音转换缓存
+    constexpr const char* iconCacheDir       = "/config/NX-Mod-Manager/iconCache";       // 已解码图标像素缓存
     constexpr const char* modShopDir          = "/config/NX-Mod-Manager/modShop/";
     constexpr const char* storeGameIconDir    = "/config/NX-Mod-Manager/modShop/gameIcons";
     constexpr const char* storeGameIconCachePath = "/config/NX-Mod-Manager/modShop/gameIconCache.json";
+    constexpr const char* storeCatalogPath    = "/config/NX-Mod-Manager/modShop/storeCatalog.bin"; // 商店目录与搜索索引
+    constexpr const char* downloadQueuePath   = "/config/NX-Mod-Manager/modShop/downloadQueue.json"; // 后台下载队列
+    constexpr const char* downloadTempDir     = "/config/NX-Mod-Manager/modShop/temp/";  // 下载中的模组 zip
     constexpr const char* appUpdateDir        = "/config/NX-Mod-Manager/appUpdate/";
 
     // ── 内置资源路径 ──
@@ -12,8 +12,8 @@
 struct GameInfo {
     std::string displayName;     // 显示名（回滚链：JSON displayName → JSON gameName → 目录名）
     std::string version;         // 版本号（从 JSON 缓存读，第二阶段 API 更新）
-    std::string modCount;        // mod 数量
-    int iconId = 0;              // NVG 图标 ID
+    int modCount = 0;            // mod 数量
+    int iconId = 0;              // 图标在 IconAtlas 中的槽位 ID
     uint64_t appId = 0;          // 游戏唯一 ID
     std::string dirPath;         // 完整路径 /mods2/dirName/appIdHex
     bool isInstalled = false;    // 游戏本体是否已安装在主机
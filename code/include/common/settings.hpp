@@ -1,6 +1,6 @@
 /**
  * Settings - 全局运行时配置（单文件）
- * 启动时从 SD 卡 JSON 加载，set 时可自动持久化
+ * 启动时从 SD 卡 JSON 加载，set 时可自动持久化（延迟合并写入）
  * 基于 JsonFile 封装，category 对应 JSON 的 rootKey
  */
 
@@ -43,16 +43,26 @@ public:
         return json().getBool(category, key, defaultValue);
     }
 
+    /**
+     * @brief 读取整数配置
+     * @param category 分类
+     * @param key 键名
+     * @param defaultValue 默认值
+     */
+    static int getInt(const std::string& category, const std::string& key, int defaultValue = 0) {
+        return json().getInt(category, key, defaultValue);
+    }
+
     /**
      * @brief 写入字符串配置
      * @param category 分类
      * @param key 键名
      * @param value 值
-     * @param save 是否立即持久化
+     * @param save 是否持久化（交给写入队列，不等待 SD 卡）
      */
     static void setString(const std::string& category, const std::string& key, const std::string& value, bool save = true) {
         json().setString(category, key, value);
-        if (save) json().save();
+        if (save) json().saveDeferred();
     }
 
     /**
@@ -60,11 +70,23 @@ public:
      * @param category 分类
      * @param key 键名
      * @param value 值
-     * @param save 是否立即持久化
+     * @param save 是否持久化（交给写入队列，不等待 SD 卡）
      */
     static void setBool(const std::string& category, const std::string& key, bool value, bool save = true) {
         json().setBool(category, key, value);
-        if (save) json().save();
+        if (save) json().saveDeferred();
+    }
+
+    /**
+     * @brief 写入整数配置
+     * @param category 分类
+     * @param key 键名
+     * @param value 值
+     * @param save 是否持久化（交给写入队列，不等待 SD 卡）
+     */
+    static void setInt(const std::string& category, const std::string& key, int value, bool save = true) {
+        json().setInt(category, key, value);
+        if (save) json().saveDeferred();
     }
 
     /**
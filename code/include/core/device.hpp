@@ -51,11 +51,21 @@ namespace HomeButton {
     void enable();
 }
 
+/**
+ * CPU 加速按调用方计数：第一个 enableFastLoad 开启，最后一个 disable 恢复，可在任意线程调用；
+ * 每次 enableFastLoad 须对应一次 disable
+ */
 namespace CpuBoost {
-    /** @brief 开启 FastLoad CPU 加速模式 */
+    /**
+     * @brief 设置是否允许加速（主线程在读取设置后调用），加速进行中时立即生效
+     * @param enabled 是否允许
+     */
+    void setEnabled(bool enabled);
+
+    /** @brief 申请 FastLoad CPU 加速模式 */
     void enableFastLoad();
 
-    /** @brief 恢复普通 CPU 模式 */
+    /** @brief 释放一次申请，没有调用方时恢复普通 CPU 模式 */
     void disable();
 }
 
@@ -0,0 +1,271 @@
+/**
+ * DownloadManager - 商店模组后台下载队列
+ * 单例，与进程同生命周期，不随页面创建/销毁：页面只负责加入任务、显示状态和控制单个任务。
+ *
+ * 队列写入 config::downloadQueuePath，启动时恢复：未完成的任务排队后从续传记录继续，
+ * 已下载完成但尚未放入游戏目录的任务重新交给完成回调。
+ * 同时下载的任务数由设置 Download/concurrency 决定（1 ~ maxConcurrency），其余任务排队。
+ * 暂停 = 停止传输，保留临时文件与续传记录；取消 = 停止传输并删除临时文件与续传记录。
+ *
+ * 下载完成（CRC32 已核对）后在下载线程调用完成回调，由持有 GameManager 的 Home 切到主线程调用 complete()，
+ * 创建或更新本地模组项目；页面持有的 ModManager 通过 attach() 登记，完成时优先写入它，避免页面数据过期。
+ * 页面在后台线程读取 ModManager（安装、边下载边安装）期间用 hold() 占用，目标游戏的完成推迟到 release() 后重新回调。
+ */
+
+#pragma once
+
+#include "common/modInfo.hpp"
+#include "utils/async.hpp"
+#include "utils/jsonFile.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+
+class GameManager;
+class ModManager;
+
+class DownloadManager {
+public:
+    static constexpr int maxConcurrency = 3;     // 同时下载的任务数上限
+    static constexpr int defaultConcurrency = 2; // 默认同时下载的任务数
+
+    /** @brief 任务状态 */
+    enum class State {
+        Queued,     // 排队等待
+        Running,    // 正在下载
+        Paused,     // 已暂停（保留已下载的部分）
+        Downloaded, // 已下载，等待放入游戏目录
+        Failed      // 下载失败（可重试）
+    };
+
+    /** @brief 下载任务 */
+    struct Task {
+        int id = 0;                  // 任务 ID（队列内唯一）
+        int modId = 0;               // 模组 ID
+        std::string gameTid;         // 游戏 TID
+        std::string gameName;        // 当前显示游戏名
+        std::string gameDir;         // 加入时的本地游戏目录（为空时按 TID 查找或新建项目）
+        bool update = false;         // 是否为更新（完成后替换已下载模组的 zip）
+        ModInfo modInfo;             // 完成后写入的模组信息（fileCrc32 为商店给出的期望值）
+        int64_t fileSize = 0;        // 商店给出的文件大小（服务器未给出总大小时代替显示）
+        State state = State::Queued; // 当前状态
+        std::string gameNameEn;      // 英文游戏名（获取下载信息后填入）
+        std::string modDirName;      // 模组目录名（获取下载信息后填入）
+        std::string fileCrc32;       // 下载时计算的 zip CRC32
+        std::string error;           // 失败原因
+        uint64_t downloaded = 0;     // 已下载字节数
+        uint64_t total = 0;          // 总字节数（未知时为 0）
+        double speed = 0;            // 平滑后的下载速度（字节/秒）
+    };
+
+    /** @brief 队列整体传输情况 */
+    struct Throughput {
+        int running = 0;       // 正在下载的任务数
+        int queued = 0;        // 排队中的任务数
+        double speed = 0;      // 正在下载的任务速度之和（字节/秒）
+        uint64_t received = 0; // 本次启动以来收到的字节数
+    };
+
+    /** @brief complete() 的结果 */
+    struct Completion {
+        bool success = false;  // 是否已放入游戏目录
+        bool deferred = false; // 需要新建游戏项目但当前不允许，稍后再调用
+        bool held = false;     // 目标游戏的 ModManager 正被后台线程读取，解除占用时重新回调
+        bool newGame = false;  // 是否新建了游戏项目
+        bool update = false;   // 是否为更新
+        int modId = 0;         // 模组 ID
+        std::string gameDir;   // 模组所在游戏目录
+    };
+
+    /** @brief 下载完成回调（下载线程调用），参数为任务 ID */
+    using FinishedCallback = std::function<void(int id)>;
+
+    /** @brief 任务放入游戏目录后的监听（主线程调用） */
+    using CompletedListener = std::function<void(const Completion& completion)>;
+
+    /** @brief 获取下载队列单例 */
+    static DownloadManager& instance();
+
+    /**
+     * @brief 恢复持久化的队列并开始下载（Home 创建后调用一次）
+     * @param onFinished 下载完成回调，已下载待放入的任务立即回调一次
+     */
+    void start(FinishedCallback onFinished);
+
+    /** @brief 停止所有下载并等待线程退出，正在下载的任务下次启动时继续（退出前调用） */
+    void shutdown();
+
+    /**
+     * @brief 加入下载任务；同一模组已在队列中时不重复加入，暂停或失败的任务改为排队
+     * @param task 任务信息（id、状态与进度字段由队列填写）
+     * @return 任务 ID
+     */
+    int enqueue(Task task);
+
+    /**
+     * @brief 暂停任务（排队或下载中）
+     * @param id 任务 ID
+     */
+    void pause(int id);
+
+    /**
+     * @brief 继续已暂停或失败的任务
+     * @param id 任务 ID
+     */
+    void resume(int id);
+
+    /**
+     * @brief 取消任务，删除临时文件与续传记录
+     * @param id 任务 ID
+     */
+    void cancel(int id);
+
+    /**
+     * @brief 把已下载的任务放入游戏目录并移出队列（主线程调用）
+     * @param id 任务 ID
+     * @param games 游戏数据管理
+     * @param allowNewGame 是否允许新建游戏项目（会重新排序游戏列表）
+     * @return 完成结果
+     */
+    Completion complete(int id, GameManager& games, bool allowNewGame);
+
+    /**
+     * @brief 按模组 ID 查找任务
+     * @param modId 模组 ID
+     * @return 任务副本，不在队列中时返回空
+     */
+    std::optional<Task> findByModId(int modId) const;
+
+    /** @brief 队列中所有任务的副本（按加入顺序） */
+    std::vector<Task> tasks() const;
+
+    /** @brief 队列整体传输情况 */
+    Throughput throughput() const;
+
+    /** @brief 同时下载的任务数 */
+    int concurrency() const;
+
+    /**
+     * @brief 设置同时下载的任务数并写入设置（已在下载的任务不中断）
+     * @param count 任务数，超出 1 ~ maxConcurrency 时截断
+     */
+    void setConcurrency(int count);
+
+    /**
+     * @brief 登记页面持有的 ModManager，完成时优先写入它
+     * @param mods 页面持有的 ModManager
+     */
+    void attach(ModManager* mods);
+
+    /**
+     * @brief 取消登记（页面销毁前调用）
+     * @param mods 页面持有的 ModManager
+     */
+    void detach(ModManager* mods);
+
+    /**
+     * @brief 占用页面持有的 ModManager：后台线程读取模组列表期间不写入它（主线程在提交任务前调用）
+     * @param mods 页面持有的 ModManager
+     */
+    void hold(ModManager* mods);
+
+    /**
+     * @brief 解除占用，并重新回调占用期间推迟的任务（任意线程调用，需在排入主线程的后续处理之后）
+     * @param mods 页面持有的 ModManager
+     */
+    void release(ModManager* mods);
+
+    /**
+     * @brief 添加完成监听（主线程调用）
+     * @param listener 监听函数
+     * @return 监听 ID，用于 removeListener
+     */
+    int addListener(CompletedListener listener);
+
+    /**
+     * @brief 移除完成监听（主线程调用）
+     * @param listenerId addListener 返回的监听 ID
+     */
+    void removeListener(int listenerId);
+
+    /**
+     * @brief 任务的临时 zip 路径
+     * @param modId 模组 ID
+     */
+    static std::string tempPathOf(int modId);
+
+private:
+    DownloadManager() = default;
+
+    /** @brief 一个下载线程 */
+    struct Worker {
+        int id = 0;                    // 任务 ID
+        int modId = 0;                 // 模组 ID（任务被取消后用于清理临时文件）
+        bool finished = false;         // 线程函数是否已结束
+        util::AsyncFurture<void> task; // 下载线程
+    };
+
+    mutable std::mutex m_mutex;                                        // 保护以下所有成员
+    std::vector<Task> m_tasks;                                         // 队列（按加入顺序）
+    std::vector<Worker> m_workers;                                     // 下载线程（含已请求停止、尚未退出的）
+    std::vector<ModManager*> m_modManagers;                            // 页面持有的 ModManager
+    std::vector<ModManager*> m_heldModManagers;                        // 正被后台线程读取的 ModManager（可重复占用）
+    std::vector<int> m_heldTasks;                                      // 因占用推迟完成的任务 ID
+    std::vector<std::pair<int, CompletedListener>> m_listeners;        // 完成监听
+    FinishedCallback m_onFinished;                                     // 下载完成回调
+    JsonFile m_json{JsonFile::Format::Compact};                        // 持久化的队列
+    std::atomic<uint64_t> m_received{0};                               // 本次启动以来收到的字节数
+    int m_nextId = 1;                                                  // 下一个任务 ID
+    int m_nextListenerId = 1;                                          // 下一个监听 ID
+    int m_concurrency = defaultConcurrency;                            // 同时下载的任务数
+    bool m_started = false;                                            // 是否已调用 start
+    bool m_shuttingDown = false;                                       // 是否正在退出
+    bool m_boosted = false;                                            // 是否持有一次 CPU 加速申请
+
+    /** @brief 按 ID 查找任务（调用方持有锁） */
+    Task* findLocked(int id);
+
+    /** @brief 任务是否还有未退出的下载线程（调用方持有锁） */
+    bool busyLocked(int id) const;
+
+    /** @brief 请求停止任务的下载线程（调用方持有锁） */
+    void stopWorkerLocked(int id);
+
+    /** @brief 回收已退出的线程，按并发数启动排队的任务（调用方持有锁） */
+    void scheduleLocked();
+
+    /** @brief 从文件恢复队列（调用方持有锁） */
+    void loadLocked();
+
+    /** @brief 把队列写入文件，不等待 SD 卡（调用方持有锁） */
+    void saveLocked();
+
+    /**
+     * @brief 下载线程：获取下载信息后下载到临时文件
+     * @param id 任务 ID
+     * @param token 暂停、取消或退出时停止
+     */
+    void run(int id, std::stop_token token);
+
+    /**
+     * @brief 下载线程结束时更新任务状态并启动下一个任务
+     * @param id 任务 ID
+     * @param success 是否下载成功
+     * @param fileCrc32 下载时计算的 CRC32
+     * @param error 失败原因
+     */
+    void finish(int id, bool success, const std::string& fileCrc32, const std::string& error);
+
+    /**
+     * @brief 放入游戏目录失败：临时文件仍在时标记失败，已丢失时重新排队下载
+     * @param id 任务 ID
+     * @param error 失败原因
+     */
+    void failCompletion(int id, const std::string& error);
+};
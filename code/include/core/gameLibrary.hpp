@@ -0,0 +1,59 @@
+/**
+ * gameLibrary - 游戏库目录扫描与启动快照
+ *
+ * 扫描：列出 /mods2/ 下的游戏目录，找到其中的 TID 子目录并统计 MOD 数量（纯文件系统操作，可在后台线程执行）
+ * 快照：上次扫描结果保存在 config::gameLibraryPath，启动时直接读取快照展示首屏，
+ *       再由后台重新扫描，与内存中的游戏列表对比后把差异同步到界面
+ *
+ * 快照格式（小端）：
+ *   "NXGL" | u32 版本 | u32 条目数
+ *   条目 × N：u16 长度 + 游戏目录名 | u16 长度 + TID 目录名 | u64 appId | u32 MOD 数量
+ *   u32 以上全部内容的 CRC32（校验失败视为无快照，回退到同步扫描）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+namespace gameLibrary {
+
+/** @brief 扫描得到的单个游戏项目 */
+struct GameDirEntry {
+    std::string dirName;  // 游戏目录名（/mods2/ 下一级）
+    std::string appIdHex; // TID 子目录名
+    uint64_t appId = 0;   // 游戏 appId
+    int modCount = 0;     // MOD 数量（TID 目录下的子目录数）
+
+    /** @brief 游戏项目路径 /mods2/dirName/appIdHex */
+    std::string dirPath() const;
+
+    bool operator==(const GameDirEntry&) const = default;
+};
+
+/**
+ * @brief 扫描 /mods2/ 下的全部游戏项目（跳过没有 TID 目录或没有 MOD 的目录）
+ * @param token 可选的取消令牌，取消时返回已扫描的部分
+ * @return 按目录列举顺序排列的游戏项目
+ */
+std::vector<GameDirEntry> scan(std::stop_token* token = nullptr);
+
+/**
+ * @brief 读取启动快照
+ * @param path 快照文件路径
+ * @param entries 输出的游戏项目
+ * @return 快照不存在或校验失败时返回 false
+ */
+bool loadSnapshot(const std::string& path, std::vector<GameDirEntry>& entries);
+
+/**
+ * @brief 写入启动快照
+ * @param path 快照文件路径
+ * @param entries 游戏项目
+ * @return 是否写入成功
+ */
+bool saveSnapshot(const std::string& path, const std::vector<GameDirEntry>& entries);
+
+} // namespace gameLibrary
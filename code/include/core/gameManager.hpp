@@ -2,6 +2,14 @@
  * GameManager - 游戏数据管理
  * 作为游戏数据的总调度层，内部持有游戏列表和 JSON 缓存
  * Home 页面通过此类完成所有游戏相关的数据操作
+ *
+ * 查找：appId / 项目路径 / 已安装游戏均有哈希索引，列表增删与排序后在内部重建，查找为 O(1)
+ *
+ * 启动流程：
+ *   有游戏库快照时直接用快照构建列表，首屏无需遍历 /mods2/；
+ *   Home 随后在后台执行 gameLibrary::scan，再在主线程调用 applyScan 把差异同步到列表。
+ *   列表在扫描期间被修改（添加 / 清理游戏、MOD 数量变化）时扫描结果作废，由调用方重新扫描。
+ *   无快照（首次启动或快照损坏）时同步扫描并写出快照。
  */
 
 #pragma once
@@ -9,12 +17,15 @@
 #include "api/game.hpp"
 #include "common/gameInfo.hpp"
 #include "common/settings.hpp"
+#include "core/gameLibrary.hpp"
 #include "utils/fsHelper.hpp"
 #include "utils/gameNacp.hpp"
 #include "utils/jsonFile.hpp"
 
 #include <stop_token>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /** @brief 游戏列表排序模式 */
@@ -35,6 +46,35 @@ public:
      */
     std::vector<GameInfo>& games();
 
+    /** @brief 游戏列表是否来自启动快照（需要后台重新扫描核对） */
+    bool loadedFromSnapshot() const;
+
+    /**
+     * @brief 获取游戏列表版本号，列表增删或 MOD 数量变化时递增
+     * @return 当前版本号
+     */
+    uint32_t libraryVersion() const;
+
+    /** @brief 后台扫描结果与当前列表的差异 */
+    struct LibraryDiff {
+        bool applied = false;            // 扫描期间列表未被修改，结果已应用
+        int added = 0;                   // 新增的游戏项目数
+        int removed = 0;                 // 移除的游戏项目数
+        int changed = 0;                 // MOD 数量变化的游戏项目数
+        std::vector<int> releasedIcons;  // 已无任何项目使用的图标纹理 ID
+
+        /** @brief 是否有任何变化 */
+        bool any() const { return added > 0 || removed > 0 || changed > 0; }
+    };
+
+    /**
+     * @brief 用后台扫描结果核对游戏列表，同步差异并更新快照（主线程调用）
+     * @param version 开始扫描时的 libraryVersion()
+     * @param entries gameLibrary::scan 的结果
+     * @return 差异；版本号已变化时不应用，applied 为 false
+     */
+    LibraryDiff applyScan(uint32_t version, const std::vector<gameLibrary::GameDirEntry>& entries);
+
     /**
      * @brief 获取游戏目录名（从 dirPath 提取倒数第二段）
      * @param idx 游戏索引
@@ -89,9 +129,9 @@ public:
     /**
      * @brief 按 appId 查找所有游戏索引
      * @param appId 游戏 appId
-     * @return 所有匹配的游戏索引
+     * @return 所有匹配的游戏索引（升序），列表增删或重新排序后失效
      */
-    std::vector<int> findAllByAppId(uint64_t appId);
+    const std::vector<int>& findAllByAppId(uint64_t appId);
 
     /**
      * @brief 按 appId 查找已安装游戏索引（找不到返回 -1）
@@ -198,10 +238,9 @@ public:
      * @brief 添加游戏（检查是否已存在，不存在则创建目录 + 写 JSON）
      * @param installedIdx 已安装游戏索引
      * @param modCount 模组数量
-     * @param iconId Home 永久持有的图标纹理 ID
-     * @return 游戏目录路径
+     * @return 游戏目录路径（新项目标记为待加载，回到主页后加载图标）
      */
-    std::string addGame(size_t installedIdx, int modCount, int iconId);
+    std::string addGame(size_t installedIdx, int modCount);
 
     /**
      * @brief 商店下载时创建新游戏项目
@@ -330,10 +369,39 @@ private:
     bool m_installedGamesLoaded = false;             // 已安装游戏是否已加载
     std::string m_pendingFocusDirPath;               // 待聚焦游戏项目路径
     std::string m_pendingCleanupDirPath;             // 待清理游戏项目路径
-    std::vector<uint64_t> m_installedTids;           // 已安装游戏 TID 缓存（懒加载）
+    std::vector<uint64_t> m_installedTids;           // 已安装游戏 TID 缓存（懒加载，保持最近游玩顺序）
+    std::unordered_set<uint64_t> m_installedTidSet;  // 已安装游戏 TID 集合，与 m_installedTids 同时加载
+    std::unordered_map<uint64_t, uint32_t> m_recentPlayRank;     // appId → 最近游玩名次，与 m_installedTids 同时加载
+    std::unordered_map<uint64_t, std::vector<int>> m_appIdIndex; // appId → 游戏索引（升序）
+    std::unordered_map<std::string, int> m_dirPathIndex;         // 项目路径 → 游戏索引
+    std::unordered_map<uint64_t, int> m_installedIndex;          // appId → 已安装游戏索引（不含虚拟游戏）
     bool m_installedTidsLoaded = false;              // 已安装游戏 TID 是否已查询（结果允许为空）
     SortMode m_sortMode = SortMode::Name;            // 当前排序模式
     bool m_sortAsc = true;                           // 当前升降序
+    bool m_fromSnapshot = false;                     // 游戏列表是否来自启动快照
+    uint32_t m_libraryVersion = 0;                   // 游戏列表版本号
+
+    /**
+     * @brief 由扫描条目和 JSON 缓存构建游戏信息
+     * @param entry 扫描得到的游戏项目
+     * @return 游戏信息
+     */
+    GameInfo makeGameInfo(const gameLibrary::GameDirEntry& entry);
+
+    /** @brief 游戏列表增删或排序后重建 appId / 项目路径索引 */
+    void reindex();
+
+    /** @brief 已安装游戏列表加载或排序后重建 appId 索引 */
+    void reindexInstalled();
+
+    /** @brief 按 appId 索引重新计算全部项目的重复标记与重复数量 */
+    void refreshDuplicates();
+
+    /** @brief 按当前游戏列表同步已安装游戏列表中的模组数量 */
+    void syncInstalledModCounts();
+
+    /** @brief 列表增删或 MOD 数量变化后调用：递增版本号并写出快照 */
+    void libraryChanged();
 
     /** @brief 从 Settings 读取排序配置 */
     void loadSortSettings();
@@ -345,6 +413,13 @@ private:
      */
     void sort(SortMode mode, bool ascending);
 
+    /**
+     * @brief 取游戏的最近游玩名次
+     * @param appId 游戏 appId
+     * @return 在最近游玩列表中的位置，不在列表中返回 UINT32_MAX
+     */
+    uint32_t recentPlayRank(uint64_t appId);
+
     /**
      * @brief 按标题拼音排序
      * @param ascending 是否升序
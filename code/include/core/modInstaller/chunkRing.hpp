@@ -0,0 +1,119 @@
+/**
+ * ChunkRing - 解压 / 写入流水线的有界缓冲环
+ * 解压线程取空槽填充数据后提交，写入线程按序号顺序取出写盘再归还空槽。
+ * 槽位数量与大小在 alloc 时固定，整条流水线的内存占用有上限。
+ *
+ * 顺序与并行：
+ *   每个数据块在开始前就确定全局序号（按安装顺序编号），多个解压线程可以乱序完成，
+ *   写入线程始终按序号取出，因此写盘顺序与单线程一致，回滚列表不受影响。
+ *   acquire 只向序号落在 [下一个待写序号, +槽位数-1) 窗口内的块分配槽位：
+ *   写入线程最多占用 1 个槽，窗口内最多占用 槽位数-1 个，
+ *   下一个待写的块总能拿到空槽，不会因后面的块占满槽位而死锁。
+ *
+ * 关闭语义：
+ *   - 全部序号取完后 pop 返回 false
+ *   - close()：失败 / 取消时中止，唤醒所有等待方，acquire 返回 nullptr，pop 返回 false
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace ModInstaller {
+
+/** @brief 数据块状态 */
+enum class ChunkStatus {
+    Data,          // 正常数据
+    ExtractFailed, // 一次性解压失败
+    ReadFailed,    // 流式读取失败
+};
+
+/** @brief 流水线中传递的数据块 */
+struct Chunk {
+    int fileIndex = -1;                     // 所属文件在安装列表中的下标
+    int64_t seq = 0;                        // 全局序号（写入顺序）
+    void* data = nullptr;                   // 槽位缓冲区，失败块为空
+    size_t size = 0;                        // 有效数据长度
+    bool first = false;                     // 是否为该文件的第一块
+    bool last = false;                      // 是否为该文件的最后一块
+    ChunkStatus status = ChunkStatus::Data; // 块状态
+};
+
+class ChunkRing {
+public:
+    /** @brief 创建空缓冲环，使用前须调用 alloc */
+    ChunkRing() = default;
+
+    /** @brief 释放全部槽位 */
+    ~ChunkRing();
+
+    /** @brief 禁止复制构造 */
+    ChunkRing(const ChunkRing&) = delete;
+
+    /** @brief 禁止复制赋值 */
+    ChunkRing& operator=(const ChunkRing&) = delete;
+
+    /**
+     * @brief 分配槽位
+     * @param slotCount 槽位数量（至少 2）
+     * @param slotSize 单个槽位大小
+     * @return 是否全部分配成功
+     */
+    bool alloc(int slotCount, size_t slotSize);
+
+    /** @brief 单个槽位大小 */
+    size_t slotSize() const { return m_slotSize; }
+
+    /**
+     * @brief 设置本次流水线的数据块总数，序号从 0 开始
+     * @param totalChunks 数据块总数
+     */
+    void start(int64_t totalChunks);
+
+    /**
+     * @brief 生产方：为指定序号的块取一个空槽，阻塞直到序号进入窗口且有空槽，或环被关闭
+     * @param seq 数据块序号
+     * @return 槽位缓冲区，环已关闭时返回 nullptr
+     */
+    void* acquire(int64_t seq);
+
+    /**
+     * @brief 生产方：提交数据块（环已关闭时直接丢弃）
+     * @param chunk 数据块
+     */
+    void push(const Chunk& chunk);
+
+    /**
+     * @brief 消费方：按序号取出下一块，阻塞直到该块提交
+     * @param chunk 输出数据块
+     * @return 全部数据块已取完或环已关闭时返回 false
+     */
+    bool pop(Chunk& chunk);
+
+    /**
+     * @brief 归还槽位
+     * @param slot 槽位缓冲区，为空时忽略
+     */
+    void release(void* slot);
+
+    /** @brief 中止流水线，唤醒所有等待方 */
+    void close();
+
+private:
+    std::vector<void*> m_slots;         // 全部槽位
+    std::vector<void*> m_free;          // 空闲槽位
+    std::map<int64_t, Chunk> m_ready;   // 已提交待写入的数据块（按序号）
+    size_t m_slotSize = 0;              // 单个槽位大小
+    int64_t m_nextSeq = 0;              // 下一个待写序号
+    int64_t m_totalChunks = 0;          // 数据块总数
+    bool m_closed = false;              // 是否已中止
+    std::mutex m_mutex;                 // 保护以上状态
+    std::condition_variable m_cv;       // 槽位归还 / 数据提交 / 序号推进时唤醒
+};
+
+} // namespace ModInstaller
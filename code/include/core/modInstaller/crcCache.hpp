@@ -0,0 +1,142 @@
+/**
+ * CrcCache - 文件 CRC32 持久缓存
+ * 以 {路径 → (大小, 修改时间, CRC32)} 记录已知文件的 CRC，保存在 {游戏目录}/crcCache.bin。
+ * 冲突检测前先取文件元数据，大小与修改时间都未变化时直接使用缓存值，不再读取文件内容；
+ * 覆盖安装 / 更新大型 MOD 时只有元数据变化的文件需要重新计算。
+ *
+ * 记录来源：
+ *   - 计算过的文件（目标文件、目录 MOD 的源文件）
+ *   - 安装器刚写入的目标文件：CRC 取自 ZIP 中央目录或复制时的流式计算，无需回读
+ *
+ * 批量查询（fromFiles）：先逐个取元数据，未命中的文件交给 crc::fromFiles 并发计算。
+ *
+ * 失效：元数据不一致即视为未命中并重新计算；已删除文件的记录由后台校验（prune）清理。
+ * 修改时间精度有限（Switch 为秒），记录后在同一时间刻度内以相同大小重写的文件元数据不变。
+ * 因此从文件加载的条目中，修改时间距缓存文件写入不足 racyWindowSeconds 的视为不可信，
+ * 命中时仍重新计算（与缓存文件比较，两者来自同一文件系统时钟）；重新计算后随下次保存转为可信。
+ *
+ * 并发：安装与后台校验可能各自加载同一个缓存文件。保存时在锁内重新读取文件，以文件当前内容为底，
+ * 叠加本实例删除的条目（仅删除与当时一致的版本）和本实例计算或记录的条目，不丢失对方已保存的记录。
+ *
+ * 文件格式（小端）：
+ *   "NXCC" | u32 版本 | u32 条目数
+ *   条目 × N：u16 长度 + 路径 | i64 大小 | u64 修改时间 | u32 crc32
+ *   u32 以上全部内容的 CRC32（校验失败视为空缓存）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/fsHelper.hpp"
+
+class CrcCache {
+public:
+    /** @brief 创建空缓存 */
+    CrcCache() = default;
+
+    /**
+     * @brief 获取指定游戏的缓存文件路径
+     * @param gameDirPath 游戏项目目录
+     * @return 缓存文件路径
+     */
+    static std::string pathOf(const std::string& gameDirPath);
+
+    /** @brief 缓存文件读写的全局互斥锁 */
+    static std::mutex& mutex();
+
+    /**
+     * @brief 从文件加载缓存
+     * @param path 缓存文件路径
+     * @return 文件不存在或校验失败时返回 false（缓存为空，路径仍会记住供 save 使用）
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 有变化时与文件当前内容合并后写回 load 时的路径
+     * @return 是否保存成功（无变化视为成功）
+     */
+    bool save();
+
+    /**
+     * @brief 计算文件 CRC32，元数据与缓存一致时跳过读取
+     * @param path 文件路径
+     * @param buf 读取缓冲区
+     * @param bufSize 缓冲区大小
+     * @param token 可选的取消令牌
+     * @return 文件不存在或取消时返回 -1，成功时返回 0~0xFFFFFFFF
+     */
+    int64_t fromFile(const std::string& path, void* buf, size_t bufSize, std::stop_token* token = nullptr);
+
+    /**
+     * @brief 批量计算文件 CRC32：命中缓存的直接返回，未命中的并发计算后写入缓存
+     * @param paths 文件路径
+     * @param token 取消令牌
+     * @return 与 paths 一一对应的结果，文件不存在或取消时为 -1
+     */
+    std::vector<int64_t> fromFiles(const std::vector<std::string>& paths, std::stop_token token);
+
+    /**
+     * @brief 记录已知 CRC 的文件（取当前元数据，文件不存在时忽略）
+     * @param path 文件路径
+     * @param crc32 文件 CRC32
+     */
+    void record(const std::string& path, uint32_t crc32);
+
+    /**
+     * @brief 删除磁盘上已不存在或元数据已变化的记录
+     * @param token 取消令牌
+     * @return 删除的条目数
+     */
+    size_t prune(std::stop_token token);
+
+    /** @brief 条目数 */
+    size_t size() const { return m_entries.size(); }
+
+private:
+    static constexpr uint64_t racyWindowSeconds = 2; // 修改时间距缓存写入不足该值的条目不可信（FAT 修改时间精度为 2 秒）
+
+    /** @brief 单个缓存条目 */
+    struct Entry {
+        int64_t size = 0;       // 文件大小
+        uint64_t mtime = 0;     // 修改时间
+        uint32_t crc32 = 0;     // 文件 CRC32
+        bool verified = false;  // 本次加载后计算或记录的（不受写入时间窗口限制）
+    };
+
+    using Entries = std::unordered_map<std::string, Entry>;
+
+    /**
+     * @brief 读取缓存文件（调用方持有锁）
+     * @param path 缓存文件路径
+     * @param entries 输出条目，失败时为空
+     * @param savedAt 输出缓存文件的修改时间，失败时为 0
+     * @return 文件不存在或校验失败时返回 false
+     */
+    static bool readEntries(const std::string& path, Entries& entries, uint64_t& savedAt);
+
+    /**
+     * @brief 缓存条目是否可信：本次加载后计算或记录的，或修改时间早于缓存文件写入 racyWindowSeconds 以上
+     * @param entry 缓存条目
+     * @param savedAt 条目所在缓存文件的修改时间
+     */
+    static bool trusted(const Entry& entry, uint64_t savedAt);
+
+    /**
+     * @brief 缓存条目是否与文件当前元数据一致且可信
+     * @param entry 缓存条目
+     * @param st 文件当前元数据
+     */
+    bool matches(const Entry& entry, const fs::FileStat& st) const;
+
+    std::string m_path;                              // 缓存文件路径
+    Entries m_entries;                               // 路径 → 缓存条目
+    Entries m_removed;                               // 本实例删除的条目（保存时只删除文件中与之一致的版本）
+    uint64_t m_savedAt = 0;                          // 加载时缓存文件的修改时间（与条目修改时间同一时钟）
+    bool m_dirty = false;                            // 是否有未保存的变化
+};
@@ -62,5 +62,5 @@ public:
     void removeMod(const std::string& modDirName);
 
 private:
-    JsonFile m_json; // 映射文件数据
+    JsonFile m_json{JsonFile::Format::Compact}; // 映射文件数据（只由程序读写）
 };
@@ -8,11 +8,14 @@
 #include <vector>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <stop_token>
 #include "common/modInfo.hpp"
 #include "common/gameInfo.hpp"
 #include "core/modGameType.hpp"
 
+class PartialFile;
+
 namespace ModInstaller {
 
 // ============================================================================
@@ -29,12 +32,24 @@ struct Progress {
     int64_t bytesTotal;         // 当前文件总字节数
 };
 
+/** @brief 安装或卸载各阶段耗时（微秒），用于性能分析 */
+struct PhaseTimes {
+    int64_t scan = 0;           // 扫描源文件 / 读取 ZIP 目录 / 加载引用计数
+    int64_t conflict = 0;       // CRC 冲突检测（卸载时不使用）
+    int64_t mkdir = 0;          // 创建目录（卸载时为清理空目录）
+    int64_t write = 0;          // 解压 / 复制写入（卸载时为删除文件）
+    int64_t save = 0;           // 保存引用计数与特殊规则记录
+};
+
 /** @brief 模组安装结果 */
 struct InstallResult {
     bool success = false;       // 是否安装成功
     std::string errorFile;      // 失败时：出错的文件路径
     std::string errorMsg;       // 失败原因
-    std::string conflictMod;    // CRC 冲突时，对方 mod 名称
+    std::string conflictMod;    // CRC 冲突时，对方 mod 名称（多个时以逗号连接）
+    std::vector<std::string> conflictMods; // CRC 冲突时，全部对方 mod 名称（去重）
+    int conflictFiles = 0;      // CRC 冲突文件数
+    PhaseTimes phases;          // 各阶段耗时
 };
 
 /** @brief 模组卸载结果 */
@@ -42,6 +57,7 @@ struct UninstallResult {
     bool success = false;       // 是否卸载成功
     std::string errorFile;      // 失败时：出错的文件路径
     std::string errorMsg;       // 失败原因
+    PhaseTimes phases;          // 各阶段耗时
 };
 
 // ============================================================================
@@ -60,6 +76,19 @@ struct UninstallResult {
  */
 InstallResult install(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::function<void(const Progress&)> progressCb = nullptr, std::stop_token token = {});
 
+/**
+ * @brief 边下载边安装 ZIP 模组（中央目录已先行取回，条目数据随下载到达后解压）
+ * @param mod 模组信息
+ * @param game 游戏信息
+ * @param modGameType 当前游戏的 MOD 适配类型
+ * @param allMods 所有模组列表（用于冲突检测）
+ * @param source 下载中的 ZIP
+ * @param progressCb 进度回调
+ * @param token 取消令牌
+ * @return 模组安装结果
+ */
+InstallResult installStreaming(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::shared_ptr<PartialFile> source, std::function<void(const Progress&)> progressCb = nullptr, std::stop_token token = {});
+
 /**
  * @brief 卸载模组（自动识别 ZIP/目录）
  * @param mod 模组信息
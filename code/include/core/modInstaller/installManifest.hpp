@@ -0,0 +1,89 @@
+/**
+ * InstallManifest - 单个 MOD 的安装清单
+ * 安装成功后写入 {游戏目录}/{MOD 目录名}.manifest，记录本次安装涉及的全部目标文件与目录。
+ * 卸载、强制清理、冲突查询直接读取清单，不再打开 ZIP 或重新扫描源目录，
+ * 源文件被删除或移走后依然可以卸载。
+ *
+ * 路径语义：
+ *   - targetPath 为特殊规则处理前的标准目标路径，卸载时交给卸载规则重新解析
+ *     （怪猎 pak 编号会随其他 MOD 卸载而前移，不能直接使用安装时的实际路径）
+ *   - installedPath 为安装时特殊规则处理后的实际写入路径，与 targetPath 相同时不单独存储
+ *
+ * 文件格式（小端）：
+ *   "NXMF" | u32 版本 | u32 文件数 | u32 目录数 | u8 标志 | 3 字节保留
+ *   文件 × N：u32 crc32 | u8 标志 | i64 大小 | u16 长度 + targetPath | u16 长度 + installedPath
+ *   目录 × M：u16 长度 + 目录路径
+ *   u32 以上全部内容的 CRC32（校验失败视为清单不存在，调用方回退到旧流程）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** @brief 清单中的单个已安装文件 */
+struct ManifestFile {
+    std::string targetPath;     // 标准目标路径（特殊规则处理前）
+    std::string installedPath;  // 实际写入路径（特殊规则处理后）
+    int64_t size = 0;           // 文件大小
+    uint32_t crc32 = 0;         // 文件 CRC32
+    bool shared = false;        // 安装时目标已存在且 CRC 一致，仅增加了引用计数
+};
+
+class InstallManifest {
+public:
+    /** @brief 创建空清单 */
+    InstallManifest() = default;
+
+    /**
+     * @brief 获取指定 MOD 的清单文件路径
+     * @param gameDirPath 游戏项目目录
+     * @param modDirName MOD 目录名
+     * @return 清单文件路径
+     */
+    static std::string pathOf(const std::string& gameDirPath, const std::string& modDirName);
+
+    /**
+     * @brief 从文件加载清单
+     * @param path 清单文件路径
+     * @return 文件不存在、版本不符或校验失败时返回 false
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 序列化并写入文件
+     * @param path 清单文件路径
+     * @return 是否保存成功
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief 追加一个已安装文件
+     * @param file 文件记录
+     */
+    void addFile(ManifestFile file);
+
+    /**
+     * @brief 设置本次安装创建的标准目标目录（特殊规则处理前，按创建顺序）
+     * @param dirs 目录列表
+     */
+    void setDirs(std::vector<std::string> dirs);
+
+    /** @brief 标记本次安装包含 pchtxt 补丁 */
+    void setHasPchtxt() { m_hasPchtxt = true; }
+
+    /** @brief 已安装文件列表 */
+    const std::vector<ManifestFile>& files() const { return m_files; }
+
+    /** @brief 标准目标目录列表 */
+    const std::vector<std::string>& dirs() const { return m_dirs; }
+
+    /** @brief 是否包含 pchtxt 补丁 */
+    bool hasPchtxt() const { return m_hasPchtxt; }
+
+private:
+    std::vector<ManifestFile> m_files;  // 已安装文件
+    std::vector<std::string> m_dirs;    // 标准目标目录
+    bool m_hasPchtxt = false;           // 是否包含 pchtxt 补丁
+};
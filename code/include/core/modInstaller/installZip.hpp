@@ -6,6 +6,10 @@
 
 #include "core/modInstaller/install.hpp"
 
+#include <memory>
+
+class PartialFile;
+
 namespace ModInstaller {
 
 /**
@@ -20,6 +24,19 @@ namespace ModInstaller {
  */
 InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::function<void(const Progress&)> progressCb, std::stop_token token);
 
+/**
+ * @brief 从下载中的 ZIP 安装模组，解压与下载同时进行
+ * @param mod 模组信息
+ * @param game 游戏信息
+ * @param modGameType 当前游戏的 MOD 适配类型
+ * @param allMods 所有模组列表（用于冲突检测）
+ * @param source 下载中的 ZIP（已含中央目录）
+ * @param progressCb 进度回调
+ * @param token 取消令牌
+ * @return 模组安装结果，下载失败时以解压失败报告
+ */
+InstallResult installFromZipStream(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::shared_ptr<PartialFile> source, std::function<void(const Progress&)> progressCb, std::stop_token token);
+
 /**
  * @brief 卸载 ZIP 模组
  * @param mod 模组信息
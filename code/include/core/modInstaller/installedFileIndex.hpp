@@ -0,0 +1,119 @@
+/**
+ * InstalledFileIndex - 游戏级已安装文件索引
+ * 记录 {实际写入路径 → (所属 MOD, CRC32, 大小)}，保存在 {游戏目录}/installedFiles.idx。
+ * 安装 / 卸载成功后增量更新，冲突归属直接按路径查表，不再逐个打开其他 MOD 的 ZIP 或扫描源目录。
+ *
+ * 一致性：
+ *   - 索引是各 MOD 安装清单的汇总，文件缺失或损坏时可由清单完整重建（rebuild）
+ *   - 怪猎 pak 重新编号、用户手动改动 SD 卡等情况会让索引过期，
+ *     查询方须用磁盘 CRC 与记录比对，不一致时视为未命中；后台校验（verify）负责清理过期条目
+ *   - 安装器与后台校验可能并发读写同一文件，读-改-写须持有 mutex()
+ *
+ * 文件格式（小端）：
+ *   "NXFI" | u32 版本 | u32 MOD 数 | u32 文件数
+ *   MOD × N：u16 长度 + MOD 目录名
+ *   文件 × M：u16 长度 + 路径 | u32 crc32 | i64 大小 | u8 所属 MOD 数 | u16 MOD 下标 × K
+ *   u32 以上全部内容的 CRC32
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class InstallManifest;
+
+/** @brief 索引中的单个已安装文件 */
+struct IndexedFile {
+    std::vector<std::string> owners; // 所属 MOD 目录名（首个为首次写入者，其余为共享者）
+    uint32_t crc32 = 0;              // 文件 CRC32
+    int64_t size = 0;                // 文件大小
+};
+
+class InstalledFileIndex {
+public:
+    /** @brief 创建空索引 */
+    InstalledFileIndex() = default;
+
+    /**
+     * @brief 获取指定游戏的索引文件路径
+     * @param gameDirPath 游戏项目目录
+     * @return 索引文件路径
+     */
+    static std::string pathOf(const std::string& gameDirPath);
+
+    /** @brief 索引文件读-改-写的全局互斥锁 */
+    static std::mutex& mutex();
+
+    /**
+     * @brief 从文件加载索引
+     * @param path 索引文件路径
+     * @return 文件不存在、版本不符或校验失败时返回 false（索引为空，路径仍会记住供 save 使用）
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 序列化并写回 load 时的路径
+     * @return 是否保存成功
+     */
+    bool save() const;
+
+    /**
+     * @brief 由各 MOD 的安装清单重建索引
+     * @param gameDirPath 游戏项目目录
+     * @param modDirNames 已安装 MOD 的目录名
+     */
+    void rebuild(const std::string& gameDirPath, const std::vector<std::string>& modDirNames);
+
+    /**
+     * @brief 记录一个 MOD 安装的全部文件（先移除该 MOD 的旧记录）
+     * @param modDirName MOD 目录名
+     * @param manifest 该 MOD 的安装清单
+     */
+    void addMod(const std::string& modDirName, const InstallManifest& manifest);
+
+    /**
+     * @brief 移除一个 MOD 的全部记录，无其他所属 MOD 的文件条目随之删除
+     * @param modDirName MOD 目录名
+     */
+    void removeMod(const std::string& modDirName);
+
+    /**
+     * @brief 按实际写入路径查找
+     * @param path 目标文件路径
+     * @return 条目指针，未收录时返回 nullptr
+     */
+    const IndexedFile* find(const std::string& path) const;
+
+    /** @brief 已收录的全部 MOD 目录名（去重） */
+    std::vector<std::string> mods() const;
+
+    /**
+     * @brief 对照磁盘校验：文件缺失或大小不符的条目视为过期
+     * 只比较大小不读内容，全量 CRC 在 SD 卡上代价过高；内容被改但大小不变的情况由查询方的 CRC 比对兜底
+     * @param token 取消令牌
+     * @return 过期条目路径，取消时返回已检查部分的结果
+     */
+    std::vector<std::string> findStale(std::stop_token token) const;
+
+    /**
+     * @brief 删除指定条目
+     * @param paths 目标文件路径
+     * @return 实际删除的条目数
+     */
+    size_t erase(const std::vector<std::string>& paths);
+
+    /** @brief 已收录文件数 */
+    size_t size() const { return m_files.size(); }
+
+    /** @brief 全部已收录文件 */
+    const std::unordered_map<std::string, IndexedFile>& files() const { return m_files; }
+
+private:
+    std::string m_path;                                  // 索引文件路径
+    std::unordered_map<std::string, IndexedFile> m_files; // 实际写入路径 → 文件记录
+};
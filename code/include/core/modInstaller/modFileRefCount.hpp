@@ -1,21 +1,40 @@
 /**
  * ModFileRefCount - MOD 共享文件引用计数
  * 当多个 MOD 安装了相同文件（CRC32 一致）时，记录共享次数
- * 
+ *
  * 计数语义：记录"有多少个额外 MOD 共享该文件"（不含首次写入者）
  *   - 首次写入文件 → 不记录（无 key）
  *   - 第二个 MOD 共享 → increment → 计数 1
  *   - 第三个 MOD 共享 → increment → 计数 2
- * 
+ *
  * 卸载判定：
  *   - 有记录 → decrement，不删文件（还有其他 MOD 在用）
  *   - 无记录 → 返回 true，调用方应删除文件（最后一个使用者）
+ *
+ * 存储格式（modFileRefCount.bin，小端）：
+ *   快照：头部 20 字节 "NXRC" | u32 版本 | u32 条目数 | u32 快照字节数 | u32 快照 CRC32
+ *         u32 记录偏移 × N（按路径排序，可直接映射后二分查找）
+ *         记录 × N：u32 计数 | u16 长度 + 路径
+ *   日志：快照之后追加的增量记录：u32 计数（0 表示删除）| u16 长度 + 路径 | u32 本条 CRC32
+ *
+ * 查询：
+ *   加载时不展开快照，记录按偏移表二分查找；日志与本次修改放在内存覆盖表中，优先于快照
+ *
+ * 保存策略：
+ *   - 平时只把本次变化的条目追加到日志，不重写整个文件
+ *   - 日志超过快照大小、或加载时发现残缺日志尾，则压缩：写临时文件后替换原文件
+ *   - 加载时日志逐条校验，掉电造成的残缺尾部直接丢弃；原文件缺失时使用残留的临时文件
+ *   - 首次加载时若只存在旧版 modFileRefCount.json，则一次性迁移，保存成功后删除 JSON
  */
 
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include "utils/jsonFile.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 class ModFileRefCount {
 public:
@@ -23,14 +42,14 @@ public:
     ModFileRefCount() = default;
 
     /**
-     * @brief 加载指定游戏的引用计数文件，文件不存在时自动创建
+     * @brief 加载指定游戏的引用计数文件，文件不存在时视为空表
      * @param path 引用计数文件路径
-     * @return 是否加载成功
+     * @return 是否加载成功（文件不存在也返回 true）
      */
     bool load(const std::string& path);
 
     /**
-     * @brief 持久化到文件
+     * @brief 持久化到文件：增量追加或压缩重写
      * @return 是否保存成功
      */
     bool save();
@@ -48,6 +67,50 @@ public:
      */
     bool decrement(const std::string& filePath);
 
+    /**
+     * @brief 获取与引用计数文件配套的旧版 JSON 与临时文件路径（清理时一并删除）
+     * @param path 引用计数文件路径
+     * @return {旧版 JSON 路径, 压缩临时文件路径}
+     */
+    static std::pair<std::string, std::string> auxPaths(const std::string& path);
+
 private:
-    JsonFile m_json; // 文件引用计数数据
+    /**
+     * @brief 校验快照并重放日志，成功后接管文件内容作为快照
+     * @param data 文件内容
+     * @return 快照是否有效
+     */
+    bool parse(std::vector<uint8_t>& data);
+
+    /**
+     * @brief 查询当前计数（覆盖表优先，其次二分查找快照）
+     * @param filePath 目标文件路径
+     * @return 共享计数，无记录为 0
+     */
+    uint32_t count(const std::string& filePath) const;
+
+    /**
+     * @brief 在快照中二分查找
+     * @param filePath 目标文件路径
+     * @return 共享计数，无记录为 0
+     */
+    uint32_t snapshotCount(const std::string& filePath) const;
+
+    /** @brief 清空内存状态 */
+    void reset();
+
+    /** @brief 从旧版 JSON 迁移 */
+    bool migrateLegacy(const std::string& jsonPath);
+
+    /** @brief 全量重写快照（临时文件 + 替换） */
+    bool compact();
+
+    std::string m_path;                                  // 引用计数文件路径
+    std::vector<uint8_t> m_snapshot;                     // 快照原始字节（不含日志）
+    uint32_t m_snapshotEntries = 0;                      // 快照条目数
+    std::unordered_map<std::string, uint32_t> m_overlay; // 日志与本次修改：路径 → 计数（0 表示已删除）
+    std::unordered_set<std::string> m_dirty;             // 自上次保存后变化的路径
+    size_t m_journalBytes = 0;                           // 日志部分有效字节数
+    bool m_needCompact = false;                          // 下次保存必须全量重写
+    std::string m_migratedFrom;                          // 已迁移的旧版 JSON 路径，保存成功后删除
 };
@@ -0,0 +1,23 @@
+/**
+ * ModInstaller - 按安装清单卸载模组
+ */
+
+#pragma once
+
+#include "core/modInstaller/install.hpp"
+#include "core/modInstaller/installManifest.hpp"
+
+namespace ModInstaller {
+
+/**
+ * @brief 按安装清单卸载模组，不访问 ZIP 或源目录
+ * @param manifest 已加载的安装清单
+ * @param mod 模组信息
+ * @param game 游戏信息
+ * @param modGameType 当前游戏的 MOD 适配类型
+ * @param progressCb 进度回调
+ * @return 模组卸载结果
+ */
+UninstallResult uninstallFromManifest(const InstallManifest& manifest, const ModInfo& mod, const GameInfo& game, ModGameType modGameType, std::function<void(const Progress&)> progressCb);
+
+} // namespace ModInstaller
@@ -5,7 +5,9 @@
 #pragma once
 
 #include "core/modInstaller/install.hpp"
+#include "core/modInstaller/installManifest.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <malloc.h>
 
@@ -22,6 +24,9 @@ inline const std::vector<std::string> modKeywords = {
 inline constexpr const char* pchtxtExt = ".pchtxt";         // pchtxt 文件扩展名
 inline constexpr size_t ioBufSize = 32 * 1024 * 1024;   // 32MB
 inline constexpr size_t crcBufSize = 64 * 1024;          // 64KB
+inline constexpr size_t ringSlotSize = 1024 * 1024;      // ZIP 解压流水线单槽 1MB
+inline constexpr int ringSlotCount = 32;                 // 槽位数量，总量与 ioBufSize 一致
+inline constexpr int extractWorkerCount = 3;             // ZIP 并行解压线程数（各持独立游标）
 
 } // namespace ModInstaller
 
@@ -41,12 +46,13 @@ struct InstallBuf {
 
     /**
      * @brief 分配安装缓冲区
+     * @param withIo 是否分配 I/O 缓冲区（ZIP 安装使用流水线缓冲环，只需 CRC 缓冲区）
      * @return 是否全部分配成功
      */
-    bool alloc() {
-        io = memalign(0x1000, ioBufSize);
+    bool alloc(bool withIo = true) {
+        if (withIo) io = memalign(0x1000, ioBufSize);
         crc = malloc(crcBufSize);
-        return io && crc;
+        return (io || !withIo) && crc;
     }
 
     /** @brief 释放安装缓冲区 */
@@ -58,6 +64,29 @@ struct InstallBuf {
     }
 };
 
+/** @brief 阶段计时器，lap() 返回距上次打点的微秒数 */
+struct PhaseTimer {
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now(); // 上次打点时间
+
+    /**
+     * @brief 打点并返回距上次打点的耗时
+     * @return 耗时（微秒）
+     */
+    int64_t lap() {
+        auto now = std::chrono::steady_clock::now();
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+        last = now;
+        return us;
+    }
+};
+
+/** @brief 冲突检测阶段发现的单个 CRC 不一致文件 */
+struct ConflictFile {
+    std::string targetPath;  // 实际写入路径
+    uint32_t srcCrc = 0;     // 待安装文件的 CRC
+    uint32_t diskCrc = 0;    // 磁盘上现有文件的 CRC
+};
+
 /** @brief 批量创建目录结果 */
 struct CreateDirsResult {
     bool success = true;       // 是否全部创建成功
@@ -188,4 +217,43 @@ void removePchtxt(const std::string& modDirName, const std::string& gameDirName)
  */
 std::string findConflictModName(const std::string& targetPath, uint32_t conflictCrc, const std::vector<ModInfo>& allMods, void* crcBuf, size_t crcBufLen, std::stop_token* token = nullptr);
 
+/**
+ * @brief 按已安装文件索引归属全部冲突文件，并填写安装结果的冲突信息
+ * 索引命中且记录 CRC 与磁盘一致时直接取所属 MOD；未命中或记录过期的文件
+ * 只在索引未收录的已安装 MOD（旧版本安装、无清单）中回退到 findConflictModName
+ * @param result 安装结果（填写 errorFile / errorMsg / conflictMod / conflictMods）
+ * @param conflicts 冲突文件列表，不能为空
+ * @param gameDirPath 游戏项目目录
+ * @param allMods 所有模组列表
+ * @param crcBuf CRC 计算缓冲区
+ * @param crcBufLen 缓冲区长度
+ * @param token 取消令牌，可为空
+ */
+void reportConflicts(InstallResult& result, const std::vector<ConflictFile>& conflicts, const std::string& gameDirPath, const std::vector<ModInfo>& allMods, void* crcBuf, size_t crcBufLen, std::stop_token* token = nullptr);
+
+/**
+ * @brief 安装成功后把安装清单记入已安装文件索引（索引缺失时先由全部清单重建）
+ * @param gameDirPath 游戏项目目录
+ * @param modDirName 模组目录名
+ * @param manifest 本次安装的清单
+ */
+void recordInstalledFiles(const std::string& gameDirPath, const std::string& modDirName, const InstallManifest& manifest);
+
+/**
+ * @brief 卸载或移除模组后从已安装文件索引中删除其记录（索引不存在时忽略）
+ * @param gameDirPath 游戏项目目录
+ * @param modDirName 模组目录名
+ */
+void forgetInstalledFiles(const std::string& gameDirPath, const std::string& modDirName);
+
+/**
+ * @brief 后台校验已安装文件索引：与各 MOD 清单对账，并清理磁盘上已缺失或大小不符的条目
+ * 磁盘检查期间不持锁，与并发安装交错时只删除重新检查后仍过期的条目；
+ * 同时清理 CRC 缓存中元数据已失效的记录
+ * @param gameDirPath 游戏项目目录
+ * @param token 取消令牌
+ * @return 清理的条目数
+ */
+size_t verifyInstalledFiles(const std::string& gameDirPath, std::stop_token token);
+
 } // namespace ModInstaller::utils
@@ -248,6 +248,23 @@ public:
      */
     ModInstaller::InstallResult installMod(int index, std::function<void(const ModInstaller::Progress&)> progressCb = nullptr, std::stop_token token = {});
 
+    /**
+     * @brief 安装商店下载的 mod（尚未加入列表）
+     * @param info mod 信息
+     * @param source 正在下载的 ZIP（为空时安装已下载完成的 ZIP）
+     * @param progressCb 进度回调
+     * @param token 取消令牌
+     * @return 模组安装结果
+     */
+    ModInstaller::InstallResult installFromStore(const ModInfo& info, std::shared_ptr<PartialFile> source, std::function<void(const ModInstaller::Progress&)> progressCb = nullptr, std::stop_token token = {});
+
+    /**
+     * @brief 卸载商店下载的 mod（尚未加入列表，如下载失败时撤销已完成的边下载边安装）
+     * @param info mod 信息
+     * @return 模组卸载结果
+     */
+    ModInstaller::UninstallResult uninstallFromStore(const ModInfo& info);
+
     /**
      * @brief 卸载 mod
      * @param index mod 索引
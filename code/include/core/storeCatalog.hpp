@@ -0,0 +1,152 @@
+/**
+ * StoreCatalog - 商店目录本地缓存与离线搜索
+ * 单例，缓存商店的游戏与 MOD 目录（各语言名称、TID、MOD 类型、作者），并建立倒排索引，
+ * 商店搜索先在本地作答，服务器查询在后台进行，离线时仍可搜索
+ *
+ * 刷新（后台线程）：分页拉取完整游戏列表，与缓存合并（名称按语言累积）；
+ *       MOD 只为 lastUpdate 变化过的游戏重新拉取，每次刷新限定游戏数，多次刷新后逐步收敛
+ * 索引：每个游戏 / MOD 的文本切分为词项（原文单词、拼音 token、首字母串、拼音拼接串、TID），
+ *       排序后的词表 + 倒排表，查询词按前缀匹配，多个查询词须落在同一条目上
+ *
+ * 文件格式（小端，config::storeCatalogPath）：
+ *   "NXSC" | u32 版本 | i64 上次完整刷新时间
+ *   u32 游戏数 | 游戏 × N：str TID | i32 MOD 数 | str lastUpdate | str MOD 已同步的 lastUpdate | 名称表
+ *   u32 MOD 数 | MOD × N：i32 modId | u32 所属游戏序号 | str 类型 | str 作者 | 名称表
+ *   名称表：u8 条数 | (str 语言 + str 名称) × n；str 为 u16 长度 + 内容
+ *   u32 以上全部内容的 CRC32
+ */
+
+#pragma once
+
+#include "api/game.hpp"
+#include "api/mod.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+class StoreCatalog {
+public:
+    /** @brief 某一语言下的名称 */
+    struct LocalizedName {
+        std::string lang; // 语言（api::url::getLang() 的取值）
+        std::string name; // 名称
+    };
+
+    /** @brief 目录中的游戏 */
+    struct Game {
+        std::string gameTid;              // 游戏 TID
+        int modCount = 0;                 // MOD 数量
+        std::string lastUpdate;           // 最后更新时间
+        std::string modsSyncedAt;         // MOD 列表同步时对应的 lastUpdate（不一致时需要重新拉取）
+        std::vector<LocalizedName> names; // 各语言名称
+    };
+
+    /** @brief 目录中的 MOD */
+    struct Mod {
+        int modId = 0;                    // 模组 ID
+        uint32_t game = 0;                // 所属游戏在 games 中的序号
+        std::string modType;              // 功能类型
+        std::string author;               // 作者
+        std::vector<LocalizedName> names; // 各语言名称
+    };
+
+    /** @brief 刷新使用的数据源（默认走商店 API，也可替换为本地替身） */
+    struct Source {
+        std::function<api::game::GameListResult(int page, int limit, std::stop_token token)> fetchGames; // 拉取一页游戏
+        std::function<api::mod::ModListResult(const std::string& gameTid, int page, int limit, std::stop_token token)> fetchMods; // 拉取一页 MOD
+        std::string lang; // 本次拉取结果的语言
+    };
+
+    /** @brief 刷新结果统计 */
+    struct RefreshStats {
+        bool success = false; // 游戏列表是否完整拉取（失败或已有刷新在进行时保留原缓存）
+        int games = 0;        // 刷新后的游戏数
+        int added = 0;        // 新增游戏数
+        int removed = 0;      // 移除游戏数
+        int modGames = 0;     // 本次同步了 MOD 列表的游戏数
+        int requests = 0;     // 发出的请求数
+    };
+
+    static constexpr int pageSize = 100;                    // 刷新时每页拉取数量
+    static constexpr int defaultModGameBudget = 20;         // 每次刷新最多同步 MOD 列表的游戏数
+    static constexpr std::time_t refreshInterval = 6 * 3600; // 两次完整刷新的最小间隔（秒）
+
+    /** @brief 获取商店目录单例（首次调用时读取 config::storeCatalogPath） */
+    static StoreCatalog& instance();
+
+    /** @brief 默认数据源：商店 API，语言取当前界面语言 */
+    static Source apiSource();
+
+    /**
+     * @brief 从文件读取目录并建立索引
+     * @param path 目录文件路径
+     * @return 文件不存在或校验失败时返回 false（目录置空）
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 写出目录到 load() 使用的路径
+     * @return 是否写入成功
+     */
+    bool save();
+
+    /**
+     * @brief 拉取商店目录并与缓存合并，完成后重建索引并写出（可在后台线程调用，已有刷新在进行时直接返回）
+     * @param source 数据源
+     * @param token 取消令牌，取消时丢弃本次结果
+     * @param modGameBudget 最多同步 MOD 列表的游戏数
+     * @return 刷新结果统计
+     */
+    RefreshStats refresh(const Source& source, std::stop_token token, int modGameBudget = defaultModGameBudget);
+
+    /**
+     * @brief 距上次完整刷新是否已超过 refreshInterval
+     * @return 需要刷新时返回 true
+     */
+    bool needsRefresh() const;
+
+    /**
+     * @brief 本地搜索：游戏名称 / TID 命中的在前，只有 MOD（名称、类型、作者）命中的在后，同级保持目录顺序
+     * @param keyword 搜索关键词（中文、拼音、首字母均可）
+     * @param lang 结果名称使用的语言（缺失时取任一语言）
+     * @param maxResults 最大返回数
+     * @return 商店游戏列表条目
+     */
+    std::vector<api::game::GameList> search(const std::string& keyword, const std::string& lang, size_t maxResults = 200) const;
+
+    /** @brief 目录中的游戏数 */
+    size_t gameCount() const;
+
+    /** @brief 目录中的 MOD 数 */
+    size_t modCount() const;
+
+private:
+    /** @brief 倒排索引：词项升序，postings[offsets[i], offsets[i+1]) 为词项 i 的条目（升序） */
+    struct Index {
+        std::vector<std::string> terms; // 词项（大写字母数字）
+        std::vector<uint32_t> offsets;  // 各词项倒排表起点，末尾多一项
+        std::vector<uint32_t> postings; // 条目编号：游戏为 [0, 游戏数)，MOD 为 游戏数 + MOD 序号
+    };
+
+    mutable std::mutex m_mutex;    // 保护以下数据（刷新在后台线程整体替换）
+    std::string m_path;            // 目录文件路径
+    std::time_t m_refreshedAt = 0; // 上次完整刷新时间
+    std::vector<Game> m_games;     // 游戏（商店列表顺序）
+    std::vector<Mod> m_mods;       // MOD（按所属游戏分组）
+    Index m_index;                 // 倒排索引
+    std::atomic<bool> m_refreshing{false}; // 是否有刷新正在进行（同一时间只允许一个）
+
+    /**
+     * @brief 为目录建立倒排索引
+     * @param games 游戏
+     * @param mods MOD
+     * @return 索引
+     */
+    static Index buildIndex(const std::vector<Game>& games, const std::vector<Mod>& mods);
+};
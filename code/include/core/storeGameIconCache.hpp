@@ -18,6 +18,9 @@ public:
     struct Metadata {
         std::string etag;         // ETag
         std::string lastModified; // Last-Modified
+
+        /** @brief 图标版本标签（iconCache 据此判断解码缓存是否过期） */
+        std::string tag() const { return etag + "|" + lastModified; }
     };
 
     /** @brief 创建商店游戏图标缓存 */
@@ -83,6 +86,6 @@ public:
     void updateMetadata(const std::string& tid, const std::string& etag, const std::string& lastModified);
 
 private:
-    JsonFile m_json; // HTTP 缓存元数据 JSON
+    JsonFile m_json{JsonFile::Format::Compact}; // HTTP 缓存元数据 JSON（只由程序读写）
     bool m_dirty = false; // 缓存元数据是否需要保存
 };
@@ -19,6 +19,22 @@ public:
      */
     void appendPage(api::game::GameListResult result);
 
+    /**
+     * @brief 用本地目录的搜索结果作为完整列表（按当前筛选模式过滤，不再分页，主线程调用）
+     * @param list 本地搜索结果
+     */
+    void setLocalResults(std::vector<api::game::GameList> list);
+
+    /**
+     * @brief 将服务器搜索结果中本地目录缺少的游戏追加到列表末尾（主线程调用）
+     * @param result 服务器返回的一页数据
+     * @return 追加的游戏数
+     */
+    size_t mergeServerPage(api::game::GameListResult result);
+
+    /** @brief 当前列表是否来自本地目录搜索 */
+    bool isLocalResults() const;
+
     /** @brief 获取游戏列表引用 */
     std::vector<api::game::GameList>& storeGameList();
 
@@ -64,6 +80,7 @@ private:
     int m_currentPage = 0;                            // 当前已加载页码
     int m_total = 0;                                  // 服务器游戏总数
     GameFilterMode m_filterMode = GameFilterMode::All; // 当前筛选模式
+    bool m_localResults = false;                      // 列表是否来自本地目录搜索
     std::string m_tidsJson;                           // 本机已安装游戏 TID JSON
     std::unordered_set<uint64_t> m_installedTids;     // 本机已安装游戏 TID 集合
 };
@@ -50,22 +50,28 @@ public:
     ModInfo buildDownloadedModInfo(std::string modDirName, std::string modDir) const;
 
     /**
-     * @brief 商店下载：创建 mod 目录、移动 zip，不写 modInfo.json
+     * @brief 在游戏目录下创建不重名的 mod 目录，填入目录名和路径
+     * @param info 商店 mod 信息（buildDownloadedModInfo 构造）
      * @param gameDir 游戏目录路径
-     * @param modDirName mod 目录名
+     * @param modDirName 期望的 mod 目录名
+     * @return 填好目录名和路径的 ModInfo
+     */
+    static ModInfo reserveModDir(ModInfo info, const std::string& gameDir, const std::string& modDirName);
+
+    /**
+     * @brief 把下载完成的 zip 移入 mod 目录
+     * @param info 已创建目录的 mod 信息
      * @param tempZipPath 临时 zip 文件路径
-     * @return 构造好的 ModInfo
+     * @return 是否移动成功
      */
-    ModInfo createDownloadedMod(const std::string& gameDir, std::string modDirName, const std::string& tempZipPath);
+    static bool placeDownloadedZip(const ModInfo& info, const std::string& tempZipPath);
 
     /**
-     * @brief 商店下载：创建 mod 目录、移动 zip、写 modInfo.json
+     * @brief 把商店 mod 信息写入游戏目录的 modInfo.json（页面没有持有该游戏的 ModManager 时使用）
      * @param gameDir 游戏目录路径
-     * @param modDirName mod 目录名
-     * @param tempZipPath 临时 zip 文件路径
-     * @return 构造好的 ModInfo
+     * @param info 已创建目录的 mod 信息
      */
-    ModInfo saveDownloadedMod(const std::string& gameDir, std::string modDirName, const std::string& tempZipPath);
+    static void saveModInfo(const std::string& gameDir, const ModInfo& info);
 
     /**
      * @brief 追加一页留言（主线程调用）
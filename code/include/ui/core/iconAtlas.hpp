@@ -0,0 +1,133 @@
+/**
+ * IconAtlas - 游戏图标纹理图集
+ *
+ * 主页为每个游戏永久持有一个图标，原来每个图标各建一张 256×256 的 NanoVG 纹理，
+ * 游戏多时是几百张小纹理，滚动时每张卡片都要切换纹理。本类把图标放进少量 4×4 格的大纹理（页），
+ * 卡片按子区域从页上绘制，同一页上的图标共用一张纹理。
+ *
+ * 用法与 brls::TextureCache 相同：按键查找 / 添加，按槽位 ID 引用计数；
+ * 引用归零的槽位保留内容，再次查找时直接命中，没有空格时才按最久未使用的顺序复用。
+ *
+ * NanoVG 只提供整张纹理的更新，每页在 CPU 端保留一份像素副本，
+ * 添加图标只改副本并标记该页，绘制时每页最多上传一次。
+ *
+ * 只在主线程使用。
+ */
+
+#pragma once
+
+#include "utils/iconCache.hpp"
+#include "utils/imageDecoder.hpp"
+
+#include <borealis.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class IconAtlas {
+public:
+    static constexpr int slotSize = iconCache::maxSize;      // 单个图标的最大边长
+    static constexpr int slotPitch = slotSize + 2;           // 槽位间距（四周各 1 像素复制边缘，缩放采样不会混入相邻图标）
+    static constexpr int pageSlots = 4;                      // 每页每行 / 每列的槽位数
+    static constexpr int pageSize = slotPitch * pageSlots;   // 页纹理边长
+
+    /** @brief 获取全局实例 */
+    static IconAtlas& instance();
+
+    /**
+     * @brief 查找图标（命中时引用计数加一）
+     * @param key 图标键
+     * @return 槽位 ID，不存在时返回 0
+     */
+    int getCache(const std::string& key);
+
+    /**
+     * @brief 添加图标（引用计数为 1；键已存在时更新像素并加一）
+     * @param key 图标键
+     * @param image RGBA 像素，超过 slotSize 时按比例缩小
+     * @return 槽位 ID，图像无效时返回 0
+     */
+    int addCache(const std::string& key, const imageDecoder::DecodedImage& image);
+
+    /**
+     * @brief 引用计数减一，归零后槽位可被复用
+     * @param id 槽位 ID
+     */
+    void removeCache(int id);
+
+    /**
+     * @brief 按 fit 方式把图标绘制到指定区域（居中、保持比例、圆角裁剪）
+     * @param vg NanoVG 上下文
+     * @param id 槽位 ID
+     * @param x 区域横坐标
+     * @param y 区域纵坐标
+     * @param width 区域宽度
+     * @param height 区域高度
+     * @param cornerRadius 圆角半径
+     * @param alpha 不透明度
+     * @return 槽位无效或纹理创建失败时返回 false
+     */
+    bool draw(NVGcontext* vg, int id, float x, float y, float width, float height, float cornerRadius, float alpha);
+
+    /**
+     * @brief 获取独立纹理（与 TextureCache::getCache 相同，引用计数加一），供 brls::Image 等只接受纹理 ID 的控件使用；
+     * TextureCache 中没有该键时从图集复制一份像素创建纹理并加入缓存
+     * @param key 图标键
+     * @return 纹理 ID，两处都没有时返回 0
+     */
+    int acquireTexture(const std::string& key);
+
+    /** @brief 已创建的页数 */
+    size_t pageCount() const { return m_pages.size(); }
+
+private:
+    /** @brief 一页图集 */
+    struct Page {
+        std::vector<uint8_t> pixels; // CPU 端像素副本
+        int image = 0;               // NanoVG 纹理 ID，0 表示尚未创建
+        bool dirty = true;           // 副本有未上传的修改
+    };
+
+    /** @brief 一个图标槽位 */
+    struct Slot {
+        std::string key;      // 图标键，空串表示从未使用
+        int refs = 0;         // 引用计数
+        int width = 0;        // 图标宽
+        int height = 0;       // 图标高
+        uint64_t lastUse = 0; // 最近使用序号，复用时先选最小的
+    };
+
+    std::vector<Page> m_pages;                    // 全部页
+    std::vector<Slot> m_slots;                    // 全部槽位（第 i 页占 [i * 16, i * 16 + 16)）
+    std::unordered_map<std::string, int> m_index; // 图标键 → 槽位 ID
+    uint64_t m_useCounter = 0;                    // 使用序号
+
+    /** @brief 槽位 ID 是否有效 */
+    bool valid(int id) const { return id > 0 && id <= static_cast<int>(m_slots.size()); }
+
+    /** @brief 找一个空槽位（从未使用的优先，其次最久未使用的零引用槽位），没有时新建一页 */
+    int allocate();
+
+    /**
+     * @brief 把像素写入槽位对应的页副本，并复制边缘到 1 像素的间隔
+     * @param id 槽位 ID
+     * @param image RGBA 像素（不超过 slotSize）
+     */
+    void blit(int id, const imageDecoder::DecodedImage& image);
+
+    /**
+     * @brief 获取槽位左上角在页内的像素坐标
+     * @param id 槽位 ID
+     * @param x 输出：横坐标
+     * @param y 输出：纵坐标
+     */
+    static void origin(int id, int& x, int& y);
+
+    /**
+     * @brief 把图集中的图标复制为独立纹理
+     * @param key 图标键
+     * @return 新纹理 ID，不存在时返回 0
+     */
+    int createTexture(const std::string& key);
+};
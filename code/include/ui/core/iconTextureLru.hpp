@@ -0,0 +1,72 @@
+/**
+ * IconTextureLru - 最近使用的图标纹理常驻
+ *
+ * brls::TextureCache 按引用计数管理纹理：卡片回收或页面关闭后引用归零，纹理随即释放，
+ * 滚回来或再次进入页面时又要读文件、解码、上传。本类为最近创建或命中的图标纹理额外持有一个引用，
+ * 按像素字节数限定总量，超出时释放最久未使用的引用（仍被卡片使用的纹理不受影响）。
+ *
+ * 只在主线程使用。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+class IconTextureLru {
+public:
+    static constexpr size_t defaultBudget = 32 * 1024 * 1024; // 常驻纹理的像素字节上限（约 128 个 256×256 图标）
+
+    /** @brief 获取全局实例 */
+    static IconTextureLru& instance();
+
+    /**
+     * @brief 查找纹理缓存（与 TextureCache::getCache 相同，命中时引用计数加一），并记录命中统计
+     * @param key 纹理键
+     * @return 纹理 ID，不存在时返回 0
+     */
+    int acquire(const std::string& key);
+
+    /**
+     * @brief 常驻刚创建的纹理（额外持有一个引用），超出预算时释放最久未使用的纹理
+     * @param key 纹理键
+     * @param iconId 纹理 ID
+     * @param bytes 纹理像素字节数
+     */
+    void keep(const std::string& key, int iconId, size_t bytes);
+
+    /**
+     * @brief 释放指定纹理的常驻引用（图标内容已更新时调用）
+     * @param key 纹理键
+     */
+    void drop(const std::string& key);
+
+    /** @brief 释放全部常驻引用 */
+    void clear();
+
+    /** @brief 命中次数 */
+    int hits() const { return m_hits; }
+
+    /** @brief 未命中次数 */
+    int misses() const { return m_misses; }
+
+private:
+    /** @brief 常驻条目 */
+    struct Entry {
+        std::string key;  // 纹理键
+        int iconId = 0;   // 纹理 ID
+        size_t bytes = 0; // 像素字节数
+    };
+
+    std::list<Entry> m_entries;                                          // 最近使用的在前
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index; // 纹理键 → 条目
+    size_t m_bytes = 0;                                                  // 常驻纹理字节数
+    size_t m_budget = defaultBudget;                                     // 字节上限
+    int m_hits = 0;                                                      // 命中次数
+    int m_misses = 0;                                                    // 未命中次数
+
+    /** @brief 释放最久未使用的条目直到不超过预算 */
+    void evict();
+};
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "common/gameInfo.hpp"
+#include "ui/core/iconAtlas.hpp"
 #include "ui/view/addGameCard.hpp"
 #include "ui/view/recyclingGrid.hpp"
 #include <borealis/core/cache_helper.hpp>
@@ -46,7 +47,7 @@ public:
 
         int iconId = 0;
         if (!game.iconKey.empty()) {
-            iconId = brls::TextureCache::instance().getCache(game.iconKey);
+            iconId = IconAtlas::instance().acquireTexture(game.iconKey);
             if (iconId <= 0) {
                 m_textureMissingCallback(index);
                 return grid->dequeueReusableCell("Skeleton");
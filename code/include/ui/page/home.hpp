@@ -15,12 +15,15 @@
 #include "utils/async.hpp"
 #include "utils/imageDecoder.hpp"
 #include <any>
+#include <array>
 #include <atomic>
 #include <borealis.hpp>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <stop_token>
 #include <string>
+#include <vector>
 
 class Home : public Page, public ShellState {
 public:
@@ -37,19 +40,32 @@ public:
     void onResume() override;
 
 private:
+    static constexpr size_t cardPrefetchJobs = 3;        // 同时加载的卡片数（Switch 应用可用 3 个核心）
+
+    /** @brief 一个正在加载的卡片 */
+    struct CardSlot {
+        uint64_t appId = 0;                  // 正在加载的游戏，0 表示空闲
+        bool cancelled = false;              // 已取消、等待任务退出（读取 NACP 无法中断，退出前仍占用槽位）
+        util::AsyncFurture<void> task;       // 读取 NACP + 解码图标的后台任务
+    };
+
+    std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now(); // 页面创建时间（先于游戏列表加载），用于统计启动到首帧耗时
     GameManager m_gameManager;                           // 游戏数据管理
     util::AsyncFurture<void> m_startupUpdateTask;         // 启动更新检查任务
-    util::AsyncFurture<void> m_nacpLoader;                // 异步 NACP 加载任务
+    std::array<CardSlot, cardPrefetchJobs> m_cardSlots;  // 并行 NACP 加载槽位
     util::AsyncFurture<void> m_clearTask;                 // 异步清空中转站任务
     util::AsyncFurture<void> m_deleteGameTask;            // 异步删除项目任务
     util::AsyncFurture<void> m_deleteIconCacheTask;       // 异步删除图标缓存任务
     util::AsyncFurture<void> m_updateTask;                // 异步下载更新任务
     util::AsyncFurture<void> m_resetTask;                 // 异步重置状态任务
+    util::AsyncFurture<void> m_reconcileTask;             // 后台核对游戏库快照任务
     brls::VoidEvent::Subscription m_windowSizeChangedSubscription; // 窗口尺寸事件订阅
     std::atomic<int> m_focusedIndex{0};                   // 当前焦点索引（后台线程读，主线程写）
     bool m_nacpComplete = false;                          // NACP 加载是否完成
     bool m_allowForcedUpdate = true;                      // 本次是否允许弹出强制更新
     std::function<void()> m_onNacpComplete;               // NACP 加载完成后的待执行回调
+    std::function<void()> m_pendingLibraryScan;           // 页面不在前台时暂存的游戏库核对结果，onResume 时应用
+    std::vector<int> m_pendingDownloads;                  // 需要新建游戏项目、等回到主页再放入的下载任务
 
     /** @brief 设置页面标题 */
     void setHeader();
@@ -69,14 +85,46 @@ private:
     /** @brief 窗口尺寸初始化完成后启动卡片加载 */
     void startCardLoader();
 
-    /** @brief 按当前焦点提交下一张卡片 */
-    void submitNextCard();
+    /**
+     * @brief 调度卡片加载：可见范围内的优先，其次按与焦点的距离，
+     * 同时最多 cardPrefetchJobs 个任务（含已取消、尚未退出的）；已滚出可见范围且不再排在前面的任务被取消。
+     * 没有待加载的卡片时完成 NACP 加载
+     */
+    void scheduleCards();
+
+    /**
+     * @brief 已取消的加载任务退出后释放槽位并重新调度（主线程调用）
+     * @param appId 任务加载的游戏
+     */
+    void releaseCancelledCard(uint64_t appId);
+
+    /** @brief 是否有卡片正在加载 */
+    bool cardsLoading() const;
+
+    /** @brief 游戏列表来自启动快照时，在后台重新扫描 /mods2/ 核对 */
+    void startLibraryReconcile();
 
     /**
-     * @brief 获取或创建 Home 永久持有的游戏图标纹理
+     * @brief 在主线程应用游戏库扫描结果，刷新网格并保持焦点
+     * @param version 开始扫描时的游戏列表版本号
+     * @param entries 扫描结果
+     */
+    void applyLibraryScan(uint32_t version, std::vector<gameLibrary::GameDirEntry> entries);
+
+    /** @brief 恢复商店下载队列，下载完成的任务切到主线程放入游戏目录 */
+    void startDownloadQueue();
+
+    /**
+     * @brief 在主线程把下载完成的商店模组放入游戏目录，新建项目时刷新网格并保持焦点
+     * @param taskId 下载任务 ID
+     */
+    void completeStoreDownload(int taskId);
+
+    /**
+     * @brief 获取或添加 Home 永久持有的游戏图标（IconAtlas 槽位）
      * @param appId 游戏唯一 ID
      * @param image 解码后的游戏图标
-     * @return 图标纹理 ID，失败时返回 -1
+     * @return 图集槽位 ID，失败时返回 -1
      */
     int loadGameIcon(uint64_t appId, const imageDecoder::DecodedImage& image);
 
@@ -174,6 +222,7 @@ private:
     ContextMenuPage m_themeMenu{brls::getStr("page/home/themeMenuTitle")};                   // 主题颜色子菜单
     ContextMenuPage m_langMenu{brls::getStr("page/home/langMenuTitle")};                     // 语言设置子菜单
     ContextMenuPage m_sortFilterMenu{brls::getStr("page/home/sortFilterTitle")};             // 排序筛选子菜单
+    ContextMenuPage m_downloadConcurrencyMenu{brls::getStr("page/home/downloadConcurrency")}; // 同时下载数子菜单
 
     /** @brief 初始化菜单 */
     void setupMenu();
@@ -187,6 +236,9 @@ private:
     /** @brief 初始化"语言设置"子菜单 */
     void setupLangMenu();
 
+    /** @brief 初始化"同时下载"子菜单 */
+    void setupDownloadConcurrencyMenu();
+
     /** @brief 初始化"功能设置"子菜单 */
     void setupSettingsMenu();
 
@@ -62,6 +62,7 @@ private:
     bool m_metadataLoading = false;            // 体积和 CRC32 顺序流程是否进行中
     int m_focusedIndex = 0;                    // 当前焦点索引（元数据任务优先级）
     bool m_layoutReady = false;                // 页面内容是否已经完成初始化
+    int m_downloadListener = 0;                // 下载队列完成监听 ID
 
     /** @brief 设置页面标题 */
     void setHeader();
@@ -183,6 +184,9 @@ private:
     /** @brief CRC32 全部就绪后异步检查模组更新，并单独刷新命中的卡片 */
     void submitUpdateCheck();
 
+    /** @brief 卡片加载完成后在后台校验已安装文件索引，清理过期条目 */
+    void submitIndexVerify();
+
     /**
      * @brief 应用显示名称（写 JSON + 更新 Cell）
      * @param idx 模组索引
@@ -70,9 +70,8 @@ public:
 private:
     std::vector<ResultButton*> m_resultButtons; // 当前搜索结果按钮
     brls::View* m_lastKeyboardFocus = nullptr;  // 键盘区域最后一个焦点
-    std::vector<std::string> m_items;           // 搜索数据源
     std::function<void(int)> m_onSelect;        // 搜索结果选中回调
-    SearchEngine m_searchEngine;                // 搜索引擎
+    SearchEngine m_searchEngine;                // 搜索引擎（持有搜索数据源及其索引）
 
     /** @brief 设置页面标题 */
     void setHeader();
@@ -39,6 +39,7 @@ private:
     static constexpr const char* TID_PLACEHOLDER = "0000000000000000"; // 尚未选中游戏时显示的 16 位占位 TID
 
     std::stop_source m_stopSource;                       // 取消源（页面退出/重载时取消所有任务）
+    std::stop_source m_catalogStopSource;                // 商店目录后台刷新的取消源（只在页面退出时取消）
     StoreGameManager m_manager;                          // 数据管理
     StoreGameIconCache m_iconFileCache;                  // 本地图标 WebP 和缓存元数据
     std::unordered_set<std::string> m_pendingDownloads;  // 等待网络下载的游戏 TID
@@ -69,9 +70,12 @@ private:
     /** @brief B 键：有搜索词时重置搜索，否则返回主页 */
     bool handleBackOrResetSearch();
 
-    /** @brief 加载下一页数据 */
+    /** @brief 加载下一页数据（搜索首页先显示本地目录结果，服务器结果到达后合并） */
     void loadNextPage();
 
+    /** @brief 商店目录超过刷新间隔时在后台刷新 */
+    void refreshCatalog();
+
     /** @brief 重置数据 + 重新加载 */
     void reloadData();
 
@@ -145,6 +149,24 @@ private:
     /** @brief 主线程回调：处理分页加载结果 */
     void onPageLoaded(api::game::GameListResult result);
 
+    /**
+     * @brief 主线程回调：显示本地目录搜索结果（按筛选模式过滤后为空时不显示，等待服务器结果）
+     * @param list 本地搜索结果
+     */
+    void onLocalResults(std::vector<api::game::GameList> list);
+
+    /**
+     * @brief 主线程回调：将服务器搜索结果合并到本地结果之后（请求失败时保留本地结果，不弹窗）
+     * @param result 服务器返回的一页数据
+     */
+    void onServerResultsMerged(api::game::GameListResult result);
+
+    /**
+     * @brief 刷新网格显示当前列表
+     * @param firstPage 是否为首页（首页重新加载网格并恢复焦点）
+     */
+    void showList(bool firstPage);
+
     /**
      * @brief 处理游戏卡片点击
      * @param index 点击的游戏索引
@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include "core/downloadManager.hpp"
 #include "core/gameManager.hpp"
 #include "core/modManager.hpp"
 #include "core/storeModDetailManager.hpp"
@@ -104,6 +105,7 @@ private:
     std::string m_gameVersion;                        // 本地游戏版本号（"..."表示未安装/未知）
     bool m_fromModList = false;                       // 下载完成后是否返回本地 ModList
     bool m_directFromModList = false;                 // 是否直接从本地 ModList 进入
+    int m_downloadListener = 0;                       // 下载队列完成监听 ID
 
     bool m_detailLoaded = false;                     // 详情是否加载完成
     bool m_commentLoading = false;                   // 留言是否正在加载
@@ -180,6 +182,18 @@ private:
     /** @brief 下载按钮逻辑 */
     void onDownloadAction();
 
+    /**
+     * @brief 显示下载队列中任务的状态，提供暂停、继续和取消
+     * @param task 当前模组的下载任务
+     */
+    void showTaskDialog(const DownloadManager::Task& task);
+
+    /**
+     * @brief 确认后取消下载任务
+     * @param taskId 任务 ID
+     */
+    void confirmCancelDownload(int taskId);
+
     /**
      * @brief 显示已下载状态下的下载提示
      * @param detail 当前模组详情
@@ -191,21 +205,28 @@ private:
     void showDownloadConfirmDialog();
 
     /**
-     * @brief 开始下载或更新模组
+     * @brief 把下载或更新加入后台下载队列
      * @param updateMode 是否为更新模式
      */
-    void startDownload(bool updateMode);
+    void enqueueDownload(bool updateMode);
+
+    /**
+     * @brief 下载队列中的任务放入游戏目录后刷新下载状态
+     * @param completion 完成结果
+     */
+    void onDownloadCompleted(const DownloadManager::Completion& completion);
+
+    /** @brief 下载并安装到本地游戏（边下载边安装，显示进度弹窗） */
+    void startDownloadAndInstall();
 
     /**
-     * @brief 下载成功后在主线程保存模组并显示完成弹窗
+     * @brief 下载并安装结束后在主线程加入模组列表并显示结果弹窗
      * @param gameTid 游戏 TID
-     * @param gameNameEn 英文游戏名
-     * @param gameName 当前显示游戏名
-     * @param modDirName 模组目录名
-     * @param tempPath 下载完成的临时 zip 路径
+     * @param modInfo 已移入 zip 的模组信息
+     * @param result 安装结果
      * @param modName 当前显示模组名
      */
-    void finishDownloadOnMainThread(const std::string& gameTid, const std::string& gameNameEn, const std::string& gameName, const std::string& modDirName, const std::string& tempPath, const std::string& modName);
+    void finishInstallOnMainThread(const std::string& gameTid, ModInfo modInfo, const ModInstaller::InstallResult& result, const std::string& modName);
 
     /**
      * @brief 补齐游戏名称、版本和图标
@@ -215,14 +236,7 @@ private:
     void loadGameMetadata(int gameIndex, const std::string& gameTid);
 
     /**
-     * @brief 更新成功后在主线程替换 zip 并刷新状态
-     * @param tempPath 下载完成的临时 zip 路径
-     * @param modName 当前显示模组名
-     */
-    void finishUpdateOnMainThread(const std::string& tempPath, const std::string& modName);
-
-    /**
-     * @brief 显示下载/更新完成弹窗
+     * @brief 显示下载并安装完成弹窗
      * @param message 弹窗正文
      */
     void showCompleteDialog(const std::string& message);
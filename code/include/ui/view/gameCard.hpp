@@ -42,7 +42,7 @@ public:
      * @param version 版本号
      * @param modCount mod 数量
      */
-    void setGame(const std::string& name, const std::string& version, const std::string& modCount);
+    void setGame(const std::string& name, const std::string& version, int modCount);
 
     /**
      * @brief 设置是否显示启动提示
@@ -58,7 +58,7 @@ public:
 
     /**
      * @brief 设置游戏图标
-     * @param iconId NVG 纹理 ID
+     * @param iconId IconAtlas 槽位 ID（引用由 Home 持有）
      */
     void setIcon(int iconId);
 
@@ -90,8 +90,10 @@ private:
     static constexpr float LAUNCH_HINT_HIDDEN_X = 106.0f; // 启动提示完全移出图标区域时的横向偏移
     static constexpr float FOCUS_ICON_SCALE = 1.05f;      // 游戏图标获得焦点后的缩放倍数
     static constexpr float PRESSED_ICON_SCALE = FOCUS_ICON_SCALE * 0.95f; // 启动按下时的游戏图标缩放倍数
+    static constexpr float ICON_CORNER_RADIUS = 6.0f;     // 图集图标的圆角半径（与 XML 中默认图标一致）
 
     int m_defaultIconId = 0;                              // 默认游戏图标的纹理 ID
+    int m_atlasIconId = 0;                                // 图集中的游戏图标槽位 ID，0 表示显示默认图标
     bool m_launchAvailable = false;                       // 当前游戏是否已安装并允许显示启动提示
     bool m_launching = false;                             // 是否正在播放启动按压动画
     brls::Animatable m_launchHintX{LAUNCH_HINT_HIDDEN_X}; // 启动提示横向平移动画值
@@ -188,6 +188,14 @@ public:
     /** @brief 获取所有可见 Cell */
     std::vector<RecyclingGridItem*>& getGridItems();
 
+    /**
+     * @brief 获取当前已创建 Cell 的索引范围（含预加载行）
+     * @param first 输出：首个索引
+     * @param last 输出：末个索引
+     * @return 尚未创建任何 Cell 时返回 false
+     */
+    bool getVisibleRange(size_t& first, size_t& last) const;
+
     /** @brief 获取条目总数 */
     size_t getItemCount();
 
@@ -55,6 +55,7 @@ private:
     BRLS_BIND(brls::Box, m_titleContent, "globalHeader/titleContent");               // 普通标题内容容器
     BRLS_BIND(brls::Box, m_contentTitleCapsule, "globalHeader/contentTitleCapsule"); // 内容标题胶囊
     BRLS_BIND(brls::Label, m_contentTitleLabel, "globalHeader/contentTitle");        // 内容标题文字
+    BRLS_BIND(brls::Label, m_downloadLabel, "globalHeader/download");                // 后台下载速度文本
     BRLS_BIND(brls::Label, m_fpsLabel, "globalHeader/fps");                          // FPS 文本
     BRLS_BIND(brls::Label, m_memLabel, "globalHeader/memory");                       // 内存使用文本
     BRLS_BIND(brls::Label, m_timeLabel, "globalHeader/time");                        // 当前时间文本
@@ -78,6 +79,7 @@ private:
     static constexpr brls::Time BATTERY_UPDATE_INTERVAL_US = 5000000; // 电池百分比刷新间隔（5s）
     static constexpr brls::Time FPS_UPDATE_INTERVAL_US = 1000000;     // FPS 文本刷新间隔（1s）
     static constexpr brls::Time MEM_UPDATE_INTERVAL_US = 1000000;     // 内存采样间隔（1s）
+    static constexpr brls::Time DOWNLOAD_UPDATE_INTERVAL_US = 1000000; // 下载速度刷新间隔（1s）
 
     // 时间状态
     std::string m_timeText;            // 当前显示的时间文本
@@ -97,6 +99,10 @@ private:
     uint64_t m_lastTotalMB = 0;       // 上次显示的总内存
     bool m_showMem = false;           // 是否显示内存信息
 
+    // 后台下载状态
+    brls::Time m_lastDownloadUpdateUs = 0; // 上次刷新下载速度的时间点
+    std::string m_downloadText;            // 当前显示的下载文本（为空时隐藏）
+
     /** @brief 应用普通标题状态 */
     void applyTitleState(const std::optional<TitleState>& state);
 
@@ -136,4 +142,7 @@ private:
 
     /** @brief 更新右上角内存文本 */
     void updateMemStatus(brls::Time now);
+
+    /** @brief 更新右上角后台下载速度（没有下载任务时隐藏） */
+    void updateDownloadStatus(brls::Time now);
 };
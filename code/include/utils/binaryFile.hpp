@@ -0,0 +1,190 @@
+/**
+ * binaryFile - 小端二进制持久化格式的公共读写
+ * 安装清单、已安装文件索引、引用计数、CRC 缓存、游戏库快照、拼音缓存、商店目录、图标缓存、续传记录共用
+ *
+ * 带框文件（多数格式）：
+ *   4 字节魔数 | u32 版本 | 正文 | u32 以上全部内容的 CRC32
+ * 只有文件头的文件（逐条追加、记录自带 CRC 的格式）：
+ *   4 字节魔数 | u32 版本 | 正文
+ *
+ * Reader 越界后所有读取都失败并返回默认值，调用方读完后统一检查 ok，不必逐个判断
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace binaryFile {
+
+/** @brief 文件魔数 */
+using Magic = char[4];
+
+inline constexpr size_t headerSize = sizeof(Magic) + sizeof(uint32_t); // 魔数 + 版本
+
+/**
+ * @brief 在缓冲区末尾追加一个定长值
+ * @param buf 缓冲区
+ * @param val 值
+ */
+template <typename T>
+void put(std::vector<uint8_t>& buf, T val) {
+    size_t pos = buf.size();
+    buf.resize(pos + sizeof(T));
+    std::memcpy(buf.data() + pos, &val, sizeof(T));
+}
+
+/**
+ * @brief 读取指定位置的定长值（调用方保证不越界）
+ * @param p 数据指针
+ */
+template <typename T>
+T peek(const uint8_t* p) {
+    T val;
+    std::memcpy(&val, p, sizeof(T));
+    return val;
+}
+
+/** @brief 顺序写入小端二进制数据 */
+struct Writer {
+    std::vector<uint8_t> buf; // 已写入的内容
+
+    Writer() = default;
+
+    /**
+     * @brief 创建并写入文件头
+     * @param magic 文件魔数
+     * @param version 格式版本
+     */
+    Writer(const Magic& magic, uint32_t version) {
+        buf.resize(sizeof(Magic));
+        std::memcpy(buf.data(), magic, sizeof(Magic));
+        put(version);
+    }
+
+    template <typename T>
+    void put(T val) {
+        binaryFile::put(buf, val);
+    }
+
+    /** @brief 写入长度前缀 + 字符串，超出 Len 能表示的长度时截断 */
+    template <typename Len = uint16_t>
+    void putStr(const std::string& str) {
+        size_t len = std::min<size_t>(str.size(), std::numeric_limits<Len>::max());
+        put(static_cast<Len>(len));
+        buf.insert(buf.end(), str.begin(), str.begin() + len);
+    }
+
+    /** @brief 写入原始字节 */
+    void putBytes(const void* data, size_t size) {
+        auto* bytes = static_cast<const uint8_t*>(data);
+        buf.insert(buf.end(), bytes, bytes + size);
+    }
+
+    /**
+     * @brief 追加 [start, 当前末尾) 的 CRC32
+     * @param start 校验范围起点，默认从文件头开始
+     */
+    void putCrc(size_t start = 0);
+};
+
+/** @brief 顺序读取小端二进制数据，越界后所有读取失败 */
+struct Reader {
+    const uint8_t* data = nullptr; // 数据起点
+    size_t size = 0;               // 可读范围（带框文件不含末尾 CRC）
+    size_t pos = 0;                // 当前读取位置
+    bool ok = true;                // 是否未越界且格式有效
+
+    template <typename T>
+    T get() {
+        T val{};
+        if (!ok || pos + sizeof(T) > size) {
+            ok = false;
+            return val;
+        }
+        std::memcpy(&val, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return val;
+    }
+
+    /** @brief 读取长度前缀 + 字符串 */
+    template <typename Len = uint16_t>
+    std::string getStr() {
+        Len len = get<Len>();
+        const uint8_t* start = skip(len);
+        if (!start) return {};
+        return std::string(reinterpret_cast<const char*>(start), len);
+    }
+
+    /**
+     * @brief 跳过 len 字节
+     * @return 被跳过内容的起点，越界时返回 nullptr
+     */
+    const uint8_t* skip(size_t len) {
+        if (!ok || pos + len > size) {
+            ok = false;
+            return nullptr;
+        }
+        const uint8_t* start = data + pos;
+        pos += len;
+        return start;
+    }
+
+    /** @brief 读取成功且恰好读完 */
+    bool finished() const { return ok && pos == size; }
+};
+
+/**
+ * @brief 打开只有文件头的文件
+ * @param data 文件内容（Reader 引用它，调用方保证在读完前不释放）
+ * @param magic 文件魔数
+ * @param version 格式版本
+ * @return 定位到文件头之后的 Reader，魔数或版本不符时 ok = false
+ */
+Reader openHeader(const std::vector<uint8_t>& data, const Magic& magic, uint32_t version);
+
+/**
+ * @brief 打开带框文件
+ * @param data 文件内容（Reader 引用它，调用方保证在读完前不释放）
+ * @param magic 文件魔数
+ * @param version 格式版本
+ * @param verifyCrc 是否立即校验 CRC32；为 false 时由调用方在读完正文后调用 crcMatches（先用正文排除过期文件，省去大文件的校验）
+ * @return 定位到文件头之后、范围不含末尾 CRC 的 Reader，长度、魔数、版本或 CRC 不符时 ok = false
+ */
+Reader openFramed(const std::vector<uint8_t>& data, const Magic& magic, uint32_t version, bool verifyCrc = true);
+
+/**
+ * @brief 带框文件末尾的 CRC32 是否与内容一致
+ * @param data 文件内容
+ */
+bool crcMatches(const std::vector<uint8_t>& data);
+
+/**
+ * @brief 追加 CRC32 后写入带框文件
+ * @param path 文件路径
+ * @param writer 已写入文件头和正文的 Writer
+ * @return 是否写入成功
+ */
+bool saveFramed(const std::string& path, Writer& writer);
+
+/**
+ * @brief 先完整写出临时文件，再删除原文件并改名；替换中途掉电时临时文件仍然完整
+ * @param path 文件路径
+ * @param data 文件内容
+ * @param size 内容长度
+ * @return 是否写入成功
+ */
+bool writeAtomic(const std::string& path, const void* data, size_t size);
+
+/**
+ * @brief 获取原子替换使用的临时文件路径
+ * @param path 文件路径
+ * @return 临时文件路径
+ */
+std::string tempPath(const std::string& path);
+
+} // namespace binaryFile
@@ -1,26 +1,85 @@
 /**
  * crc32 - 文件 CRC32 计算
- * 基于 libnx 硬件加速 CRC32 + 原生 FS API
+ * Switch：基于 libnx 硬件加速 CRC32 + 原生 FS API
+ * 其他平台：基于 fsHelper POSIX 后端 + 可移植的 slicing-by-8 软件 CRC32（结果与 zlib 一致）
+ *
+ * 批量计算（fromFiles）：
+ *   多个文件在 ThreadPool 上并发读取与计算，每个线程使用独立的对齐大缓冲区，
+ *   调用线程自身也参与计算，线程池繁忙时不会因等待空闲线程而停滞
  */
 
 #pragma once
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <stop_token>
+#include <string>
+#include <vector>
+#ifdef __SWITCH__
 #include <switch.h>
+#else
+#include "utils/fsHelper.hpp"
+#endif
 
 namespace crc {
 
+inline constexpr size_t batchBufSize = 1024 * 1024;  // 批量计算时每个线程的读取缓冲区 1MB
+inline constexpr int batchWorkerCount = 3;           // 批量计算默认并发数（含调用线程）
+
+/**
+ * @brief 可移植的软件 CRC32（slicing-by-8，每次处理 8 字节），不依赖硬件指令
+ * @param seed 之前的 CRC32（首段传 0）
+ * @param data 数据指针
+ * @param len 数据长度
+ * @return 累计 CRC32
+ */
+uint32_t software(uint32_t seed, const void* data, size_t len);
+
+/**
+ * @brief 逐字节查表的软件 CRC32（slicing-by-8 的对照实现，供性能测试比较）
+ * @param seed 之前的 CRC32（首段传 0）
+ * @param data 数据指针
+ * @param len 数据长度
+ * @return 累计 CRC32
+ */
+uint32_t bytewise(uint32_t seed, const void* data, size_t len);
+
+/**
+ * @brief 合并相邻两段数据的 CRC32，不需要重新读取数据（与 zlib 的 crc32_combine 一致）
+ * @param crc1 前一段的 CRC32
+ * @param crc2 后一段的 CRC32
+ * @param len2 后一段的长度
+ * @return 两段连起来的 CRC32
+ */
+uint32_t combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+/**
+ * @brief 在已有 CRC32 基础上继续计算一段内存
+ * @param seed 之前的 CRC32（首段传 0）
+ * @param data 数据指针
+ * @param len 数据长度
+ * @return 累计 CRC32
+ */
+inline uint32_t fromBuffer(uint32_t seed, const void* data, size_t len) {
+#ifdef __SWITCH__
+    return crc32CalculateWithSeed(seed, data, len);
+#else
+    return software(seed, data, len);
+#endif
+}
+
 /**
  * @brief 计算文件的 CRC32
  * @param path 文件路径
  * @param buf 读取缓冲区（调用方提供）
  * @param bufSize 缓冲区大小
  * @param token 可选的取消令牌
+ * @param bytes 可选，输出实际读取的字节数
  * @return 文件不存在或取消时返回 -1，成功时返回 0~0xFFFFFFFF
  */
-inline int64_t fromFile(const char* path, void* buf, size_t bufSize, std::stop_token* token = nullptr) {
+inline int64_t fromFile(const char* path, void* buf, size_t bufSize, std::stop_token* token = nullptr, int64_t* bytes = nullptr) {
+#ifdef __SWITCH__
     FsFileSystem* fs = fsdevGetDeviceFileSystem("sdmc:");
     if (!fs) return -1;
 
@@ -46,7 +105,53 @@ inline int64_t fromFile(const char* path, void* buf, size_t bufSize, std::stop_t
     }
 
     fsFileClose(&file);
+    if (bytes) *bytes = offset;
     return static_cast<int64_t>(crc);
+#else
+    fs::FileReader reader;
+    if (reader.open(path) != 0) return -1;
+
+    uint32_t crc = 0;
+    int64_t offset = 0;
+    while (true) {
+        if (token && token->stop_requested()) return -1;
+        size_t bytesRead = reader.read(buf, bufSize);
+        if (bytesRead == 0) break;
+        crc = software(crc, buf, bytesRead);
+        offset += static_cast<int64_t>(bytesRead);
+    }
+
+    if (bytes) *bytes = offset;
+    return static_cast<int64_t>(crc);
+#endif
 }
 
+/** @brief 批量计算中的单个文件 */
+struct FileTask {
+    std::string path;   // 文件路径
+    int64_t crc = -1;   // 计算结果，文件不存在、读取失败或取消时为 -1
+    int64_t bytes = 0;  // 实际读取的字节数
+};
+
+/** @brief 批量计算统计 */
+struct BatchStats {
+    int files = 0;       // 成功计算的文件数
+    int failed = 0;      // 失败或被取消的文件数
+    int64_t bytes = 0;   // 读取总字节数
+    int64_t micros = 0;  // 总耗时（微秒）
+
+    /** @brief 聚合吞吐（字节/秒） */
+    double bytesPerSec() const { return micros > 0 ? bytes * 1e6 / micros : 0.0; }
+};
+
+/**
+ * @brief 并发计算一批文件的 CRC32
+ * @param tasks 待计算文件，结果写回各元素
+ * @param token 取消令牌，取消后未开始的文件直接标记失败
+ * @param workers 并发数（含调用线程），小于 1 时按 1 处理
+ * @param progressCb 每完成一个文件回调一次（在工作线程中调用，须线程安全），可为空
+ * @return 批量统计
+ */
+BatchStats fromFiles(std::vector<FileTask>& tasks, std::stop_token token, int workers = batchWorkerCount, std::function<void(int done, int total)> progressCb = nullptr);
+
 } // namespace crc
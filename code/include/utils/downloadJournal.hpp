@@ -0,0 +1,76 @@
+/**
+ * downloadJournal - 断点续传的下载记录
+ * 每个未完成的下载文件旁有一个记录文件（下载路径 + ".journal"），记录来源地址、
+ * 服务器的校验标识（ETag / Last-Modified）、文件总大小，以及每个分段已确认写入的字节数及其 CRC32。
+ * 重新下载时按记录对每个未完成的分段发送 Range + If-Range 请求，从已确认的位置继续
+ *
+ * 已确认字节数只在 fflush 之后更新，记录之后的内容视为不可靠，续传时覆盖
+ *
+ * 文件格式（小端）：
+ *   "NXDJ" | u32 版本 | u16 长度 + 地址 | u16 长度 + ETag | u16 长度 + Last-Modified |
+ *   u64 总大小 | u32 期望 CRC32 | u32 分段数 | 分段 × (u64 起点 | u64 终点 | u64 已确认字节数 | u32 CRC32) |
+ *   u32 以上全部内容的 CRC32
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace downloadJournal {
+
+    /** @brief 文件中的一段连续区间 [start, end) */
+    struct Segment {
+        uint64_t start = 0; // 起点
+        uint64_t end = 0;   // 终点（不含），0 表示直到文件结束（总大小未知时只有一段）
+        uint64_t done = 0;  // 从起点开始已确认写入的字节数
+        uint32_t crc = 0;   // 已确认部分的 CRC32
+
+        /** @brief 是否已下载完 */
+        bool complete() const { return end > 0 && start + done >= end; }
+    };
+
+    /** @brief 一个未完成下载的记录 */
+    struct Journal {
+        std::string url;               // 下载地址（不同地址的记录不续传）
+        std::string etag;              // 服务器返回的 ETag
+        std::string lastModified;      // 服务器返回的 Last-Modified
+        uint64_t totalSize = 0;        // 文件总大小，0 表示未知
+        uint32_t expectedCrc = 0;      // 调用方给出的期望 CRC32，0 表示未知
+        std::vector<Segment> segments; // 各分段进度，按起点排序
+
+        /** @brief 续传时 If-Range 使用的校验标识（优先 ETag），没有时不能续传 */
+        const std::string& validator() const { return etag.empty() ? lastModified : etag; }
+    };
+
+    /**
+     * @brief 获取下载文件对应的记录文件路径
+     * @param filePath 下载文件路径
+     * @return 记录文件路径
+     */
+    std::string pathOf(const std::string& filePath);
+
+    /**
+     * @brief 读取记录
+     * @param filePath 下载文件路径
+     * @param journal 输出：记录内容
+     * @return 记录存在且校验通过时返回 true
+     */
+    bool load(const std::string& filePath, Journal& journal);
+
+    /**
+     * @brief 写入记录（整体覆盖，写坏的记录读取时校验失败，等同于没有记录）
+     * @param filePath 下载文件路径
+     * @param journal 记录内容
+     * @return 是否写入成功
+     */
+    bool save(const std::string& filePath, const Journal& journal);
+
+    /**
+     * @brief 删除记录
+     * @param filePath 下载文件路径
+     */
+    void remove(const std::string& filePath);
+
+} // namespace downloadJournal
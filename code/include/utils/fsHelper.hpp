@@ -1,11 +1,18 @@
 /**
  * fsHelper - 文件系统操作封装
- * 基于 libnx 原生 API，纯工具函数，不含业务逻辑
+ * 纯工具函数，不含业务逻辑，后端在编译期选择：
+ *   - Switch（__SWITCH__）：基于 libnx 原生 API，直接操作 sdmc:
+ *   - 其他平台：基于 POSIX API，以可配置的根目录模拟 sdmc:/（用于主机端构建与性能测试）
+ * 所有路径均为 SD 卡内的绝对路径（如 /mods2/...），由后端负责映射
  */
 
 #pragma once
 
+#ifdef __SWITCH__
 #include <switch.h>
+#else
+#include <dirent.h>
+#endif
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -28,6 +35,24 @@ struct FsPath {
 
 namespace fs {
 
+#ifndef __SWITCH__
+    /**
+     * @brief 设置 POSIX 后端的根目录（相当于 Switch 的 sdmc:/）
+     * 未设置时读取环境变量 NXMM_SD_ROOT，仍为空则使用当前目录下的 sdmc
+     * @param dir 主机上的根目录路径
+     */
+    void setRootDir(const std::string& dir);
+
+    /** @brief 获取 POSIX 后端当前的根目录 */
+    const std::string& rootDir();
+#endif
+
+    /**
+     * @brief 转为 C 标准库可直接打开的路径（Switch 原样返回，POSIX 后端拼接根目录）
+     * @param path SD 卡内的绝对路径
+     */
+    std::string nativePath(const FsPath& path);
+
     /**
      * @brief 目录是否存在
      * @param path 目录路径
@@ -47,7 +72,7 @@ namespace fs {
     bool ensureDir(const FsPath& path);
 
     /**
-     * @brief 单层创建目录，已存在返回 0，失败返回 libnx Result 错误码
+     * @brief 单层创建目录，已存在返回 0，失败返回错误码（libnx Result / POSIX errno）
      * @param path 目录路径
      */
     uint32_t createDir(const FsPath& path);
@@ -105,6 +130,27 @@ namespace fs {
      */
     int64_t getFileSize(const FsPath& path);
 
+    /** @brief 文件元数据 */
+    struct FileStat {
+        int64_t size = -1;   // 文件大小
+        uint64_t mtime = 0;  // 修改时间（Switch 为秒，其他平台为纳秒，只用于比较是否变化）
+    };
+
+    /** @brief FileStat::mtime 每秒的计数 */
+#ifdef __SWITCH__
+    inline constexpr uint64_t mtimeTicksPerSecond = 1;
+#else
+    inline constexpr uint64_t mtimeTicksPerSecond = 1000000000ull;
+#endif
+
+    /**
+     * @brief 获取文件大小与修改时间，不读取内容
+     * @param path 文件路径
+     * @param out 输出元数据
+     * @return 文件不存在或不是普通文件时返回 false
+     */
+    bool statFile(const FsPath& path, FileStat& out);
+
     /**
      * @brief 递归统计目录总大小（字节）
      * @param path 目录路径
@@ -142,7 +188,7 @@ namespace fs {
         int deletedCount;      // 已删除文件数量
         int totalCount;        // 扫描到的文件总数
         std::string errorPath; // FsError 时：失败的文件或目录完整路径
-        std::string errorCode; // FsError 时：libnx Result 十六进制字符串
+        std::string errorCode; // FsError 时：错误码十六进制字符串（libnx Result / POSIX errno）
         std::string elapsed;   // Completed 时：格式化后的耗时文本
     };
 
@@ -187,13 +233,21 @@ namespace fs {
     bool deleteEmptyDir(const FsPath& path);
 
     /**
-     * @brief 小文件一次性写入，成功返回 0，失败返回 libnx Result 错误码
+     * @brief 小文件一次性写入，成功返回 0，失败返回错误码（libnx Result / POSIX errno）
      * @param path 文件路径
      * @param data 数据指针
      * @param size 数据大小
      */
     uint32_t writeFile(const FsPath& path, const void* data, size_t size);
 
+    /**
+     * @brief 追加写入文件末尾（不存在时创建），写入后立即落盘，成功返回 0
+     * @param path 文件路径
+     * @param data 数据指针
+     * @param size 数据大小
+     */
+    uint32_t appendFile(const FsPath& path, const void* data, size_t size);
+
     /**
      * @brief 小文件一次性读取，失败返回空数组
      * @param path 文件路径
@@ -227,7 +281,11 @@ namespace fs {
         int64_t size() const { return m_size; }
 
     private:
+#ifdef __SWITCH__
         FsFile m_handle{};    // libnx 文件句柄
+#else
+        int m_fd = -1;        // POSIX 文件描述符
+#endif
         int64_t m_offset = 0; // 当前读取偏移
         int64_t m_size = 0;   // 文件总大小
         bool m_open = false;  // 句柄是否已打开
@@ -257,7 +315,11 @@ namespace fs {
         uint32_t write(const void* data, size_t size);
 
     private:
+#ifdef __SWITCH__
         FsFile m_handle{};    // libnx 文件句柄
+#else
+        int m_fd = -1;        // POSIX 文件描述符
+#endif
         int64_t m_offset = 0; // 当前写入偏移
         bool m_open = false;  // 句柄是否已打开
     };
@@ -288,7 +350,12 @@ namespace fs {
         void close();
 
     private:
+#ifdef __SWITCH__
         FsDir m_handle{};    // libnx 目录句柄
+#else
+        DIR* m_dir = nullptr; // POSIX 目录句柄
+        std::string m_path;   // 主机上的目录路径（读取条目类型和大小时使用）
+#endif
         bool m_open = false; // 句柄是否已打开
     };
 
@@ -49,19 +49,23 @@ struct Header {
     std::string value; // 字段值
 };
 
+struct Response;
+
 /** @brief HTTP 请求参数 */
 struct Request {
-    Method method = Method::Get;                            // 请求方法
-    std::string url;                                        // 请求地址
-    std::vector<Header> headers;                            // 请求头
-    std::vector<uint8_t> body;                              // 请求体（原始字节）
-    std::stop_token token = {};                             // 取消令牌
-    std::function<bool(size_t total, size_t now)> progress; // 进度回调，返回 false 可中断
+    Method method = Method::Get;                              // 请求方法
+    std::string url;                                          // 请求地址
+    std::vector<Header> headers;                              // 请求头
+    std::vector<uint8_t> body;                                // 请求体（原始字节）
+    std::stop_token token = {};                               // 取消令牌
+    std::function<bool(size_t total, size_t now)> progress;   // 进度回调，返回 false 可中断
+    std::function<bool(const Response& response)> onResponse; // 流式请求收到首块响应体前回调一次（状态码、响应头和最终地址已填好），返回 false 可中断
 };
 
 /** @brief HTTP 响应结果，只描述网络事实，不做业务成功判断 */
 struct Response {
     long statusCode = 0;         // HTTP 状态码（200、304、404 等），0 表示没有拿到响应
+    std::string url;             // 最终地址（跟随重定向后）
     int networkCode = 0;         // libcurl 结果码，0 表示网络层成功
     bool cancelled = false;      // 是否因 stop_token 取消
     std::string error;           // 网络层错误文本
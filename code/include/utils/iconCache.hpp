@@ -0,0 +1,92 @@
+/**
+ * iconCache - 已解码图标的磁盘缓存
+ * 游戏主页 / 添加游戏页的 NACP JPEG 图标和商店的 WebP 图标共用，保存解码并缩小后的 RGBA 像素，
+ * 再次启动或重新进入页面时直接读取像素上传纹理，不再解码
+ *
+ * 每个图标一个文件（缓存目录/键.rgba），文件内记录标签（NACP 版本号、商店 ETag 等），
+ * 标签与调用方当前的标签不一致时视为未命中，重新解码后覆盖
+ *
+ * 文件格式（小端）：
+ *   "NXIC" | u32 版本 | u16 长度 + 标签 | u16 宽 | u16 高 | RGBA 像素 × 宽 × 高 | u32 以上全部内容的 CRC32
+ */
+
+#pragma once
+
+#include "utils/imageDecoder.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string>
+
+namespace iconCache {
+
+    /** @brief 缓存像素的最大边长，超出时按比例缩小（NACP 图标原始尺寸，不损失清晰度） */
+    constexpr int maxSize = 256;
+
+    /** @brief 本次启动的命中统计 */
+    struct Stats {
+        int hits = 0;         // 命中次数
+        int misses = 0;       // 未命中（解码）次数
+        double readMs = 0;    // 命中时读取缓存的总耗时
+        double decodeMs = 0;  // 未命中时解码 + 缩小的总耗时
+
+        /** @brief 按本次平均解码耗时估算命中节省的时间（没有未命中时无法估算，返回 0） */
+        double savedMs() const { return misses > 0 ? hits * (decodeMs / misses) - readMs : 0; }
+    };
+
+    /**
+     * @brief 设置缓存目录，应用启动时调用一次
+     * @param dir 缓存目录，空串表示不使用磁盘缓存（load() 直接解码）
+     */
+    void setDir(const std::string& dir);
+
+    /**
+     * @brief 读取缓存像素，未命中时调用 decode 解码、缩小并写入缓存（线程安全）
+     * @param key 图标键（作为文件名，只含字母数字）
+     * @param tag 图标标签，与缓存记录不一致时重新解码
+     * @param decode 解码函数，返回空图像时不写缓存
+     * @return RGBA 像素（最大边长不超过 maxSize）
+     */
+    imageDecoder::DecodedImage load(const std::string& key, const std::string& tag, const std::function<imageDecoder::DecodedImage()>& decode);
+
+    /**
+     * @brief 读取缓存像素
+     * @param key 图标键
+     * @param tag 图标标签
+     * @param image 输出：RGBA 像素
+     * @return 文件存在、标签一致且校验通过时返回 true
+     */
+    bool read(const std::string& key, const std::string& tag, imageDecoder::DecodedImage& image);
+
+    /**
+     * @brief 写入缓存像素（临时文件 + 改名替换）
+     * @param key 图标键
+     * @param tag 图标标签
+     * @param image RGBA 像素
+     * @return 是否写入成功
+     */
+    bool write(const std::string& key, const std::string& tag, const imageDecoder::DecodedImage& image);
+
+    /**
+     * @brief 按区域平均把图像缩小到最大边长不超过 size（不超过时原样返回）
+     * @param image RGBA 像素
+     * @param size 最大边长
+     * @return 缩小后的图像
+     */
+    imageDecoder::DecodedImage downscale(imageDecoder::DecodedImage image, int size = maxSize);
+
+    /** @brief 获取本次启动的命中统计 */
+    Stats stats();
+
+    /** @brief 删除缓存目录 */
+    void clear();
+
+    /**
+     * @brief 获取缓存目录占用大小
+     * @param token 取消令牌
+     * @return 缓存占用字节数，取消时返回 -1
+     */
+    int64_t cacheSize(std::stop_token token = {});
+
+} // namespace iconCache
@@ -2,6 +2,13 @@
  * JsonFile - JSON 文件读写封装
  * 基于 yyjson，提供两层嵌套结构的通用读写接口
  * 不包含任何业务逻辑，纯 JSON 操作
+ *
+ * 加载时原地解析为不可变文档（字符串直接指向读入的缓冲区，不复制），只读场景不再转换；
+ * 第一次写入时才转为可变文档。写入值与原值相同时不算修改，没有修改的文件 save() 不会重写。
+ *
+ * 写文件经由 persistQueue：save() 同步等待写出，saveDeferred() 交给后台合并写入后立即返回。
+ * 两者都以临时文件 + 改名替换原文件；load() 优先读取队列中尚未写出的内容，
+ * 原文件缺失或损坏时回退到临时文件。
  */
 
 #pragma once
@@ -10,25 +17,45 @@
 #include <vector>
 
 // 前向声明 yyjson 类型，避免暴露 yyjson.h
+struct yyjson_doc;
 struct yyjson_mut_doc;
 
 class JsonFile {
 public:
-    JsonFile();
+    /** @brief 写出格式 */
+    enum class Format {
+        Pretty,  // 缩进格式（用户可能手动查看、编辑的文件）
+        Compact  // 紧凑格式（只由程序读写的文件）
+    };
+
+    /**
+     * @brief 构造 JSON 文件对象
+     * @param format 保存时的写出格式
+     */
+    explicit JsonFile(Format format = Format::Pretty);
     ~JsonFile();
 
     JsonFile(const JsonFile&) = delete;
     JsonFile& operator=(const JsonFile&) = delete;
 
     /**
-     * @brief 从文件加载 JSON
+     * @brief 从文件加载 JSON（写入队列中有该文件尚未写出的内容时以其为准）
      * @param path 文件路径
      */
     bool load(const std::string& path);
 
-    /** @brief 保存到文件 */
+    /**
+     * @brief 保存到文件（自加载 / 上次保存后没有修改时直接返回 true，不写文件）
+     * @return 是否成功
+     */
     bool save();
 
+    /** @brief 延迟保存：序列化后交给写入队列，不等待 SD 卡（界面交互使用；没有修改时不提交） */
+    void saveDeferred();
+
+    /** @brief 自加载 / 上次保存后是否有修改 */
+    bool isDirty() const;
+
     /**
      * @brief 读取字符串（rootKey → key）
      * @param rootKey 根键
@@ -122,9 +149,35 @@ public:
 
 private:
     std::string m_path;                // 当前加载或保存的文件路径
-    yyjson_mut_doc* m_doc = nullptr;   // yyjson 可变文档，由本对象持有
+    Format m_format;                   // 保存时的写出格式
+    std::vector<char> m_buffer;        // 原地解析的文件内容（不可变文档的字符串指向这里）
+    yyjson_doc* m_readDoc = nullptr;   // yyjson 不可变文档（加载后、首次写入前），由本对象持有
+    yyjson_mut_doc* m_doc = nullptr;   // yyjson 可变文档（首次写入时创建），由本对象持有
+    bool m_dirty = false;              // 自加载 / 上次保存后是否有修改
+
+    /** @brief 释放两种文档和读入缓冲区 */
+    void reset();
+
+    /**
+     * @brief 读取整个文件并原地解析
+     * @param path 文件路径
+     * @return 文件不存在、为空或解析失败时返回 false
+     */
+    bool readFile(const std::string& path);
+
+    /**
+     * @brief 原地解析 m_buffer（末尾须留出 YYJSON_PADDING_SIZE 个 0）
+     * @param size 内容字节数
+     */
+    bool parseBuffer(size_t size);
+
+    /**
+     * @brief 序列化当前文档（确保父目录存在）
+     * @param out 输出：文件内容
+     */
+    bool serialize(std::string& out);
 
-    /** @brief 确保文档已初始化 */
+    /** @brief 确保可变文档已初始化（已加载的不可变文档在此转换） */
     yyjson_mut_doc* ensureDoc();
 
     /**
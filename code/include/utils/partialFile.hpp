@@ -0,0 +1,104 @@
+/**
+ * PartialFile - 正在下载中的文件的只读视图
+ * 下载器每把一段数据写入文件就登记一次区间，读取方读取尚未写入的区间时阻塞等待，
+ * 下载结束（成功或失败）后不再等待。下载前另外取得的内容（如 ZIP 尾部的中央目录）
+ * 可以预先放入内存，读到这部分时直接从内存返回。
+ *
+ * 读取方使用自己的无缓冲文件句柄（FILE 缓冲可能预读到尚未写入的区域），
+ * 多个线程的读取在句柄上串行进行
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PartialFile {
+public:
+    /**
+     * @brief 创建视图（文件由下载器创建，首次从磁盘读取时才打开）
+     * @param path 文件路径
+     * @param size 文件总大小
+     */
+    PartialFile(std::string path, uint64_t size);
+
+    /** @brief 析构时关闭读取句柄 */
+    ~PartialFile();
+
+    /** @brief 禁止复制构造 */
+    PartialFile(const PartialFile&) = delete;
+
+    /** @brief 禁止复制赋值 */
+    PartialFile& operator=(const PartialFile&) = delete;
+
+    /** @brief 文件总大小 */
+    uint64_t size() const { return m_size; }
+
+    /** @brief 文件路径 */
+    const std::string& path() const { return m_path; }
+
+    /**
+     * @brief 放入下载前已取得的内容（须在开始读取前调用）
+     * @param offset 内容在文件中的起点
+     * @param data 内容
+     */
+    void preload(uint64_t offset, std::vector<uint8_t> data);
+
+    /** @brief 预先放入的内容 */
+    const std::vector<uint8_t>& preloaded() const { return m_preload; }
+
+    /** @brief 预先放入的内容在文件中的起点 */
+    uint64_t preloadOffset() const { return m_preloadOffset; }
+
+    /**
+     * @brief 登记已写入文件（已 fflush）的区间 [start, end)，唤醒等待的读取
+     * @param start 起点
+     * @param end 终点（不含）
+     */
+    void markWritten(uint64_t start, uint64_t end);
+
+    /**
+     * @brief 下载结束：成功时全部内容视为可读，失败时等待中的和之后的读取都返回 0
+     * 下载器从头重新下载时也以失败调用（已登记的区间作废），之后再次调用不会恢复
+     * @param success 下载是否成功
+     */
+    void finish(bool success);
+
+    /** @brief 下载是否已失败 */
+    bool failed() const;
+
+    /**
+     * @brief 读取指定区间，内容尚未写入时阻塞等待
+     * @param offset 起点
+     * @param buf 缓冲区
+     * @param size 读取字节数
+     * @return 实际读取字节数，下载失败或读文件出错时返回 0
+     */
+    size_t read(uint64_t offset, void* buf, size_t size);
+
+private:
+    std::string m_path;                                  // 文件路径
+    uint64_t m_size;                                     // 文件总大小
+    uint64_t m_preloadOffset = 0;                        // 预先放入的内容的起点
+    std::vector<uint8_t> m_preload;                      // 预先放入的内容
+
+    mutable std::mutex m_mutex;                          // 保护以下区间与状态
+    std::condition_variable m_written;                   // 有新区间写入或下载结束
+    std::vector<std::pair<uint64_t, uint64_t>> m_ranges; // 已写入的区间（按起点排序、相邻合并）
+    bool m_finished = false;                             // 下载已结束
+    bool m_failed = false;                               // 下载失败
+
+    std::mutex m_readMutex;                              // 串行化磁盘读取
+    FILE* m_fp = nullptr;                                // 读取句柄（无缓冲）
+
+    /** @brief [start, end) 是否都已写入或预先放入 */
+    bool readyLocked(uint64_t start, uint64_t end) const;
+
+    /** @brief 从磁盘读取 [offset, offset + size) */
+    size_t readDisk(uint64_t offset, void* buf, size_t size);
+};
@@ -0,0 +1,76 @@
+/**
+ * persistQueue - 元数据文件的合并写入队列
+ * JsonFile 等把序列化好的完整文件内容交给队列，由唯一的后台线程写到 SD 卡：
+ *   - 延迟写入（submit）：同一路径尚未写出的旧内容直接被新内容替换，
+ *     最后一次提交后静默 debounceMs 才开始写，连续点击只写一次，界面不等待 SD 卡；
+ *   - 同步写入（write）：排在已提交的写入之后执行并等待完成，保证同一路径不会被旧内容覆盖；
+ *   - 生命周期边界（失去焦点 / 退出）调用 flush() 立即写出全部待写内容。
+ *
+ * 顺序：同一路径按提交顺序生效（只写最新内容）；不同路径按首次进入队列的顺序写出。
+ * 读己之写：写出完成前，pending() 返回最新内容，JsonFile::load 优先使用。
+ *
+ * 每个文件都先写到 path + ".tmp"，再删除原文件并改名（libnx 改名不能覆盖），
+ * 任何时刻原文件或临时文件至少有一个完整；读取方在原文件缺失或损坏时回退到临时文件。
+ * 后台写出时父目录已不存在（目录在等待期间被删除）则放弃该文件，不会重新创建目录。
+ */
+
+#pragma once
+
+#include <string>
+
+namespace persistQueue {
+
+    /** @brief 最后一次延迟提交后等待的毫秒数 */
+    constexpr int debounceMs = 500;
+
+    /**
+     * @brief 以临时文件 + 改名的方式替换文件（调用线程直接写）
+     * @param path 文件路径
+     * @param data 完整文件内容
+     * @return 是否成功
+     */
+    bool writeAtomic(const std::string& path, const std::string& data);
+
+    /**
+     * @brief 获取原子替换使用的临时文件路径
+     * @param path 文件路径
+     * @return 临时文件路径
+     */
+    std::string tempPath(const std::string& path);
+
+    /**
+     * @brief 提交延迟写入（线程安全，不等待）
+     * @param path 文件路径（父目录须已存在）
+     * @param data 完整文件内容
+     */
+    void submit(const std::string& path, std::string data);
+
+    /**
+     * @brief 同步写入：排在已提交的写入之后执行，等待该路径写出完成（线程安全）
+     * @param path 文件路径（父目录须已存在）
+     * @param data 完整文件内容
+     * @return 是否成功
+     */
+    bool write(const std::string& path, std::string data);
+
+    /**
+     * @brief 获取尚未写出（含正在写出）的最新内容
+     * @param path 文件路径
+     * @param data 输出：最新内容
+     * @return 有待写内容时返回 true
+     */
+    bool pending(const std::string& path, std::string& data);
+
+    /**
+     * @brief 立即写出全部待写内容
+     * @param wait 是否等待写出完成
+     */
+    void flush(bool wait = true);
+
+    /** @brief 后台线程累计写出的文件数（统计用，同步写入也经由后台线程） */
+    int writeCount();
+
+    /** @brief 写出全部待写内容并停止后台线程（退出时调用，之后的写入直接在调用线程完成） */
+    void shutdown();
+
+} // namespace persistQueue
@@ -0,0 +1,64 @@
+/**
+ * pinYinCache - 拼音转换结果的持久化缓存
+ * GameManager / ModManager 排序与 SearchEngine 搜索共用，名称按 64 位哈希索引，
+ * 一次转换同时得到排序键和搜索 token，跨页面、跨启动复用
+ *
+ * 首次查询时才读取缓存文件；新转换的名称先记在内存，flush() 时追加到文件末尾。
+ * 文件条目超过上限时只保留本次启动用到的名称重写文件。
+ *
+ * 文件格式（小端）：
+ *   "NXPY" | u32 版本
+ *   记录 × N：u64 名称哈希 | u16 长度 + 排序键 | u8 token 数 | (u8 长度 + token) × n | u32 本条记录 CRC32
+ *   （读到第一条残缺或校验失败的记录即停止，其后的内容在下次写入时丢弃）
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace pinYinCache {
+
+    /** @brief 单个名称的拼音转换结果 */
+    struct Entry {
+        std::string sortKey;             // 排序键（全文拼音，大写）
+        std::vector<std::string> tokens; // 搜索 token，只含字母数字并大写（如 ["BAO", "KE", "MENG"]）
+    };
+
+    /**
+     * @brief 设置缓存文件路径（不立即读取），应用启动时调用一次
+     * @param path 缓存文件路径，空串表示只在内存中缓存
+     */
+    void setPath(const std::string& path);
+
+    /**
+     * @brief 查询名称的拼音转换结果，未命中时转换并记入缓存（线程安全）
+     * @param text 原始名称
+     * @return 缓存条目，引用在 unload() 之前一直有效
+     */
+    const Entry& get(const std::string& text);
+
+    /**
+     * @brief 查询名称的排序键
+     * @param text 原始名称
+     * @return 排序键
+     */
+    inline const std::string& sortKey(const std::string& text) { return get(text).sortKey; }
+
+    /**
+     * @brief 查询名称的搜索 token
+     * @param text 原始名称
+     * @return token 列表
+     */
+    inline const std::vector<std::string>& tokens(const std::string& text) { return get(text).tokens; }
+
+    /**
+     * @brief 把新转换的名称写回缓存文件（无新内容时直接返回）
+     * @return 是否写入成功
+     */
+    bool flush();
+
+    /** @brief 丢弃内存中的缓存（之前返回的引用全部失效），下次查询时重新读取文件 */
+    void unload();
+
+} // namespace pinYinCache
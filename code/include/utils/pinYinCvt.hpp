@@ -12,6 +12,12 @@ namespace pinYinCvt {
     /** @brief 初始化拼音引擎（加载字典），应用启动时调用一次 */
     void init();
 
+    /**
+     * @brief 拼音引擎是否已初始化（未初始化时转换函数原样返回输入）
+     * @return 已初始化返回 true
+     */
+    bool isReady();
+
     /**
      * @brief 中文转拼音（无声调），非中文字符原样保留
      * @param text 输入文本
@@ -1,14 +1,18 @@
 /**
  * SearchEngine - 通用搜索引擎
- * 支持原文匹配和拼音混合匹配（全拼/首字母可任意组合）
- * 拼音结果按需计算并缓存（memoization）
+ * 支持原文匹配和拼音混合匹配（每个拼音 token 可取任意非空前缀：首字母、全拼或部分拼写，可任意组合）
+ *
+ * setItems() 为数据源建立一次索引（大写原文、拼音拼接串、token 起点、首字母串），
+ * 名称的拼音 token 取自 pinYinCache（与排序共用，跨启动持久化）。
+ * 匹配规则保证关键词变长时命中集合只会缩小，因此续写关键词时只复查上一次的命中项，
+ * 删除字符时直接取回之前对应关键词的命中结果。结果按匹配质量排序，同质量保持数据源顺序。
  */
 
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 class SearchEngine {
@@ -20,36 +24,62 @@ public:
     };
 
     /**
-     * @brief 搜索：对 items 做匹配，返回最多 maxResults 条结果
-     * @param keyword 搜索关键词
+     * @brief 设置搜索数据源并建立索引（清空增量搜索状态）
      * @param items 待搜索列表
-     * @param maxResults 最大返回数
+     */
+    void setItems(std::vector<std::string> items);
+
+    /**
+     * @brief 搜索：返回按匹配质量排序的前 maxResults 条结果
+     * @param keyword 搜索关键词
+     * @param maxResults 最大返回数（小于 0 表示不限）
      * @return 匹配到的搜索结果
      */
-    std::vector<Result> search(const std::string& keyword, const std::vector<std::string>& items, int maxResults = 6);
+    std::vector<Result> search(const std::string& keyword, int maxResults = 6);
 
 private:
-    /** @brief 单个名称的拼音缓存 */
-    struct PinyinCache {
-        std::vector<std::string> tokens; // 每个拼音 token，全大写（如 ["BAO", "KE", "MENG"]）
+    /** @brief 单个名称的索引 */
+    struct Entry {
+        std::string upperName;           // 原文大写（ASCII）
+        std::string pinyin;              // 全部拼音 token 拼接（如 "BAOKEMENG"）
+        std::string initials;            // 各 token 首字母（如 "BKM"）
+        std::vector<uint16_t> tokenEnds; // 各 token 在 pinyin 中的结束位置
     };
 
-    std::unordered_map<std::string, PinyinCache> m_cache; // memoization 缓存
+    /** @brief 一次关键词的命中记录（增量搜索用） */
+    struct Level {
+        std::string upperKeyword;   // 原文大写关键词
+        std::string pinyinKeyword;  // 拼音关键词（只含大写字母数字）
+        std::vector<int> hits;      // 全部命中项下标（升序）
+        std::vector<uint8_t> ranks; // 与 hits 对应的匹配质量（越小越好）
+    };
+
+    std::vector<std::string> m_items;  // 数据源
+    std::vector<Entry> m_entries;      // 与 m_items 一一对应的索引
+    std::vector<Level> m_levels;       // 逐级续写的关键词命中记录，栈底为最短关键词
+    std::vector<int> m_reach;          // 拼音匹配的状态数组（当前 / 下一 token 两段，复用避免每项分配）
 
     /**
-     * @brief 按需计算并缓存拼音
-     * @param name 原始名称
-     * @return 名称对应的拼音缓存
+     * @brief 取关键词的命中记录：命中缓存直接返回，否则在可复用的上一级命中内匹配
+     * @param keyword 搜索关键词（非空）
+     * @return 命中记录
      */
-    const PinyinCache& getPinyinCache(const std::string& name);
+    const Level& match(const std::string& keyword);
 
     /**
-     * @brief 混合匹配：递归尝试全拼或首字母消费
-     * @param keyword 搜索关键词
-     * @param tokens 拼音 token 列表
-     * @param keywordPos keyword 当前位置
-     * @param tokenPos tokens 当前位置
-     * @return 是否匹配成功
+     * @brief 计算单个名称的匹配质量
+     * @param entry 名称索引
+     * @param level 当前关键词（只读取两个关键词字段）
+     * @return 匹配质量，不匹配返回 UINT8_MAX
+     */
+    uint8_t rankOf(const Entry& entry, const Level& level);
+
+    /**
+     * @brief 拼音匹配：关键词能否切分为从某个 token 起连续若干 token 的非空前缀
+     * 迭代状态转移（m_reach[j] 为已消费关键词前 j 个字符时最早的起始 token），无回溯
+     * @param entry 名称索引
+     * @param keyword 拼音关键词
+     * @return 最早可匹配的起始 token，不匹配返回 -1
      */
-    static bool mixedMatch(const std::string& keyword, const std::vector<std::string>& tokens, size_t keywordPos, size_t tokenPos);
+    int pinyinMatch(const Entry& entry, const std::string& keyword);
 };
@@ -0,0 +1,73 @@
+/**
+ * segmentDownload - 分段并发、可断点续传的文件下载
+ *
+ * 首个请求总是带 Range: bytes=<起点>-：服务器返回 206 时得知支持分段和文件总大小，返回 200 时按单连接下载。
+ * 支持分段时按观察到的吞吐逐个增加连接：每加一个连接，从剩余最多的分段后半截拆出一段交给新连接，
+ * 加连接后吞吐提升不足 15% 时不再增加。被拆分的连接写到缩短后的终点时自行断开，
+ * 先下完的连接继续拆分剩余最多的分段，尾部不会只剩一个连接。
+ *
+ * 各连接把数据攒到 256KB 后按偏移写入预分配的文件（共用一个 FILE，加锁 fseek + fwrite），
+ * 进度合并后在调用线程回调。分段请求使用首个请求重定向后的最终地址，不重复经过 API 服务器。
+ * 分段请求收到 200（服务器忽略 Range 或文件已变化）时退回单连接从头下载。
+ *
+ * 各分段进度记录在 downloadJournal 中，中断后以相同地址再次下载时每个分段从已确认的位置继续。
+ * 网络中断时各连接分别重试；某个连接放弃的分段由其他连接接手
+ *
+ * 调用方可以通过 onWritten 得知哪些区间已经落盘（边下载边读取，见 PartialFile）
+ *
+ * 各连接在写入时顺带计算分段的 CRC32（续传的分段沿用记录中的值），完成后按偏移合并为整个文件的 CRC32，
+ * 不重新读取文件。调用方给出期望 CRC32 时核对，不一致时删除文件和记录并返回 checksumMismatch
+ */
+
+#pragma once
+
+#include "utils/http.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace segmentDownload {
+
+inline constexpr int defaultConnections = 4;                  // 默认最大并发连接数
+inline constexpr int maxTotalConnections = 8;                 // 进程内所有下载合计的连接上限，达到后不再增加连接（每个下载至少保留一个）
+inline constexpr uint64_t minSegmentSize = 4 * 1024 * 1024;   // 拆分后每段的最小大小（小于两倍的文件不分段）
+inline constexpr int maxAttempts = 4;                         // 每个连接连续网络失败的最大次数
+inline constexpr int checksumMismatch = -1;                   // 下载完成但 CRC32 与期望不符时的 networkCode（libcurl 结果码均不为负）
+
+/** @brief 一次下载的统计 */
+struct Stats {
+    int connections = 0; // 同时工作的最大连接数
+    int requests = 0;    // 发出的请求数
+    int segments = 0;    // 最终的分段数
+    uint32_t crc32 = 0;  // 成功时整个文件的 CRC32
+};
+
+/**
+ * @brief 区间落盘回调：[start, end) 已写入文件并 fflush，在写入的连接线程中调用（持有下载器的锁，须尽快返回）
+ * 续传时已确认的区间在开始时先回调一次
+ */
+using WrittenCallback = std::function<void(uint64_t start, uint64_t end)>;
+
+/**
+ * @brief 从头重新下载回调：此前通过 WrittenCallback 登记的区间全部作废（文件将被截断或覆盖），
+ * 在丢弃已写入内容前调用（可能持有下载器的锁，须尽快返回）
+ */
+using RestartCallback = std::function<void()>;
+
+/**
+ * @brief 下载到文件
+ * 失败时：服务器支持续传且已写入内容的，保留不完整文件和记录供下次续传；否则删除不完整文件
+ * @param request 请求模板（地址、请求头、取消令牌、进度回调），进度回调在调用线程中执行，
+ *                服务器开始返回文件内容后才回调（重定向等前置阶段不回调；总大小未知时 total 为 0）
+ * @param path 保存路径
+ * @param connections 最大并发连接数，1 表示只用单连接
+ * @param stats 可选，输出统计
+ * @param onWritten 可选，区间落盘回调
+ * @param expectedCrc 期望的 CRC32，0 表示不核对（续传记录的期望值不同时从头下载）
+ * @param onRestart 可选，从头重新下载回调
+ * @return 最终的 HTTP 响应（成功时为首个被接受的响应，不含响应体）
+ */
+http::Response toFile(const http::Request& request, const std::string& path, int connections = defaultConnections, Stats* stats = nullptr, const WrittenCallback& onWritten = nullptr, uint32_t expectedCrc = 0, const RestartCallback& onRestart = nullptr);
+
+} // namespace segmentDownload
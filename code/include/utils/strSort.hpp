@@ -1,46 +1,85 @@
 /**
  * strSort - 字符串排序工具
  * 基于拼音的多语言排序（中文按拼音，英文直接，其他按 Unicode）
- * 内部自动预计算排序键，调用方无需关心缓存细节
+ *
+ * 每个元素只计算一次排序键：分组字段打包为 64 位整数，名称取拼音排序键及其前 8 字节，
+ * 排序在紧凑的键数组上进行，多数比较只比两个整数；排好后按下标一次性重排元素。
+ * 名称相同的元素各自保有排序键，按原顺序排列。拼音排序键取自 pinYinCache，见过的名称不再转换。
  */
 
 #pragma once
 
-#include "utils/pinYinCvt.hpp"
+#include "utils/pinYinCache.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace strSort {
 
+    /** @brief 单个元素的预计算排序键 */
+    struct Key {
+        uint64_t group = 0;   // 打包的分组字段，小者在前
+        uint64_t prefix = 0;  // 名称排序键前 8 字节（大端，不足补 0）
+        uint32_t index = 0;   // 元素原始下标，同时索引完整名称排序键
+    };
+
     /**
-     * @brief 构建拼音缓存
-     * @param items 待排序列表
-     * @param getName 从元素提取排序字符串的成员指针或 lambda
-     * @return 名称与拼音排序键的映射
+     * @brief 取名称排序键前 8 字节打包为大端整数，整数大小与字节序比较一致
+     * @param sortKey 名称排序键
+     * @return 打包后的前缀
      */
-    template<typename T, typename GetName>
-    std::unordered_map<std::string, std::string> buildCache(const std::vector<T>& items, GetName getName) {
-        std::unordered_map<std::string, std::string> cache;
-        for (const auto& item : items) {
-            const auto& name = std::invoke(getName, item);
-            cache.emplace(name, pinYinCvt::getSortKey(name));
+    inline uint64_t namePrefix(const std::string& sortKey) {
+        uint64_t prefix = 0;
+        size_t len = std::min<size_t>(sortKey.size(), 8);
+        for (size_t i = 0; i < 8; ++i) {
+            prefix <<= 8;
+            if (i < len) prefix |= static_cast<unsigned char>(sortKey[i]);
         }
-        return cache;
+        return prefix;
+    }
+
+    /**
+     * @brief 按排好序的键重排元素
+     * @param items 待重排列表
+     * @param keys 排好序的键
+     */
+    template<typename T>
+    void applyOrder(std::vector<T>& items, const std::vector<Key>& keys) {
+        std::vector<T> sorted;
+        sorted.reserve(items.size());
+        for (const auto& key : keys) sorted.push_back(std::move(items[key.index]));
+        items = std::move(sorted);
     }
 
     /**
-     * @brief 用缓存比较两个名字
-     * @param cache 拼音缓存
-     * @param a 名字 a
-     * @param b 名字 b
-     * @return a 的排序键小于 b 时返回 true，否则返回 false
+     * @brief 按预计算键排序：分组升序 → 名称 → 原顺序
+     * @param items 待排序列表
+     * @param getSortKey 返回元素的名称排序键（已转换的拼音键，每个元素调用一次）
+     * @param getGroup 返回元素的打包分组值（uint64_t，小者在前，每个元素调用一次）
+     * @param ascending 名称方向：true=A-Z, false=Z-A（不影响分组方向）
      */
-    inline bool compareByCache(const std::unordered_map<std::string, std::string>& cache, const std::string& a, const std::string& b) {
-        return cache.at(a) < cache.at(b);
+    template<typename T, typename GetSortKey, typename GetGroup>
+    void sortByKey(std::vector<T>& items, GetSortKey getSortKey, GetGroup getGroup, bool ascending = true) {
+        std::vector<std::string> names;
+        std::vector<Key> keys(items.size());
+        names.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            names.push_back(std::invoke(getSortKey, items[i]));
+            keys[i].group = std::invoke(getGroup, items[i]);
+            keys[i].prefix = namePrefix(names.back());
+            keys[i].index = static_cast<uint32_t>(i);
+        }
+
+        std::sort(keys.begin(), keys.end(), [&names, ascending](const Key& a, const Key& b) {
+            if (a.group != b.group) return a.group < b.group;
+            int cmp = a.prefix != b.prefix ? (a.prefix < b.prefix ? -1 : 1) : names[a.index].compare(names[b.index]);
+            if (cmp != 0) return ascending ? cmp < 0 : cmp > 0;
+            return a.index < b.index;
+        });
+        applyOrder(items, keys);
     }
 
     /**
@@ -51,12 +90,8 @@ namespace strSort {
      */
     template<typename T, typename GetName>
     void sortAZ(std::vector<T>& items, GetName getName, bool ascending = true) {
-        auto cache = buildCache(items, getName);
-        std::sort(items.begin(), items.end(), [&](const T& a, const T& b) {
-            return ascending
-                ? cache[std::invoke(getName, a)] < cache[std::invoke(getName, b)]
-                : cache[std::invoke(getName, a)] > cache[std::invoke(getName, b)];
-        });
+        sortByKey(items, [&](const T& item) -> const std::string& { return pinYinCache::sortKey(std::invoke(getName, item)); },
+                  [](const T&) { return uint64_t{0}; }, ascending);
     }
 
     /**
@@ -68,19 +103,13 @@ namespace strSort {
      */
     template<typename T, typename GetName, typename GroupBy>
     void sortAZ(std::vector<T>& items, GetName getName, GroupBy groupBy, bool ascending = true) {
-        auto cache = buildCache(items, getName);
-        std::sort(items.begin(), items.end(), [&](const T& a, const T& b) {
-            auto ga = std::invoke(groupBy, a);
-            auto gb = std::invoke(groupBy, b);
-            if (ga != gb) return ga > gb;
-            return ascending
-                ? cache[std::invoke(getName, a)] < cache[std::invoke(getName, b)]
-                : cache[std::invoke(getName, a)] > cache[std::invoke(getName, b)];
-        });
+        sortByKey(items, [&](const T& item) -> const std::string& { return pinYinCache::sortKey(std::invoke(getName, item)); },
+                  [&](const T& item) { return std::invoke(groupBy, item) ? uint64_t{0} : uint64_t{1}; }, ascending);
     }
 
     /**
      * @brief 三级排序：bool 分组 + 可比较分组 + 拼音
+     * 二级分组值先去重排序得到名次，再与一级分组打包进同一个整数
      * @param items 待排序列表
      * @param getName 从元素提取排序字符串
      * @param group1 一级分组条件（bool）
@@ -90,18 +119,19 @@ namespace strSort {
     template<typename T, typename GetName, typename Group1, typename Group2,
              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Group2>, bool>>>
     void sortAZ(std::vector<T>& items, GetName getName, Group1 group1, Group2 group2, bool ascending = true) {
-        auto cache = buildCache(items, getName);
-        std::sort(items.begin(), items.end(), [&](const T& a, const T& b) {
-            auto ga = std::invoke(group1, a);
-            auto gb = std::invoke(group1, b);
-            if (ga != gb) return ga > gb;
-            auto sa = std::invoke(group2, a);
-            auto sb = std::invoke(group2, b);
-            if (sa != sb) return sa < sb;
-            return ascending
-                ? cache[std::invoke(getName, a)] < cache[std::invoke(getName, b)]
-                : cache[std::invoke(getName, a)] > cache[std::invoke(getName, b)];
-        });
+        using Value = std::decay_t<std::invoke_result_t<Group2, const T&>>;
+        std::vector<Value> ranks;
+        ranks.reserve(items.size());
+        for (const auto& item : items) ranks.push_back(std::invoke(group2, item));
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+        sortByKey(items, [&](const T& item) -> const std::string& { return pinYinCache::sortKey(std::invoke(getName, item)); },
+                  [&](const T& item) {
+                      uint64_t first = std::invoke(group1, item) ? 0 : 1;
+                      uint64_t rank = std::lower_bound(ranks.begin(), ranks.end(), std::invoke(group2, item)) - ranks.begin();
+                      return first << 32 | rank;
+                  }, ascending);
     }
 
 } // namespace strSort
@@ -2,15 +2,27 @@
  * ZipReader - ZIP 读取封装
  * 基于 miniz，RAII 管理 ZIP 句柄，构造时打开，析构时关闭
  * 仅负责读取，不涉及任何写盘操作
+ *
+ * 并行解压：
+ *   ZipReader 本身只有一个 miniz 句柄，同一时刻只能解码一个条目。
+ *   需要多线程解压时，由 openCursor 为每个线程创建独立的 ZipCursor，
+ *   条目列表仍使用 ZipReader 缓存的 files()，条目下标在各游标间通用。
+ *
+ * 边下载边读取：
+ *   以 PartialFile 构造时，中央目录取自预先放入的尾部内容，条目数据读到尚未下载的区间时阻塞等待，
+ *   下载失败时读取失败。游标共用同一个 PartialFile。
  */
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
 #include <miniz.h>
 
+class PartialFile;
+
 /** @brief ZIP 文件条目信息（从中央目录读取，不含目录条目） */
 struct ZipEntry {
     std::string path;         // ZIP 内相对路径
@@ -19,6 +31,71 @@ struct ZipEntry {
     int index;                // miniz 文件索引
 };
 
+/**
+ * @brief 独立解码游标
+ * 持有自己的文件句柄与 miniz 状态，多个游标可在不同线程并行解压同一 ZIP 的不同条目；
+ * 单个游标不可跨线程同时使用
+ */
+class ZipCursor {
+public:
+    /**
+     * @brief 打开 ZIP 文件（不排序中央目录，只按条目下标访问）
+     * @param zipPath ZIP 文件路径
+     */
+    ZipCursor(const std::string& zipPath);
+
+    /**
+     * @brief 打开正在下载中的 ZIP（不排序中央目录，只按条目下标访问）
+     * @param source 下载中的文件
+     */
+    ZipCursor(std::shared_ptr<PartialFile> source);
+
+    /** @brief 析构时自动关闭 ZIP 文件 */
+    ~ZipCursor();
+
+    /** @brief 禁止复制构造 */
+    ZipCursor(const ZipCursor&) = delete;
+
+    /** @brief 禁止复制赋值 */
+    ZipCursor& operator=(const ZipCursor&) = delete;
+
+    /** @brief ZIP 文件是否成功打开 */
+    bool isOpen() const;
+
+    /**
+     * @brief 将指定条目一次性解压到外部缓冲区
+     * @param entry ZIP 文件条目（来自 ZipReader::files）
+     * @param buf 缓冲区
+     * @param bufSize 缓冲区大小
+     * @return 实际解压字节数，0 表示失败
+     */
+    size_t readFile(const ZipEntry& entry, void* buf, size_t bufSize);
+
+    /**
+     * @brief 开始流式读取指定条目
+     * @param entry ZIP 文件条目（来自 ZipReader::files）
+     * @return 是否成功创建流式读取器
+     */
+    bool beginRead(const ZipEntry& entry);
+
+    /**
+     * @brief 读取一块数据
+     * @param buf 缓冲区
+     * @param bufSize 缓冲区大小
+     * @return 实际读取字节数，0 表示读完或出错
+     */
+    size_t read(void* buf, size_t bufSize);
+
+    /** @brief 结束当前流式读取，释放内部迭代器 */
+    void endRead();
+
+private:
+    std::shared_ptr<PartialFile> m_source;            // 下载中的文件（按路径打开时为空）
+    mz_zip_archive m_archive{};                       // miniz ZIP 句柄
+    bool m_open = false;                              // ZIP 文件是否成功打开
+    mz_zip_reader_extract_iter_state* m_iter = nullptr; // 当前流式读取迭代器
+};
+
 class ZipReader {
 public:
     /**
@@ -27,6 +104,12 @@ public:
      */
     ZipReader(const std::string& zipPath);
 
+    /**
+     * @brief 从正在下载中的 ZIP 的中央目录缓存所有条目信息
+     * @param source 下载中的文件（须已预先放入包含中央目录的尾部内容）
+     */
+    ZipReader(std::shared_ptr<PartialFile> source);
+
     /** @brief 析构时自动关闭 ZIP 文件 */
     ~ZipReader();
 
@@ -45,6 +128,12 @@ public:
     /** @brief 获取所有路径安全的目录路径（构造时已去重排序，不含尾斜杠） */
     const std::vector<std::string>& dirs() const;
 
+    /**
+     * @brief 为并行解压创建独立游标（各自打开文件句柄）
+     * @return 游标，打开失败时 isOpen() 为 false
+     */
+    std::unique_ptr<ZipCursor> openCursor() const;
+
     /**
      * @brief 将指定条目一次性解压到外部缓冲区
      * @param entry ZIP 文件条目
@@ -73,9 +162,14 @@ public:
     void endRead();
 
 private:
+    std::string m_path;                               // ZIP 文件路径（创建游标使用）
+    std::shared_ptr<PartialFile> m_source;            // 下载中的文件（按路径打开时为空）
     mz_zip_archive m_archive{};                       // miniz ZIP 句柄
     bool m_open = false;                              // ZIP 文件是否成功打开
     std::vector<ZipEntry> m_files;                    // 路径安全的文件条目
     std::vector<std::string> m_dirs;                  // 路径安全的目录列表
     mz_zip_reader_extract_iter_state* m_iter = nullptr; // 当前流式读取迭代器
+
+    /** @brief 读取中央目录，缓存路径安全的文件条目与目录 */
+    void loadEntries();
 };
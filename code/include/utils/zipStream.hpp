@@ -0,0 +1,46 @@
+/**
+ * zipStream - 边下载边读取的 ZIP 下载
+ *
+ * 先用 Range: bytes=-<尾部大小> 取回 ZIP 尾部（EOCD 与中央目录，ZIP64 时含 ZIP64 EOCD，
+ * 中央目录超出尾部时再补取一次），放入 PartialFile 后立即交给调用方，再用 segmentDownload 下载整个文件。
+ * 调用方拿到 PartialFile 后即可构造 ZipReader 列出条目并开始解压，
+ * 读到尚未下载的区间时等待，下载完成或失败时唤醒。
+ *
+ * 服务器不支持 Range、文件不是 ZIP 或中央目录过大时不交给调用方，只下载文件。
+ * 下载完成后核对预先取回的尾部与文件中的内容，不一致（下载期间文件被替换）时按下载失败通知读取方；
+ * 条目数据本身由 ZIP 的 CRC32 校验
+ */
+
+#pragma once
+
+#include "utils/http.hpp"
+#include "utils/partialFile.hpp"
+#include "utils/segmentDownload.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace zipStream {
+
+inline constexpr uint64_t tailSize = 64 * 1024 + 22;              // 首次取回的尾部大小（EOCD 最长注释 + EOCD 本身）
+inline constexpr uint64_t maxCentralDirectory = 16 * 1024 * 1024; // 中央目录超过此大小时不边下载边读取
+
+/** @brief 取得中央目录后的回调，在下载线程中调用 */
+using OpenedCallback = std::function<void(std::shared_ptr<PartialFile> file)>;
+
+/**
+ * @brief 下载 ZIP 到文件，取得中央目录后先回调 onOpened，再下载整个文件
+ * 回调返回后才开始下载；下载结束时 PartialFile 已标记成功或失败
+ * @param request 请求模板（地址、请求头、取消令牌、进度回调）
+ * @param path 保存路径
+ * @param onOpened 取得中央目录后的回调（不支持边下载边读取时不调用）
+ * @param connections 最大并发连接数
+ * @param stats 可选，输出统计（含整个文件的 CRC32）
+ * @param expectedCrc 期望的 CRC32，0 表示不核对；不一致时按下载失败通知读取方
+ * @return 下载的最终 HTTP 响应
+ */
+http::Response toFile(const http::Request& request, const std::string& path, const OpenedCallback& onOpened, int connections = segmentDownload::defaultConnections, segmentDownload::Stats* stats = nullptr, uint32_t expectedCrc = 0);
+
+} // namespace zipStream
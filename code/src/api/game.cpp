@@ -26,9 +26,7 @@ NameResult fetchName(const std::string& tid, std::stop_token token) {
     return {true, "", name};
 }
 
-GameListResult fetchGameList(int page, int limit, const std::string& keyword, std::stop_token token) {
-    auto request = api::utils::makeRequest(http::Method::Get, url::game::list(page, limit, keyword), token);
-    auto resp = http::requestToMemory(request);
+GameListResult parseGameList(const http::Response& resp) {
     if (!api::utils::isOk(resp)) return {false, api::utils::responseErrorMessage(resp)};
 
     JsonResp json(resp);
@@ -50,31 +48,17 @@ GameListResult fetchGameList(int page, int limit, const std::string& keyword, st
     return result;
 }
 
+GameListResult fetchGameList(int page, int limit, const std::string& keyword, std::stop_token token) {
+    auto request = api::utils::makeRequest(http::Method::Get, url::game::list(page, limit, keyword), token);
+    return parseGameList(http::requestToMemory(request));
+}
+
 GameListResult fetchInstalledGameList(int page, int limit, const std::string& keyword, const std::string& tidsJson, bool returnInstalled, std::stop_token token) {
     std::string body = "{\"tids\":" + tidsJson + ",\"returnInstalled\":" + (returnInstalled ? "true" : "false") + '}';
 
     auto request = api::utils::makeRequest(http::Method::Post, url::game::installed(page, limit, keyword), token);
     api::utils::setTextBody(request, body, "application/json");
-    auto resp = http::requestToMemory(request);
-    if (!api::utils::isOk(resp)) return {false, api::utils::responseErrorMessage(resp)};
-
-    JsonResp jr(resp);
-    if (!jr.enter("data")) return {false, api::utils::getParseErrorMessage()};
-
-    GameListResult result;
-    result.success = true;
-    result.total = jr.getInt("total");
-
-    for (auto item : jr.getArray("list")) {
-        GameList game;
-        game.gameTid    = item.getString("game_tid");
-        game.gameName   = item.getString("game_name");
-        game.modCount   = item.getInt("mod_count");
-        game.lastUpdate = item.getString("last_update");
-        result.list.push_back(std::move(game));
-    }
-
-    return result;
+    return parseGameList(http::requestToMemory(request));
 }
 
 /**
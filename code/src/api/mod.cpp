@@ -7,14 +7,44 @@
 #include "api/utils.hpp"
 #include "utils/http.hpp"
 #include "utils/jsonResp.hpp"
+#include "utils/segmentDownload.hpp"
 #include <borealis/core/i18n.hpp>
+#include <cstdio>
+#include <cstdlib>
 #include <utility>
 
 namespace api::mod {
 
-ModListResult fetchModList(const std::string& gameTid, int page, int limit, const std::string& sort, const std::string& keyword, const std::string& version, const std::string& modType, std::stop_token token) {
-    auto request = api::utils::makeRequest(http::Method::Get, url::mod::list(gameTid, page, limit, sort, keyword, version, modType), token);
-    auto resp = http::requestToMemory(request);
+namespace {
+
+    /** @brief 解析商店给出的十六进制 CRC32，为空或格式不对时返回 0（不核对） */
+    uint32_t parseCrc32(const std::string& hex) {
+        if (hex.empty() || hex.size() > 8) return 0;
+        char* end = nullptr;
+        unsigned long value = std::strtoul(hex.c_str(), &end, 16);
+        return *end == '\0' ? static_cast<uint32_t>(value) : 0;
+    }
+
+    DownloadResult downloadResult(const http::Response& resp, uint32_t crc32) {
+        DownloadResult result;
+        if (api::utils::isOk(resp)) {
+            char hex[9];
+            std::snprintf(hex, sizeof(hex), "%08x", crc32);
+            result.success = true;
+            result.fileCrc32 = hex;
+        } else if (resp.networkCode == segmentDownload::checksumMismatch) {
+            result.error = brls::getStr("other/api/modDownloadCorrupted");
+        } else if (resp.statusCode == 429) {
+            result.error = brls::getStr("other/api/modDownloadRateLimit");
+        } else {
+            result.error = brls::getStr("other/api/modDownloadFailed");
+        }
+        return result;
+    }
+
+} // namespace
+
+ModListResult parseModList(const http::Response& resp) {
     if (!api::utils::isOk(resp)) return {false, api::utils::responseErrorMessage(resp)};
 
     JsonResp json(resp);
@@ -46,6 +76,11 @@ ModListResult fetchModList(const std::string& gameTid, int page, int limit, cons
     return result;
 }
 
+ModListResult fetchModList(const std::string& gameTid, int page, int limit, const std::string& sort, const std::string& keyword, const std::string& version, const std::string& modType, std::stop_token token) {
+    auto request = api::utils::makeRequest(http::Method::Get, url::mod::list(gameTid, page, limit, sort, keyword, version, modType), token);
+    return parseModList(http::requestToMemory(request));
+}
+
 ModGameVersionsResult fetchModGameVersions(const std::string& gameTid, std::stop_token token) {
     auto request = api::utils::makeRequest(http::Method::Get, url::mod::gameVersions(gameTid), token);
     auto resp = http::requestToMemory(request);
@@ -134,11 +169,16 @@ DownloadInfoResult fetchDownloadInfo(int modId, std::stop_token token) {
     return result;
 }
 
-api::ApiResult download(int modId, const std::string& path, std::function<bool(size_t total, size_t now)> progress, std::stop_token token) {
-    auto resp = api::utils::downloadToFile(url::mod::download(modId), path, progress, token);
-    if (api::utils::isOk(resp)) return {true, ""};
-    if (resp.statusCode == 429) return {false, brls::getStr("other/api/modDownloadRateLimit")};
-    return {false, brls::getStr("other/api/modDownloadFailed")};
+DownloadResult download(int modId, const std::string& path, const std::string& expectedCrc32, std::function<bool(size_t total, size_t now)> progress, std::stop_token token) {
+    uint32_t crc32 = 0;
+    auto resp = api::utils::downloadToFile(url::mod::download(modId), path, progress, token, parseCrc32(expectedCrc32), &crc32);
+    return downloadResult(resp, crc32);
+}
+
+DownloadResult downloadStreaming(int modId, const std::string& path, const std::string& expectedCrc32, const std::function<void(std::shared_ptr<PartialFile> file)>& onOpened, std::function<bool(size_t total, size_t now)> progress, std::stop_token token) {
+    uint32_t crc32 = 0;
+    auto resp = api::utils::downloadZipToFile(url::mod::download(modId), path, onOpened, progress, token, parseCrc32(expectedCrc32), &crc32);
+    return downloadResult(resp, crc32);
 }
 
 ModUpdateCheckResult checkModUpdates(const std::string& gameTid, const std::string& modsJson, std::stop_token token) {
@@ -4,12 +4,11 @@
 
 #include "api/utils.hpp"
 #include "core/device.hpp"
-#include "utils/fsHelper.hpp"
 #include "utils/http.hpp"
 #include "utils/jsonResp.hpp"
+#include "utils/segmentDownload.hpp"
 
 #include <borealis/core/i18n.hpp>
-#include <cstdio>
 
 namespace api::utils {
 
@@ -69,27 +68,21 @@ http::Response downloadBytes(const std::string& url, const std::vector<http::Hea
     return http::requestToMemory(request);
 }
 
-http::Response downloadToFile(const std::string& url, const std::string& path, std::function<bool(size_t total, size_t now)> progress, std::stop_token token) {
-    http::Response response;
-
-    auto slashPos = path.rfind('/');
-    if (slashPos != std::string::npos && slashPos != 0) fs::ensureDir(path.substr(0, slashPos));
-
-    FILE* fp = std::fopen(path.c_str(), "wb");
-    if (!fp) return response;
-    std::setvbuf(fp, nullptr, _IOFBF, 512 * 1024);
-
+http::Response downloadToFile(const std::string& url, const std::string& path, std::function<bool(size_t total, size_t now)> progress, std::stop_token token, uint32_t expectedCrc, uint32_t* crc32) {
     auto request = makeRequest(http::Method::Get, url, token);
-    request.progress = progress;
-
-    response = http::requestStream(request, [fp](const uint8_t* data, size_t size) {
-        return std::fwrite(data, 1, size, fp) == size;
-    });
-
-    std::fclose(fp);
-
-    if (!isOk(response)) std::remove(path.c_str());
+    request.progress = std::move(progress);
+    segmentDownload::Stats stats;
+    auto response = segmentDownload::toFile(request, path, segmentDownload::defaultConnections, &stats, nullptr, expectedCrc);
+    if (crc32) *crc32 = stats.crc32;
+    return response;
+}
 
+http::Response downloadZipToFile(const std::string& url, const std::string& path, const zipStream::OpenedCallback& onOpened, std::function<bool(size_t total, size_t now)> progress, std::stop_token token, uint32_t expectedCrc, uint32_t* crc32) {
+    auto request = makeRequest(http::Method::Get, url, token);
+    request.progress = std::move(progress);
+    segmentDownload::Stats stats;
+    auto response = zipStream::toFile(request, path, onOpened, segmentDownload::defaultConnections, &stats, expectedCrc);
+    if (crc32) *crc32 = stats.crc32;
     return response;
 }
 
@@ -2,10 +2,12 @@
  * Device - Switch 设备信息与控制能力封装
  */
 
+#ifdef __SWITCH__
+
 #include "core/device.hpp"
-#include "common/settings.hpp"
 
 #include <malloc.h>
+#include <mutex>
 #include <switch.h>
 
 extern AppletType __nx_applet_type;  // libnx 当前 Applet 类型
@@ -80,14 +82,37 @@ void enable() {
 
 namespace deviceControl::CpuBoost {
 
+static std::mutex s_mutex;     // 保护以下状态
+static int s_users = 0;        // 申请加速的调用方数
+static bool s_enabled = true;  // 设置是否允许加速
+static bool s_applied = false; // 当前是否处于 FastLoad 模式
+
+/** @brief 按调用方数与设置切换 CPU 模式（调用方持有锁） */
+static void applyLocked() {
+    bool boost = s_enabled && s_users > 0;
+    if (boost == s_applied) return;
+    s_applied = boost;
+    appletSetCpuBoostMode(boost ? ApmCpuBoostMode_FastLoad : ApmCpuBoostMode_Normal);
+}
+
+void setEnabled(bool enabled) {
+    std::lock_guard lock(s_mutex);
+    s_enabled = enabled;
+    applyLocked();
+}
+
 void enableFastLoad() {
-    if (!Settings::getBool("Performance", "cpuBoost", true)) return;
-    appletSetCpuBoostMode(ApmCpuBoostMode_FastLoad);
+    std::lock_guard lock(s_mutex);
+    s_users++;
+    applyLocked();
 }
 
 void disable() {
-    if (!Settings::getBool("Performance", "cpuBoost", true)) return;
-    appletSetCpuBoostMode(ApmCpuBoostMode_Normal);
+    std::lock_guard lock(s_mutex);
+    if (s_users > 0) s_users--;
+    applyLocked();
 }
 
 } // namespace deviceControl::CpuBoost
+
+#endif // __SWITCH__
@@ -0,0 +1,55 @@
+/**
+ * Device - 设备信息与控制能力（主机端占位实现）
+ * 主机上没有 Applet / 系统设置服务，控制类接口为空操作
+ */
+
+#ifndef __SWITCH__
+
+#include "core/device.hpp"
+
+#include <malloc.h>
+
+namespace deviceInfo::Memory {
+
+HeapUsage getHeapUsage() {
+    struct mallinfo2 mi = mallinfo2();
+    return {static_cast<uint64_t>(mi.uordblks) / (1024 * 1024), 0};
+}
+
+} // namespace deviceInfo::Memory
+
+namespace deviceInfo::Network {
+
+bool isAvailable() {
+    return true;
+}
+
+} // namespace deviceInfo::Network
+
+namespace deviceInfo::Identity {
+
+uint64_t getDeviceId() {
+    return 0;
+}
+
+} // namespace deviceInfo::Identity
+
+namespace deviceControl::HomeButton {
+
+void disable() {}
+
+void enable() {}
+
+} // namespace deviceControl::HomeButton
+
+namespace deviceControl::CpuBoost {
+
+void setEnabled(bool) {}
+
+void enableFastLoad() {}
+
+void disable() {}
+
+} // namespace deviceControl::CpuBoost
+
+#endif // !__SWITCH__
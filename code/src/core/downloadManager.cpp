@@ -0,0 +1,638 @@
+/**
+ * DownloadManager - 商店模组后台下载队列实现
+ */
+
+#include "core/downloadManager.hpp"
+#include "api/mod.hpp"
+#include "common/config.hpp"
+#include "common/settings.hpp"
+#include "core/device.hpp"
+#include "core/gameManager.hpp"
+#include "core/modManager.hpp"
+#include "core/storeModDetailManager.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/textClean.hpp"
+#include <algorithm>
+#include <borealis/core/i18n.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+
+namespace {
+
+    constexpr double speedAlpha = 0.3;                                     // 速度平滑系数（与下载弹窗一致）
+    constexpr auto speedInterval = std::chrono::seconds(1);                // 速度采样间隔
+    constexpr auto publishInterval = std::chrono::milliseconds(250);       // 进度写回队列的间隔
+
+    const char* stateName(DownloadManager::State state) {
+        switch (state) {
+            case DownloadManager::State::Paused: return "paused";
+            case DownloadManager::State::Downloaded: return "downloaded";
+            case DownloadManager::State::Failed: return "failed";
+            default: return "queued"; // 正在下载的任务下次启动时重新排队
+        }
+    }
+
+    DownloadManager::State parseState(const std::string& name) {
+        if (name == "paused") return DownloadManager::State::Paused;
+        if (name == "downloaded") return DownloadManager::State::Downloaded;
+        if (name == "failed") return DownloadManager::State::Failed;
+        return DownloadManager::State::Queued;
+    }
+
+    /** @brief 删除临时文件与续传记录 */
+    void removeTempFiles(const std::string& path) {
+        if (fs::fileExists(path)) fs::deleteFile(path);
+        downloadJournal::remove(path);
+    }
+
+} // namespace
+
+DownloadManager& DownloadManager::instance() {
+    static DownloadManager manager;
+    return manager;
+}
+
+std::string DownloadManager::tempPathOf(int modId) {
+    return std::string(config::downloadTempDir) + std::to_string(modId) + ".zip";
+}
+
+// 生命周期
+
+void DownloadManager::start(FinishedCallback onFinished) {
+    std::vector<int> downloaded;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_started) return;
+        m_started = true;
+        m_onFinished = onFinished;
+        m_concurrency = std::clamp(Settings::getInt("Download", "concurrency", defaultConcurrency), 1, maxConcurrency);
+        loadLocked();
+        for (const auto& task : m_tasks) {
+            if (task.state == State::Downloaded) downloaded.push_back(task.id);
+        }
+        scheduleLocked();
+    }
+    if (onFinished) {
+        for (int id : downloaded) onFinished(id);
+    }
+}
+
+void DownloadManager::shutdown() {
+    std::vector<Worker> workers;
+    {
+        std::lock_guard lock(m_mutex);
+        m_shuttingDown = true;
+        m_onFinished = nullptr;
+        for (auto& worker : m_workers) worker.task.request_stop();
+        workers = std::move(m_workers);
+        m_workers.clear();
+    }
+    // 线程结束时需要锁，先释放再等待
+    workers.clear();
+
+    std::lock_guard lock(m_mutex);
+    for (auto& task : m_tasks) {
+        if (task.state == State::Running) task.state = State::Queued;
+    }
+    saveLocked();
+    m_json.save();
+}
+
+// 任务控制
+
+int DownloadManager::enqueue(Task task) {
+    std::lock_guard lock(m_mutex);
+    for (auto& existing : m_tasks) {
+        if (existing.modId != task.modId) continue;
+        if (existing.state == State::Paused || existing.state == State::Failed) {
+            existing.state = State::Queued;
+            existing.error.clear();
+            saveLocked();
+            scheduleLocked();
+        }
+        return existing.id;
+    }
+
+    task.id = m_nextId++;
+    task.state = State::Queued;
+    task.fileCrc32.clear();
+    task.error.clear();
+    task.downloaded = 0;
+    task.total = 0;
+    task.speed = 0;
+    m_tasks.push_back(std::move(task));
+    int id = m_tasks.back().id;
+    saveLocked();
+    scheduleLocked();
+    return id;
+}
+
+void DownloadManager::pause(int id) {
+    std::lock_guard lock(m_mutex);
+    auto* task = findLocked(id);
+    if (!task || (task->state != State::Queued && task->state != State::Running)) return;
+
+    task->state = State::Paused;
+    task->speed = 0;
+    stopWorkerLocked(id);
+    saveLocked();
+    scheduleLocked();
+}
+
+void DownloadManager::resume(int id) {
+    std::lock_guard lock(m_mutex);
+    auto* task = findLocked(id);
+    if (!task || (task->state != State::Paused && task->state != State::Failed)) return;
+
+    task->state = State::Queued;
+    task->error.clear();
+    saveLocked();
+    scheduleLocked();
+}
+
+void DownloadManager::cancel(int id) {
+    std::string cleanup;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [id](const Task& task) { return task.id == id; });
+        if (it == m_tasks.end()) return;
+
+        // 线程还在写文件时由线程退出后清理
+        if (!busyLocked(id)) cleanup = tempPathOf(it->modId);
+        stopWorkerLocked(id);
+        m_tasks.erase(it);
+        m_json.removeRootKey(std::to_string(id));
+        saveLocked();
+        scheduleLocked();
+    }
+    if (!cleanup.empty()) removeTempFiles(cleanup);
+}
+
+// 完成
+
+DownloadManager::Completion DownloadManager::complete(int id, GameManager& games, bool allowNewGame) {
+    Completion result;
+    Task task;
+    {
+        std::lock_guard lock(m_mutex);
+        auto* found = findLocked(id);
+        if (!found || found->state != State::Downloaded) return result;
+        task = *found;
+    }
+    result.modId = task.modId;
+    result.update = task.update;
+
+    std::string tempPath = tempPathOf(task.modId);
+    if (!fs::fileExists(tempPath)) {
+        failCompletion(id, {});
+        return result;
+    }
+
+    // 目标游戏项目：加入时的本地项目 → 同 TID 的已有项目 → 新建
+    int gameIndex = task.gameDir.empty() ? -1 : games.findByDirPath(task.gameDir);
+    if (gameIndex < 0) gameIndex = games.findByAppId(format::appIdFromHex(task.gameTid));
+    if (gameIndex < 0 && !allowNewGame) {
+        result.deferred = true;
+        return result;
+    }
+
+    // 页面的后台线程正在读取该游戏的模组列表，写入会与之竞争：解除占用时重新回调
+    if (gameIndex >= 0) {
+        std::lock_guard lock(m_mutex);
+        const std::string& gameDir = games.games()[gameIndex].dirPath;
+        bool held = std::any_of(m_heldModManagers.begin(), m_heldModManagers.end(), [&gameDir](const ModManager* mods) { return mods->game().dirPath == gameDir; });
+        if (held) {
+            if (std::find(m_heldTasks.begin(), m_heldTasks.end(), id) == m_heldTasks.end()) m_heldTasks.push_back(id);
+            result.held = true;
+            return result;
+        }
+    }
+
+    auto attached = [this](const std::string& gameDir) -> ModManager* {
+        std::lock_guard lock(m_mutex);
+        for (auto it = m_modManagers.rbegin(); it != m_modManagers.rend(); ++it) {
+            if ((*it)->game().dirPath == gameDir) return *it;
+        }
+        return nullptr;
+    };
+
+    ModInfo info = task.modInfo;
+    if (!task.fileCrc32.empty()) info.fileCrc32 = task.fileCrc32;
+
+    // 更新：替换原模组的 zip；没有页面持有该游戏时临时构造 ModManager
+    if (task.update && gameIndex >= 0) {
+        std::string gameDir = games.games()[gameIndex].dirPath;
+        std::optional<ModManager> pageless;
+        ModManager* mods = attached(gameDir);
+        if (!mods) mods = &pageless.emplace(games.games()[gameIndex]);
+
+        int index = mods->findByModID(task.modId);
+        if (index >= 0) {
+            // 排队期间原模组被安装到游戏中：替换 zip 会丢失安装记录，等卸载后再继续
+            if (mods->mods()[index].isInstalled) {
+                failCompletion(id, brls::getStr("other/download/updateInstalled"));
+                return result;
+            }
+            if (!mods->updateModFromStore(index, std::move(info), tempPath)) {
+                failCompletion(id, brls::getStr("other/download/placeFailed"));
+                return result;
+            }
+            mods->setPendingFocus(task.modId);
+            result.gameDir = gameDir;
+            result.success = true;
+        }
+        // 原模组已被删除：按新下载放入
+    }
+
+    if (!result.success) {
+        bool newGame = gameIndex < 0;
+        std::string gameDir = newGame ? games.addNewGameFromStore(task.gameTid, task.gameNameEn, task.gameName) : games.games()[gameIndex].dirPath;
+        info = StoreModDetailManager::reserveModDir(std::move(info), gameDir, task.modDirName);
+        if (!StoreModDetailManager::placeDownloadedZip(info, tempPath)) {
+            fs::removeDirAll(info.path);
+            failCompletion(id, brls::getStr("other/download/placeFailed"));
+            return result;
+        }
+
+        if (!newGame) games.addExistingGameFromStore(gameDir);
+        if (ModManager* mods = attached(gameDir)) {
+            mods->setPendingFocus(info.modID);
+            mods->addModFromStore(std::move(info));
+        } else {
+            StoreModDetailManager::saveModInfo(gameDir, info);
+        }
+        result.newGame = newGame;
+        result.gameDir = gameDir;
+        result.success = true;
+    }
+
+    std::vector<std::pair<int, CompletedListener>> listeners;
+    {
+        std::lock_guard lock(m_mutex);
+        std::erase_if(m_tasks, [id](const Task& t) { return t.id == id; });
+        m_json.removeRootKey(std::to_string(id));
+        saveLocked();
+        listeners = m_listeners;
+    }
+    for (auto& [listenerId, listener] : listeners) listener(result);
+    return result;
+}
+
+void DownloadManager::failCompletion(int id, const std::string& error) {
+    std::lock_guard lock(m_mutex);
+    auto* task = findLocked(id);
+    if (!task) return;
+
+    if (fs::fileExists(tempPathOf(task->modId))) {
+        task->state = State::Failed;
+        task->error = error;
+    } else {
+        task->state = State::Queued;
+        task->fileCrc32.clear();
+    }
+    saveLocked();
+    scheduleLocked();
+}
+
+// 查询
+
+std::optional<DownloadManager::Task> DownloadManager::findByModId(int modId) const {
+    std::lock_guard lock(m_mutex);
+    for (const auto& task : m_tasks) {
+        if (task.modId == modId) return task;
+    }
+    return std::nullopt;
+}
+
+std::vector<DownloadManager::Task> DownloadManager::tasks() const {
+    std::lock_guard lock(m_mutex);
+    return m_tasks;
+}
+
+DownloadManager::Throughput DownloadManager::throughput() const {
+    Throughput result;
+    result.received = m_received.load();
+
+    std::lock_guard lock(m_mutex);
+    for (const auto& task : m_tasks) {
+        if (task.state == State::Running) {
+            result.running++;
+            result.speed += task.speed;
+        } else if (task.state == State::Queued) {
+            result.queued++;
+        }
+    }
+    return result;
+}
+
+int DownloadManager::concurrency() const {
+    std::lock_guard lock(m_mutex);
+    return m_concurrency;
+}
+
+void DownloadManager::setConcurrency(int count) {
+    count = std::clamp(count, 1, maxConcurrency);
+    Settings::setInt("Download", "concurrency", count);
+
+    std::lock_guard lock(m_mutex);
+    m_concurrency = count;
+    scheduleLocked();
+}
+
+// 页面登记
+
+void DownloadManager::attach(ModManager* mods) {
+    std::lock_guard lock(m_mutex);
+    m_modManagers.push_back(mods);
+}
+
+void DownloadManager::detach(ModManager* mods) {
+    std::lock_guard lock(m_mutex);
+    std::erase(m_modManagers, mods);
+    std::erase(m_heldModManagers, mods);
+}
+
+void DownloadManager::hold(ModManager* mods) {
+    std::lock_guard lock(m_mutex);
+    m_heldModManagers.push_back(mods);
+}
+
+void DownloadManager::release(ModManager* mods) {
+    FinishedCallback callback;
+    std::vector<int> ids;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = std::find(m_heldModManagers.begin(), m_heldModManagers.end(), mods);
+        if (it != m_heldModManagers.end()) m_heldModManagers.erase(it);
+        callback = m_onFinished;
+        ids = std::exchange(m_heldTasks, {});
+    }
+    // 仍被占用的任务在 complete() 中再次推迟
+    if (callback) {
+        for (int id : ids) callback(id);
+    }
+}
+
+int DownloadManager::addListener(CompletedListener listener) {
+    std::lock_guard lock(m_mutex);
+    int listenerId = m_nextListenerId++;
+    m_listeners.emplace_back(listenerId, std::move(listener));
+    return listenerId;
+}
+
+void DownloadManager::removeListener(int listenerId) {
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_listeners, [listenerId](const auto& entry) { return entry.first == listenerId; });
+}
+
+// 调度
+
+DownloadManager::Task* DownloadManager::findLocked(int id) {
+    for (auto& task : m_tasks) {
+        if (task.id == id) return &task;
+    }
+    return nullptr;
+}
+
+bool DownloadManager::busyLocked(int id) const {
+    return std::any_of(m_workers.begin(), m_workers.end(), [id](const Worker& worker) { return worker.id == id && !worker.finished; });
+}
+
+void DownloadManager::stopWorkerLocked(int id) {
+    for (auto& worker : m_workers) {
+        if (worker.id == id && !worker.finished) worker.task.request_stop();
+    }
+}
+
+void DownloadManager::scheduleLocked() {
+    std::erase_if(m_workers, [](const Worker& worker) {
+        return worker.finished && worker.task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    if (!m_started || m_shuttingDown) return;
+
+    int running = static_cast<int>(std::count_if(m_tasks.begin(), m_tasks.end(), [](const Task& task) { return task.state == State::Running; }));
+    for (auto& task : m_tasks) {
+        if (running >= m_concurrency) break;
+        // 暂停后立即继续时，上一个线程可能还在写同一个文件，等它退出
+        if (task.state != State::Queued || busyLocked(task.id)) continue;
+
+        if (!m_boosted) {
+            m_boosted = true;
+            deviceControl::CpuBoost::enableFastLoad();
+        }
+        running++;
+        task.state = State::Running;
+        task.speed = 0;
+
+        int id = task.id;
+        Worker worker;
+        worker.id = id;
+        worker.modId = task.modId;
+        worker.task = util::async([this, id](std::stop_token token) { run(id, token); });
+        m_workers.push_back(std::move(worker));
+    }
+}
+
+void DownloadManager::run(int id, std::stop_token token) {
+    Task task;
+    {
+        std::lock_guard lock(m_mutex);
+        if (auto* found = findLocked(id)) task = *found;
+    }
+    if (task.id == 0) {
+        finish(id, false, {}, {});
+        return;
+    }
+
+    // 目录名取自英文模组名，只在第一次下载前获取
+    std::string error;
+    if (task.modDirName.empty()) {
+        auto info = api::mod::fetchDownloadInfo(task.modId, token);
+        if (info.success) {
+            task.gameNameEn = info.gameNameEn;
+            task.modDirName = textClean::safeDirName(info.modNameEn);
+            if (task.modDirName.empty()) task.modDirName = "mod_" + std::to_string(task.modId);
+
+            std::lock_guard lock(m_mutex);
+            if (auto* found = findLocked(id)) {
+                found->gameNameEn = task.gameNameEn;
+                found->modDirName = task.modDirName;
+            }
+        } else {
+            error = info.error;
+        }
+    }
+    if (task.modDirName.empty()) {
+        finish(id, false, {}, error);
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastPublish{};
+    Clock::time_point lastSample{};
+    uint64_t sampleBytes = 0;
+    uint64_t lastBytes = 0;
+    double speed = 0;
+
+    auto onProgress = [&, id](size_t total, size_t now) -> bool {
+        // 进度只在开始接收文件内容后回调；服务器未给出总大小时按商店给出的大小显示
+        if (total == 0 && task.fileSize > 0) total = static_cast<size_t>(task.fileSize);
+
+        auto t = Clock::now();
+        if (lastSample == Clock::time_point{} || now < sampleBytes) {
+            // 第一次回调（续传时包含已下载的部分）或重新开始下载：只建立基准
+            lastSample = t;
+            sampleBytes = now;
+            lastBytes = now;
+        }
+        if (now > lastBytes) m_received.fetch_add(now - lastBytes);
+        lastBytes = now;
+
+        if (t - lastSample >= speedInterval) {
+            double dt = std::chrono::duration<double>(t - lastSample).count();
+            double instant = (now - sampleBytes) / dt;
+            speed = speed < 1.0 ? instant : speedAlpha * instant + (1.0 - speedAlpha) * speed;
+            sampleBytes = now;
+            lastSample = t;
+        }
+
+        if (t - lastPublish < publishInterval) return true;
+        lastPublish = t;
+        std::lock_guard lock(m_mutex);
+        if (auto* found = findLocked(id)) {
+            found->downloaded = now;
+            found->total = total;
+            found->speed = speed;
+        }
+        return true;
+    };
+
+    auto result = api::mod::download(task.modId, tempPathOf(task.modId), task.modInfo.fileCrc32, onProgress, token);
+    finish(id, result.success, result.fileCrc32, result.error);
+}
+
+void DownloadManager::finish(int id, bool success, const std::string& fileCrc32, const std::string& error) {
+    FinishedCallback callback;
+    std::string cleanup;
+    {
+        std::lock_guard lock(m_mutex);
+        int modId = 0;
+        for (auto& worker : m_workers) {
+            if (worker.id != id || worker.finished) continue;
+            worker.finished = true;
+            modId = worker.modId;
+            break;
+        }
+
+        auto* task = findLocked(id);
+        if (!task) {
+            // 下载期间被取消
+            cleanup = tempPathOf(modId);
+        } else if (success) {
+            // 暂停请求晚于下载完成时同样视为完成，文件已完整
+            task->state = State::Downloaded;
+            task->fileCrc32 = fileCrc32;
+            task->speed = 0;
+            if (task->total > 0) task->downloaded = task->total;
+            callback = m_onFinished;
+        } else if (task->state == State::Running) {
+            task->speed = 0;
+            if (m_shuttingDown) {
+                task->state = State::Queued;
+            } else {
+                task->state = State::Failed;
+                task->error = error;
+            }
+        }
+        saveLocked();
+        scheduleLocked();
+
+        // 加速申请按队列整体持有一次：暂停后立即启动其他任务时不重复申请
+        bool anyRunning = std::any_of(m_tasks.begin(), m_tasks.end(), [](const Task& t) { return t.state == State::Running; });
+        if (!anyRunning && m_boosted) {
+            m_boosted = false;
+            deviceControl::CpuBoost::disable();
+        }
+    }
+
+    if (!cleanup.empty()) removeTempFiles(cleanup);
+    if (callback) callback(id);
+}
+
+// 持久化
+
+void DownloadManager::loadLocked() {
+    fs::ensureDir(config::modShopDir);
+    m_json.load(config::downloadQueuePath);
+    for (const auto& key : m_json.getRootKeys()) {
+        Task task;
+        task.id = std::atoi(key.c_str());
+        task.modId = m_json.getInt(key, "modId");
+        if (task.id <= 0 || task.modId <= 0) continue;
+
+        task.gameTid = m_json.getString(key, "gameTid");
+        task.gameName = m_json.getString(key, "gameName");
+        task.gameDir = m_json.getString(key, "gameDir");
+        task.update = m_json.getBool(key, "update");
+        // 按字符串保存，2GB 以上不截断；兼容旧版本写入的整数
+        std::string fileSize = m_json.getString(key, "fileSize");
+        task.fileSize = fileSize.empty() ? m_json.getInt(key, "fileSize") : std::strtoll(fileSize.c_str(), nullptr, 10);
+        task.state = parseState(m_json.getString(key, "state"));
+        task.gameNameEn = m_json.getString(key, "gameNameEn");
+        task.modDirName = m_json.getString(key, "modDirName");
+        task.fileCrc32 = m_json.getString(key, "fileCrc32");
+        task.error = m_json.getString(key, "error");
+
+        auto& info = task.modInfo;
+        info.displayName = m_json.getString(key, "displayName");
+        info.type        = m_json.getString(key, "type");
+        info.description = m_json.getString(key, "description");
+        info.modVersion  = m_json.getString(key, "modVersion");
+        info.gameVersion = m_json.getString(key, "gameVersion");
+        info.author      = m_json.getString(key, "author");
+        info.authorLink  = m_json.getString(key, "authorLink");
+        info.size        = m_json.getString(key, "size");
+        info.fileCrc32   = m_json.getString(key, "expectedCrc32");
+        info.modID       = task.modId;
+        info.isZip       = true;
+
+        // 已下载的 zip 丢失时重新下载
+        if (task.state == State::Downloaded && !fs::fileExists(tempPathOf(task.modId))) task.state = State::Queued;
+
+        m_nextId = std::max(m_nextId, task.id + 1);
+        m_tasks.push_back(std::move(task));
+    }
+    std::sort(m_tasks.begin(), m_tasks.end(), [](const Task& a, const Task& b) { return a.id < b.id; });
+}
+
+void DownloadManager::saveLocked() {
+    for (const auto& task : m_tasks) {
+        std::string key = std::to_string(task.id);
+        m_json.setInt(key, "modId", task.modId);
+        m_json.setString(key, "gameTid", task.gameTid);
+        m_json.setString(key, "gameName", task.gameName);
+        m_json.setString(key, "gameDir", task.gameDir);
+        m_json.setBool(key, "update", task.update);
+        m_json.setString(key, "fileSize", std::to_string(task.fileSize));
+        m_json.setString(key, "state", stateName(task.state));
+        m_json.setString(key, "gameNameEn", task.gameNameEn);
+        m_json.setString(key, "modDirName", task.modDirName);
+        m_json.setString(key, "fileCrc32", task.fileCrc32);
+        m_json.setString(key, "error", task.error);
+
+        const auto& info = task.modInfo;
+        m_json.setString(key, "displayName", info.displayName);
+        m_json.setString(key, "type", info.type);
+        m_json.setString(key, "description", info.description);
+        m_json.setString(key, "modVersion", info.modVersion);
+        m_json.setString(key, "gameVersion", info.gameVersion);
+        m_json.setString(key, "author", info.author);
+        m_json.setString(key, "authorLink", info.authorLink);
+        m_json.setString(key, "size", info.size);
+        m_json.setString(key, "expectedCrc32", info.fileCrc32);
+    }
+    m_json.saveDeferred();
+}
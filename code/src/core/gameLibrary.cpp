@@ -0,0 +1,94 @@
+/**
+ * gameLibrary - 游戏库目录扫描与启动快照实现
+ */
+
+#include "core/gameLibrary.hpp"
+#include "common/config.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+
+namespace gameLibrary {
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'G', 'L'};
+    constexpr uint32_t version = 1;
+
+} // namespace
+
+std::string GameDirEntry::dirPath() const {
+    return std::string(config::modsRoot) + dirName + "/" + appIdHex;
+}
+
+std::vector<GameDirEntry> scan(std::stop_token* token) {
+    std::vector<GameDirEntry> entries;
+    auto dirs = fs::listSubDirs(config::modsRoot);
+
+    for (const auto& dirName : dirs) {
+        if (token && token->stop_requested()) break;
+        std::string dirPath = std::string(config::modsRoot) + dirName + "/";
+
+        // 找 hex 子目录 → appId
+        GameDirEntry entry;
+        for (const auto& sub : fs::listSubDirs(dirPath)) {
+            uint64_t val = format::appIdFromHex(sub);
+            if (val != 0 && format::appIdIsValid(val)) {
+                entry.appId = val;
+                entry.appIdHex = sub;
+                break;
+            }
+        }
+        if (entry.appId == 0) continue;
+
+        // 数 mod（只数子目录，每个子目录 = 一个 mod）
+        entry.modCount = fs::countDirs(dirPath + entry.appIdHex + "/");
+        if (entry.modCount == 0) continue;
+
+        entry.dirName = dirName;
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+bool loadSnapshot(const std::string& path, std::vector<GameDirEntry>& entries) {
+    entries.clear();
+    auto data = fs::readFile(path);
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    if (!reader.ok) return false;
+
+    uint32_t count = reader.get<uint32_t>();
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok; ++i) {
+        GameDirEntry entry;
+        entry.dirName = reader.getStr();
+        entry.appIdHex = reader.getStr();
+        entry.appId = reader.get<uint64_t>();
+        entry.modCount = static_cast<int>(reader.get<uint32_t>());
+        entries.push_back(std::move(entry));
+    }
+
+    if (!reader.finished()) {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool saveSnapshot(const std::string& path, const std::vector<GameDirEntry>& entries) {
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(16 + entries.size() * 64);
+    writer.put(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        writer.putStr(entry.dirName);
+        writer.putStr(entry.appIdHex);
+        writer.put(entry.appId);
+        writer.put(static_cast<uint32_t>(entry.modCount));
+    }
+
+    auto pos = path.rfind('/');
+    if (pos != std::string::npos && pos > 0) fs::ensureDir(path.substr(0, pos));
+    return binaryFile::saveFramed(path, writer);
+}
+
+} // namespace gameLibrary
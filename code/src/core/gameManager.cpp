@@ -5,13 +5,18 @@
 #include "core/gameManager.hpp"
 #include "common/config.hpp"
 #include "core/modManager.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "core/modInstaller/installedFileIndex.hpp"
+#include "core/modInstaller/crcCache.hpp"
+#include "core/modInstaller/modFileRefCount.hpp"
 #include "utils/format.hpp"
+#include "utils/pinYinCache.hpp"
 #include "utils/textClean.hpp"
 #include "utils/strSort.hpp"
 
-#include <climits>
-#include <cstdlib>
+#include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
 
 GameManager::GameManager() {
     m_jsonCache.load(config::gameInfoPath);
@@ -19,78 +24,134 @@ GameManager::GameManager() {
     // 确保 mods 目录和中转站目录存在（递归创建）
     fs::ensureDir(config::transitDir);
 
-    // 扫描 /mods2/ 获取所有游戏目录名
-    auto dirs = fs::listSubDirs(config::modsRoot);
-    std::unordered_map<uint64_t, int> seenAppIds;
+    // 优先使用启动快照，无快照时同步扫描 /mods2/ 并写出快照
+    std::vector<gameLibrary::GameDirEntry> entries;
+    m_fromSnapshot = gameLibrary::loadSnapshot(config::gameLibraryPath, entries);
+    if (!m_fromSnapshot) {
+        entries = gameLibrary::scan();
+        gameLibrary::saveSnapshot(config::gameLibraryPath, entries);
+    }
 
-    for (const auto& dirName : dirs) {
-        std::string dirPath = std::string(config::modsRoot) + dirName + "/";
+    m_games.reserve(entries.size());
+    for (const auto& entry : entries) m_games.push_back(makeGameInfo(entry));
+    reindex();
+    refreshDuplicates();
 
-        // 找 hex 子目录 → appId
-        auto subDirs = fs::listSubDirs(dirPath);
-        uint64_t appId = 0;
-        std::string appIdHex;
+    loadSortSettings();
+}
 
-        for (const auto& sub : subDirs) {
-            uint64_t val = format::appIdFromHex(sub);
-            if (val != 0 && format::appIdIsValid(val)) {
-                appId = val;
-                appIdHex = sub;
-                break;
-            }
-        }
+GameInfo GameManager::makeGameInfo(const gameLibrary::GameDirEntry& entry) {
+    // 用 appId 查 JSON
+    std::string appIdKey = format::appIdHex(entry.appId);
 
-        if (appId == 0) continue;
-
-        // 数 mod（只数子目录，每个子目录 = 一个 mod）
-        std::string appIdPath = dirPath + appIdHex + "/";
-        int modCount = fs::countDirs(appIdPath);
-        if (modCount == 0) continue;
-
-        // 用 appId 查 JSON
-        std::string appIdKey = format::appIdHex(appId);
-
-        std::string displayName = m_jsonCache.getString(appIdKey, "displayName");
-        std::string gameName = m_jsonCache.getString(appIdKey, "gameName");
-        std::string version = m_jsonCache.getString(appIdKey, "version");
-        bool isFavorite = m_jsonCache.getBool(appIdKey, "favorite", false);
-        bool isModsDisabled = m_jsonCache.getBool(appIdKey, "modsDisabled", false);
-        bool hasInstalledMod = m_jsonCache.getBool(appIdKey, "hasInstalledMod", false);
-
-        // 显示名回滚链：displayName → gameName → 目录名
-        std::string finalName;
-        if (!displayName.empty()) finalName = displayName;
-        else if (!gameName.empty()) finalName = gameName;
-        else finalName = dirName;
-
-        // 填充 GameInfo
-        GameInfo info;
-        info.displayName = finalName;
-        info.version = version.empty() ? "..." : version;
-        info.modCount = std::to_string(modCount);
-        info.appId = appId;
-        info.dirPath = dirPath + appIdHex;
-        info.isInstalled = isGameInstalled(appId);
-        info.isFavorite = isFavorite;
-        info.isModsDisabled = isModsDisabled;
-        info.hasInstalledMod = hasInstalledMod;
-
-        // 检测重复 appId
-        auto it = seenAppIds.find(appId);
-        if (it != seenAppIds.end()) {
-            if (!m_games[it->second].isDuplicate) {
-                m_duplicateCount++;
-                m_games[it->second].isDuplicate = true;
-            }
-            info.isDuplicate = true;
-        } else {
-            seenAppIds[appId] = static_cast<int>(m_games.size());
+    std::string displayName = m_jsonCache.getString(appIdKey, "displayName");
+    std::string gameName = m_jsonCache.getString(appIdKey, "gameName");
+    std::string version = m_jsonCache.getString(appIdKey, "version");
+
+    // 显示名回滚链：displayName → gameName → 目录名
+    std::string finalName;
+    if (!displayName.empty()) finalName = displayName;
+    else if (!gameName.empty()) finalName = gameName;
+    else finalName = entry.dirName;
+
+    GameInfo info;
+    info.displayName = finalName;
+    info.version = version.empty() ? "..." : version;
+    info.modCount = entry.modCount;
+    info.appId = entry.appId;
+    info.dirPath = entry.dirPath();
+    info.isInstalled = isGameInstalled(entry.appId);
+    info.isFavorite = m_jsonCache.getBool(appIdKey, "favorite", false);
+    info.isModsDisabled = m_jsonCache.getBool(appIdKey, "modsDisabled", false);
+    info.hasInstalledMod = m_jsonCache.getBool(appIdKey, "hasInstalledMod", false);
+    return info;
+}
+
+void GameManager::refreshDuplicates() {
+    m_duplicateCount = 0;
+    for (const auto& [appId, indices] : m_appIdIndex) {
+        bool isDuplicate = indices.size() > 1;
+        if (isDuplicate) m_duplicateCount++;
+        for (int idx : indices) m_games[idx].isDuplicate = isDuplicate;
+    }
+}
+
+void GameManager::syncInstalledModCounts() {
+    for (auto& installed : m_installedGames) {
+        if (installed.appId == 0) continue;
+        int idx = findByAppId(installed.appId);
+        installed.modCount = idx >= 0 ? std::to_string(m_games[idx].modCount) : "";
+    }
+}
+
+void GameManager::libraryChanged() {
+    ++m_libraryVersion;
+
+    std::vector<gameLibrary::GameDirEntry> entries;
+    entries.reserve(m_games.size());
+    for (const auto& game : m_games) {
+        gameLibrary::GameDirEntry entry;
+        entry.dirName = format::gameDirName(game.dirPath);
+        entry.appIdHex = game.dirPath.substr(game.dirPath.rfind('/') + 1);
+        entry.appId = game.appId;
+        entry.modCount = game.modCount;
+        entries.push_back(std::move(entry));
+    }
+    gameLibrary::saveSnapshot(config::gameLibraryPath, entries);
+}
+
+bool GameManager::loadedFromSnapshot() const {
+    return m_fromSnapshot;
+}
+
+uint32_t GameManager::libraryVersion() const {
+    return m_libraryVersion;
+}
+
+GameManager::LibraryDiff GameManager::applyScan(uint32_t version, const std::vector<gameLibrary::GameDirEntry>& entries) {
+    LibraryDiff diff;
+    if (version != m_libraryVersion) return diff;
+    diff.applied = true;
+
+    std::unordered_map<std::string, const gameLibrary::GameDirEntry*> scanned;
+    for (const auto& entry : entries) scanned.emplace(entry.dirPath(), &entry);
+
+    // 移除磁盘上已不存在的项目，同步 MOD 数量
+    std::vector<GameInfo> removed;
+    for (size_t i = 0; i < m_games.size();) {
+        auto it = scanned.find(m_games[i].dirPath);
+        if (it == scanned.end()) {
+            removed.push_back(std::move(m_games[i]));
+            m_games.erase(m_games.begin() + i);
+            continue;
         }
+        if (m_games[i].modCount != it->second->modCount) {
+            m_games[i].modCount = it->second->modCount;
+            diff.changed++;
+        }
+        scanned.erase(it);
+        ++i;
+    }
+    diff.removed = static_cast<int>(removed.size());
 
-        m_games.push_back(std::move(info));
+    // 新增项目按扫描顺序追加，随后统一排序
+    for (const auto& entry : entries) {
+        if (scanned.count(entry.dirPath()) == 0) continue;
+        m_games.push_back(makeGameInfo(entry));
+        diff.added++;
     }
 
-    loadSortSettings();
+    if (!diff.any()) return diff;
+
+    reindex();
+    for (const auto& game : removed) {
+        if (game.iconId > 0 && findByAppId(game.appId) < 0) diff.releasedIcons.push_back(game.iconId);
+    }
+    refreshDuplicates();
+    syncInstalledModCounts();
+    sort();
+    libraryChanged();
+    return diff;
 }
 
 std::vector<GameInfo>& GameManager::games() {
@@ -146,73 +207,81 @@ void GameManager::sort(SortMode mode, bool ascending) {
         case SortMode::ModCount:   sortByModCount(ascending); break;
         case SortMode::RecentPlay: sortByRecentPlay(ascending); break;
     }
+    reindex();
+    pinYinCache::flush();
+}
+
+uint32_t GameManager::recentPlayRank(uint64_t appId) {
+    getInstalledTids();
+    auto it = m_recentPlayRank.find(appId);
+    return it != m_recentPlayRank.end() ? it->second : UINT32_MAX;
 }
 
 void GameManager::sortByName(bool ascending) {
-    strSort::sortAZ(m_games, &GameInfo::displayName, &GameInfo::isFavorite, ascending);
+    strSort::sortByKey(m_games, [](const GameInfo& game) -> const std::string& { return pinYinCache::sortKey(game.displayName); },
+                       [](const GameInfo& game) { return game.isFavorite ? uint64_t{0} : uint64_t{1} << 32; }, ascending);
 }
 
 void GameManager::sortByModCount(bool ascending) {
-    auto cache = strSort::buildCache(m_games, &GameInfo::displayName);
-    std::sort(m_games.begin(), m_games.end(), [ascending, &cache](const GameInfo& a, const GameInfo& b) {
-        if (a.isFavorite != b.isFavorite) return a.isFavorite > b.isFavorite;
-        int ca = std::stoi(a.modCount), cb = std::stoi(b.modCount);
-        if (ca != cb) return ascending ? (ca < cb) : (ca > cb);
-        return strSort::compareByCache(cache, a.displayName, b.displayName);
-    });
+    strSort::sortByKey(m_games, [](const GameInfo& game) -> const std::string& { return pinYinCache::sortKey(game.displayName); },
+                       [ascending](const GameInfo& game) {
+                           uint32_t count = static_cast<uint32_t>(std::max(game.modCount, 0));
+                           uint64_t group = game.isFavorite ? 0 : uint64_t{1} << 32;
+                           return group | (ascending ? count : ~count);
+                       });
 }
 
 void GameManager::sortByRecentPlay(bool ascending) {
-    auto& tids = getInstalledTids();
-    auto cache = strSort::buildCache(m_games, &GameInfo::displayName);
-    std::sort(m_games.begin(), m_games.end(), [&tids, ascending, &cache](const GameInfo& a, const GameInfo& b) {
-        if (a.isFavorite != b.isFavorite) return a.isFavorite > b.isFavorite;
-        int posA = INT_MAX, posB = INT_MAX;
-        for (int i = 0; i < static_cast<int>(tids.size()); i++) {
-            if (tids[i] == a.appId) { posA = i; break; }
-        }
-        for (int i = 0; i < static_cast<int>(tids.size()); i++) {
-            if (tids[i] == b.appId) { posB = i; break; }
-        }
-        if (posA != posB) return ascending ? (posA < posB) : (posA > posB);
-        return strSort::compareByCache(cache, a.displayName, b.displayName);
-    });
+    strSort::sortByKey(m_games, [](const GameInfo& game) -> const std::string& { return pinYinCache::sortKey(game.displayName); },
+                       [this, ascending](const GameInfo& game) {
+                           uint32_t rank = recentPlayRank(game.appId);
+                           uint64_t group = game.isFavorite ? 0 : uint64_t{1} << 32;
+                           return group | (ascending ? rank : ~rank);
+                       });
 }
 
 int GameManager::findByAppId(uint64_t appId) {
-    for (int i = 0; i < static_cast<int>(m_games.size()); i++) {
-        if (m_games[i].appId == appId) return i;
-    }
-    return -1;
+    auto it = m_appIdIndex.find(appId);
+    return it != m_appIdIndex.end() ? it->second.front() : -1;
 }
 
 int GameManager::findByDirPath(const std::string& dirPath) {
-    for (int i = 0; i < static_cast<int>(m_games.size()); i++) {
-        if (m_games[i].dirPath == dirPath) return i;
-    }
-    return -1;
+    auto it = m_dirPathIndex.find(dirPath);
+    return it != m_dirPathIndex.end() ? it->second : -1;
 }
 
-std::vector<int> GameManager::findAllByAppId(uint64_t appId) {
-    std::vector<int> indices;
-    for (int i = 0; i < static_cast<int>(m_games.size()); i++) {
-        if (m_games[i].appId == appId) indices.push_back(i);
-    }
-    return indices;
+const std::vector<int>& GameManager::findAllByAppId(uint64_t appId) {
+    static const std::vector<int> empty;
+    auto it = m_appIdIndex.find(appId);
+    return it != m_appIdIndex.end() ? it->second : empty;
 }
 
 int GameManager::findInstalledByAppId(uint64_t appId) {
-    for (int i = 0; i < static_cast<int>(m_installedGames.size()); i++) {
-        if (m_installedGames[i].appId == appId) return i;
-    }
-    return -1;
+    auto it = m_installedIndex.find(appId);
+    return it != m_installedIndex.end() ? it->second : -1;
 }
 
 bool GameManager::isGameInstalled(uint64_t appId) {
-    for (uint64_t tid : getInstalledTids()) {
-        if (tid == appId) return true;
+    getInstalledTids();
+    return m_installedTidSet.count(appId) > 0;
+}
+
+void GameManager::reindex() {
+    m_appIdIndex.clear();
+    m_dirPathIndex.clear();
+    m_dirPathIndex.reserve(m_games.size());
+    for (int i = 0; i < static_cast<int>(m_games.size()); i++) {
+        m_appIdIndex[m_games[i].appId].push_back(i);
+        m_dirPathIndex.emplace(m_games[i].dirPath, i);
+    }
+}
+
+void GameManager::reindexInstalled() {
+    m_installedIndex.clear();
+    m_installedIndex.reserve(m_installedGames.size());
+    for (int i = 0; i < static_cast<int>(m_installedGames.size()); i++) {
+        if (m_installedGames[i].appId != 0) m_installedIndex.emplace(m_installedGames[i].appId, i);
     }
-    return false;
 }
 
 GameMetadata GameManager::fetchMetadata(int idx) {
@@ -233,7 +302,7 @@ void GameManager::setFavorite(int idx, bool favorite) {
     game.isFavorite = favorite;
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.setBool(appIdKey, "favorite", favorite);
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 void GameManager::setModsDisabled(int idx, bool disabled) {
@@ -241,7 +310,7 @@ void GameManager::setModsDisabled(int idx, bool disabled) {
     game.isModsDisabled = disabled;
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.setBool(appIdKey, "modsDisabled", disabled);
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 void GameManager::setHasInstalledMod(int idx, bool value) {
@@ -250,15 +319,16 @@ void GameManager::setHasInstalledMod(int idx, bool value) {
     std::string appIdKey = format::appIdHex(game.appId);
     if (value) m_jsonCache.setBool(appIdKey, "hasInstalledMod", true);
     else m_jsonCache.removeKey(appIdKey, "hasInstalledMod");
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 void GameManager::setModCount(int idx, int modCount) {
     auto& game = m_games[idx];
-    game.modCount = std::to_string(modCount);
+    game.modCount = modCount;
 
     int installedIdx = findInstalledByAppId(game.appId);
-    if (installedIdx >= 0) m_installedGames[installedIdx].modCount = game.modCount;
+    if (installedIdx >= 0) m_installedGames[installedIdx].modCount = std::to_string(modCount);
+    libraryChanged();
 }
 
 void GameManager::setVersion(int idx, const std::string& version, bool save) {
@@ -266,7 +336,7 @@ void GameManager::setVersion(int idx, const std::string& version, bool save) {
     game.version = version;
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.setString(appIdKey, "version", version);
-    if (save) m_jsonCache.save();
+    if (save) m_jsonCache.saveDeferred();
 }
 
 void GameManager::setGameName(int idx, const std::string& name, bool save) {
@@ -274,7 +344,7 @@ void GameManager::setGameName(int idx, const std::string& name, bool save) {
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.setString(appIdKey, "gameName", name);
     if (m_jsonCache.getString(appIdKey, "displayName").empty()) game.displayName = name;
-    if (save) m_jsonCache.save();
+    if (save) m_jsonCache.saveDeferred();
 }
 
 void GameManager::setDisplayName(int idx, const std::string& name) {
@@ -282,7 +352,7 @@ void GameManager::setDisplayName(int idx, const std::string& name) {
     game.displayName = name;
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.setString(appIdKey, "displayName", name);
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 std::string GameManager::getRestoredDisplayName(int idx) {
@@ -302,7 +372,7 @@ void GameManager::deleteCustomDisplayName(int idx, const std::string& restoredNa
     game.displayName = restoredName;
     std::string appIdKey = format::appIdHex(game.appId);
     m_jsonCache.removeKey(appIdKey, "displayName");
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 bool GameManager::removeGame(int idx) {
@@ -339,15 +409,17 @@ bool GameManager::cleanupGame(int idx) {
 
     // 从列表中移除
     m_games.erase(m_games.begin() + idx);
+    reindex();
 
     // 同步到已安装列表，供添加页面显示
     int installedIdx = findInstalledByAppId(appId);
-    auto remaining = findAllByAppId(appId);
+    const auto& remaining = findAllByAppId(appId);
     if (!remaining.empty()) {
-        if (installedIdx >= 0) m_installedGames[installedIdx].modCount = m_games[remaining.front()].modCount;
+        if (installedIdx >= 0) m_installedGames[installedIdx].modCount = std::to_string(m_games[remaining.front()].modCount);
         if (wasDuplicate && remaining.size() == 1) m_duplicateCount--;
         bool isDuplicate = remaining.size() > 1;
         for (int gameIdx : remaining) m_games[gameIdx].isDuplicate = isDuplicate;
+        libraryChanged();
         return false;
     }
 
@@ -355,6 +427,7 @@ bool GameManager::cleanupGame(int idx) {
     m_jsonCache.removeRootKey(appIdKey);
     m_jsonCache.save();
     if (installedIdx >= 0) m_installedGames[installedIdx].modCount = "";
+    libraryChanged();
     return true;
 }
 
@@ -372,17 +445,16 @@ GameManager::DeleteGameContentsResult GameManager::deleteGameContents(int idx, s
     return {result, 0};
 }
 
-std::string GameManager::addGame(size_t installedIdx, int modCount, int iconId) {
+std::string GameManager::addGame(size_t installedIdx, int modCount) {
     auto& installed = m_installedGames[installedIdx];
     uint64_t appId = installed.appId;
 
     int existing = findByAppId(appId);
     if (existing >= 0) {
         m_games[existing].isInstalled = true;
-        int old = std::stoi(m_games[existing].modCount);
-        std::string newCount = std::to_string(old + modCount);
-        m_games[existing].modCount = newCount;
-        installed.modCount = newCount;  // 同步到已安装列表，供添加页面显示
+        m_games[existing].modCount += modCount;
+        installed.modCount = std::to_string(m_games[existing].modCount);  // 同步到已安装列表，供添加页面显示
+        libraryChanged();
         return m_games[existing].dirPath;
     }
 
@@ -405,15 +477,15 @@ std::string GameManager::addGame(size_t installedIdx, int modCount, int iconId)
     GameInfo info;
     info.displayName = gameName;
     info.version = version;
-    info.modCount = std::to_string(modCount);
-    info.iconId = iconId;
+    info.modCount = modCount;
     info.appId = appId;
     info.dirPath = dirPath;
     info.isInstalled = true;
-    info.isPending = false;
+    info.isPending = true;  // 图标在 Home 的图集中，回到主页后由卡片加载器读取（磁盘缓存命中）
     m_games.push_back(info);
-    installed.modCount = info.modCount;  // 同步到已安装列表，供添加页面显示
+    installed.modCount = std::to_string(modCount);  // 同步到已安装列表，供添加页面显示
     sort();
+    libraryChanged();
 
     return dirPath;
 }
@@ -448,8 +520,7 @@ std::string GameManager::addExistingGameFromStore(const std::string& dirPath) {
     int idx = findByDirPath(dirPath);
     auto& game = m_games[idx];
     game.isInstalled = isGameInstalled(game.appId);
-    int old = std::stoi(game.modCount);
-    setModCount(idx, old + 1);
+    setModCount(idx, game.modCount + 1);
     return game.dirPath;
 }
 
@@ -459,8 +530,8 @@ std::string GameManager::addGameByTid(const std::string& tid, int modCount) {
     int existing = findByAppId(appId);
     if (existing >= 0) {
         m_games[existing].isInstalled = isGameInstalled(appId);
-        int old = std::stoi(m_games[existing].modCount);
-        m_games[existing].modCount = std::to_string(old + modCount);
+        m_games[existing].modCount += modCount;
+        libraryChanged();
         return m_games[existing].dirPath;
     }
 
@@ -474,13 +545,14 @@ std::string GameManager::addGameByTid(const std::string& tid, int modCount) {
     GameInfo info;
     info.displayName = tid;
     info.version = "...";
-    info.modCount = std::to_string(modCount);
+    info.modCount = modCount;
     info.appId = appId;
     info.dirPath = dirPath;
     info.isInstalled = isGameInstalled(appId);
     info.isPending = false;
     m_games.push_back(info);
     sort();
+    libraryChanged();
 
     return dirPath;
 }
@@ -496,18 +568,27 @@ void GameManager::resetState(std::function<void(int, int, const std::string&)> o
         auto& game = m_games[i];
         if (onProgress) onProgress(i + 1, total, game.displayName);
 
-        // 清理 modInfo.json: 删 installed
+        // 清理 modInfo.json: 删 installed，同时删除各 MOD 的安装清单
+        auto modDirs = fs::listSubDirs(game.dirPath);
         JsonFile modJson;
         if (modJson.load(game.dirPath + config::modInfoFile)) {
-            auto modDirs = fs::listSubDirs(game.dirPath);
             for (const auto& dir : modDirs) {
                 modJson.removeKey(dir, "installed");
             }
             modJson.save();
         }
+        for (const auto& dir : modDirs) {
+            fs::deleteFile(InstallManifest::pathOf(game.dirPath, dir));
+        }
 
-        // 删除 modFileRefCount.json
-        fs::deleteFile(game.dirPath + config::refCountFile);
+        // 删除引用计数文件（含旧版 JSON 与临时文件）、已安装文件索引与 CRC 缓存
+        std::string refCountPath = game.dirPath + config::refCountFile;
+        auto [legacyRefCountPath, tmpRefCountPath] = ModFileRefCount::auxPaths(refCountPath);
+        fs::deleteFile(refCountPath);
+        fs::deleteFile(legacyRefCountPath);
+        fs::deleteFile(tmpRefCountPath);
+        fs::deleteFile(CrcCache::pathOf(game.dirPath));
+        fs::deleteFile(InstalledFileIndex::pathOf(game.dirPath));
 
         // 删除怪猎特殊 pak 安装映射记录
         fs::deleteFile(game.dirPath + config::mhriseInstallMapFile);
@@ -528,7 +609,7 @@ void GameManager::resetState(std::function<void(int, int, const std::string&)> o
 }
 
 void GameManager::saveJsonCache() {
-    m_jsonCache.save();
+    m_jsonCache.saveDeferred();
 }
 
 void GameManager::sortInstalledGames(bool ascending) {
@@ -536,23 +617,25 @@ void GameManager::sortInstalledGames(bool ascending) {
     // 弹出虚拟游戏（appId==0 的头部条目），按最近游玩顺序排序真实游戏，再插回头部
     InstalledGameInfo vg = m_installedGames.front();
     m_installedGames.erase(m_installedGames.begin());
-    auto& tids = getInstalledTids();
-    std::sort(m_installedGames.begin(), m_installedGames.end(), [&tids, ascending](const InstalledGameInfo& a, const InstalledGameInfo& b) {
-        int posA = INT_MAX, posB = INT_MAX;
-        for (int i = 0; i < static_cast<int>(tids.size()); i++) {
-            if (tids[i] == a.appId) { posA = i; break; }
-        }
-        for (int i = 0; i < static_cast<int>(tids.size()); i++) {
-            if (tids[i] == b.appId) { posB = i; break; }
-        }
-        return ascending ? (posA < posB) : (posA > posB);
-    });
+    std::vector<std::pair<uint32_t, InstalledGameInfo>> keyed;
+    keyed.reserve(m_installedGames.size());
+    for (auto& info : m_installedGames) {
+        uint32_t rank = recentPlayRank(info.appId);
+        keyed.emplace_back(ascending ? rank : ~rank, std::move(info));
+    }
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    m_installedGames.clear();
+    for (auto& [rank, info] : keyed) m_installedGames.push_back(std::move(info));
     m_installedGames.insert(m_installedGames.begin(), vg);
+    reindexInstalled();
 }
 
 const std::vector<uint64_t>& GameManager::getInstalledTids() {
     if (!m_installedTidsLoaded) {
         m_installedTids = gameNacp::getInstalledGameTids();
+        m_installedTidSet = std::unordered_set<uint64_t>(m_installedTids.begin(), m_installedTids.end());
+        m_recentPlayRank.clear();
+        for (size_t i = 0; i < m_installedTids.size(); i++) m_recentPlayRank.emplace(m_installedTids[i], static_cast<uint32_t>(i));
         m_installedTidsLoaded = true;
     }
     return m_installedTids;
@@ -571,7 +654,7 @@ std::vector<InstalledGameInfo>& GameManager::getInstalledGames() {
         if (idx >= 0) {
             info.displayName = m_games[idx].displayName;
             info.version     = m_games[idx].version;
-            info.modCount    = m_games[idx].modCount;
+            info.modCount    = std::to_string(m_games[idx].modCount);
             if (m_games[idx].iconId > 0) info.iconKey = format::appIdHex(tid);
             info.isLoaded    = true;
         } else {
@@ -592,6 +675,7 @@ std::vector<InstalledGameInfo>& GameManager::getInstalledGames() {
     vg.iconKey     = config::virtualGameIconKey;
     vg.isLoaded    = true;
     m_installedGames.insert(m_installedGames.begin(), vg);
+    reindexInstalled();
 
     m_installedGamesLoaded = true;
     return m_installedGames;
@@ -0,0 +1,96 @@
+/**
+ * ChunkRing - 解压 / 写入流水线的有界缓冲环实现
+ */
+
+#include "core/modInstaller/chunkRing.hpp"
+
+#include <cstdlib>
+#include <malloc.h>
+
+namespace ModInstaller {
+
+ChunkRing::~ChunkRing() {
+    for (void* slot : m_slots) free(slot);
+}
+
+bool ChunkRing::alloc(int slotCount, size_t slotSize) {
+    m_slotSize = slotSize;
+    for (int i = 0; i < slotCount; ++i) {
+        void* slot = memalign(0x1000, slotSize);
+        if (!slot) return false;
+        m_slots.push_back(slot);
+    }
+    m_free = m_slots;
+    return slotCount >= 2;
+}
+
+void ChunkRing::start(int64_t totalChunks) {
+    std::lock_guard lock(m_mutex);
+    m_totalChunks = totalChunks;
+    m_nextSeq = 0;
+    m_closed = false;
+    m_ready.clear();
+}
+
+void* ChunkRing::acquire(int64_t seq) {
+    const int64_t window = static_cast<int64_t>(m_slots.size()) - 1;
+
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this, seq, window] {
+        return m_closed || (!m_free.empty() && seq < m_nextSeq + window);
+    });
+    if (m_closed) return nullptr;
+
+    void* slot = m_free.back();
+    m_free.pop_back();
+    return slot;
+}
+
+void ChunkRing::push(const Chunk& chunk) {
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_closed) {
+            if (chunk.data) m_free.push_back(chunk.data);
+            return;
+        }
+        m_ready.emplace(chunk.seq, chunk);
+    }
+    m_cv.notify_all();
+}
+
+bool ChunkRing::pop(Chunk& chunk) {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] {
+        return m_closed || m_nextSeq >= m_totalChunks || (!m_ready.empty() && m_ready.begin()->first == m_nextSeq);
+    });
+    if (m_closed || m_nextSeq >= m_totalChunks) return false;
+
+    auto it = m_ready.begin();
+    chunk = it->second;
+    m_ready.erase(it);
+    ++m_nextSeq;
+    lock.unlock();
+
+    // 序号推进后窗口右移，唤醒等待槽位的生产方
+    m_cv.notify_all();
+    return true;
+}
+
+void ChunkRing::release(void* slot) {
+    if (!slot) return;
+    {
+        std::lock_guard lock(m_mutex);
+        m_free.push_back(slot);
+    }
+    m_cv.notify_all();
+}
+
+void ChunkRing::close() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_closed = true;
+    }
+    m_cv.notify_all();
+}
+
+} // namespace ModInstaller
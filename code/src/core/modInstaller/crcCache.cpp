@@ -0,0 +1,183 @@
+/**
+ * CrcCache - 文件 CRC32 持久缓存实现
+ */
+
+#include "core/modInstaller/crcCache.hpp"
+#include "common/config.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/crc32.hpp"
+
+#include <vector>
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'C', 'C'};
+    constexpr uint32_t version = 1;
+
+} // namespace
+
+std::string CrcCache::pathOf(const std::string& gameDirPath) {
+    return gameDirPath + config::crcCacheFile;
+}
+
+std::mutex& CrcCache::mutex() {
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+bool CrcCache::load(const std::string& path) {
+    m_path = path;
+    m_removed.clear();
+    m_dirty = false;
+
+    std::lock_guard lock(mutex());
+    return readEntries(path, m_entries, m_savedAt);
+}
+
+bool CrcCache::readEntries(const std::string& path, Entries& entries, uint64_t& savedAt) {
+    entries.clear();
+    savedAt = 0;
+
+    std::vector<uint8_t> data = fs::readFile(path);
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    if (!reader.ok) return false;
+
+    uint32_t count = reader.get<uint32_t>();
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok; ++i) {
+        std::string filePath = reader.getStr();
+        Entry entry;
+        entry.size = reader.get<int64_t>();
+        entry.mtime = reader.get<uint64_t>();
+        entry.crc32 = reader.get<uint32_t>();
+        entries.emplace(std::move(filePath), entry);
+    }
+
+    if (!reader.finished()) {
+        entries.clear();
+        return false;
+    }
+
+    fs::FileStat st;
+    if (fs::statFile(path, st)) savedAt = st.mtime;
+    return true;
+}
+
+bool CrcCache::save() {
+    if (m_path.empty()) return false;
+    if (!m_dirty) return true;
+
+    std::lock_guard lock(mutex());
+
+    // 以文件当前内容为底（其他实例可能在本实例加载后保存过），叠加本实例的删除与新记录
+    Entries merged;
+    uint64_t savedAt = 0;
+    readEntries(m_path, merged, savedAt);
+    for (const auto& [filePath, removed] : m_removed) {
+        auto it = merged.find(filePath);
+        if (it != merged.end() && it->second.size == removed.size && it->second.mtime == removed.mtime && it->second.crc32 == removed.crc32) merged.erase(it);
+    }
+    // 未重新计算的不可信条目不写回：新缓存文件的修改时间更晚，写回后会被误判为可信
+    for (auto it = merged.begin(); it != merged.end();) {
+        if (trusted(it->second, savedAt)) ++it;
+        else it = merged.erase(it);
+    }
+    for (const auto& [filePath, entry] : m_entries) {
+        if (entry.verified) merged[filePath] = entry;
+    }
+
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(16 + merged.size() * 96);
+    writer.put(static_cast<uint32_t>(merged.size()));
+    for (const auto& [filePath, entry] : merged) {
+        writer.putStr(filePath);
+        writer.put(entry.size);
+        writer.put(entry.mtime);
+        writer.put(entry.crc32);
+    }
+
+    if (!binaryFile::saveFramed(m_path, writer)) return false;
+    // 合并进来的条目按写入前的文件判定过可信，保存后仍然可信
+    for (auto& [filePath, entry] : merged) entry.verified = true;
+    m_entries = std::move(merged);
+    m_removed.clear();
+    m_dirty = false;
+    return true;
+}
+
+bool CrcCache::trusted(const Entry& entry, uint64_t savedAt) {
+    // 缓存写入前不久修改的文件可能在记录后同一时间刻度内被重写
+    return entry.verified || entry.mtime + racyWindowSeconds * fs::mtimeTicksPerSecond <= savedAt;
+}
+
+bool CrcCache::matches(const Entry& entry, const fs::FileStat& st) const {
+    return entry.size == st.size && entry.mtime == st.mtime && trusted(entry, m_savedAt);
+}
+
+int64_t CrcCache::fromFile(const std::string& path, void* buf, size_t bufSize, std::stop_token* token) {
+    fs::FileStat st;
+    if (!fs::statFile(path.c_str(), st)) return -1;
+
+    auto it = m_entries.find(path);
+    if (it != m_entries.end() && matches(it->second, st)) return it->second.crc32;
+
+    int64_t crc = crc::fromFile(path.c_str(), buf, bufSize, token);
+    if (crc < 0) return crc;
+
+    m_entries[path] = {st.size, st.mtime, static_cast<uint32_t>(crc), true};
+    m_dirty = true;
+    return crc;
+}
+
+std::vector<int64_t> CrcCache::fromFiles(const std::vector<std::string>& paths, std::stop_token token) {
+    std::vector<int64_t> crcs(paths.size(), -1);
+    std::vector<crc::FileTask> misses;
+    std::vector<std::pair<size_t, fs::FileStat>> missInfo; // 未命中文件：结果下标 + 计算前的元数据
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        fs::FileStat st;
+        if (!fs::statFile(paths[i].c_str(), st)) continue;
+        auto it = m_entries.find(paths[i]);
+        if (it != m_entries.end() && matches(it->second, st)) {
+            crcs[i] = it->second.crc32;
+            continue;
+        }
+        misses.push_back({paths[i]});
+        missInfo.emplace_back(i, st);
+    }
+    if (misses.empty()) return crcs;
+
+    crc::fromFiles(misses, token);
+    for (size_t j = 0; j < misses.size(); ++j) {
+        if (misses[j].crc < 0) continue;
+        const auto& [index, st] = missInfo[j];
+        crcs[index] = misses[j].crc;
+        m_entries[paths[index]] = {st.size, st.mtime, static_cast<uint32_t>(misses[j].crc), true};
+        m_dirty = true;
+    }
+    return crcs;
+}
+
+void CrcCache::record(const std::string& path, uint32_t crc32) {
+    fs::FileStat st;
+    if (!fs::statFile(path.c_str(), st)) return;
+    m_entries[path] = {st.size, st.mtime, crc32, true};
+    m_dirty = true;
+}
+
+size_t CrcCache::prune(std::stop_token token) {
+    size_t removed = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (token.stop_requested()) break;
+        fs::FileStat st;
+        if (fs::statFile(it->first.c_str(), st) && st.size == it->second.size && st.mtime == it->second.mtime) {
+            ++it;
+            continue;
+        }
+        m_removed[it->first] = it->second;
+        it = m_entries.erase(it);
+        ++removed;
+    }
+    if (removed > 0) m_dirty = true;
+    return removed;
+}
@@ -5,6 +5,9 @@
 #include "core/modInstaller/install.hpp"
 #include "core/modInstaller/installZip.hpp"
 #include "core/modInstaller/installDir.hpp"
+#include "core/modInstaller/uninstallManifest.hpp"
+#include "core/modInstaller/utils.hpp"
+#include "utils/fsHelper.hpp"
 
 namespace ModInstaller {
 
@@ -14,10 +17,27 @@ InstallResult install(const ModInfo& mod, const GameInfo& game, ModGameType modG
     return installFromDir(mod, game, modGameType, allMods, progressCb, token);
 }
 
+InstallResult installStreaming(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::shared_ptr<PartialFile> source, std::function<void(const Progress&)> progressCb, std::stop_token token) {
+
+    return installFromZipStream(mod, game, modGameType, allMods, std::move(source), progressCb, token);
+}
+
 UninstallResult uninstall(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, std::function<void(const Progress&)> progressCb) {
 
-    if (mod.isZip) return uninstallZip(mod, game, modGameType, progressCb);
-    return uninstallDir(mod, game, modGameType, progressCb);
+    // 优先使用安装清单；旧版本安装（无清单）或清单损坏时回退到重新扫描源文件
+    std::string manifestPath = InstallManifest::pathOf(game.dirPath, mod.dirName);
+    InstallManifest manifest;
+    UninstallResult result;
+
+    if (manifest.load(manifestPath)) result = uninstallFromManifest(manifest, mod, game, modGameType, progressCb);
+    else if (mod.isZip) result = uninstallZip(mod, game, modGameType, progressCb);
+    else result = uninstallDir(mod, game, modGameType, progressCb);
+
+    if (result.success) {
+        fs::deleteFile(manifestPath);
+        utils::forgetInstalledFiles(game.dirPath, mod.dirName);
+    }
+    return result;
 }
 
 } // namespace ModInstaller
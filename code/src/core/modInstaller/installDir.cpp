@@ -5,6 +5,8 @@
 #include "core/modInstaller/installDir.hpp"
 #include "core/modInstaller/utils.hpp"
 #include "core/modInstaller/specialRules.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "core/modInstaller/crcCache.hpp"
 #include "utils/fsHelper.hpp"
 #include "utils/crc32.hpp"
 #include "utils/format.hpp"
@@ -25,6 +27,8 @@ struct DirModFile {
     std::string targetPath;   // pchtxt 为空，安装时由转换结果决定
     int64_t size;
     bool skip = false;
+    std::string standardPath; // 特殊规则处理前的目标路径（写入安装清单）
+    uint32_t crc32 = 0;       // 安装时计算的 CRC32（写入安装清单）
 };
 
 struct DirScanResult {
@@ -81,7 +85,7 @@ DirScanResult scanDirMod(const std::string& modPath, const std::string& tid, boo
                 }
 
                 if (utils::endsWith(relPath, pchtxtExt)) {
-                    result.files.push_back({std::move(fullPath), {}, e.fileSize});
+                    result.files.push_back({std::move(fullPath), {}, e.fileSize, false, {}, 0});
                     int totalFiles = static_cast<int>(result.files.size());
                     if (progressCb && (totalFiles % 1000 == 0)) progressCb({false, 0, totalFiles, brls::getStr("other/installer/scanningFiles"), 0, 0});
                     continue;
@@ -89,7 +93,7 @@ DirScanResult scanDirMod(const std::string& modPath, const std::string& tid, boo
 
                 std::string target = utils::buildTargetPath(relPath, tid);
                 if (target.empty()) continue;
-                result.files.push_back({std::move(fullPath), std::move(target), e.fileSize});
+                result.files.push_back({std::move(fullPath), std::move(target), e.fileSize, false, {}, 0});
                 int totalFiles = static_cast<int>(result.files.size());
                 if (progressCb && (totalFiles % 1000 == 0)) progressCb({false, 0, totalFiles, brls::getStr("other/installer/scanningFiles"), 0, 0});
             }
@@ -108,6 +112,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
     if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
 
     InstallResult result{};
+    utils::PhaseTimer timer;
     std::string tid = format::appIdHex(game.appId);
     std::string gameDirName = format::gameDirName(game.dirPath);
 
@@ -146,40 +151,78 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
     ModFileRefCount refCount;
     refCount.load(game.dirPath + config::refCountFile);
 
+    // CRC 缓存：目标与源文件元数据未变化时不再读取内容
+    CrcCache crcCache;
+    crcCache.load(CrcCache::pathOf(game.dirPath));
+    result.phases.scan = timer.lap();
+
     if (progressCb) progressCb({false, 0, totalFiles, brls::getStr("other/installer/detectingConflicts"), 0, 0});
 
+    InstallManifest manifest;
+    std::vector<utils::ConflictFile> conflicts;
     int copiedFiles = 0;
+
+    // 先套用特殊规则得到全部目标路径，再批量并发计算 CRC：
+    // 目标文件全部计算，源文件只计算目标已存在的那部分
+    std::vector<std::string> targetPaths;
+    targetPaths.reserve(totalFiles);
     for (int i = 0; i < totalFiles; ++i) {
-        if (token.stop_requested()) return result;
         auto& file = scan.files[i];
-        if (file.targetPath.empty()) continue;
+        if (file.targetPath.empty()) {
+            manifest.setHasPchtxt();
+            continue;
+        }
+        file.standardPath = file.targetPath;
         if (!specialRules.apply(file.targetPath)) {
             result.errorFile = file.targetPath;
             result.errorMsg = brls::getStr("other/installer/mhrisePatchNoLimit");
             return result;
         }
+        targetPaths.push_back(file.targetPath);
+    }
+    auto diskCrcs = crcCache.fromFiles(targetPaths, token);
+
+    std::vector<std::string> sourcePaths;
+    for (int i = 0, t = 0; i < totalFiles; ++i) {
+        if (scan.files[i].targetPath.empty()) continue;
+        if (diskCrcs[t++] >= 0) sourcePaths.push_back(scan.files[i].sourcePath);
+    }
+    auto srcCrcs = crcCache.fromFiles(sourcePaths, token);
 
-        int64_t diskCrc = crc::fromFile(file.targetPath.c_str(), buf.crc, crcBufSize, &token);
+    // 发现冲突后继续检查剩余文件，写盘前一次性报告全部冲突 MOD
+    for (int i = 0, t = 0, s = 0; i < totalFiles; ++i) {
+        if (token.stop_requested()) return result;
+        auto& file = scan.files[i];
+        if (file.targetPath.empty()) continue;
+        int64_t diskCrc = diskCrcs[t++];
         if (diskCrc < 0) continue;
 
-        int64_t srcCrc = crc::fromFile(file.sourcePath.c_str(), buf.crc, crcBufSize, &token);
+        int64_t srcCrc = srcCrcs[s++];
         if (srcCrc < 0 || static_cast<uint32_t>(srcCrc) != static_cast<uint32_t>(diskCrc)) {
-            if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/checkingConflicts"), 0, 0});
-            result.errorFile = file.targetPath;
-            result.conflictMod = utils::findConflictModName(file.targetPath, static_cast<uint32_t>(srcCrc), allMods, buf.crc, crcBufSize, &token);
-            result.errorMsg = brls::getStr("other/installer/modConflict");
-            return result;
+            conflicts.push_back({file.targetPath, static_cast<uint32_t>(srcCrc), static_cast<uint32_t>(diskCrc)});
+            continue;
         }
 
         file.skip = true;
+        file.crc32 = static_cast<uint32_t>(diskCrc);
         ++copiedFiles;
         refCount.increment(file.targetPath);
         if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/detectingConflicts"), 0, 0});
     }
 
+    if (!conflicts.empty()) {
+        if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/checkingConflicts"), 0, 0});
+        crcCache.save();
+        utils::reportConflicts(result, conflicts, game.dirPath, allMods, buf.crc, crcBufSize, &token);
+        return result;
+    }
+
+    result.phases.conflict = timer.lap();
+
     // 创建目录
     if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/buildingDirs"), 0, 0});
 
+    manifest.setDirs(scan.dirs);
     for (auto& targetDir : scan.dirs) specialRules.applyDirectory(targetDir);
 
     utils::CreateDirsResult dirResult = utils::createDirs(scan.dirs);
@@ -191,6 +234,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
         result.errorMsg = dirResult.errorMsg;
         return result;
     }
+    result.phases.mkdir = timer.lap();
 
     bool cancelled = false;
     bool failed = false;
@@ -235,7 +279,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
             break;
         }
 
-        const auto& file = scan.files[i];
+        auto& file = scan.files[i];
         if (file.skip) continue;
         const char* fileName = utils::lastSegment(file.sourcePath);
 
@@ -292,6 +336,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
                 break;
             }
 
+            file.crc32 = crc::fromBuffer(0, static_cast<char*>(buf.io) + cacheSize, bytesRead);
             cache.push_back({file.targetPath, cacheSize, bytesRead});
             cacheSize += bytesRead;
             if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/aggregatingFiles"), static_cast<int64_t>(cacheSize), static_cast<int64_t>(cacheMemLimit)});
@@ -340,6 +385,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
                 writeError = true;
                 break;
             }
+            file.crc32 = crc::fromBuffer(file.crc32, buf.io, bytesRead);
 
             written += static_cast<int64_t>(bytesRead);
             if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, written, file.size});
@@ -358,6 +404,7 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
     if (!failed && !cancelled) {
         flushCache();
     }
+    result.phases.write = timer.lap();
 
     // 失败/取消 → 回滚
     if (failed || cancelled) {
@@ -367,6 +414,20 @@ InstallResult installFromDir(const ModInfo& mod, const GameInfo& game, ModGameTy
 
     refCount.save();
     specialRules.save();
+
+    // 新写入的文件 CRC 已在复制时算出，直接记入缓存，下次覆盖安装无需回读
+    for (const auto& file : scan.files) {
+        if (file.targetPath.empty()) continue;
+        manifest.addFile({file.standardPath, file.targetPath, file.size, file.crc32, file.skip});
+        if (file.skip) continue;
+        crcCache.record(file.targetPath, file.crc32);
+        crcCache.record(file.sourcePath, file.crc32);
+    }
+    manifest.save(InstallManifest::pathOf(game.dirPath, mod.dirName));
+    utils::recordInstalledFiles(game.dirPath, mod.dirName, manifest);
+    crcCache.save();
+
+    result.phases.save = timer.lap();
     result.success = true;
     return result;
 }
@@ -376,6 +437,7 @@ UninstallResult uninstallDir(const ModInfo& mod, const GameInfo& game, ModGameTy
     if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
 
     UninstallResult result{};
+    utils::PhaseTimer timer;
     std::string tid = format::appIdHex(game.appId);
     std::string gameDirName = format::gameDirName(game.dirPath);
     fs::deleteFile(contentsPath + "/" + tid + "/romfs_metadata.bin");
@@ -401,6 +463,7 @@ UninstallResult uninstallDir(const ModInfo& mod, const GameInfo& game, ModGameTy
 
     ModFileRefCount refCount;
     refCount.load(game.dirPath + config::refCountFile);
+    result.phases.scan = timer.lap();
 
     for (int i = 0; i < totalFiles; ++i) {
         const auto& file = scan.files[i];
@@ -422,15 +485,19 @@ UninstallResult uninstallDir(const ModInfo& mod, const GameInfo& game, ModGameTy
         if (refCount.decrement(targetPath)) fs::deleteFile(targetPath);
     }
 
+    result.phases.write = timer.lap();
+
     for (int i = static_cast<int>(scan.dirs.size()) - 1; i >= 0; --i) {
         fs::deleteEmptyDir(scan.dirs[i]);
     }
+    result.phases.mkdir = timer.lap();
 
     refCount.save();
     if (!specialRules.save()) {
         result.errorMsg = brls::getStr("other/installer/mhriseReorderFailed");
         return result;
     }
+    result.phases.save = timer.lap();
     result.success = true;
     return result;
 }
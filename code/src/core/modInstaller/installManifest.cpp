@@ -0,0 +1,91 @@
+/**
+ * InstallManifest - 单个 MOD 的安装清单实现
+ */
+
+#include "core/modInstaller/installManifest.hpp"
+#include "common/config.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'M', 'F'};
+    constexpr uint32_t version = 1;
+
+    constexpr uint8_t flagHasPchtxt = 0x01;  // 清单标志：包含 pchtxt
+    constexpr uint8_t flagShared = 0x01;     // 文件标志：共享文件
+
+} // namespace
+
+std::string InstallManifest::pathOf(const std::string& gameDirPath, const std::string& modDirName) {
+    return gameDirPath + "/" + modDirName + config::installManifestExt;
+}
+
+bool InstallManifest::load(const std::string& path) {
+    m_files.clear();
+    m_dirs.clear();
+    m_hasPchtxt = false;
+
+    auto data = fs::readFile(path);
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    if (!reader.ok) return false;
+
+    uint32_t fileCount = reader.get<uint32_t>();
+    uint32_t dirCount = reader.get<uint32_t>();
+    uint8_t flags = reader.get<uint8_t>();
+    reader.skip(3);
+    m_hasPchtxt = flags & flagHasPchtxt;
+
+    m_files.reserve(fileCount);
+    for (uint32_t i = 0; i < fileCount && reader.ok; ++i) {
+        ManifestFile file;
+        file.crc32 = reader.get<uint32_t>();
+        file.shared = reader.get<uint8_t>() & flagShared;
+        file.size = reader.get<int64_t>();
+        file.targetPath = reader.getStr();
+        file.installedPath = reader.getStr();
+        if (file.installedPath.empty()) file.installedPath = file.targetPath;
+        m_files.push_back(std::move(file));
+    }
+
+    m_dirs.reserve(dirCount);
+    for (uint32_t i = 0; i < dirCount && reader.ok; ++i) {
+        m_dirs.push_back(reader.getStr());
+    }
+
+    if (!reader.finished()) {
+        m_files.clear();
+        m_dirs.clear();
+        m_hasPchtxt = false;
+        return false;
+    }
+    return true;
+}
+
+bool InstallManifest::save(const std::string& path) const {
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(64 + m_files.size() * 96);
+    writer.put(static_cast<uint32_t>(m_files.size()));
+    writer.put(static_cast<uint32_t>(m_dirs.size()));
+    writer.put(static_cast<uint8_t>(m_hasPchtxt ? flagHasPchtxt : 0));
+    for (int i = 0; i < 3; ++i) writer.put(static_cast<uint8_t>(0));
+
+    for (const auto& file : m_files) {
+        writer.put(file.crc32);
+        writer.put(static_cast<uint8_t>(file.shared ? flagShared : 0));
+        writer.put(file.size);
+        writer.putStr(file.targetPath);
+        writer.putStr(file.installedPath == file.targetPath ? std::string() : file.installedPath);
+    }
+    for (const auto& dir : m_dirs) writer.putStr(dir);
+
+    return binaryFile::saveFramed(path, writer);
+}
+
+void InstallManifest::addFile(ManifestFile file) {
+    m_files.push_back(std::move(file));
+}
+
+void InstallManifest::setDirs(std::vector<std::string> dirs) {
+    m_dirs = std::move(dirs);
+}
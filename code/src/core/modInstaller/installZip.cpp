@@ -3,17 +3,26 @@
  */
 
 #include "core/modInstaller/installZip.hpp"
+#include "core/modInstaller/chunkRing.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "core/modInstaller/crcCache.hpp"
 #include "core/modInstaller/utils.hpp"
 #include "core/modInstaller/specialRules.hpp"
 #include "core/modInstaller/modFileRefCount.hpp"
 #include "common/config.hpp"
 #include "utils/fsHelper.hpp"
+#include "utils/partialFile.hpp"
 #include "utils/zipReader.hpp"
 #include "utils/crc32.hpp"
 #include "utils/format.hpp"
+#include "utils/threadPool.hpp"
 #include <borealis/core/i18n.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace ModInstaller {
 
@@ -23,6 +32,7 @@ struct ZipModFile {
     const ZipEntry* entry;
     std::string targetPath;   // pchtxt 为空，安装时由转换结果决定
     bool skip = false;        // CRC 匹配后标记跳过，不需复制
+    std::string standardPath; // 特殊规则处理前的目标路径（写入安装清单）
 };
 
 std::vector<ZipModFile> buildModFileList(const std::vector<ZipEntry>& files, const std::string& tid) {
@@ -31,32 +41,162 @@ std::vector<ZipModFile> buildModFileList(const std::vector<ZipEntry>& files, con
         if (utils::hasDotPathSegment(entry.path)) continue;
 
         if (utils::endsWith(entry.path, pchtxtExt)) {
-            modFiles.push_back({&entry, {}});
+            modFiles.push_back({&entry, {}, false, {}});
         } else {
             std::string target = utils::buildTargetPath(entry.path, tid);
             if (target.empty()) continue;
-            modFiles.push_back({&entry, std::move(target)});
+            modFiles.push_back({&entry, std::move(target), false, {}});
         }
     }
     return modFiles;
 }
 
-} // namespace
+/** @brief 单个待解压文件在流水线中的编号 */
+struct ExtractJob {
+    int fileIndex;      // 安装列表下标
+    int64_t firstSeq;   // 第一个数据块的序号
+    int64_t chunkCount; // 数据块数量（能装入单个槽位的条目为 1）
+};
 
-InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::function<void(const Progress&)> progressCb, std::stop_token token) {
+/**
+ * @brief 为未跳过的文件按安装顺序分配数据块序号
+ * @param modFiles 安装文件列表
+ * @param slotSize 单个槽位大小
+ * @param totalChunks 输出数据块总数
+ * @return 解压任务列表
+ */
+std::vector<ExtractJob> buildExtractJobs(const std::vector<ZipModFile>& modFiles, size_t slotSize, int64_t& totalChunks) {
+    std::vector<ExtractJob> jobs;
+    totalChunks = 0;
+    int64_t slot = static_cast<int64_t>(slotSize);
 
-    if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
+    for (int i = 0; i < static_cast<int>(modFiles.size()); ++i) {
+        if (modFiles[i].skip) continue;
+        int64_t size = modFiles[i].entry->uncompressedSize;
+        // pchtxt 需整体转换，写入线程拼接各块；超过 ioBufSize 的按一块提交，解压失败后报错
+        bool oversizedPchtxt = modFiles[i].targetPath.empty() && size > static_cast<int64_t>(ioBufSize);
+        int64_t chunks = (oversizedPchtxt || size <= slot) ? 1 : (size + slot - 1) / slot;
+        jobs.push_back({i, totalChunks, chunks});
+        totalChunks += chunks;
+    }
+    return jobs;
+}
 
-    InstallResult result{};
+/**
+ * @brief 从流式读取器读满指定长度（迭代器单次可能返回不足）
+ * @return 实际读取字节数，小于 want 表示读取失败
+ */
+size_t readFull(ZipCursor& cursor, void* buf, size_t want) {
+    size_t total = 0;
+    while (total < want) {
+        size_t bytesRead = cursor.read(static_cast<char*>(buf) + total, want - total);
+        if (bytesRead == 0) break;
+        total += bytesRead;
+    }
+    return total;
+}
 
-    std::string zipPath = utils::getZipModFilePath(mod.path);
-    if (zipPath.empty()) {
-        result.errorFile = mod.path;
-        result.errorMsg = brls::getStr("other/installer/zipNotFound");
-        return result;
+/**
+ * @brief 解压单个文件到缓冲环
+ * 能装入单个槽位的条目一次性解压为一块，更大的条目流式拆分为多块；
+ * 失败时提交一个失败块，由写入线程负责报错与回滚
+ * @return 是否成功（失败或环被关闭时返回 false）
+ */
+bool extractJob(ZipCursor& cursor, const ZipModFile& file, const ExtractJob& job, ChunkRing& ring, std::stop_token token) {
+    const ZipEntry& entry = *file.entry;
+    const size_t slotSize = ring.slotSize();
+
+    void* slot = ring.acquire(job.firstSeq);
+    if (!slot) return false;
+
+    // 小文件（含小 pchtxt）：一次性解压为一块
+    if (job.chunkCount == 1) {
+        size_t bytesRead = cursor.readFile(entry, slot, slotSize);
+        bool emptyFile = entry.uncompressedSize == 0 && !file.targetPath.empty();
+        if (bytesRead == 0 && !emptyFile) {
+            ring.release(slot);
+            ring.push({job.fileIndex, job.firstSeq, nullptr, 0, true, true, ChunkStatus::ExtractFailed});
+            return false;
+        }
+        ring.push({job.fileIndex, job.firstSeq, slot, bytesRead, true, true, ChunkStatus::Data});
+        return true;
     }
 
-    ZipReader zip(zipPath);
+    // 大文件与大 pchtxt：流式分块
+    if (!cursor.beginRead(entry)) {
+        ring.release(slot);
+        ring.push({job.fileIndex, job.firstSeq, nullptr, 0, true, true, ChunkStatus::ReadFailed});
+        return false;
+    }
+
+    int64_t remaining = entry.uncompressedSize;
+    bool ok = true;
+
+    for (int64_t c = 0; c < job.chunkCount; ++c) {
+        int64_t seq = job.firstSeq + c;
+        if (c > 0) {
+            if (token.stop_requested()) {
+                ring.close();
+                ok = false;
+                break;
+            }
+            slot = ring.acquire(seq);
+            if (!slot) {
+                ok = false;
+                break;
+            }
+        }
+
+        size_t want = static_cast<size_t>(std::min<int64_t>(remaining, static_cast<int64_t>(slotSize)));
+        size_t bytesRead = readFull(cursor, slot, want);
+        if (bytesRead != want) {
+            ring.release(slot);
+            ring.push({job.fileIndex, seq, nullptr, 0, c == 0, true, ChunkStatus::ReadFailed});
+            ok = false;
+            break;
+        }
+
+        remaining -= static_cast<int64_t>(bytesRead);
+        ring.push({job.fileIndex, seq, slot, bytesRead, c == 0, c == job.chunkCount - 1, ChunkStatus::Data});
+    }
+
+    cursor.endRead();
+    return ok;
+}
+
+/**
+ * @brief 解压线程：从共享任务计数器领取文件，用自己的游标解压进缓冲环
+ * 多个解压线程并行领取，序号在领取前已确定，写入线程仍按安装顺序写盘
+ * @param cursor 本线程独占的解码游标
+ * @param modFiles 安装文件列表
+ * @param jobs 解压任务列表
+ * @param nextJob 下一个待领取的任务下标
+ * @param ring 缓冲环
+ * @param token 取消令牌
+ */
+void extractWorker(ZipCursor& cursor, const std::vector<ZipModFile>& modFiles, const std::vector<ExtractJob>& jobs, std::atomic<size_t>& nextJob, ChunkRing& ring, std::stop_token token) {
+    while (true) {
+        size_t j = nextJob.fetch_add(1);
+        if (j >= jobs.size()) return;
+
+        // 取消时关闭缓冲环，写入线程随之退出等待
+        if (token.stop_requested()) {
+            ring.close();
+            return;
+        }
+        if (!extractJob(cursor, modFiles[jobs[j].fileIndex], jobs[j], ring, token)) return;
+    }
+}
+
+/**
+ * @brief 从已打开的 ZIP 安装：冲突检测、建目录、解压写盘、保存记录
+ * @param zip ZIP 读取器（本地文件或下载中的文件）
+ * @param zipPath ZIP 文件路径（用于报错）
+ * @param timer 阶段计时（调用方打开 ZIP 前开始）
+ */
+InstallResult installFromReader(ZipReader& zip, const std::string& zipPath, const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::function<void(const Progress&)> progressCb, std::stop_token token, utils::PhaseTimer& timer) {
+
+    InstallResult result{};
     if (!zip.isOpen()) {
         result.errorFile = zipPath;
         result.errorMsg = brls::getStr("other/installer/zipOpenFailed");
@@ -83,9 +223,10 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
 
     if (progressCb) progressCb({false, 0, totalFiles, brls::getStr("other/installer/scanningFiles"), 0, 0});
 
-    // 分配缓冲区
+    // 分配缓冲区（解压与写入之间通过缓冲环传递数据）
     utils::InstallBuf buf;
-    if (!buf.alloc()) {
+    ChunkRing ring;
+    if (!buf.alloc(false) || !ring.alloc(ringSlotCount, ringSlotSize)) {
         result.errorMsg = brls::getStr("other/installer/memAllocFailed");
         return result;
     }
@@ -93,29 +234,47 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
     ModFileRefCount refCount;
     refCount.load(game.dirPath + config::refCountFile);
 
+    // CRC 缓存：目标文件元数据未变化时不再读取内容（源文件 CRC 直接取自 ZIP 中央目录）
+    CrcCache crcCache;
+    crcCache.load(CrcCache::pathOf(game.dirPath));
+    result.phases.scan = timer.lap();
+
     if (progressCb) progressCb({false, 0, totalFiles, brls::getStr("other/installer/detectingConflicts"), 0, 0});
 
     int copiedFiles = 0;
 
+    InstallManifest manifest;
+    std::vector<utils::ConflictFile> conflicts;
+
     // CRC 冲突检测（独立阶段，避免与解压写入交替刷 FS 缓存）
+    // 先套用特殊规则得到全部目标路径，再批量并发计算磁盘上已有文件的 CRC
+    std::vector<std::string> targetPaths;
+    targetPaths.reserve(totalFiles);
     for (int i = 0; i < totalFiles; ++i) {
-        if (token.stop_requested()) return result;
-        if (modFiles[i].targetPath.empty()) continue;
+        if (modFiles[i].targetPath.empty()) {
+            manifest.setHasPchtxt();
+            continue;
+        }
+        modFiles[i].standardPath = modFiles[i].targetPath;
         if (!specialRules.apply(modFiles[i].targetPath)) {
             result.errorFile = modFiles[i].targetPath;
             result.errorMsg = brls::getStr("other/installer/mhrisePatchNoLimit");
             return result;
         }
+        targetPaths.push_back(modFiles[i].targetPath);
+    }
+    auto diskCrcs = crcCache.fromFiles(targetPaths, token);
 
-        int64_t diskCrc = crc::fromFile(modFiles[i].targetPath.c_str(), buf.crc, crcBufSize, &token);
+    // 发现冲突后继续检查剩余文件，写盘前一次性报告全部冲突 MOD
+    for (int i = 0, t = 0; i < totalFiles; ++i) {
+        if (token.stop_requested()) return result;
+        if (modFiles[i].targetPath.empty()) continue;
+        int64_t diskCrc = diskCrcs[t++];
         if (diskCrc < 0) continue;
 
         if (static_cast<uint32_t>(diskCrc) != modFiles[i].entry->crc32) {
-            if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/checkingConflicts"), 0, 0});
-            result.errorFile = modFiles[i].targetPath;
-            result.conflictMod = utils::findConflictModName(modFiles[i].targetPath, modFiles[i].entry->crc32, allMods, buf.crc, crcBufSize, &token);
-            result.errorMsg = brls::getStr("other/installer/modConflict");
-            return result;
+            conflicts.push_back({modFiles[i].targetPath, modFiles[i].entry->crc32, static_cast<uint32_t>(diskCrc)});
+            continue;
         }
 
         modFiles[i].skip = true;
@@ -124,12 +283,39 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
         if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/detectingConflicts"), 0, 0});
     }
 
+    if (!conflicts.empty()) {
+        if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/checkingConflicts"), 0, 0});
+        crcCache.save();
+        utils::reportConflicts(result, conflicts, game.dirPath, allMods, buf.crc, crcBufSize, &token);
+        return result;
+    }
+
+    // 为每个解压线程打开独立游标（至少一个，否则无法解压）
+    int64_t totalChunks = 0;
+    auto jobs = buildExtractJobs(modFiles, ring.slotSize(), totalChunks);
+    int workerCount = std::min<int>(extractWorkerCount, static_cast<int>(jobs.size()));
+
+    std::vector<std::unique_ptr<ZipCursor>> cursors;
+    for (int i = 0; i < workerCount; ++i) {
+        auto cursor = zip.openCursor();
+        if (!cursor->isOpen()) break;
+        cursors.push_back(std::move(cursor));
+    }
+    if (cursors.empty() && !jobs.empty()) {
+        result.errorFile = zipPath;
+        result.errorMsg = brls::getStr("other/installer/zipOpenFailed");
+        return result;
+    }
+
+    result.phases.conflict = timer.lap();
+
     // 创建目录
     if (progressCb) progressCb({false, copiedFiles, totalFiles, brls::getStr("other/installer/buildingDirs"), 0, 0});
 
     auto targetDirs = utils::buildTargetDirs(zip.dirs(), tid, true);
     std::vector<std::string> writtenFiles;
 
+    manifest.setDirs(targetDirs);
     for (auto& targetDir : targetDirs) specialRules.applyDirectory(targetDir);
 
     utils::CreateDirsResult dirResult = utils::createDirs(targetDirs);
@@ -139,37 +325,66 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
         result.errorMsg = dirResult.errorMsg;
         return result;
     }
+    result.phases.mkdir = timer.lap();
 
     bool cancelled = false;
     bool failed = false;
 
-    // 解压 + 写入
-    for (int i = 0; i < totalFiles; ++i) {
+    // 解压线程并行填充缓冲环，当前线程按序号顺序写盘，SD 写入与解压重叠进行
+    ring.start(totalChunks);
+    std::atomic<size_t> nextJob{0};
+    std::vector<WaitableTask> extractTasks;
+    for (auto& cursor : cursors) {
+        extractTasks.push_back(ThreadPool::instance().submitWaitable([&cursor, &modFiles, &jobs, &nextJob, &ring](std::stop_token tk) {
+            extractWorker(*cursor, modFiles, jobs, nextJob, ring, tk);
+        }, token));
+    }
+
+    std::optional<fs::FileWriter> writer;  // 正在流式写入的大文件
+    int writerIndex = -1;                  // 流式写入文件的下标
+    int64_t written = 0;                   // 流式写入文件的已写字节数
+    std::vector<uint8_t> pchtxtData;       // 分多块解压的 pchtxt 拼接结果
+    Chunk chunk;
+
+    while (ring.pop(chunk)) {
         if (token.stop_requested()) {
             cancelled = true;
             break;
         }
-        if (modFiles[i].skip) continue;
 
-        const char* fileName = utils::lastSegment(modFiles[i].entry->path);
+        const ZipModFile& file = modFiles[chunk.fileIndex];
+        const char* fileName = utils::lastSegment(file.entry->path);
+        int64_t fileSize = file.entry->uncompressedSize;
 
-        // pchtxt → 转换为 IPS 写入
-        if (modFiles[i].targetPath.empty()) {
-            
-            if (progressCb) progressCb({false, copiedFiles + 1, totalFiles, fileName, 0, modFiles[i].entry->uncompressedSize});
+        if (chunk.status != ChunkStatus::Data) {
+            result.errorFile = file.entry->path;
+            if (file.targetPath.empty()) result.errorMsg = brls::getStr("other/installer/readPchtxtFailed");
+            else if (chunk.status == ChunkStatus::ExtractFailed) result.errorMsg = brls::getStr("other/installer/zipExtractFailed");
+            else result.errorMsg = brls::getStr("other/installer/zipReadFailed");
+            failed = true;
+            break;
+        }
 
-            size_t pchtxtSize = zip.readFile(*modFiles[i].entry, buf.io, ioBufSize);
-            if (pchtxtSize == 0) {
-                result.errorFile = modFiles[i].entry->path;
-                result.errorMsg = brls::getStr("other/installer/readPchtxtFailed");
-                failed = true;
-                break;
+        // pchtxt → 转换为 IPS 写入（分多块时拼接完整后再转换）
+        if (file.targetPath.empty()) {
+            bool whole = chunk.first && chunk.last;
+            if (!whole) {
+                if (chunk.first) pchtxtData.reserve(static_cast<size_t>(fileSize));
+                auto* bytes = static_cast<const uint8_t*>(chunk.data);
+                pchtxtData.insert(pchtxtData.end(), bytes, bytes + chunk.size);
+                ring.release(chunk.data);
+                if (!chunk.last) continue;
             }
 
-            auto pchtxt = utils::writePchtxt(buf.io, pchtxtSize, mod.dirName, gameDirName);
+            if (progressCb) progressCb({false, copiedFiles + 1, totalFiles, fileName, 0, fileSize});
+
+            auto pchtxt = whole ? utils::writePchtxt(chunk.data, chunk.size, mod.dirName, gameDirName)
+                                : utils::writePchtxt(pchtxtData.data(), pchtxtData.size(), mod.dirName, gameDirName);
+            if (whole) ring.release(chunk.data);
+            std::vector<uint8_t>().swap(pchtxtData);
             if (!pchtxt.success) {
                 if (!pchtxt.ipsPath.empty()) writtenFiles.push_back(pchtxt.ipsPath);
-                result.errorFile = pchtxt.ipsDir.empty() ? modFiles[i].entry->path : pchtxt.ipsDir;
+                result.errorFile = pchtxt.ipsDir.empty() ? file.entry->path : pchtxt.ipsDir;
                 result.errorMsg = pchtxt.errorMsg;
                 failed = true;
                 break;
@@ -180,86 +395,76 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
             continue;
         }
 
-        // 普通文件
-        if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, 0, modFiles[i].entry->uncompressedSize});
-
-        // 小文件：一次性解压 + 写入
-        if (modFiles[i].entry->uncompressedSize <= static_cast<int64_t>(ioBufSize)) {
-            size_t bytesRead = zip.readFile(*modFiles[i].entry, buf.io, ioBufSize);
-
-            if (bytesRead == 0 && modFiles[i].entry->uncompressedSize > 0) {
-                result.errorFile = modFiles[i].entry->path;
-                result.errorMsg = brls::getStr("other/installer/zipExtractFailed");
-                failed = true;
-                break;
-            }
+        // 小文件：整块写入
+        if (chunk.first && chunk.last) {
+            if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, 0, fileSize});
 
-            uint32_t rc = fs::writeFile(modFiles[i].targetPath, buf.io, bytesRead);
+            uint32_t rc = fs::writeFile(file.targetPath, chunk.data, chunk.size);
+            ring.release(chunk.data);
+            writtenFiles.push_back(file.targetPath);
             if (rc != 0) {
-                writtenFiles.push_back(modFiles[i].targetPath);
-                result.errorFile = modFiles[i].targetPath;
+                result.errorFile = file.targetPath;
                 result.errorMsg = brls::getStr("other/installer/writeFailed", format::resultHex(rc));
                 failed = true;
                 break;
             }
-
-            writtenFiles.push_back(modFiles[i].targetPath);
             ++copiedFiles;
             continue;
         }
 
-        if (!zip.beginRead(*modFiles[i].entry)) {
-            result.errorFile = modFiles[i].entry->path;
-            result.errorMsg = brls::getStr("other/installer/zipReadFailed");
-            failed = true;
-            break;
+        // 大文件：首块创建文件，逐块流式写入
+        if (chunk.first) {
+            if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, 0, fileSize});
+
+            writer.emplace();
+            uint32_t rc = writer->open(file.targetPath, fileSize);
+            if (rc != 0) {
+                writer.reset();
+                ring.release(chunk.data);
+                result.errorFile = file.targetPath;
+                result.errorMsg = brls::getStr("other/installer/createFileFailed", format::resultHex(rc));
+                failed = true;
+                break;
+            }
+            writerIndex = chunk.fileIndex;
+            written = 0;
         }
 
-        // 大文件：流式分块读写
-        fs::FileWriter writer;
-        uint32_t rc = writer.open(modFiles[i].targetPath, modFiles[i].entry->uncompressedSize);
+        uint32_t rc = writer->write(chunk.data, chunk.size);
+        ring.release(chunk.data);
         if (rc != 0) {
-            zip.endRead();
-            result.errorFile = modFiles[i].targetPath;
-            result.errorMsg = brls::getStr("other/installer/createFileFailed", format::resultHex(rc));
+            result.errorFile = file.targetPath;
+            result.errorMsg = brls::getStr("other/installer/writeFailed", format::resultHex(rc));
             failed = true;
             break;
         }
 
-        int64_t written = 0;
-        bool writeError = false;
-        size_t bytesRead;
-
-        while ((bytesRead = zip.read(buf.io, ioBufSize)) > 0) {
-            if (token.stop_requested()) {
-                cancelled = true;
-                break;
-            }
-
-            rc = writer.write(buf.io, bytesRead);
-            if (rc != 0) {
-                result.errorFile = modFiles[i].targetPath;
-                result.errorMsg = brls::getStr("other/installer/writeFailed", format::resultHex(rc));
-                writeError = true;
-                break;
-            }
+        written += static_cast<int64_t>(chunk.size);
+        if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, written, fileSize});
 
-            written += static_cast<int64_t>(bytesRead);
-            if (progressCb) progressCb({false, copiedFiles, totalFiles, fileName, written, modFiles[i].entry->uncompressedSize});
+        if (chunk.last) {
+            writer.reset();
+            writerIndex = -1;
+            writtenFiles.push_back(file.targetPath);
+            ++copiedFiles;
         }
+    }
 
-        zip.endRead();
+    // 中止解压线程并等待其退出，之后才能释放游标与缓冲环
+    ring.close();
+    extractTasks.clear();
 
-        if (writeError || cancelled) {
-            writtenFiles.push_back(modFiles[i].targetPath);
-            if (writeError) failed = true;
-            break;
-        }
+    // 解压线程因取消关闭缓冲环时，写入线程从 pop 返回，此处补记取消状态
+    if (!failed && copiedFiles < totalFiles && token.stop_requested()) cancelled = true;
 
-        writtenFiles.push_back(modFiles[i].targetPath);
-        ++copiedFiles;
+    // 写到一半的大文件同样需要回滚
+    if (writer) {
+        writer.reset();
+        writtenFiles.push_back(modFiles[writerIndex].targetPath);
     }
 
+    result.phases.write = timer.lap();
+
     // 失败或取消 → 回滚
     if (failed || cancelled) {
         utils::rollback(writtenFiles, targetDirs, progressCb);
@@ -268,15 +473,59 @@ InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameTy
 
     refCount.save();
     specialRules.save();
+
+    // 新写入文件的 CRC 即 ZIP 成员 CRC，直接记入缓存，下次覆盖安装无需回读
+    for (const auto& file : modFiles) {
+        if (file.targetPath.empty()) continue;
+        manifest.addFile({file.standardPath, file.targetPath, file.entry->uncompressedSize, file.entry->crc32, file.skip});
+        if (!file.skip) crcCache.record(file.targetPath, file.entry->crc32);
+    }
+    manifest.save(InstallManifest::pathOf(game.dirPath, mod.dirName));
+    utils::recordInstalledFiles(game.dirPath, mod.dirName, manifest);
+    crcCache.save();
+
+    result.phases.save = timer.lap();
     result.success = true;
     return result;
 }
 
+} // namespace
+
+InstallResult installFromZip(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::function<void(const Progress&)> progressCb, std::stop_token token) {
+
+    if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
+
+    utils::PhaseTimer timer;
+
+    std::string zipPath = utils::getZipModFilePath(mod.path);
+    if (zipPath.empty()) {
+        InstallResult result{};
+        result.errorFile = mod.path;
+        result.errorMsg = brls::getStr("other/installer/zipNotFound");
+        return result;
+    }
+
+    ZipReader zip(zipPath);
+    return installFromReader(zip, zipPath, mod, game, modGameType, allMods, progressCb, token, timer);
+}
+
+InstallResult installFromZipStream(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, const std::vector<ModInfo>& allMods, std::shared_ptr<PartialFile> source, std::function<void(const Progress&)> progressCb, std::stop_token token) {
+
+    if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
+
+    utils::PhaseTimer timer;
+
+    // 中央目录已在内存中，条目数据读到尚未下载的区间时解压线程等待
+    ZipReader zip(source);
+    return installFromReader(zip, source->path(), mod, game, modGameType, allMods, progressCb, token, timer);
+}
+
 UninstallResult uninstallZip(const ModInfo& mod, const GameInfo& game, ModGameType modGameType, std::function<void(const Progress&)> progressCb) {
 
     if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
 
     UninstallResult result{};
+    utils::PhaseTimer timer;
 
     std::string zipPath = utils::getZipModFilePath(mod.path);
     if (zipPath.empty()) {
@@ -318,6 +567,7 @@ UninstallResult uninstallZip(const ModInfo& mod, const GameInfo& game, ModGameTy
 
     ModFileRefCount refCount;
     refCount.load(game.dirPath + config::refCountFile);
+    result.phases.scan = timer.lap();
 
     // 遍历 files，逐个删除
     for (int i = 0; i < totalFiles; ++i) {
@@ -343,16 +593,20 @@ UninstallResult uninstallZip(const ModInfo& mod, const GameInfo& game, ModGameTy
         if (refCount.decrement(targetPath)) fs::deleteFile(targetPath);
     }
 
+    result.phases.write = timer.lap();
+
     // 遍历 dirs，倒序清理空目录
     for (int i = static_cast<int>(targetDirs.size()) - 1; i >= 0; --i) {
         fs::deleteEmptyDir(targetDirs[i]);
     }
+    result.phases.mkdir = timer.lap();
 
     refCount.save();
     if (!specialRules.save()) {
         result.errorMsg = brls::getStr("other/installer/mhriseReorderFailed");
         return result;
     }
+    result.phases.save = timer.lap();
     result.success = true;
     return result;
 }
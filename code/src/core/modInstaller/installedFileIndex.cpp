@@ -0,0 +1,161 @@
+/**
+ * InstalledFileIndex - 游戏级已安装文件索引实现
+ */
+
+#include "core/modInstaller/installedFileIndex.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "common/config.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'F', 'I'};
+    constexpr uint32_t version = 1;
+
+} // namespace
+
+std::string InstalledFileIndex::pathOf(const std::string& gameDirPath) {
+    return gameDirPath + config::installedIndexFile;
+}
+
+std::mutex& InstalledFileIndex::mutex() {
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+bool InstalledFileIndex::load(const std::string& path) {
+    m_path = path;
+    m_files.clear();
+
+    auto data = fs::readFile(path);
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    if (!reader.ok) return false;
+
+    uint32_t modCount = reader.get<uint32_t>();
+    uint32_t fileCount = reader.get<uint32_t>();
+
+    std::vector<std::string> mods;
+    mods.reserve(modCount);
+    for (uint32_t i = 0; i < modCount && reader.ok; ++i) mods.push_back(reader.getStr());
+
+    m_files.reserve(fileCount);
+    for (uint32_t i = 0; i < fileCount && reader.ok; ++i) {
+        std::string filePath = reader.getStr();
+        IndexedFile file;
+        file.crc32 = reader.get<uint32_t>();
+        file.size = reader.get<int64_t>();
+        uint8_t ownerCount = reader.get<uint8_t>();
+        for (uint8_t k = 0; k < ownerCount && reader.ok; ++k) {
+            uint16_t modIdx = reader.get<uint16_t>();
+            if (modIdx >= mods.size()) {
+                reader.ok = false;
+                break;
+            }
+            file.owners.push_back(mods[modIdx]);
+        }
+        m_files.emplace(std::move(filePath), std::move(file));
+    }
+
+    if (!reader.finished()) {
+        m_files.clear();
+        return false;
+    }
+    return true;
+}
+
+bool InstalledFileIndex::save() const {
+    if (m_path.empty()) return false;
+
+    // 所属 MOD 以下标引用，同一 MOD 名只存一次
+    std::vector<std::string> mods;
+    std::unordered_map<std::string, uint16_t> modIndex;
+    for (const auto& [path, file] : m_files) {
+        for (const auto& owner : file.owners) {
+            if (modIndex.emplace(owner, static_cast<uint16_t>(mods.size())).second) mods.push_back(owner);
+        }
+    }
+
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(64 + mods.size() * 32 + m_files.size() * 96);
+    writer.put(static_cast<uint32_t>(mods.size()));
+    writer.put(static_cast<uint32_t>(m_files.size()));
+    for (const auto& mod : mods) writer.putStr(mod);
+
+    for (const auto& [path, file] : m_files) {
+        writer.putStr(path);
+        writer.put(file.crc32);
+        writer.put(file.size);
+        size_t ownerCount = std::min<size_t>(file.owners.size(), UINT8_MAX);
+        writer.put(static_cast<uint8_t>(ownerCount));
+        for (size_t k = 0; k < ownerCount; ++k) writer.put(modIndex[file.owners[k]]);
+    }
+
+    return binaryFile::saveFramed(m_path, writer);
+}
+
+void InstalledFileIndex::rebuild(const std::string& gameDirPath, const std::vector<std::string>& modDirNames) {
+    m_files.clear();
+    for (const auto& modDirName : modDirNames) {
+        InstallManifest manifest;
+        if (manifest.load(InstallManifest::pathOf(gameDirPath, modDirName))) addMod(modDirName, manifest);
+    }
+}
+
+void InstalledFileIndex::addMod(const std::string& modDirName, const InstallManifest& manifest) {
+    removeMod(modDirName);
+
+    for (const auto& mf : manifest.files()) {
+        auto [it, inserted] = m_files.try_emplace(mf.installedPath);
+        IndexedFile& file = it->second;
+        if (inserted || file.owners.empty() || !mf.shared) {
+            // 首次写入（或覆盖了过期条目）：以本 MOD 的记录为准
+            file.crc32 = mf.crc32;
+            file.size = mf.size;
+        }
+        file.owners.push_back(modDirName);
+    }
+}
+
+void InstalledFileIndex::removeMod(const std::string& modDirName) {
+    for (auto it = m_files.begin(); it != m_files.end();) {
+        auto& owners = it->second.owners;
+        owners.erase(std::remove(owners.begin(), owners.end(), modDirName), owners.end());
+        if (owners.empty()) it = m_files.erase(it);
+        else ++it;
+    }
+}
+
+const IndexedFile* InstalledFileIndex::find(const std::string& path) const {
+    auto it = m_files.find(path);
+    return it == m_files.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> InstalledFileIndex::mods() const {
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> result;
+    for (const auto& [path, file] : m_files) {
+        for (const auto& owner : file.owners) {
+            if (seen.insert(owner).second) result.push_back(owner);
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> InstalledFileIndex::findStale(std::stop_token token) const {
+    std::vector<std::string> stale;
+    for (const auto& [path, file] : m_files) {
+        if (token.stop_requested()) break;
+        if (fs::getFileSize(path) != file.size) stale.push_back(path);
+    }
+    return stale;
+}
+
+size_t InstalledFileIndex::erase(const std::vector<std::string>& paths) {
+    size_t erased = 0;
+    for (const auto& path : paths) erased += m_files.erase(path);
+    return erased;
+}
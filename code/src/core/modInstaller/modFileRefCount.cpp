@@ -3,31 +3,262 @@
  */
 
 #include "core/modInstaller/modFileRefCount.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/crc32.hpp"
+#include "utils/fsHelper.hpp"
+#include "yyjson.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
 
 namespace {
-    constexpr const char* refCount = "refCount";
+
+    constexpr char magic[4] = {'N', 'X', 'R', 'C'};
+    constexpr uint32_t version = 1;
+    constexpr size_t headerSize = 20;
+    constexpr size_t minCompactBytes = 16 * 1024;  // 日志小于该值时不压缩，避免小表频繁重写
+    constexpr const char* refCountKey = "refCount"; // 旧版 JSON 根键
+
+    using binaryFile::peek;
+
+    /** @brief 追加一条 u32 计数 | u16 长度 + 路径 记录 */
+    void putRecord(binaryFile::Writer& writer, std::string_view path, uint32_t count) {
+        writer.put(count);
+        writer.put(static_cast<uint16_t>(path.size()));
+        writer.putBytes(path.data(), path.size());
+    }
+
+} // namespace
+
+std::pair<std::string, std::string> ModFileRefCount::auxPaths(const std::string& path) {
+    size_t dot = path.rfind('.');
+    size_t slash = path.rfind('/');
+    std::string stem = (dot != std::string::npos && (slash == std::string::npos || dot > slash)) ? path.substr(0, dot) : path;
+    return {stem + ".json", binaryFile::tempPath(path)};
+}
+
+void ModFileRefCount::reset() {
+    m_snapshot.clear();
+    m_snapshotEntries = 0;
+    m_overlay.clear();
+    m_dirty.clear();
+    m_journalBytes = 0;
+    m_needCompact = false;
+    m_migratedFrom.clear();
 }
 
 bool ModFileRefCount::load(const std::string& path) {
-    return m_json.load(path);
+    m_path = path;
+    reset();
+
+    auto [legacyPath, tmpPath] = auxPaths(path);
+
+    auto data = fs::readFile(path);
+    bool hadFile = !data.empty();
+    if (hadFile && parse(data)) return true;
+
+    // 原文件缺失或损坏：压缩替换中途掉电时临时文件仍然完整
+    auto tmp = fs::readFile(tmpPath);
+    reset();
+    if (!tmp.empty() && parse(tmp)) {
+        m_needCompact = true;
+        return true;
+    }
+    reset();
+    m_needCompact = hadFile;
+
+    if (fs::fileExists(legacyPath)) return migrateLegacy(legacyPath);
+    return !hadFile;
+}
+
+bool ModFileRefCount::parse(std::vector<uint8_t>& data) {
+    if (data.size() < headerSize || std::memcmp(data.data(), magic, sizeof(magic)) != 0) return false;
+    if (peek<uint32_t>(data.data() + 4) != version) return false;
+
+    uint32_t entries = peek<uint32_t>(data.data() + 8);
+    uint32_t snapshotBytes = peek<uint32_t>(data.data() + 12);
+    uint32_t snapshotCrc = peek<uint32_t>(data.data() + 16);
+    if (snapshotBytes < headerSize || snapshotBytes > data.size()) return false;
+    if (headerSize + static_cast<size_t>(entries) * sizeof(uint32_t) > snapshotBytes) return false;
+    if (crc::fromBuffer(0, data.data() + headerSize, snapshotBytes - headerSize) != snapshotCrc) return false;
+
+    // 快照只校验偏移表边界，不展开记录
+    const uint8_t* offsets = data.data() + headerSize;
+    for (uint32_t i = 0; i < entries; ++i) {
+        uint32_t off = peek<uint32_t>(offsets + i * sizeof(uint32_t));
+        if (off + 6 > snapshotBytes || off + 6 + peek<uint16_t>(data.data() + off + 4) > snapshotBytes) return false;
+    }
+
+    // 日志：逐条校验重放，遇到残缺或校验失败的尾部即停止，下次保存时压缩掉
+    size_t pos = snapshotBytes;
+    while (pos < data.size()) {
+        if (pos + 6 > data.size()) break;
+        uint32_t refs = peek<uint32_t>(data.data() + pos);
+        uint16_t len = peek<uint16_t>(data.data() + pos + 4);
+        size_t recordSize = 6 + len;
+        if (pos + recordSize + sizeof(uint32_t) > data.size()) break;
+        if (crc::fromBuffer(0, data.data() + pos, recordSize) != peek<uint32_t>(data.data() + pos + recordSize)) break;
+
+        m_overlay[std::string(reinterpret_cast<const char*>(data.data() + pos + 6), len)] = refs;
+        pos += recordSize + sizeof(uint32_t);
+    }
+    m_journalBytes = pos - snapshotBytes;
+    if (pos != data.size()) m_needCompact = true;
+
+    data.resize(snapshotBytes);
+    m_snapshot = std::move(data);
+    m_snapshotEntries = entries;
+    return true;
+}
+
+uint32_t ModFileRefCount::snapshotCount(const std::string& filePath) const {
+    const uint8_t* base = m_snapshot.data();
+    const uint8_t* offsets = base + headerSize;
+    std::string_view key(filePath);
+
+    uint32_t lo = 0, hi = m_snapshotEntries;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const uint8_t* rec = base + peek<uint32_t>(offsets + mid * sizeof(uint32_t));
+        std::string_view recPath(reinterpret_cast<const char*>(rec + 6), peek<uint16_t>(rec + 4));
+        int cmp = recPath.compare(key);
+        if (cmp == 0) return peek<uint32_t>(rec);
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return 0;
+}
+
+uint32_t ModFileRefCount::count(const std::string& filePath) const {
+    auto it = m_overlay.find(filePath);
+    if (it != m_overlay.end()) return it->second;
+    return snapshotCount(filePath);
+}
+
+bool ModFileRefCount::migrateLegacy(const std::string& jsonPath) {
+    auto data = fs::readFile(jsonPath);
+    yyjson_doc* doc = data.empty() ? nullptr : yyjson_read(reinterpret_cast<const char*>(data.data()), data.size(), 0);
+    if (!doc) return false;
+
+    yyjson_val* obj = yyjson_obj_get(yyjson_doc_get_root(doc), refCountKey);
+    size_t idx, max;
+    yyjson_val *key, *val;
+    yyjson_obj_foreach(obj, idx, max, key, val) {
+        long refs = 0;
+        if (yyjson_is_str(val)) refs = std::strtol(yyjson_get_str(val), nullptr, 10);
+        else if (yyjson_is_int(val)) refs = static_cast<long>(yyjson_get_sint(val));
+        if (refs > 0) m_overlay.emplace(std::string(yyjson_get_str(key), yyjson_get_len(key)), static_cast<uint32_t>(refs));
+    }
+    yyjson_doc_free(doc);
+
+    m_migratedFrom = jsonPath;
+    m_needCompact = true;
+    return true;
 }
 
 bool ModFileRefCount::save() {
-    return m_json.save();
+    if (m_path.empty()) return false;
+    if (m_dirty.empty() && !m_needCompact) return true;
+
+    // 日志过长时压缩，否则只追加本次变化
+    if (!m_needCompact && !m_snapshot.empty()) {
+        binaryFile::Writer journal;
+        for (const auto& path : m_dirty) {
+            size_t start = journal.buf.size();
+            putRecord(journal, path, m_overlay[path]);
+            journal.putCrc(start);
+        }
+
+        if (m_journalBytes + journal.buf.size() <= std::max(m_snapshot.size(), minCompactBytes)) {
+            if (fs::appendFile(m_path, journal.buf.data(), journal.buf.size()) == 0) {
+                m_journalBytes += journal.buf.size();
+                m_dirty.clear();
+                return true;
+            }
+            // 追加失败时文件尾可能残缺，改为全量重写
+        }
+    }
+    return compact();
+}
+
+bool ModFileRefCount::compact() {
+    // 覆盖表按路径排序后与快照归并，输出仍然有序
+    std::vector<const std::pair<const std::string, uint32_t>*> changes;
+    changes.reserve(m_overlay.size());
+    for (const auto& entry : m_overlay) changes.push_back(&entry);
+    std::sort(changes.begin(), changes.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::vector<uint32_t> recordOffsets;
+    binaryFile::Writer records;
+    records.buf.reserve(m_snapshot.size() + changes.size() * 96);
+    auto emit = [&](std::string_view path, uint32_t refs) {
+        if (refs == 0) return;
+        recordOffsets.push_back(static_cast<uint32_t>(records.buf.size()));
+        putRecord(records, path, refs);
+    };
+
+    const uint8_t* base = m_snapshot.data();
+    size_t c = 0;
+    for (uint32_t i = 0; i < m_snapshotEntries; ++i) {
+        const uint8_t* rec = base + peek<uint32_t>(base + headerSize + i * sizeof(uint32_t));
+        std::string_view recPath(reinterpret_cast<const char*>(rec + 6), peek<uint16_t>(rec + 4));
+        while (c < changes.size() && std::string_view(changes[c]->first) < recPath) {
+            emit(changes[c]->first, changes[c]->second);
+            ++c;
+        }
+        if (c < changes.size() && changes[c]->first == recPath) {
+            emit(recPath, changes[c]->second);
+            ++c;
+        } else {
+            emit(recPath, peek<uint32_t>(rec));
+        }
+    }
+    for (; c < changes.size(); ++c) emit(changes[c]->first, changes[c]->second);
+
+    uint32_t entries = static_cast<uint32_t>(recordOffsets.size());
+    uint32_t recordBase = static_cast<uint32_t>(headerSize + entries * sizeof(uint32_t));
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(recordBase + records.buf.size());
+    writer.put(entries);
+    writer.put(static_cast<uint32_t>(recordBase + records.buf.size()));
+    writer.put(static_cast<uint32_t>(0));  // 快照 CRC，写完后回填
+    for (uint32_t off : recordOffsets) writer.put(recordBase + off);
+    writer.putBytes(records.buf.data(), records.buf.size());
+
+    std::vector<uint8_t>& buf = writer.buf;
+    uint32_t snapshotCrc = crc::fromBuffer(0, buf.data() + headerSize, buf.size() - headerSize);
+    std::memcpy(buf.data() + 16, &snapshotCrc, sizeof(snapshotCrc));
+
+    // 先写临时文件再替换：任何时刻原文件或临时文件至少有一个完整
+    if (!binaryFile::writeAtomic(m_path, buf.data(), buf.size())) return false;
+
+    m_snapshot = std::move(buf);
+    m_snapshotEntries = entries;
+    m_overlay.clear();
+    m_dirty.clear();
+    m_journalBytes = 0;
+    m_needCompact = false;
+
+    if (!m_migratedFrom.empty()) {
+        fs::deleteFile(m_migratedFrom);
+        m_migratedFrom.clear();
+    }
+    return true;
 }
 
 void ModFileRefCount::increment(const std::string& filePath) {
-    std::string val = m_json.getString(refCount, filePath, "0");
-    int count = std::stoi(val) + 1;
-    m_json.setString(refCount, filePath, std::to_string(count));
+    uint32_t refs = count(filePath);
+    m_overlay[filePath] = refs + 1;
+    m_dirty.insert(filePath);
 }
 
 bool ModFileRefCount::decrement(const std::string& filePath) {
-    std::string val = m_json.getString(refCount, filePath, "");
-    if (val.empty()) return true;
+    uint32_t refs = count(filePath);
+    if (refs == 0) return true;
 
-    int count = std::stoi(val) - 1;
-    if (count <= 0) m_json.removeKey(refCount, filePath);
-    else m_json.setString(refCount, filePath, std::to_string(count));
+    m_overlay[filePath] = refs - 1;
+    m_dirty.insert(filePath);
     return false;
 }
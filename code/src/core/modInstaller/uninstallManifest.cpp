@@ -0,0 +1,82 @@
+/**
+ * ModInstaller - 按安装清单卸载模组实现
+ */
+
+#include "core/modInstaller/uninstallManifest.hpp"
+#include "core/modInstaller/utils.hpp"
+#include "core/modInstaller/specialRules.hpp"
+#include "core/modInstaller/modFileRefCount.hpp"
+#include "common/config.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/format.hpp"
+#include <borealis/core/i18n.hpp>
+
+namespace ModInstaller {
+
+UninstallResult uninstallFromManifest(const InstallManifest& manifest, const ModInfo& mod, const GameInfo& game, ModGameType modGameType, std::function<void(const Progress&)> progressCb) {
+
+    if (progressCb) progressCb({false, 0, 0, brls::getStr("other/installer/scanningFiles"), 0, 0});
+
+    UninstallResult result{};
+    utils::PhaseTimer timer;
+
+    const auto& files = manifest.files();
+    int totalFiles = static_cast<int>(files.size()) + (manifest.hasPchtxt() ? 1 : 0);
+
+    std::string tid = format::appIdHex(game.appId);
+    std::string gameDirName = format::gameDirName(game.dirPath);
+    fs::deleteFile(contentsPath + "/" + tid + "/romfs_metadata.bin");
+
+    SpecialModUninstallRules specialRules;
+    if (!specialRules.init(modGameType, mod, game, tid)) {
+        result.errorFile = mod.path;
+        result.errorMsg = brls::getStr("other/installer/specialUninstallRulesInitFailed");
+        return result;
+    }
+
+    std::vector<std::string> targetDirs = manifest.dirs();
+    for (auto& targetDir : targetDirs) specialRules.applyDirectory(targetDir);
+
+    ModFileRefCount refCount;
+    refCount.load(game.dirPath + config::refCountFile);
+    result.phases.scan = timer.lap();
+
+    int current = 0;
+    if (manifest.hasPchtxt()) {
+        if (progressCb) progressCb({false, ++current, totalFiles, pchtxtExt, 0, 0});
+        utils::removePchtxt(mod.dirName, gameDirName);
+    }
+
+    // 标准路径交给卸载规则重新解析，怪猎 pak 以当前映射为准
+    for (const auto& file : files) {
+        std::string targetPath = file.targetPath;
+        if (!specialRules.apply(targetPath)) {
+            result.errorFile = targetPath;
+            result.errorMsg = brls::getStr("other/installer/specialUninstallRulesApplyFailed");
+            return result;
+        }
+
+        if (progressCb) progressCb({false, ++current, totalFiles, utils::lastSegment(targetPath), 0, 0});
+
+        if (refCount.decrement(targetPath)) fs::deleteFile(targetPath);
+    }
+
+    result.phases.write = timer.lap();
+
+    // 倒序清理空目录
+    for (int i = static_cast<int>(targetDirs.size()) - 1; i >= 0; --i) {
+        fs::deleteEmptyDir(targetDirs[i]);
+    }
+    result.phases.mkdir = timer.lap();
+
+    refCount.save();
+    if (!specialRules.save()) {
+        result.errorMsg = brls::getStr("other/installer/mhriseReorderFailed");
+        return result;
+    }
+    result.phases.save = timer.lap();
+    result.success = true;
+    return result;
+}
+
+} // namespace ModInstaller
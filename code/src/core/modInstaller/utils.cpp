@@ -3,6 +3,9 @@
  */
 
 #include "core/modInstaller/utils.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "core/modInstaller/installedFileIndex.hpp"
+#include "core/modInstaller/crcCache.hpp"
 #include "common/config.hpp"
 #include "utils/fsHelper.hpp"
 #include "utils/zipReader.hpp"
@@ -10,6 +13,7 @@
 #include "utils/pchtxtConverter.hpp"
 #include "utils/format.hpp"
 #include <algorithm>
+#include <unordered_set>
 #include <borealis/core/i18n.hpp>
 
 namespace {
@@ -49,6 +53,20 @@ std::vector<std::string> collectRawDirs(const ModInfo& mod) {
     }
     return rawDirs;
 }
+
+// 加载 mod 的安装清单（清单位于 mod 所在的游戏目录）
+bool loadModManifest(const ModInfo& mod, InstallManifest& manifest) {
+    size_t slash = mod.path.rfind('/');
+    if (slash == std::string::npos) return false;
+    return manifest.load(InstallManifest::pathOf(mod.path.substr(0, slash), mod.dirName));
+}
+
+// 加载已安装文件索引，缺失或损坏时由游戏目录下全部清单重建并写回（调用方须持有索引锁）
+void loadFileIndex(InstalledFileIndex& index, const std::string& gameDirPath) {
+    if (index.load(InstalledFileIndex::pathOf(gameDirPath))) return;
+    index.rebuild(gameDirPath, fs::listSubDirs(gameDirPath));
+    index.save();
+}
 } // namespace
 
 namespace ModInstaller::utils {
@@ -241,6 +259,18 @@ std::string findConflictModName(const std::string& targetPath, uint32_t conflict
         if (token && token->stop_requested()) return {};
         if (!mod.isInstalled) continue;
 
+        // 有安装清单时直接比对记录，不打开 ZIP 也不扫描源目录
+        InstallManifest manifest;
+        if (loadModManifest(mod, manifest)) {
+            for (const auto& file : manifest.files()) {
+                if (file.crc32 == conflictCrc) continue;
+                if (file.installedPath == targetPath) return mod.displayName;
+                size_t pos = findKeywordPos(file.targetPath);
+                if (pos != std::string::npos && file.targetPath.compare(pos, std::string::npos, relFile) == 0) return mod.displayName;
+            }
+            continue;
+        }
+
         if (mod.isZip) {
             std::string zipPath = getZipModFilePath(mod.path);
             if (zipPath.empty()) continue;
@@ -304,10 +334,144 @@ std::string findConflictModName(const std::string& targetPath, uint32_t conflict
     return brls::getStr("other/installer/unknownMod");
 }
 
+void reportConflicts(InstallResult& result, const std::vector<ConflictFile>& conflicts, const std::string& gameDirPath, const std::vector<ModInfo>& allMods, void* crcBuf, size_t crcBufLen, std::stop_token* token) {
+
+    InstalledFileIndex index;
+    {
+        std::lock_guard lock(InstalledFileIndex::mutex());
+        loadFileIndex(index, gameDirPath);
+    }
+
+    auto addName = [&result](const std::string& name) {
+        if (std::find(result.conflictMods.begin(), result.conflictMods.end(), name) == result.conflictMods.end()) result.conflictMods.push_back(name);
+    };
+    auto displayNameOf = [&allMods](const std::string& dirName) -> const std::string& {
+        for (const auto& mod : allMods) {
+            if (mod.dirName == dirName) return mod.displayName;
+        }
+        return dirName;
+    };
+
+    std::vector<const ConflictFile*> misses;
+    for (const auto& conflict : conflicts) {
+        const IndexedFile* file = index.find(conflict.targetPath);
+        if (!file || file->crc32 != conflict.diskCrc) {
+            misses.push_back(&conflict);
+            continue;
+        }
+        for (const auto& owner : file->owners) addName(displayNameOf(owner));
+    }
+
+    // 索引未覆盖的文件：只在未收录的已安装 MOD 中逐个查找
+    if (!misses.empty()) {
+        auto indexed = index.mods();
+        std::unordered_set<std::string> indexedSet(indexed.begin(), indexed.end());
+        std::vector<ModInfo> legacyMods;
+        for (const auto& mod : allMods) {
+            if (mod.isInstalled && !indexedSet.count(mod.dirName)) legacyMods.push_back(mod);
+        }
+
+        if (legacyMods.empty()) addName(brls::getStr("other/installer/unknownMod"));
+        for (size_t i = 0; i < misses.size() && !legacyMods.empty(); ++i) {
+            if (token && token->stop_requested()) break;
+            addName(findConflictModName(misses[i]->targetPath, misses[i]->srcCrc, legacyMods, crcBuf, crcBufLen, token));
+        }
+    }
+
+    result.errorFile = conflicts.front().targetPath;
+    result.errorMsg = brls::getStr("other/installer/modConflict");
+    result.conflictFiles = static_cast<int>(conflicts.size());
+    for (const auto& name : result.conflictMods) {
+        if (!result.conflictMod.empty()) result.conflictMod += ", ";
+        result.conflictMod += name;
+    }
+}
+
+void recordInstalledFiles(const std::string& gameDirPath, const std::string& modDirName, const InstallManifest& manifest) {
+    std::lock_guard lock(InstalledFileIndex::mutex());
+    InstalledFileIndex index;
+    loadFileIndex(index, gameDirPath);
+    index.addMod(modDirName, manifest);
+    index.save();
+}
+
+void forgetInstalledFiles(const std::string& gameDirPath, const std::string& modDirName) {
+    std::lock_guard lock(InstalledFileIndex::mutex());
+    InstalledFileIndex index;
+    if (!index.load(InstalledFileIndex::pathOf(gameDirPath))) return;
+    index.removeMod(modDirName);
+    index.save();
+}
+
+size_t verifyInstalledFiles(const std::string& gameDirPath, std::stop_token token) {
+    InstalledFileIndex index;
+    {
+        std::lock_guard lock(InstalledFileIndex::mutex());
+        loadFileIndex(index, gameDirPath);
+
+        // 与清单对账：清单已删除的 MOD 移除，有清单但未收录的 MOD 补录
+        auto indexed = index.mods();
+        std::unordered_set<std::string> indexedSet(indexed.begin(), indexed.end());
+        bool changed = false;
+        for (const auto& modDirName : indexed) {
+            if (fs::fileExists(InstallManifest::pathOf(gameDirPath, modDirName))) continue;
+            index.removeMod(modDirName);
+            changed = true;
+        }
+        for (const auto& modDirName : fs::listSubDirs(gameDirPath)) {
+            if (indexedSet.count(modDirName)) continue;
+            InstallManifest manifest;
+            if (!manifest.load(InstallManifest::pathOf(gameDirPath, modDirName))) continue;
+            index.addMod(modDirName, manifest);
+            changed = true;
+        }
+        if (changed) index.save();
+    }
+
+    // CRC 缓存中已删除或被改动文件的记录一并清理
+    CrcCache crcCache;
+    if (crcCache.load(CrcCache::pathOf(gameDirPath)) && crcCache.prune(token) > 0 && !token.stop_requested()) crcCache.save();
+
+    // 磁盘检查不持锁，安装可以同时进行
+    auto stale = index.findStale(token);
+    if (stale.empty() || token.stop_requested()) return 0;
+
+    std::lock_guard lock(InstalledFileIndex::mutex());
+    InstalledFileIndex current;
+    if (!current.load(InstalledFileIndex::pathOf(gameDirPath))) return 0;
+
+    std::vector<std::string> confirmed;
+    for (auto& path : stale) {
+        const IndexedFile* file = current.find(path);
+        if (file && fs::getFileSize(path) != file->size) confirmed.push_back(std::move(path));
+    }
+    size_t erased = current.erase(confirmed);
+    if (erased > 0) current.save();
+    return erased;
+}
+
 ModTidAndIpsDirs collectTidAndIpsDirs(const ModInfo& mod, const GameInfo& game) {
     ModTidAndIpsDirs result;
     std::string tid = format::appIdHex(game.appId);
 
+    // 已安装且有清单：从清单记录的目标目录还原
+    InstallManifest manifest;
+    if (loadModManifest(mod, manifest)) {
+        const std::string contentsPrefix = contentsPath + "/";
+        const std::string ipsPrefix = atmospherePath + "/exefs_patches/";
+
+        for (const auto& dir : manifest.dirs()) {
+            if (dir.compare(0, ipsPrefix.size(), ipsPrefix) == 0) {
+                std::string name = dir.substr(ipsPrefix.size());
+                if (std::find(result.ipsDirs.begin(), result.ipsDirs.end(), name) == result.ipsDirs.end()) result.ipsDirs.push_back(std::move(name));
+            } else if (dir.compare(0, contentsPrefix.size(), contentsPrefix) == 0) {
+                std::string target = dir.substr(contentsPrefix.size(), dir.find('/', contentsPrefix.size()) - contentsPrefix.size());
+                if (std::find(result.tidDirs.begin(), result.tidDirs.end(), target) == result.tidDirs.end()) result.tidDirs.push_back(std::move(target));
+            }
+        }
+        return result;
+    }
+
     for (const auto& dir : collectRawDirs(mod)) {
         size_t pos = findKeywordPos(dir);
         if (pos == std::string::npos) continue;
@@ -4,8 +4,13 @@
 
 #include "core/modManager.hpp"
 #include "core/modInstaller/utils.hpp"
+#include "core/modInstaller/installManifest.hpp"
+#include "core/modInstaller/installedFileIndex.hpp"
+#include "core/modInstaller/crcCache.hpp"
+#include "core/modInstaller/modFileRefCount.hpp"
 #include "utils/fsHelper.hpp"
 #include "utils/format.hpp"
+#include "utils/pinYinCache.hpp"
 #include "utils/strSort.hpp"
 #include "common/config.hpp"
 #include <borealis/core/i18n.hpp>
@@ -76,6 +81,7 @@ ModManager::ModManager(const GameInfo& game)
 
     // 三级排序：已安装 > 未安装 → 类型分组 → 拼音
     strSort::sortAZ(m_mods, &ModInfo::displayName, &ModInfo::isInstalled, &ModInfo::type);
+    pinYinCache::flush();
 }
 
 void ModManager::buildUnmanagedModPlan() {
@@ -360,48 +366,49 @@ bool ModManager::sortAsc() const {
 
 void ModManager::sort(bool ascending) {
     strSort::sortAZ(m_mods, &ModInfo::displayName, &ModInfo::isInstalled, &ModInfo::type, ascending);
+    pinYinCache::flush();
 }
 
 void ModManager::setDisplayName(int index, const std::string& name) {
     m_mods[index].displayName = name;
     m_modJson.setString(m_mods[index].dirName, "displayName", name);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::deleteCustomDisplayName(int index) {
     m_mods[index].displayName = m_mods[index].dirName;
     m_modJson.removeKey(m_mods[index].dirName, "displayName");
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setType(int index, const std::string& type) {
     m_mods[index].type = type;
     m_modJson.setString(m_mods[index].dirName, "type", type);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setDescription(int index, const std::string& desc) {
     m_mods[index].description = desc;
     m_modJson.setString(m_mods[index].dirName, "description", desc);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setModVersion(int index, const std::string& version) {
     m_mods[index].modVersion = version;
     m_modJson.setString(m_mods[index].dirName, "modVersion", version);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setGameVersion(int index, const std::string& version) {
     m_mods[index].gameVersion = version;
     m_modJson.setString(m_mods[index].dirName, "gameVersion", version);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setAuthor(int index, const std::string& author) {
     m_mods[index].author = author;
     m_modJson.setString(m_mods[index].dirName, "author", author);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::setSize(int index, const std::string& sizeStr) {
@@ -428,7 +435,7 @@ std::string ModManager::buildUpdateCheckJson() const {
 }
 
 void ModManager::saveJson() {
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::addModFromStore(ModInfo info) {
@@ -509,6 +516,8 @@ void ModManager::removeModFromModList(int idx) {
     fs::ensureDir(config::transitDir);
     std::string dest = fs::ensureUniqueDirPath(std::string(config::transitDir) + mod.dirName);
     fs::moveDir(mod.path, dest);
+    fs::deleteFile(InstallManifest::pathOf(m_game.dirPath, mod.dirName));
+    ModInstaller::utils::forgetInstalledFiles(m_game.dirPath, mod.dirName);
 
     m_modJson.removeRootKey(mod.dirName);
     m_modJson.save();
@@ -520,6 +529,8 @@ void ModManager::deleteModFromModList(int idx) {
     auto& mod = m_mods[idx];
 
     fs::removeDirAll(mod.path);
+    fs::deleteFile(InstallManifest::pathOf(m_game.dirPath, mod.dirName));
+    ModInstaller::utils::forgetInstalledFiles(m_game.dirPath, mod.dirName);
 
     m_modJson.removeRootKey(mod.dirName);
     m_modJson.save();
@@ -543,6 +554,17 @@ ModInstaller::InstallResult ModManager::installMod(int index, std::function<void
     return ModInstaller::install(m_mods[index], m_game, m_modGameType, m_mods, progressCb, token);
 }
 
+ModInstaller::InstallResult ModManager::installFromStore(const ModInfo& info, std::shared_ptr<PartialFile> source, std::function<void(const ModInstaller::Progress&)> progressCb, std::stop_token token) {
+
+    if (source) return ModInstaller::installStreaming(info, m_game, m_modGameType, m_mods, std::move(source), progressCb, token);
+    return ModInstaller::install(info, m_game, m_modGameType, m_mods, progressCb, token);
+}
+
+ModInstaller::UninstallResult ModManager::uninstallFromStore(const ModInfo& info) {
+
+    return ModInstaller::uninstall(info, m_game, m_modGameType);
+}
+
 ModInstaller::UninstallResult ModManager::uninstallMod(int index, std::function<void(const ModInstaller::Progress&)> progressCb) {
 
     return ModInstaller::uninstall(m_mods[index], m_game, m_modGameType, progressCb);
@@ -551,7 +573,7 @@ ModInstaller::UninstallResult ModManager::uninstallMod(int index, std::function<
 void ModManager::setInstalled(int index, bool installed) {
     m_mods[index].isInstalled = installed;
     m_modJson.setBool(m_mods[index].dirName, "installed", installed);
-    m_modJson.save();
+    m_modJson.saveDeferred();
 }
 
 void ModManager::clearAllInstalledStates() {
@@ -685,12 +707,34 @@ fs::RemoveResult ModManager::forceClean(std::stop_token token, std::function<voi
         }
     }
 
-    // 删除引用计数文件
+    // 删除引用计数文件（含旧版 JSON 与压缩残留的临时文件）
     std::string refCountPath = m_game.dirPath + config::refCountFile;
-    if (fs::fileExists(refCountPath) && !fs::deleteFile(refCountPath)) {
-        result.status = fs::RemoveResult::FsError;
-        result.errorPath = refCountPath;
-        return result;
+    auto [legacyRefCountPath, tmpRefCountPath] = ModFileRefCount::auxPaths(refCountPath);
+    for (const auto& path : {refCountPath, legacyRefCountPath, tmpRefCountPath}) {
+        if (fs::fileExists(path) && !fs::deleteFile(path)) {
+            result.status = fs::RemoveResult::FsError;
+            result.errorPath = path;
+            return result;
+        }
+    }
+
+    // 删除各 MOD 的安装清单
+    for (const auto& mod : m_mods) {
+        std::string manifestPath = InstallManifest::pathOf(m_game.dirPath, mod.dirName);
+        if (fs::fileExists(manifestPath) && !fs::deleteFile(manifestPath)) {
+            result.status = fs::RemoveResult::FsError;
+            result.errorPath = manifestPath;
+            return result;
+        }
+    }
+
+    // 删除已安装文件索引与 CRC 缓存
+    for (const auto& path : {InstalledFileIndex::pathOf(m_game.dirPath), CrcCache::pathOf(m_game.dirPath)}) {
+        if (fs::fileExists(path) && !fs::deleteFile(path)) {
+            result.status = fs::RemoveResult::FsError;
+            result.errorPath = path;
+            return result;
+        }
     }
 
     // 删除怪猎特殊 pak 安装映射记录
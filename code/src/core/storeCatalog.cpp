@@ -0,0 +1,435 @@
+/**
+ * StoreCatalog - 商店目录本地缓存与离线搜索实现
+ */
+
+#include "core/storeCatalog.hpp"
+#include "api/url.hpp"
+#include "common/config.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/pinYinCache.hpp"
+#include "utils/pinYinCvt.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'S', 'C'};
+    constexpr uint32_t version = 1;
+
+    /** @brief 写入 u8 数量 + 每种语言的 语言 | 名称 */
+    void putNames(binaryFile::Writer& writer, const std::vector<StoreCatalog::LocalizedName>& names) {
+        size_t count = std::min<size_t>(names.size(), UINT8_MAX);
+        writer.put(static_cast<uint8_t>(count));
+        for (size_t i = 0; i < count; ++i) {
+            writer.putStr(names[i].lang);
+            writer.putStr(names[i].name);
+        }
+    }
+
+    std::vector<StoreCatalog::LocalizedName> getNames(binaryFile::Reader& reader) {
+        std::vector<StoreCatalog::LocalizedName> names(reader.get<uint8_t>());
+        for (auto& name : names) {
+            name.lang = reader.getStr();
+            name.name = reader.getStr();
+        }
+        return names;
+    }
+
+    /** @brief 写入或替换某一语言的名称（空名称忽略） */
+    void setName(std::vector<StoreCatalog::LocalizedName>& names, const std::string& lang, const std::string& name) {
+        if (name.empty()) return;
+        for (auto& entry : names) {
+            if (entry.lang == lang) {
+                entry.name = name;
+                return;
+            }
+        }
+        names.push_back({lang, name});
+    }
+
+    /** @brief 取指定语言的名称，缺失时取第一个 */
+    const std::string& nameFor(const std::vector<StoreCatalog::LocalizedName>& names, const std::string& lang) {
+        static const std::string empty;
+        for (const auto& entry : names) {
+            if (entry.lang == lang) return entry.name;
+        }
+        return names.empty() ? empty : names.front().name;
+    }
+
+    /** @brief 按非字母数字切分（UTF-8 多字节字符也视为分隔），每段转大写 */
+    void splitWords(const std::string& text, std::vector<std::string>& out) {
+        std::string word;
+        for (char ch : text) {
+            auto uch = static_cast<unsigned char>(ch);
+            if (uch < 0x80 && std::isalnum(uch)) {
+                word += static_cast<char>(std::toupper(uch));
+            } else if (!word.empty()) {
+                out.push_back(std::move(word));
+                word.clear();
+            }
+        }
+        if (!word.empty()) out.push_back(std::move(word));
+    }
+
+    /** @brief 收集一段文本的词项：原文单词 + 拼音 token + 首字母串 + 拼音拼接串 */
+    void collectTerms(const std::string& text, std::vector<std::string>& out) {
+        if (text.empty()) return;
+        splitWords(text, out);
+
+        const auto& tokens = pinYinCache::tokens(text);
+        out.insert(out.end(), tokens.begin(), tokens.end());
+        if (tokens.size() < 2) return;
+
+        std::string initials, joined;
+        for (const auto& token : tokens) {
+            initials += token[0];
+            joined += token;
+        }
+        out.push_back(std::move(initials));
+        out.push_back(std::move(joined));
+    }
+
+    /** @brief 商店 MOD 列表按页拉取完整列表 */
+    bool fetchAllMods(const StoreCatalog::Source& source, const std::string& gameTid, std::stop_token token,
+                      std::vector<api::mod::ModList>& mods, int& requests) {
+        for (int page = 1;; ++page) {
+            auto result = source.fetchMods(gameTid, page, StoreCatalog::pageSize, token);
+            ++requests;
+            if (!result.success || token.stop_requested()) return false;
+            for (auto& mod : result.list) mods.push_back(std::move(mod));
+            if (result.list.empty() || static_cast<int>(mods.size()) >= result.total) return true;
+        }
+    }
+
+} // namespace
+
+StoreCatalog& StoreCatalog::instance() {
+    static StoreCatalog s;
+    static std::once_flag loaded;
+    std::call_once(loaded, [] { s.load(config::storeCatalogPath); });
+    return s;
+}
+
+StoreCatalog::Source StoreCatalog::apiSource() {
+    Source source;
+    source.fetchGames = [](int page, int limit, std::stop_token token) {
+        return api::game::fetchGameList(page, limit, "", token);
+    };
+    source.fetchMods = [](const std::string& gameTid, int page, int limit, std::stop_token token) {
+        return api::mod::fetchModList(gameTid, page, limit, "latest", "", "", "", token);
+    };
+    source.lang = api::url::getLang();
+    return source;
+}
+
+bool StoreCatalog::load(const std::string& path) {
+    std::vector<Game> games;
+    std::vector<Mod> mods;
+    std::time_t refreshedAt = 0;
+
+    auto data = fs::readFile(path);
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    bool valid = reader.ok;
+    if (valid) {
+        refreshedAt = static_cast<std::time_t>(reader.get<int64_t>());
+
+        uint32_t gameCount = reader.get<uint32_t>();
+        for (uint32_t i = 0; i < gameCount && reader.ok; ++i) {
+            Game game;
+            game.gameTid = reader.getStr();
+            game.modCount = reader.get<int32_t>();
+            game.lastUpdate = reader.getStr();
+            game.modsSyncedAt = reader.getStr();
+            game.names = getNames(reader);
+            games.push_back(std::move(game));
+        }
+        uint32_t modCount = reader.get<uint32_t>();
+        for (uint32_t i = 0; i < modCount && reader.ok; ++i) {
+            Mod mod;
+            mod.modId = reader.get<int32_t>();
+            mod.game = reader.get<uint32_t>();
+            mod.modType = reader.getStr();
+            mod.author = reader.getStr();
+            mod.names = getNames(reader);
+            if (mod.game >= games.size()) reader.ok = false;
+            mods.push_back(std::move(mod));
+        }
+        valid = reader.finished();
+    }
+    if (!valid) {
+        games.clear();
+        mods.clear();
+        refreshedAt = 0;
+    }
+
+    Index index = buildIndex(games, mods);
+    std::lock_guard lock(m_mutex);
+    m_path = path;
+    m_refreshedAt = refreshedAt;
+    m_games = std::move(games);
+    m_mods = std::move(mods);
+    m_index = std::move(index);
+    return valid;
+}
+
+bool StoreCatalog::save() {
+    binaryFile::Writer writer(magic, version);
+    std::string path;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_path.empty()) return false;
+        path = m_path;
+
+        writer.buf.reserve(64 + m_games.size() * 96 + m_mods.size() * 80);
+        writer.put(static_cast<int64_t>(m_refreshedAt));
+        writer.put(static_cast<uint32_t>(m_games.size()));
+        for (const auto& game : m_games) {
+            writer.putStr(game.gameTid);
+            writer.put(static_cast<int32_t>(game.modCount));
+            writer.putStr(game.lastUpdate);
+            writer.putStr(game.modsSyncedAt);
+            putNames(writer, game.names);
+        }
+        writer.put(static_cast<uint32_t>(m_mods.size()));
+        for (const auto& mod : m_mods) {
+            writer.put(static_cast<int32_t>(mod.modId));
+            writer.put(mod.game);
+            writer.putStr(mod.modType);
+            writer.putStr(mod.author);
+            putNames(writer, mod.names);
+        }
+    }
+
+    auto pos = path.rfind('/');
+    if (pos != std::string::npos && pos > 0) fs::ensureDir(path.substr(0, pos));
+    return binaryFile::saveFramed(path, writer);
+}
+
+StoreCatalog::RefreshStats StoreCatalog::refresh(const Source& source, std::stop_token token, int modGameBudget) {
+    RefreshStats stats;
+    if (m_refreshing.exchange(true)) return stats;
+    struct Done {
+        std::atomic<bool>& flag;
+        ~Done() { flag = false; }
+    } done{m_refreshing};
+
+    // 1. 分页拉取完整游戏列表，任一页失败则放弃本次刷新
+    std::vector<api::game::GameList> fetched;
+    for (int page = 1;; ++page) {
+        auto result = source.fetchGames(page, pageSize, token);
+        ++stats.requests;
+        if (!result.success || token.stop_requested()) return stats;
+        for (auto& game : result.list) fetched.push_back(std::move(game));
+        if (result.list.empty() || static_cast<int>(fetched.size()) >= result.total) break;
+    }
+
+    // 2. 与缓存合并：保留其他语言的名称和已同步的 MOD 列表
+    std::vector<Game> oldGames;
+    std::vector<Mod> oldMods;
+    {
+        std::lock_guard lock(m_mutex);
+        oldGames = m_games;
+        oldMods = m_mods;
+    }
+    std::unordered_map<std::string, size_t> oldGameIndex;
+    for (size_t i = 0; i < oldGames.size(); ++i) oldGameIndex.emplace(oldGames[i].gameTid, i);
+    std::vector<std::vector<Mod>> modsByOldGame(oldGames.size());
+    for (auto& mod : oldMods) modsByOldGame[mod.game].push_back(std::move(mod));
+
+    std::vector<Game> games;
+    std::vector<std::vector<Mod>> modsByGame;
+    games.reserve(fetched.size());
+    modsByGame.reserve(fetched.size());
+    for (auto& item : fetched) {
+        if (item.gameTid.empty()) continue;
+        Game game;
+        std::vector<Mod> gameMods;
+        auto it = oldGameIndex.find(item.gameTid);
+        if (it != oldGameIndex.end()) {
+            game = std::move(oldGames[it->second]);
+            gameMods = std::move(modsByOldGame[it->second]);
+            oldGameIndex.erase(it);  // 同一 TID 重复出现时只保留第一条
+        } else {
+            game.gameTid = item.gameTid;
+            stats.added++;
+        }
+        game.modCount = item.modCount;
+        game.lastUpdate = item.lastUpdate;
+        setName(game.names, source.lang, item.gameName);
+        games.push_back(std::move(game));
+        modsByGame.push_back(std::move(gameMods));
+    }
+    stats.removed = static_cast<int>(oldGameIndex.size());
+
+    // 3. 只为有变化的游戏重新拉取 MOD 列表，受本次刷新的数量限制
+    for (size_t i = 0; i < games.size() && stats.modGames < modGameBudget; ++i) {
+        auto& game = games[i];
+        if (game.modsSyncedAt == game.lastUpdate) continue;
+        if (game.modCount == 0) {
+            modsByGame[i].clear();
+            game.modsSyncedAt = game.lastUpdate;
+            continue;
+        }
+
+        std::vector<api::mod::ModList> fetchedMods;
+        if (!fetchAllMods(source, game.gameTid, token, fetchedMods, stats.requests)) {
+            if (token.stop_requested()) return stats;
+            break;  // 网络异常：保留已同步部分，下次刷新继续
+        }
+
+        std::unordered_map<int, Mod*> oldById;
+        for (auto& mod : modsByGame[i]) oldById.emplace(mod.modId, &mod);
+        std::vector<Mod> gameMods;
+        gameMods.reserve(fetchedMods.size());
+        for (auto& item : fetchedMods) {
+            Mod mod;
+            auto it = oldById.find(item.modId);
+            if (it != oldById.end()) mod.names = std::move(it->second->names);
+            mod.modId = item.modId;
+            mod.modType = std::move(item.modType);
+            mod.author = std::move(item.author);
+            setName(mod.names, source.lang, item.modName);
+            gameMods.push_back(std::move(mod));
+        }
+        modsByGame[i] = std::move(gameMods);
+        game.modsSyncedAt = game.lastUpdate;
+        stats.modGames++;
+    }
+
+    std::vector<Mod> mods;
+    for (size_t i = 0; i < modsByGame.size(); ++i) {
+        for (auto& mod : modsByGame[i]) {
+            mod.game = static_cast<uint32_t>(i);
+            mods.push_back(std::move(mod));
+        }
+    }
+
+    // 4. 索引在锁外建立，整体替换后写出
+    Index index = buildIndex(games, mods);
+    if (token.stop_requested()) return stats;
+    stats.games = static_cast<int>(games.size());
+    {
+        std::lock_guard lock(m_mutex);
+        m_refreshedAt = std::time(nullptr);
+        m_games = std::move(games);
+        m_mods = std::move(mods);
+        m_index = std::move(index);
+    }
+    pinYinCache::flush();
+    save();
+    stats.success = true;
+    return stats;
+}
+
+bool StoreCatalog::needsRefresh() const {
+    std::lock_guard lock(m_mutex);
+    return m_games.empty() || std::time(nullptr) - m_refreshedAt >= refreshInterval;
+}
+
+std::vector<api::game::GameList> StoreCatalog::search(const std::string& keyword, const std::string& lang, size_t maxResults) const {
+    std::vector<api::game::GameList> results;
+
+    // 查询词：关键词转拼音后切分（中文按音节，英文按单词）
+    std::vector<std::string> queryTerms;
+    splitWords(pinYinCvt::toPinyin(keyword), queryTerms);
+    if (queryTerms.empty()) return results;
+
+    std::lock_guard lock(m_mutex);
+    const auto& terms = m_index.terms;
+
+    // 每个查询词取前缀匹配的全部词项，合并倒排表后与前面的结果求交
+    std::vector<uint32_t> docs, termDocs, merged;
+    for (size_t q = 0; q < queryTerms.size(); ++q) {
+        const std::string& query = queryTerms[q];
+        termDocs.clear();
+        for (auto it = std::lower_bound(terms.begin(), terms.end(), query);
+             it != terms.end() && it->compare(0, query.size(), query) == 0; ++it) {
+            size_t term = it - terms.begin();
+            termDocs.insert(termDocs.end(), m_index.postings.begin() + m_index.offsets[term], m_index.postings.begin() + m_index.offsets[term + 1]);
+        }
+        std::sort(termDocs.begin(), termDocs.end());
+        termDocs.erase(std::unique(termDocs.begin(), termDocs.end()), termDocs.end());
+
+        if (q == 0) {
+            docs.swap(termDocs);
+        } else {
+            merged.clear();
+            std::set_intersection(docs.begin(), docs.end(), termDocs.begin(), termDocs.end(), std::back_inserter(merged));
+            docs.swap(merged);
+        }
+        if (docs.empty()) return results;
+    }
+
+    // 条目映射到游戏：游戏自身命中优先于 MOD 命中
+    uint32_t gameCount = static_cast<uint32_t>(m_games.size());
+    std::vector<uint8_t> rank(m_games.size(), UINT8_MAX);
+    for (uint32_t doc : docs) {
+        if (doc < gameCount) rank[doc] = 0;
+        else rank[m_mods[doc - gameCount].game] = std::min<uint8_t>(rank[m_mods[doc - gameCount].game], 1);
+    }
+
+    for (uint8_t level = 0; level <= 1; ++level) {
+        for (size_t i = 0; i < m_games.size() && results.size() < maxResults; ++i) {
+            if (rank[i] != level) continue;
+            const auto& game = m_games[i];
+            api::game::GameList item;
+            item.gameTid = game.gameTid;
+            item.gameName = nameFor(game.names, lang);
+            item.modCount = game.modCount;
+            item.lastUpdate = game.lastUpdate;
+            results.push_back(std::move(item));
+        }
+    }
+    return results;
+}
+
+size_t StoreCatalog::gameCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_games.size();
+}
+
+size_t StoreCatalog::modCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_mods.size();
+}
+
+StoreCatalog::Index StoreCatalog::buildIndex(const std::vector<Game>& games, const std::vector<Mod>& mods) {
+    // (词项, 条目) 对，每个条目内先去重
+    std::vector<std::pair<std::string, uint32_t>> pairs;
+    std::vector<std::string> docTerms;
+    auto addDoc = [&](uint32_t doc) {
+        std::sort(docTerms.begin(), docTerms.end());
+        docTerms.erase(std::unique(docTerms.begin(), docTerms.end()), docTerms.end());
+        for (auto& term : docTerms) pairs.emplace_back(std::move(term), doc);
+        docTerms.clear();
+    };
+
+    for (size_t i = 0; i < games.size(); ++i) {
+        splitWords(games[i].gameTid, docTerms);
+        for (const auto& name : games[i].names) collectTerms(name.name, docTerms);
+        addDoc(static_cast<uint32_t>(i));
+    }
+    for (size_t i = 0; i < mods.size(); ++i) {
+        for (const auto& name : mods[i].names) collectTerms(name.name, docTerms);
+        splitWords(mods[i].modType, docTerms);
+        collectTerms(mods[i].author, docTerms);
+        addDoc(static_cast<uint32_t>(games.size() + i));
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    Index index;
+    index.postings.reserve(pairs.size());
+    for (auto& [term, doc] : pairs) {
+        if (index.terms.empty() || index.terms.back() != term) {
+            index.offsets.push_back(static_cast<uint32_t>(index.postings.size()));
+            index.terms.push_back(std::move(term));
+        }
+        index.postings.push_back(doc);
+    }
+    index.offsets.push_back(static_cast<uint32_t>(index.postings.size()));
+    return index;
+}
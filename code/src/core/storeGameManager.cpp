@@ -16,6 +16,35 @@ void StoreGameManager::appendPage(api::game::GameListResult result) {
     }
 }
 
+void StoreGameManager::setLocalResults(std::vector<api::game::GameList> list) {
+    m_storeGameList.clear();
+    for (auto& game : list) {
+        game.installed = m_installedTids.count(format::appIdFromHex(game.gameTid)) > 0;
+        if (m_filterMode == GameFilterMode::Installed && !game.installed) continue;
+        if (m_filterMode == GameFilterMode::NotInstalled && game.installed) continue;
+        m_storeGameList.push_back(std::move(game));
+    }
+    m_localResults = true;
+    m_currentPage = 1;
+    m_total = static_cast<int>(m_storeGameList.size());
+}
+
+size_t StoreGameManager::mergeServerPage(api::game::GameListResult result) {
+    size_t added = 0;
+    for (auto& game : result.list) {
+        if (findByTid(game.gameTid) >= 0) continue;
+        game.installed = m_installedTids.count(format::appIdFromHex(game.gameTid)) > 0;
+        m_storeGameList.push_back(std::move(game));
+        added++;
+    }
+    m_total = static_cast<int>(m_storeGameList.size());
+    return added;
+}
+
+bool StoreGameManager::isLocalResults() const {
+    return m_localResults;
+}
+
 std::vector<api::game::GameList>& StoreGameManager::storeGameList() {
     return m_storeGameList;
 }
@@ -59,6 +88,7 @@ void StoreGameManager::reset() {
     m_storeGameList.clear();
     m_currentPage = 0;
     m_total = 0;
+    m_localResults = false;
 }
 
 std::string StoreGameManager::getLocalVersion(size_t index) {
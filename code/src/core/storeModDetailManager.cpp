@@ -59,23 +59,20 @@ ModInfo StoreModDetailManager::buildDownloadedModInfo(std::string modDirName, st
     return info;
 }
 
-ModInfo StoreModDetailManager::createDownloadedMod(const std::string& gameDir, std::string modDirName, const std::string& tempZipPath) {
-    std::string modDir = fs::ensureUniqueDirPath(gameDir + "/" + modDirName);
-    modDirName = modDir.substr(modDir.rfind('/') + 1);
-    fs::ensureDir(modDir);
-
-    fs::moveFile(tempZipPath, modDir + "/" + modDirName + ".zip");
-
-    m_detail.downloaded = true;
+ModInfo StoreModDetailManager::reserveModDir(ModInfo info, const std::string& gameDir, const std::string& modDirName) {
+    info.path = fs::ensureUniqueDirPath(gameDir + "/" + modDirName);
+    info.dirName = info.path.substr(info.path.rfind('/') + 1);
+    fs::ensureDir(info.path);
+    return info;
+}
 
-    return buildDownloadedModInfo(std::move(modDirName), std::move(modDir));
+bool StoreModDetailManager::placeDownloadedZip(const ModInfo& info, const std::string& tempZipPath) {
+    return fs::moveFile(tempZipPath, info.path + "/" + info.dirName + ".zip");
 }
 
 // 商店下载安装
 
-ModInfo StoreModDetailManager::saveDownloadedMod(const std::string& gameDir, std::string modDirName, const std::string& tempZipPath) {
-    ModInfo info = createDownloadedMod(gameDir, modDirName, tempZipPath);
-
+void StoreModDetailManager::saveModInfo(const std::string& gameDir, const ModInfo& info) {
     JsonFile modJson;
     modJson.load(gameDir + config::modInfoFile);
     modJson.setString(info.dirName, "displayName", info.displayName);
@@ -89,8 +86,6 @@ ModInfo StoreModDetailManager::saveDownloadedMod(const std::string& gameDir, std
     modJson.setString(info.dirName, "modID", std::to_string(info.modID));
     modJson.setString(info.dirName, "fileCrc32", info.fileCrc32);
     modJson.save();
-
-    return info;
 }
 
 // 留言分页
@@ -8,6 +8,8 @@
 #include "common/settings.hpp"
 #include "common/config.hpp"
 #include "core/audio.hpp"
+#include "core/device.hpp"
+#include "core/downloadManager.hpp"
 #include "core/frameQueue.hpp"
 #include "ui/activity/shellActivity.hpp"
 #include "ui/page/home.hpp"
@@ -26,6 +28,9 @@
 #include "ui/view/shell/capsuleHints.hpp"
 #include "utils/gameNacp.hpp"
 #include "utils/http.hpp"
+#include "utils/iconCache.hpp"
+#include "utils/persistQueue.hpp"
+#include "utils/pinYinCache.hpp"
 #include "utils/pinYinCvt.hpp"
 #include <borealis.hpp>
 #include <cstdlib>
@@ -37,6 +42,7 @@ int main(int argc, char* argv[]) {
     config::setNroPath(argv[0]);
 
     Settings::load();
+    deviceControl::CpuBoost::setEnabled(Settings::getBool("Performance", "cpuBoost", true));
 
     // 应用用户选择的语言（必须在框架加载翻译前设置）
     std::string language = Settings::getString("UI", "language", "auto");
@@ -56,6 +62,8 @@ int main(int argc, char* argv[]) {
 
     // 初始化拼音引擎（加载字典）
     pinYinCvt::init();
+    pinYinCache::setPath(config::pinyinCachePath);
+    iconCache::setDir(config::iconCacheDir);
 
     brls::Application::createWindow("NX Mod Manager");
 
@@ -101,14 +109,26 @@ int main(int argc, char* argv[]) {
         brls::Application::getPlatform()->disableScreenDimming(false);
     });
 
+    // 失去焦点（回到主页、休眠）时立即写出待写的元数据，不等待合并延迟
+    AppletHookCookie persistHook;
+    appletHook(&persistHook, [](AppletHookType hook, void*) {
+        if (hook == AppletHookType_OnFocusState && appletGetFocusState() != AppletFocusState_InFocus) persistQueue::flush(false);
+    }, nullptr);
+
     // 推送全局 Shell Activity，普通页面由其内部 PageHost 管理
     brls::Application::pushActivity(new ShellActivity(new Home()), brls::TransitionAnimation::NONE);
 
     while (brls::Application::mainLoop()) {
     }
 
+    // 停止后台下载，未完成的任务下次启动时续传
+    DownloadManager::instance().shutdown();
+
     // 关闭全局逐帧任务队列
     FrameQueue::shutdown();
+    appletUnhook(&persistHook);
+    persistQueue::shutdown();
+    pinYinCache::flush();
     gameNacp::cleanup();
     http::cleanup();
 
@@ -0,0 +1,175 @@
+/**
+ * IconAtlas - 游戏图标纹理图集
+ */
+
+#include "ui/core/iconAtlas.hpp"
+#include <borealis/core/cache_helper.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    constexpr int slotsPerPage = IconAtlas::pageSlots * IconAtlas::pageSlots;
+
+    /** @brief 页内 (x, y) 像素的起始地址 */
+    uint8_t* pixelAt(std::vector<uint8_t>& pixels, int x, int y) {
+        return pixels.data() + (static_cast<size_t>(y) * IconAtlas::pageSize + x) * 4;
+    }
+
+} // namespace
+
+IconAtlas& IconAtlas::instance() {
+    static IconAtlas atlas;
+    return atlas;
+}
+
+int IconAtlas::getCache(const std::string& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) return 0;
+
+    Slot& slot = m_slots[it->second - 1];
+    slot.refs++;
+    slot.lastUse = ++m_useCounter;
+    return it->second;
+}
+
+int IconAtlas::addCache(const std::string& key, const imageDecoder::DecodedImage& image) {
+    if (key.empty() || image.width <= 0 || image.height <= 0) return 0;
+    if (image.pixels.size() != static_cast<size_t>(image.width) * image.height * 4) return 0;
+
+    auto it = m_index.find(key);
+    int id = it != m_index.end() ? it->second : allocate();
+    Slot& slot = m_slots[id - 1];
+    if (it == m_index.end()) {
+        // 复用的槽位：旧图标不再可查
+        if (!slot.key.empty()) m_index.erase(slot.key);
+        slot.key = key;
+        slot.refs = 0;
+        m_index[key] = id;
+    }
+
+    if (std::max(image.width, image.height) > slotSize) blit(id, iconCache::downscale(image, slotSize));
+    else blit(id, image);
+    slot.refs++;
+    slot.lastUse = ++m_useCounter;
+    return id;
+}
+
+void IconAtlas::removeCache(int id) {
+    if (!valid(id)) return;
+    Slot& slot = m_slots[id - 1];
+    if (slot.refs > 0) slot.refs--;
+}
+
+bool IconAtlas::draw(NVGcontext* vg, int id, float x, float y, float width, float height, float cornerRadius, float alpha) {
+    if (!valid(id)) return false;
+    Slot& slot = m_slots[id - 1];
+    Page& page = m_pages[(id - 1) / slotsPerPage];
+    if (slot.width <= 0 || slot.height <= 0) return false;
+
+    // 本帧首次用到该页时才上传，同一帧内添加的多个图标合并为一次
+    if (page.image == 0) {
+        page.image = nvgCreateImageRGBA(vg, pageSize, pageSize, 0, page.pixels.data());
+        if (page.image <= 0) {
+            page.image = 0;
+            return false;
+        }
+        page.dirty = false;
+    } else if (page.dirty) {
+        nvgUpdateImage(vg, page.image, page.pixels.data());
+        page.dirty = false;
+    }
+
+    float scale = std::min(width / slot.width, height / slot.height);
+    float drawWidth = slot.width * scale;
+    float drawHeight = slot.height * scale;
+    float drawX = x + (width - drawWidth) * 0.5f;
+    float drawY = y + (height - drawHeight) * 0.5f;
+
+    // 整页按同样比例铺开，平移到让槽位对齐绘制区域
+    int originX, originY;
+    origin(id, originX, originY);
+    NVGpaint paint = nvgImagePattern(vg, drawX - originX * scale, drawY - originY * scale, pageSize * scale, pageSize * scale, 0, page.image, alpha);
+    nvgBeginPath(vg);
+    nvgRoundedRect(vg, drawX, drawY, drawWidth, drawHeight, cornerRadius);
+    nvgFillPaint(vg, paint);
+    nvgFill(vg);
+    return true;
+}
+
+int IconAtlas::acquireTexture(const std::string& key) {
+    auto& textureCache = brls::TextureCache::instance();
+    int textureId = textureCache.getCache(key);
+    if (textureId > 0) return textureId;
+
+    textureId = createTexture(key);
+    if (textureId > 0) textureCache.addCache(key, textureId);
+    return textureId;
+}
+
+int IconAtlas::createTexture(const std::string& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) return 0;
+
+    int id = it->second;
+    const Slot& slot = m_slots[id - 1];
+    if (slot.width <= 0 || slot.height <= 0) return 0;
+
+    int originX, originY;
+    origin(id, originX, originY);
+    auto& pagePixels = m_pages[(id - 1) / slotsPerPage].pixels;
+    size_t rowBytes = static_cast<size_t>(slot.width) * 4;
+    std::vector<uint8_t> pixels(rowBytes * slot.height);
+    for (int row = 0; row < slot.height; ++row)
+        std::memcpy(pixels.data() + row * rowBytes, pixelAt(pagePixels, originX, originY + row), rowBytes);
+
+    int image = nvgCreateImageRGBA(brls::Application::getNVGContext(), slot.width, slot.height, 0, pixels.data());
+    return image > 0 ? image : 0;
+}
+
+int IconAtlas::allocate() {
+    int reusable = 0;
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        const Slot& slot = m_slots[i];
+        if (slot.key.empty()) return static_cast<int>(i) + 1;
+        if (slot.refs == 0 && (reusable == 0 || slot.lastUse < m_slots[reusable - 1].lastUse)) reusable = static_cast<int>(i) + 1;
+    }
+    if (reusable > 0) return reusable;
+
+    Page page;
+    page.pixels.assign(static_cast<size_t>(pageSize) * pageSize * 4, 0);
+    m_pages.push_back(std::move(page));
+    m_slots.resize(m_slots.size() + slotsPerPage);
+    return static_cast<int>(m_slots.size()) - slotsPerPage + 1;
+}
+
+void IconAtlas::blit(int id, const imageDecoder::DecodedImage& image) {
+    Slot& slot = m_slots[id - 1];
+    Page& page = m_pages[(id - 1) / slotsPerPage];
+    slot.width = image.width;
+    slot.height = image.height;
+    page.dirty = true;
+
+    int originX, originY;
+    origin(id, originX, originY);
+    size_t rowBytes = static_cast<size_t>(image.width) * 4;
+    for (int row = 0; row < image.height; ++row) {
+        uint8_t* dst = pixelAt(page.pixels, originX, originY + row);
+        std::memcpy(dst, image.pixels.data() + row * rowBytes, rowBytes);
+        // 左右各复制 1 像素边缘
+        std::memcpy(dst - 4, dst, 4);
+        std::memcpy(dst + rowBytes, dst + rowBytes - 4, 4);
+    }
+
+    // 上下各复制 1 行（含左右边缘像素）
+    size_t edgeBytes = rowBytes + 8;
+    std::memcpy(pixelAt(page.pixels, originX - 1, originY - 1), pixelAt(page.pixels, originX - 1, originY), edgeBytes);
+    std::memcpy(pixelAt(page.pixels, originX - 1, originY + image.height), pixelAt(page.pixels, originX - 1, originY + image.height - 1), edgeBytes);
+}
+
+void IconAtlas::origin(int id, int& x, int& y) {
+    int cell = (id - 1) % slotsPerPage;
+    x = (cell % pageSlots) * slotPitch + 1;
+    y = (cell / pageSlots) * slotPitch + 1;
+}
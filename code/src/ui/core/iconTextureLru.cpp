@@ -0,0 +1,62 @@
+/**
+ * IconTextureLru - 最近使用的图标纹理常驻
+ */
+
+#include "ui/core/iconTextureLru.hpp"
+#include <borealis.hpp>
+
+IconTextureLru& IconTextureLru::instance() {
+    static IconTextureLru lru;
+    return lru;
+}
+
+int IconTextureLru::acquire(const std::string& key) {
+    int iconId = brls::TextureCache::instance().getCache(key);
+    if (iconId <= 0) {
+        m_misses++;
+        return iconId;
+    }
+
+    m_hits++;
+    auto it = m_index.find(key);
+    if (it != m_index.end()) m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return iconId;
+}
+
+void IconTextureLru::keep(const std::string& key, int iconId, size_t bytes) {
+    if (iconId <= 0 || m_index.count(key) > 0) return;
+
+    // 额外引用：卡片全部释放后纹理仍然保留
+    if (brls::TextureCache::instance().getCache(key) != iconId) return;
+    m_entries.push_front({key, iconId, bytes});
+    m_index[key] = m_entries.begin();
+    m_bytes += bytes;
+    evict();
+}
+
+void IconTextureLru::drop(const std::string& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) return;
+
+    brls::TextureCache::instance().removeCache(it->second->iconId);
+    m_bytes -= it->second->bytes;
+    m_entries.erase(it->second);
+    m_index.erase(it);
+}
+
+void IconTextureLru::clear() {
+    for (const auto& entry : m_entries) brls::TextureCache::instance().removeCache(entry.iconId);
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+void IconTextureLru::evict() {
+    while (m_bytes > m_budget && m_entries.size() > 1) {
+        const Entry& entry = m_entries.back();
+        brls::TextureCache::instance().removeCache(entry.iconId);
+        m_bytes -= entry.bytes;
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
@@ -8,6 +8,8 @@
 #include "core/audio.hpp"
 #include "core/frameQueue.hpp"
 #include "core/modManager.hpp"
+#include "ui/core/iconAtlas.hpp"
+#include "ui/core/iconTextureLru.hpp"
 #include "ui/dataSource/installedGameDS.hpp"
 #include "ui/navigation/navigationGroups.hpp"
 #include "ui/page/search.hpp"
@@ -20,6 +22,7 @@
 #include "ui/view/dialog/scrollDialog.hpp"
 #include "ui/view/longTextBox.hpp"
 #include "utils/format.hpp"
+#include "utils/iconCache.hpp"
 #include "utils/threadPool.hpp"
 #include <borealis/core/cache_helper.hpp>
 #include <borealis/core/i18n.hpp>
@@ -177,12 +180,7 @@ void AddGame::onRealGameCardClicked(size_t index, std::vector<fs::DirEntry> mods
             std::vector<fs::DirEntry> chosen;
             for (int i : selected) chosen.push_back(mods[i]);
             auto& installed = m_gameManager.getInstalledGames()[index];
-            int iconId = -1;
-            if (m_gameManager.findByAppId(installed.appId) < 0 && !installed.iconKey.empty()) {
-                int cachedIconId = brls::TextureCache::instance().getCache(installed.iconKey);
-                if (cachedIconId > 0) iconId = cachedIconId;
-            }
-            std::string dirPath = m_gameManager.addGame(index, static_cast<int>(chosen.size()), iconId);
+            std::string dirPath = m_gameManager.addGame(index, static_cast<int>(chosen.size()));
             int added = ModManager::addModsFormTransit(dirPath, chosen);
             m_gameManager.setPendingFocusPath(dirPath);
             auto* cell = m_grid->getGridItemByIndex(index);
@@ -306,7 +304,9 @@ void AddGame::submitNextCard() {
 
         if (!wasLoaded && appId != 0) {
             auto meta = gameManager.fetchMetadataByAppId(appId);
-            image = imageDecoder::decodeJpeg(meta.icon.data(), meta.icon.size());
+            image = iconCache::load(format::appIdHex(appId), meta.version, [&meta] {
+                return imageDecoder::decodeJpeg(meta.icon.data(), meta.icon.size());
+            });
             name = std::move(meta.name);
             version = std::move(meta.version);
         }
@@ -331,12 +331,13 @@ int AddGame::loadVirtualIcon() {
 }
 
 int AddGame::loadGameIcon(const std::string& key, const imageDecoder::DecodedImage& image) {
-    auto& textureCache = brls::TextureCache::instance();
-    int iconId = textureCache.getCache(key);
+    int iconId = IconTextureLru::instance().acquire(key);
     if (iconId > 0 || image.width <= 0 || image.height <= 0 || image.pixels.empty()) return iconId;
 
     iconId = nvgCreateImageRGBA(brls::Application::getNVGContext(), image.width, image.height, 0, image.pixels.data());
-    if (iconId > 0) textureCache.addCache(key, iconId);
+    if (iconId <= 0) return iconId;
+    brls::TextureCache::instance().addCache(key, iconId);
+    IconTextureLru::instance().keep(key, iconId, image.pixels.size());
     return iconId;
 }
 
@@ -351,7 +352,8 @@ void AddGame::applyCard(uint64_t appId, bool wasLoaded, std::string name, std::s
         game.iconKey = iconId > 0 ? config::virtualGameIconKey : "";
     } else if (wasLoaded) {
         if (!game.iconKey.empty()) {
-            iconId = textureCache.getCache(game.iconKey);
+            // 主页已加载的游戏：图标在 Home 的图集中
+            iconId = IconAtlas::instance().acquireTexture(game.iconKey);
             if (iconId <= 0) {
                 game.isLoaded = false;
                 submitNextCard();
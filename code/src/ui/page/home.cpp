@@ -8,9 +8,12 @@
 #include "core/appUpdater.hpp"
 #include "core/audio.hpp"
 #include "core/device.hpp"
+#include "core/downloadManager.hpp"
 #include "core/frameQueue.hpp"
 #include "core/modManager.hpp"
 #include "core/storeGameIconCache.hpp"
+#include "ui/core/iconAtlas.hpp"
+#include "ui/core/iconTextureLru.hpp"
 #include "ui/dataSource/gameCardDS.hpp"
 #include "ui/navigation/navigationGroups.hpp"
 #include "ui/page/addGame.hpp"
@@ -26,13 +29,14 @@
 #include "ui/view/gameCard.hpp"
 #include "ui/view/longTextBox.hpp"
 #include "utils/format.hpp"
+#include "utils/iconCache.hpp"
 #include "utils/keyboard.hpp"
 #include <algorithm>
 #include <borealis/core/cache_helper.hpp>
 #include <borealis/core/i18n.hpp>
 #include <chrono>
-#include <climits>
 #include <cstdlib>
+#include <future>
 #include <switch.h>
 #include <utility>
 #include <vector>
@@ -101,6 +105,8 @@ void Home::onContentAvailable() {
 
     setupMenu();
     startCardLoader();
+    startLibraryReconcile();
+    startDownloadQueue();
     runStartupDialogs();
 }
 
@@ -113,13 +119,26 @@ void Home::showEmptyHint() {
 }
 
 void Home::onResume() {
+    // 其他页面打开期间完成的游戏库核对
+    if (m_pendingLibraryScan) {
+        brls::sync(std::move(m_pendingLibraryScan));
+        m_pendingLibraryScan = nullptr;
+    }
+
+    // 其他页面打开期间下载完成、需要新建游戏项目的商店模组
+    if (!m_pendingDownloads.empty()) {
+        brls::sync([this, ids = std::exchange(m_pendingDownloads, {})] {
+            for (int id : ids) completeStoreDownload(id);
+        });
+    }
+
     // 清理 ModList 返回后留下的空项目
     std::string pendingCleanupPath = m_gameManager.consumePendingCleanup();
     if (!pendingCleanupPath.empty()) {
         brls::sync([this, pendingCleanupPath] {
             int cleanupIdx = m_gameManager.findByDirPath(pendingCleanupPath);
             int iconId = m_gameManager.games()[cleanupIdx].iconId;
-            if (m_gameManager.cleanupGame(cleanupIdx) && iconId > 0) brls::TextureCache::instance().removeCache(iconId);
+            if (m_gameManager.cleanupGame(cleanupIdx) && iconId > 0) IconAtlas::instance().removeCache(iconId);
             if (m_gameManager.games().empty()) {
                 showEmptyHint();
             } else {
@@ -145,6 +164,9 @@ void Home::onResume() {
         m_grid->deferReload(newIdx);
         m_focusedIndex = newIdx;
         setNacpActionsAvailable(m_nacpComplete);
+
+        // 新增页面添加的项目需要加载图标
+        if (m_nacpComplete && newIdx >= 0 && m_gameManager.games()[newIdx].isPending) scheduleCards();
     });
 }
 
@@ -158,6 +180,8 @@ void Home::setupGridPage() {
     m_grid->setFocusChangeCallback([this](size_t index) {
         m_focusedIndex.store(index);
         ShellState::setIndexText(std::to_string(index + 1) + " / " + std::to_string(m_gameManager.games().size()));
+        // 加载中滚动时重新排优先级，取消滚出范围的任务
+        if (cardsLoading()) scheduleCards();
     });
 }
 
@@ -309,7 +333,7 @@ void Home::removeGame() {
 
     auto onConfirmDelete = [this, idx] {
         int iconId = m_gameManager.games()[idx].iconId;
-        if (m_gameManager.removeGame(idx) && iconId > 0) brls::TextureCache::instance().removeCache(iconId);
+        if (m_gameManager.removeGame(idx) && iconId > 0) IconAtlas::instance().removeCache(iconId);
         if (m_gameManager.games().empty()) {
             showEmptyHint();
         } else {
@@ -370,7 +394,7 @@ void Home::deleteGame() {
 
                 ProgressDialog::close([this, idx] {
                     int iconId = m_gameManager.games()[idx].iconId;
-                    if (m_gameManager.deleteGame(idx) && iconId > 0) brls::TextureCache::instance().removeCache(iconId);
+                    if (m_gameManager.deleteGame(idx) && iconId > 0) IconAtlas::instance().removeCache(iconId);
                     deviceControl::HomeButton::enable();
 
                     if (m_gameManager.games().empty()) {
@@ -450,7 +474,9 @@ void Home::deleteIconCache() {
 
         m_deleteIconCacheTask = util::async([](std::stop_token) {
             StoreGameIconCache::deleteCache();
+            iconCache::clear();
             brls::sync([] {
+                IconTextureLru::instance().clear();
                 deviceControl::CpuBoost::disable();
                 deviceControl::HomeButton::enable();
                 CustomDialog::show(brls::getStr("page/home/deleteIconCacheComplete"), {{brls::getStr("page/home/ok"), [] { CustomDialog::close(); }}});
@@ -628,8 +654,14 @@ void Home::setupSettingsMenu() {
     });
     cpuBoostItem.setTask([](bool value) {
         Settings::setBool("Performance", "cpuBoost", value);
+        deviceControl::CpuBoost::setEnabled(value);
     });
 
+    auto& concurrencyItem = m_advancedSettingsMenu.addSubmenu(brls::getStr("page/home/downloadConcurrency"), brls::getStr("page/home/downloadConcurrencyDesc"));
+    concurrencyItem.setIcon(format::themedIconPath("img/menu/download"));
+    concurrencyItem.setBadge([]{ return brls::getStr("page/home/downloadConcurrencyItem", DownloadManager::instance().concurrency()); });
+    concurrencyItem.setPage(m_downloadConcurrencyMenu);
+
     auto& transitItem = m_assistFeaturesMenu.addAction(brls::getStr("page/home/clearTransitItem"), brls::getStr("page/home/clearTransitDesc"));
     transitItem.setIcon(format::themedIconPath("img/menu/clearTransferStation"));
     transitItem.setBadge([this]() {
@@ -738,6 +770,18 @@ void Home::setupThemeMenu() {
     themeDarkItem.setStayOpen();
 }
 
+void Home::setupDownloadConcurrencyMenu() {
+    m_downloadConcurrencyMenu.setIcon(format::themedIconPath("img/menu/download"));
+
+    for (int count = 1; count <= DownloadManager::maxConcurrency; count++) {
+        auto& item = m_downloadConcurrencyMenu.addRadio(brls::getStr("page/home/downloadConcurrencyItem", count), brls::getStr("page/home/downloadConcurrencyItemDesc", count));
+        item.setIcon(format::themedIconPath("img/menu/download"));
+        item.setSelected([count]{ return DownloadManager::instance().concurrency() == count; });
+        item.onSelected([count]{ DownloadManager::instance().setConcurrency(count); });
+        item.setStayOpen();
+    }
+}
+
 void Home::setupSortFilterMenu() {
     m_sortFilterMenu.setIcon(format::themedIconPath("img/menu/sortType"));
 
@@ -773,6 +817,7 @@ void Home::setupMenu() {
     setupSortFilterMenu();
     setupThemeMenu();
     setupLangMenu();
+    setupDownloadConcurrencyMenu();
     setupSettingsMenu();
 
     // ── 主菜单 ──
@@ -830,68 +875,212 @@ void Home::setupMenu() {
 // TextureCache 会将该事件发生前创建的纹理缓存标记为失效。
 // 如果立即加载第一张游戏卡片，其图标可能先写入缓存，随后被标记为失效，
 // 导致其他页面无法再通过 App ID 查询该纹理。
-// 因此这里等待首次窗口尺寸事件执行后，再开始依次加载游戏卡片。
+// 因此这里等待首次窗口尺寸事件执行后，再开始加载游戏卡片。
 // 订阅需要在使用后取消，避免以后插拔底座时再次启动卡片加载；
 // 但不能在事件遍历过程中直接删除当前回调，所以通过 brls::sync()
 // 延迟到下一次主线程任务中取消订阅。
 void Home::startCardLoader() {
     auto* event = brls::Application::getWindowSizeChangedEvent();
     m_windowSizeChangedSubscription = event->subscribe([this, event] {
-        submitNextCard();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+        brls::Logger::info("Home: first frame after {} ms ({} games, {})", elapsed, m_gameManager.games().size(), m_gameManager.loadedFromSnapshot() ? "snapshot" : "scan");
+        scheduleCards();
         brls::sync([this, event] {
             event->unsubscribe(m_windowSizeChangedSubscription);
         });
     });
 }
 
-void Home::submitNextCard() {
+void Home::scheduleCards() {
+    // 待加载的游戏按（是否在可见范围外，与焦点的距离）排序
     auto& games = m_gameManager.games();
-    size_t gameIdx = games.size();
+    size_t first = 0, last = 0;
+    bool hasRange = m_grid->getVisibleRange(first, last);
     int focusedIndex = m_focusedIndex.load();
-    int bestDist = INT_MAX;
+    std::vector<std::pair<size_t, uint64_t>> candidates;
     for (size_t index = 0; index < games.size(); index++) {
         if (!games[index].isPending) continue;
-        int dist = std::abs(static_cast<int>(index) - focusedIndex);
-        if (dist < bestDist) {
-            bestDist = dist;
-            gameIdx = index;
-        }
+        size_t dist = static_cast<size_t>(std::abs(static_cast<int>(index) - focusedIndex));
+        bool visible = hasRange && index >= first && index <= last;
+        candidates.emplace_back(visible ? dist : games.size() + dist, games[index].appId);
     }
-    if (gameIdx == games.size()) {
+    if (candidates.empty()) {
         finishNacpLoading();
         return;
     }
+    std::sort(candidates.begin(), candidates.end());
+
+    // 同一 appId 的多个项目只加载一次
+    std::vector<uint64_t> wanted;
+    for (const auto& [priority, appId] : candidates) {
+        if (std::find(wanted.begin(), wanted.end(), appId) != wanted.end()) continue;
+        wanted.push_back(appId);
+        if (wanted.size() == cardPrefetchJobs) break;
+    }
 
-    uint64_t appId = games[gameIdx].appId;
-    m_nacpLoader = util::async([this, appId](std::stop_token token) {
-        auto meta = m_gameManager.fetchMetadataByAppId(appId);
-        auto image = imageDecoder::decodeJpeg(meta.icon.data(), meta.icon.size());
-        std::string name = std::move(meta.name);
-        std::string version = std::move(meta.version);
+    // 已滚出可见范围且不在前列的任务取消，等它自行退出，不阻塞主线程；退出前仍占用槽位，线程数不超过 cardPrefetchJobs
+    for (auto& slot : m_cardSlots) {
+        if (slot.appId == 0 || slot.cancelled || std::find(wanted.begin(), wanted.end(), slot.appId) != wanted.end()) continue;
+        int idx = m_gameManager.findByAppId(slot.appId);
+        if (idx >= 0 && hasRange && static_cast<size_t>(idx) >= first && static_cast<size_t>(idx) <= last) continue;
+        slot.task.request_stop();
+        slot.cancelled = true;
+    }
 
+    for (uint64_t appId : wanted) {
+        auto loading = [appId](const CardSlot& slot) { return slot.appId == appId && !slot.cancelled; };
+        if (std::any_of(m_cardSlots.begin(), m_cardSlots.end(), loading)) continue;
+        auto slot = std::find_if(m_cardSlots.begin(), m_cardSlots.end(), [](const CardSlot& slot) { return slot.appId == 0; });
+        if (slot == m_cardSlots.end()) break;
+
+        slot->appId = appId;
+        slot->task = util::async([this, appId](std::stop_token token) {
+            auto meta = m_gameManager.fetchMetadataByAppId(appId);
+            if (!token.stop_requested()) {
+                // 版本号变化（游戏更新可能换图标）时重新解码
+                auto image = iconCache::load(format::appIdHex(appId), meta.version, [&meta] {
+                    return imageDecoder::decodeJpeg(meta.icon.data(), meta.icon.size());
+                });
+                std::string name = std::move(meta.name);
+                std::string version = std::move(meta.version);
+
+                // 纹理上传仍经逐帧队列，每帧最多一两张
+                if (!token.stop_requested()) {
+                    FrameQueue::enqueue(token, [this, appId, name = std::move(name), version = std::move(version), image = std::move(image)]() mutable {
+                        applyCard(appId, std::move(name), std::move(version), std::move(image));
+                    });
+                }
+            }
+            // 被取消时由主线程回收槽位（逐帧队列中的 applyCard 随令牌一并作废）
+            if (token.stop_requested()) brls::sync([this, appId] { releaseCancelledCard(appId); });
+        });
+    }
+}
+
+void Home::releaseCancelledCard(uint64_t appId) {
+    for (auto& slot : m_cardSlots) {
+        if (slot.appId != appId || !slot.cancelled) continue;
+        slot.appId = 0;
+        slot.cancelled = false;
+        break;
+    }
+    scheduleCards();
+}
+
+bool Home::cardsLoading() const {
+    return std::any_of(m_cardSlots.begin(), m_cardSlots.end(), [](const CardSlot& slot) { return slot.appId != 0; });
+}
+
+void Home::startLibraryReconcile() {
+    if (!m_gameManager.loadedFromSnapshot()) return;
+
+    uint32_t version = m_gameManager.libraryVersion();
+    m_reconcileTask = util::async([this, version](std::stop_token token) {
+        auto entries = gameLibrary::scan(&token);
         if (token.stop_requested()) return;
-        FrameQueue::enqueue(token, [this, appId, name = std::move(name), version = std::move(version), image = std::move(image)]() mutable {
-            applyCard(appId, std::move(name), std::move(version), std::move(image));
+        brls::sync([this, version, entries = std::move(entries)]() mutable {
+            applyLibraryScan(version, std::move(entries));
         });
     });
 }
 
+void Home::applyLibraryScan(uint32_t version, std::vector<gameLibrary::GameDirEntry> entries) {
+    // 其他页面可能持有游戏索引，回到主页后再应用
+    if (!Page::isActive()) {
+        m_pendingLibraryScan = [this, version, entries = std::move(entries)]() mutable {
+            applyLibraryScan(version, std::move(entries));
+        };
+        return;
+    }
+
+    auto& games = m_gameManager.games();
+    std::string focusPath;
+    int focusedIndex = m_focusedIndex.load();
+    if (focusedIndex >= 0 && focusedIndex < static_cast<int>(games.size())) focusPath = games[focusedIndex].dirPath;
+
+    auto diff = m_gameManager.applyScan(version, entries);
+    if (!diff.applied) {
+        // 扫描期间列表被修改，结果可能已过期，重新扫描
+        startLibraryReconcile();
+        return;
+    }
+    if (!diff.any()) return;
+
+    for (int iconId : diff.releasedIcons) IconAtlas::instance().removeCache(iconId);
+    if (games.empty()) {
+        showEmptyHint();
+        return;
+    }
+
+    int newIdx = focusPath.empty() ? -1 : m_gameManager.findByDirPath(focusPath);
+    if (newIdx < 0) newIdx = std::min(focusedIndex, static_cast<int>(games.size()) - 1);
+    if (m_grid->getVisibility() == brls::Visibility::GONE) {
+        m_grid->setVisibility(brls::Visibility::VISIBLE);
+        m_noModHint->setVisibility(brls::Visibility::GONE);
+    }
+    m_grid->deferReload(newIdx);
+    m_focusedIndex = newIdx;
+    setNacpActionsAvailable(m_nacpComplete);
+
+    // 新增项目需要加载 NACP，首轮加载已结束时重新启动
+    if (diff.added > 0 && m_nacpComplete) scheduleCards();
+}
+
+void Home::startDownloadQueue() {
+    DownloadManager::instance().start([this](int taskId) {
+        brls::sync([this, taskId] { completeStoreDownload(taskId); });
+    });
+}
+
+void Home::completeStoreDownload(int taskId) {
+    auto& games = m_gameManager.games();
+    std::string focusPath;
+    int focusedIndex = m_focusedIndex.load();
+    if (focusedIndex >= 0 && focusedIndex < static_cast<int>(games.size())) focusPath = games[focusedIndex].dirPath;
+
+    // 新建项目会重新排序游戏列表，其他页面可能持有游戏索引，回到主页后再放入
+    auto result = DownloadManager::instance().complete(taskId, m_gameManager, Page::isActive());
+    if (result.deferred) {
+        m_pendingDownloads.push_back(taskId);
+        return;
+    }
+    if (!result.success) return;
+
+    int gameIdx = m_gameManager.findByDirPath(result.gameDir);
+    if (gameIdx < 0) return;
+    if (!result.newGame) {
+        m_grid->reloadItem(gameIdx);
+        return;
+    }
+
+    int newIdx = focusPath.empty() ? gameIdx : m_gameManager.findByDirPath(focusPath);
+    if (m_grid->getVisibility() == brls::Visibility::GONE) {
+        m_grid->setVisibility(brls::Visibility::VISIBLE);
+        m_noModHint->setVisibility(brls::Visibility::GONE);
+    }
+    m_grid->deferReload(newIdx);
+    m_focusedIndex = newIdx;
+    setNacpActionsAvailable(m_nacpComplete);
+
+    // 已安装的游戏需要读取 NACP 补齐名称和图标，首轮加载已结束时重新启动
+    if (games[gameIdx].isInstalled) {
+        games[gameIdx].isPending = true;
+        if (m_nacpComplete) scheduleCards();
+    }
+}
+
 int Home::loadGameIcon(uint64_t appId, const imageDecoder::DecodedImage& image) {
-    auto& textureCache = brls::TextureCache::instance();
+    auto& atlas = IconAtlas::instance();
     std::string key = format::appIdHex(appId);
-    int iconId = textureCache.getCache(key);
+    int iconId = atlas.getCache(key);
     if (iconId > 0) return iconId;
-    if (image.width <= 0 || image.height <= 0 || image.pixels.empty()) return -1;
 
-    iconId = nvgCreateImageRGBA(brls::Application::getNVGContext(), image.width, image.height, 0, image.pixels.data());
-    if (iconId <= 0) return -1;
-
-    textureCache.addCache(key, iconId);
-    return iconId;
+    iconId = atlas.addCache(key, image);
+    return iconId > 0 ? iconId : -1;
 }
 
 void Home::applyCard(uint64_t appId, std::string name, std::string version, imageDecoder::DecodedImage image) {
-    auto indices = m_gameManager.findAllByAppId(appId);
+    const auto& indices = m_gameManager.findAllByAppId(appId);
     auto& games = m_gameManager.games();
     int iconId = -1;
     for (int idx : indices) {
@@ -911,10 +1100,16 @@ void Home::applyCard(uint64_t appId, std::string name, std::string version, imag
         m_grid->reloadItem(idx);
     }
 
-    submitNextCard();
+    for (auto& slot : m_cardSlots) {
+        if (slot.appId == appId && !slot.cancelled) slot.appId = 0;
+    }
+    scheduleCards();
 }
 
 void Home::finishNacpLoading() {
+    auto stats = iconCache::stats();
+    brls::Logger::info("Home: icon cache {} hit / {} miss, read {:.1f} ms, decode {:.1f} ms, saved ~{:.1f} ms",
+                       stats.hits, stats.misses, stats.readMs, stats.decodeMs, stats.savedMs());
     m_gameManager.saveJsonCache();
     m_nacpComplete = true;
     setNacpActionsAvailable(m_nacpComplete);
@@ -10,10 +10,13 @@
 #include "core/frameQueue.hpp"
 #include "core/modInstaller/dontStarve.hpp"
 #include "core/modInstaller/mhrise.hpp"
+#include "core/modInstaller/utils.hpp"
+#include "ui/core/iconAtlas.hpp"
 #include "ui/view/modCard.hpp"
 #include "ui/dataSource/modCardDS.hpp"
 #include "utils/format.hpp"
 #include "core/device.hpp"
+#include "core/downloadManager.hpp"
 #include "utils/fsHelper.hpp"
 #include "ui/view/dialog/customDialog.hpp"
 #include "ui/view/dialog/progressDialog.hpp"
@@ -40,10 +43,21 @@ ModList::ModList(size_t gameIndex, GameManager& gameManager)
     : m_gameManager(gameManager), m_gameIndex(gameIndex), m_modManager(gameManager.games()[gameIndex]) {
     inflateFromXMLRes("xml/view/page/modList.xml");
 
+    // 后台下载完成时写入本页的 ModManager；页面在前台时原地刷新列表，保持当前焦点
+    auto& downloads = DownloadManager::instance();
+    downloads.attach(&m_modManager);
+    m_downloadListener = downloads.addListener([this](const DownloadManager::Completion& completion) {
+        if (!completion.success || completion.gameDir != m_modManager.game().dirPath || !Page::isActive()) return;
+        m_modManager.consumePendingFocus();
+        m_grid->deferReload(m_focusedIndex);
+    });
+
     setHeader();
 }
 
 ModList::~ModList() {
+    DownloadManager::instance().removeListener(m_downloadListener);
+    DownloadManager::instance().detach(&m_modManager);
     m_stopSource.request_stop();
     m_installStop.request_stop();
     if (m_iconRetryDelayId != 0) brls::cancelDelay(m_iconRetryDelayId);
@@ -222,6 +236,8 @@ void ModList::startModInstallTask(int index) {
         });
     };
 
+    // 安装期间后台下载完成的模组不写入本页列表，结束后再放入
+    DownloadManager::instance().hold(&m_modManager);
     m_installTask = ThreadPool::instance().submitWaitable([this, index, installing, progressCb, pageToken](std::stop_token token) {
         using Clock = std::chrono::steady_clock;
         auto startTime = Clock::now();
@@ -270,6 +286,8 @@ void ModList::startModInstallTask(int index) {
             else msg = (installing ? brls::getStr("page/modList/installFailed", errorMsg, errorFile) : brls::getStr("page/modList/uninstallFailed", errorMsg, errorFile));
             CustomDialog::show(msg, {{brls::getStr("page/modList/ok"), [] { CustomDialog::close(); }}});
         });
+        // 上面的结果处理先于推迟的下载完成在主线程执行，按索引更新安装状态不受影响
+        DownloadManager::instance().release(&m_modManager);
     }, installToken);
 }
 
@@ -355,6 +373,7 @@ void ModList::submitNextCard() {
     }
     if (modIdx == mods.size()) {
         startMetadataLoader(true);
+        submitIndexVerify();
         return;
     }
 
@@ -486,7 +505,7 @@ void ModList::setGameIcon() {
     std::string tid = format::appIdHex(m_modManager.game().appId);
 
     FrameQueue::enqueue(token, [this, tid, token] {
-        int textureId = brls::TextureCache::instance().getCache(tid);
+        int textureId = IconAtlas::instance().acquireTexture(tid);
         if (textureId > 0) {
             m_gameIcon->setFreeTexture(false);
             m_gameIcon->innerSetImage(textureId);
@@ -498,7 +517,7 @@ void ModList::setGameIcon() {
         m_iconRetryDelayId = brls::delay(1000, [this, tid, token] {
             m_iconRetryDelayId = 0;
             FrameQueue::enqueue(token, [this, tid] {
-                int textureId = brls::TextureCache::instance().getCache(tid);
+                int textureId = IconAtlas::instance().acquireTexture(tid);
                 if (textureId == 0) return;
 
                 brls::TextureCache::instance().removeCache(m_gameIcon->getTexture());
@@ -611,6 +630,13 @@ void ModList::submitUpdateCheck() {
     }, m_stopSource.get_token());
 }
 
+void ModList::submitIndexVerify() {
+    std::string gameDirPath = m_modManager.game().dirPath;
+    ThreadPool::instance().submit([gameDirPath = std::move(gameDirPath)](std::stop_token token) {
+        ModInstaller::utils::verifyInstalledFiles(gameDirPath, token);
+    }, m_stopSource.get_token());
+}
+
 void ModList::applyModDisplayName(int idx, const std::string& name) {
     m_modManager.setDisplayName(idx, name);
     auto& mod = m_modManager.mods()[idx];
@@ -771,6 +797,7 @@ void ModList::forceClean() {
         auto installToken = m_installStop.get_token();
         auto pageToken = m_stopSource.get_token();
 
+        DownloadManager::instance().hold(&m_modManager);
         m_installTask = ThreadPool::instance().submitWaitable([this, pageToken](std::stop_token token) {
             auto result = m_modManager.forceClean(token, [pageToken](int deleted, int total, const char* fileName) {
                 std::string fileNameStr = fileName ? fileName : "";
@@ -809,6 +836,7 @@ void ModList::forceClean() {
                 auto onClose = [this] { CustomDialog::close([this] { m_modManager.sort(); refreshAndFocus(0); }); };
                 CustomDialog::show(msg, {{brls::getStr("page/modList/ok"), onClose}}, onClose);
             });
+            DownloadManager::instance().release(&m_modManager);
         }, installToken);
     };
 
@@ -896,6 +924,7 @@ void ModList::startDeleteMod(int idx) {
     deviceControl::HomeButton::disable();
     ProgressDialog::show(brls::getStr("page/modList/deletingMod"), {}, [] {});
 
+    DownloadManager::instance().hold(&m_modManager);
     m_installTask = ThreadPool::instance().submitWaitable([this, idx, lastMod, gameDirPath](std::stop_token) {
         auto result = m_modManager.deleteModContents(idx, [](int deleted, int total, const char* fileName) {
             std::string fileNameStr = fileName ? fileName : "";
@@ -937,6 +966,7 @@ void ModList::startDeleteMod(int idx) {
                 else refreshAndFocus(newFocus);
             });
         });
+        DownloadManager::instance().release(&m_modManager);
     }, std::stop_token{});
 }
 
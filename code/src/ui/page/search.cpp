@@ -100,9 +100,9 @@ brls::View* ResultButtonGrid::create() {
 }
 
 Search::Search(const std::vector<std::string>& items, std::function<void(int)> onSelect)
-    : m_items(items)
-    , m_onSelect(std::move(onSelect)) {
+    : m_onSelect(std::move(onSelect)) {
     inflateFromXMLRes("xml/view/page/search.xml");
+    m_searchEngine.setItems(items);
 
     setHeader();
     setFooterBackgroundTheme("app/keyboardBg");
@@ -190,7 +190,7 @@ void Search::updateResults(const std::string& keyword) {
         return;
     }
 
-    auto results = m_searchEngine.search(keyword, m_items, 6);
+    auto results = m_searchEngine.search(keyword, 6);
     if (results.empty()) {
         showHint(brls::getStr("page/search/hintEmpty"));
         return;
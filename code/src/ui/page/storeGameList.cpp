@@ -3,9 +3,12 @@
  */
 
 #include "ui/page/storeGameList.hpp"
+#include "api/url.hpp"
 #include "common/config.hpp"
 #include "core/audio.hpp"
 #include "core/frameQueue.hpp"
+#include "core/storeCatalog.hpp"
+#include "ui/core/iconTextureLru.hpp"
 #include "ui/dataSource/storeGameListDS.hpp"
 #include "ui/navigation/navigationGroups.hpp"
 #include "ui/page/storeModList.hpp"
@@ -14,6 +17,7 @@
 #include "ui/view/qrCodeView.hpp"
 #include "ui/view/storeGameCard.hpp"
 #include "utils/format.hpp"
+#include "utils/iconCache.hpp"
 #include "utils/threadPool.hpp"
 #include <borealis/core/cache_helper.hpp>
 #include <borealis/core/i18n.hpp>
@@ -30,6 +34,7 @@ StoreGameList::StoreGameList(GameManager& gameManager)
 
 StoreGameList::~StoreGameList() {
     m_stopSource.request_stop();
+    m_catalogStopSource.request_stop();
     m_iconFileCache.save();
 }
 
@@ -76,6 +81,7 @@ void StoreGameList::onContentAvailable() {
     });
 
     loadNextPage();
+    refreshCatalog();
 }
 
 void StoreGameList::setupGrid() {
@@ -107,6 +113,17 @@ void StoreGameList::loadNextPage() {
     ThreadPool::instance().submit([this, page, filterMode, keyword, tidsJson](std::stop_token token) {
         if (token.stop_requested()) return;
 
+        // 搜索首页先由本地目录作答，服务器结果到达后再合并（离线时只显示本地结果）
+        if (page == 1 && !keyword.empty()) {
+            auto local = StoreCatalog::instance().search(keyword, api::url::getLang());
+            if (!local.empty()) {
+                brls::sync([this, local = std::move(local), token]() mutable {
+                    if (token.stop_requested()) return;
+                    onLocalResults(std::move(local));
+                });
+            }
+        }
+
         api::game::GameListResult result;
         if (filterMode == GameFilterMode::Installed) result = api::game::fetchInstalledGameList(page, 20, keyword, tidsJson, true, token);
         else if (filterMode == GameFilterMode::NotInstalled) result = api::game::fetchInstalledGameList(page, 20, keyword, tidsJson, false, token);
@@ -115,11 +132,21 @@ void StoreGameList::loadNextPage() {
 
         brls::sync([this, result = std::move(result), token]() mutable {
             if (token.stop_requested()) return;
-            onPageLoaded(std::move(result));
+            if (m_manager.isLocalResults()) onServerResultsMerged(std::move(result));
+            else onPageLoaded(std::move(result));
         });
     }, token);
 }
 
+void StoreGameList::refreshCatalog() {
+    // 只访问单例，不捕获页面；页面退出时取消，未完成的刷新不会写入
+    ThreadPool::instance().submit([](std::stop_token token) {
+        auto& catalog = StoreCatalog::instance();
+        if (token.stop_requested() || !catalog.needsRefresh()) return;
+        catalog.refresh(StoreCatalog::apiSource(), token);
+    }, m_catalogStopSource.get_token());
+}
+
 bool StoreGameList::handleBackOrResetSearch() {
     if (!m_keyword.empty()) {
         Audio::instance()->play(SoundEffect::Click);
@@ -224,6 +251,10 @@ void StoreGameList::submitNextIcon() {
     }
     if (gameIdx == list.size()) {
         m_iconLoading = false;
+        auto& lru = IconTextureLru::instance();
+        auto stats = iconCache::stats();
+        brls::Logger::info("StoreGameList: textures {} hit / {} miss, icon cache {} hit / {} miss, saved ~{:.1f} ms",
+                           lru.hits(), lru.misses(), stats.hits, stats.misses, stats.savedMs());
         return;
     }
 
@@ -231,9 +262,8 @@ void StoreGameList::submitNextIcon() {
     list[gameIdx].isLoading = true;
     auto token = m_stopSource.get_token();
     FrameQueue::enqueue(token, [this, tid = std::move(tid)] {
-        auto& textureCache = brls::TextureCache::instance();
         std::string key = "S" + tid;
-        int iconId = textureCache.getCache(key);
+        int iconId = IconTextureLru::instance().acquire(key);
         if (iconId > 0) {
             showCard(tid, iconId);
             scheduleNetworkTasks();
@@ -242,12 +272,15 @@ void StoreGameList::submitNextIcon() {
         }
 
         auto token = m_stopSource.get_token();
-        ThreadPool::instance().submit([this, tid](std::stop_token token) {
+        std::string tag = m_iconFileCache.metadata(tid).tag();
+        ThreadPool::instance().submit([this, tid, key = std::move(key), tag = std::move(tag)](std::stop_token token) {
             if (token.stop_requested()) return;
 
-            auto data = StoreGameIconCache::readIcon(tid);
-            imageDecoder::DecodedImage image;
-            if (!data.empty()) image = imageDecoder::decodeWebp(data.data(), data.size());
+            auto image = iconCache::load(key, tag, [&tid] {
+                auto data = StoreGameIconCache::readIcon(tid);
+                if (data.empty()) return imageDecoder::DecodedImage{};
+                return imageDecoder::decodeWebp(data.data(), data.size());
+            });
             if (token.stop_requested()) return;
 
             if (image.width > 0 && image.height > 0 && !image.pixels.empty()) {
@@ -280,12 +313,13 @@ void StoreGameList::queueCardReload(std::string key) {
 }
 
 int StoreGameList::loadGameIcon(const std::string& key, const imageDecoder::DecodedImage& image) {
-    auto& textureCache = brls::TextureCache::instance();
-    int iconId = textureCache.getCache(key);
+    int iconId = brls::TextureCache::instance().getCache(key);
     if (iconId > 0 || image.width <= 0 || image.height <= 0 || image.pixels.empty()) return iconId;
 
     iconId = nvgCreateImageRGBA(brls::Application::getNVGContext(), image.width, image.height, 0, image.pixels.data());
-    if (iconId > 0) textureCache.addCache(key, iconId);
+    if (iconId <= 0) return iconId;
+    brls::TextureCache::instance().addCache(key, iconId);
+    IconTextureLru::instance().keep(key, iconId, image.pixels.size());
     return iconId;
 }
 
@@ -363,7 +397,8 @@ void StoreGameList::submitIconDownload(std::string tid) {
         imageDecoder::DecodedImage image;
         if (success) {
             StoreGameIconCache::writeIcon(tid, result.data);
-            image = imageDecoder::decodeWebp(result.data.data(), result.data.size());
+            image = iconCache::downscale(imageDecoder::decodeWebp(result.data.data(), result.data.size()));
+            iconCache::write("S" + tid, StoreGameIconCache::Metadata{result.etag, result.lastModified}.tag(), image);
         }
         if (token.stop_requested()) return;
 
@@ -391,7 +426,11 @@ void StoreGameList::submitIconValidation(std::string tid, api::game::IconCacheVa
         std::string lastModified = std::move(result.lastModified);
         brls::sync([this, tid = std::move(tid), hasUpdate, etag = std::move(etag), lastModified = std::move(lastModified), token] {
             if (token.stop_requested()) return;
-            if (hasUpdate) m_iconFileCache.updateMetadata(tid, etag, lastModified);
+            if (hasUpdate) {
+                // 下次显示时按新标签重新解码，不再沿用常驻的旧纹理
+                m_iconFileCache.updateMetadata(tid, etag, lastModified);
+                IconTextureLru::instance().drop("S" + tid);
+            }
             m_iconChecking = false;
             scheduleNetworkTasks();
         });
@@ -419,6 +458,27 @@ void StoreGameList::onPageLoaded(api::game::GameListResult result) {
 
     bool firstPage = m_manager.currentPage() == 0;
     m_manager.appendPage(std::move(result));
+    showList(firstPage);
+}
+
+void StoreGameList::onLocalResults(std::vector<api::game::GameList> list) {
+    m_manager.setLocalResults(std::move(list));
+    if (m_manager.storeGameList().empty()) {
+        m_manager.reset();
+        return;
+    }
+    showList(true);
+}
+
+void StoreGameList::onServerResultsMerged(api::game::GameListResult result) {
+    m_loading = false;
+    if (!result.success) return;
+    if (m_manager.mergeServerPage(std::move(result)) == 0) return;
+    m_grid->notifyDataChanged();
+    startIconLoader();
+}
+
+void StoreGameList::showList(bool firstPage) {
     auto& list = m_manager.storeGameList();
     if (list.empty()) {
         m_grid->setDataSource(nullptr);
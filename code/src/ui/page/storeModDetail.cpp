@@ -12,21 +12,28 @@
 #include "ui/view/imageViewer.hpp"
 #include "ui/view/qrCodeView.hpp"
 #include "common/modInfo.hpp"
+#include "utils/async.hpp"
 #include "utils/format.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/iconCache.hpp"
+#include "utils/partialFile.hpp"
 #include "utils/textClean.hpp"
 #include "utils/threadPool.hpp"
 #include "core/audio.hpp"
 #include "core/device.hpp"
+#include "core/downloadManager.hpp"
 #include "core/frameQueue.hpp"
 #include "common/settings.hpp"
 #include "ui/navigation/navigationGroups.hpp"
 #include "utils/keyboard.hpp"
 #include "common/config.hpp"
+#include "ui/core/iconAtlas.hpp"
 #include "ui/core/pageHost.hpp"
 #include "ui/page/modList.hpp"
 #include "ui/page/storeModList.hpp"
 #include <borealis/core/cache_helper.hpp>
 #include <yoga/Yoga.h>
+#include <algorithm>
 #include <chrono>
 
 StoreModDetail::StoreModDetail(int modId, std::string gameTid, std::string gameName, std::string gameIconKey, GameManager& gameManager, ReturnCallback onReturn, ModManager* localModManager, std::string gameVersion, bool fromModList, bool directFromModList)
@@ -40,11 +47,14 @@ StoreModDetail::StoreModDetail(int modId, std::string gameTid, std::string gameN
         ShellState::setIndexText("");
     });
 
+    m_downloadListener = DownloadManager::instance().addListener([this](const DownloadManager::Completion& completion) { onDownloadCompleted(completion); });
+
     setHeader();
 }
 
 StoreModDetail::~StoreModDetail() {
     brls::Application::getGlobalFocusChangeEvent()->unsubscribe(m_focusChangedSubscription);
+    DownloadManager::instance().removeListener(m_downloadListener);
     m_stopSource.request_stop();
     m_downloadStop.request_stop();
 
@@ -674,28 +684,116 @@ void StoreModDetail::onDislikeAction() {
 void StoreModDetail::onDownloadAction() {
     auto& detail = m_manager.getDetail();
 
+    // 已在下载队列中：显示任务状态
+    if (auto task = DownloadManager::instance().findByModId(detail.modId)) {
+        showTaskDialog(*task);
+        return;
+    }
     if (showDownloadedPrompt(detail)) return;
     showDownloadConfirmDialog();
 }
 
+void StoreModDetail::showTaskDialog(const DownloadManager::Task& task) {
+    using State = DownloadManager::State;
+    const std::string& modName = m_manager.getDetail().modName;
+
+    std::string message;
+    switch (task.state) {
+        case State::Queued:
+            message = brls::getStr("page/storeModDetail/taskQueued", modName);
+            break;
+        case State::Running:
+            message = brls::getStr("page/storeModDetail/taskRunning", modName, format::fileSize(static_cast<int64_t>(task.downloaded)),
+                                   task.total > 0 ? format::fileSize(static_cast<int64_t>(task.total)) : brls::getStr("page/storeModDetail/calculating"), format::transferSpeed(task.speed));
+            break;
+        case State::Paused:
+            message = brls::getStr("page/storeModDetail/taskPaused", modName);
+            break;
+        case State::Failed:
+            message = brls::getStr("page/storeModDetail/taskFailed", modName, task.error);
+            break;
+        case State::Downloaded:
+            message = brls::getStr("page/storeModDetail/taskDownloaded", modName);
+            break;
+    }
+
+    int id = task.id;
+    std::vector<CustomDialog::ButtonConfig> buttons = {{brls::getStr("page/storeModDetail/okShort"), [] { CustomDialog::close(); }}};
+    if (task.state != State::Downloaded) {
+        buttons.push_back({brls::getStr("page/storeModDetail/cancelDownload"), [this, id] { CustomDialog::close([this, id] { confirmCancelDownload(id); }); }});
+        if (task.state == State::Paused || task.state == State::Failed) {
+            buttons.push_back({brls::getStr("page/storeModDetail/resumeDownload"), [id] {
+                DownloadManager::instance().resume(id);
+                CustomDialog::close();
+            }});
+        } else {
+            buttons.push_back({brls::getStr("page/storeModDetail/pauseDownload"), [id] {
+                DownloadManager::instance().pause(id);
+                CustomDialog::close();
+            }});
+        }
+    }
+    CustomDialog::show(message, buttons);
+}
+
+void StoreModDetail::confirmCancelDownload(int taskId) {
+    CustomDialog::show(brls::getStr("page/storeModDetail/cancelDownloadConfirm"), {
+        {brls::getStr("page/storeModDetail/cancel"), [] { CustomDialog::close(); }},
+        {brls::getStr("page/storeModDetail/confirm"), [taskId] {
+            DownloadManager::instance().cancel(taskId);
+            CustomDialog::close();
+        }},
+    });
+}
+
 bool StoreModDetail::showDownloadedPrompt(const api::mod::ModDetail& detail) {
     if (!detail.downloaded) return false;
 
     if (!detail.hasUpdate) CustomDialog::show(brls::getStr("page/storeModDetail/noRepeatInstall"), {{brls::getStr("page/storeModDetail/ok"), [] { CustomDialog::close(); }}});
     else if (detail.installed) CustomDialog::show(brls::getStr("page/storeModDetail/updateInstalledBlocked"), {{brls::getStr("page/storeModDetail/ok"), [] { CustomDialog::close(); }}});
-    else CustomDialog::show(brls::getStr("page/storeModDetail/confirmUpdate"), {{brls::getStr("page/storeModDetail/cancel"), [] { CustomDialog::close(); }}, {brls::getStr("page/storeModDetail/confirm"), [this] { CustomDialog::close([this] { startDownload(true); }); }}});
+    else CustomDialog::show(brls::getStr("page/storeModDetail/confirmUpdate"), {{brls::getStr("page/storeModDetail/cancel"), [] { CustomDialog::close(); }}, {brls::getStr("page/storeModDetail/confirm"), [this] { CustomDialog::close([this] { enqueueDownload(true); }); }}});
 
     return true;
 }
 
 void StoreModDetail::showDownloadConfirmDialog() {
-    CustomDialog::show(brls::getStr("page/storeModDetail/confirmDownload"), {
+    std::vector<CustomDialog::ButtonConfig> buttons = {
         {brls::getStr("page/storeModDetail/cancel"), [] { CustomDialog::close(); }},
-        {brls::getStr("page/storeModDetail/confirm"), [this] { CustomDialog::close([this] { startDownload(false); }); }},
-    });
+        {brls::getStr("page/storeModDetail/confirm"), [this] { CustomDialog::close([this] { enqueueDownload(false); }); }},
+    };
+    // 本地游戏存在时可以边下载边安装
+    if (m_localModManager) buttons.push_back({brls::getStr("page/storeModDetail/downloadAndInstall"), [this] { CustomDialog::close([this] { startDownloadAndInstall(); }); }});
+    CustomDialog::show(brls::getStr("page/storeModDetail/confirmDownload"), buttons);
+}
+
+void StoreModDetail::enqueueDownload(bool updateMode) {
+    auto& detail = m_manager.getDetail();
+
+    DownloadManager::Task task;
+    task.modId = detail.modId;
+    task.gameTid = detail.gameTid;
+    task.gameName = detail.gameName;
+    task.update = updateMode;
+    task.modInfo = m_manager.buildDownloadedModInfo({}, {});
+    task.fileSize = detail.fileSize;
+    if (m_localModManager) task.gameDir = m_localModManager->game().dirPath;
+    DownloadManager::instance().enqueue(std::move(task));
+
+    detail.downloadCount++;
+    m_statDownload->setText(std::to_string(detail.downloadCount));
+    CustomDialog::show(brls::getStr("page/storeModDetail/addedToQueue", detail.modName), {{brls::getStr("page/storeModDetail/okShort"), [] { CustomDialog::close(); }}});
 }
 
-void StoreModDetail::startDownload(bool updateMode) {
+void StoreModDetail::onDownloadCompleted(const DownloadManager::Completion& completion) {
+    auto& detail = m_manager.getDetail();
+    if (!m_detailLoaded || !completion.success || completion.modId != detail.modId) return;
+
+    if (m_localModManager) applyLocalState();
+    else detail.downloaded = true;
+    updateDetail();
+}
+
+void StoreModDetail::startDownloadAndInstall() {
     auto& detail = m_manager.getDetail();
 
     // 重置下载取消源
@@ -716,11 +814,24 @@ void StoreModDetail::startDownload(bool updateMode) {
 
     int modId = detail.modId;
     int expectedFileSize = detail.fileSize;
+    std::string expectedCrc32 = detail.fileCrc32;
     std::string gameTid = detail.gameTid;
-    std::string gameName = detail.gameName;
     std::string modName = detail.modName;
 
-    ThreadPool::instance().submit([this, updateMode, modId, expectedFileSize, gameTid, gameName, modName](std::stop_token token) {
+    // 目录在后台线程创建，模组信息在主线程先按详情构造好
+    ModManager* localMods = m_localModManager;
+    std::string localGameDir = m_localModManager->game().dirPath;
+    ModInfo modTemplate = m_manager.buildDownloadedModInfo({}, {});
+
+    // 边下载边安装期间后台下载完成的模组不写入本地列表，结束后再放入
+    DownloadManager::instance().hold(localMods);
+    ThreadPool::instance().submit([this, modId, expectedFileSize, expectedCrc32, gameTid, modName, localMods, localGameDir, modTemplate](std::stop_token token) {
+        // 任一路径结束时解除占用；此前排入主线程的处理（加入模组列表）先于推迟的下载完成执行
+        struct Release {
+            ModManager* mods;
+            ~Release() { DownloadManager::instance().release(mods); }
+        } release{localMods};
+
         // ── 阶段一：获取下载信息 ──
         auto info = api::mod::fetchDownloadInfo(modId, token);
         if (token.stop_requested()) return;
@@ -736,7 +847,7 @@ void StoreModDetail::startDownload(bool updateMode) {
         // ── 阶段二：计算文件名 ──
         std::string modDirName = textClean::safeDirName(info.modNameEn);
         if (modDirName.empty()) modDirName = "mod_" + std::to_string(modId);
-        std::string tempPath = std::string(config::modShopDir) + "temp/" + modDirName + ".zip";
+        std::string tempPath = std::string(config::downloadTempDir) + modDirName + ".zip";
 
         // ── 阶段三：下载 ──
         using Clock = std::chrono::steady_clock;
@@ -747,13 +858,13 @@ void StoreModDetail::startDownload(bool updateMode) {
         double smoothedSpeed = 0;
 
         auto onProgress = [&, token](size_t total, size_t now) -> bool {
+            // 进度只在开始接收文件内容后回调；服务器未给出总大小时按商店给出的大小显示
+            if (total == 0 && expectedFileSize > 0) total = static_cast<size_t>(expectedFileSize);
+
             auto t = Clock::now();
             bool textUpdate = std::chrono::duration<double>(t - lastTextTime).count() >= 1.0;
             bool barUpdate = std::chrono::duration<double>(t - lastBarTime).count() >= 0.1;
-            float pct = total > 0 ? now * 100.0f / total : 0;
-
-            bool finalProgress = expectedFileSize <= 0 || total >= static_cast<size_t>(expectedFileSize) * 9 / 10;
-            if (!finalProgress) return true;
+            float pct = total > 0 ? std::min(now * 100.0f / total, 100.0f) : 0;
 
             if (textUpdate) {
                 double dt = std::chrono::duration<double>(t - lastProgressTime).count();
@@ -786,11 +897,38 @@ void StoreModDetail::startDownload(bool updateMode) {
             return true;
         };
 
+        auto showFinishing = [token] {
+            brls::sync([token] {
+                if (token.stop_requested()) return;
+                ProgressDialog::setLeftText(brls::getStr("page/storeModDetail/finishingInstall"));
+                ProgressDialog::setRightText("--:--");
+            });
+        };
+
         deviceControl::CpuBoost::enableFastLoad();
-        auto result = api::mod::download(modId, tempPath, onProgress, token);
-        deviceControl::CpuBoost::disable();
+        ModInstaller::InstallResult installResult;
+        std::shared_ptr<PartialFile> source;
+
+        // 先占用 mod 目录；取回中央目录后立即开始安装，解压随下载进度推进
+        ModInfo modInfo = StoreModDetailManager::reserveModDir(modTemplate, localGameDir, modDirName);
+        util::AsyncFurture<void> installTask;
+        auto result = api::mod::downloadStreaming(modId, tempPath, expectedCrc32, [&](std::shared_ptr<PartialFile> file) {
+            source = file;
+            // 安装与下载共用取消令牌，取消下载时一并取消安装
+            installTask = util::async([&, file](std::stop_token) {
+                installResult = localMods->installFromStore(modInfo, file, nullptr, token);
+            });
+        }, onProgress, token);
+        if (installTask.valid()) {
+            if (result.success) showFinishing();
+            installTask.get();
+        }
 
         if (!result.success) {
+            // 边下载边安装可能已在下载出错前装好：先撤销安装再删除目录；撤销失败时保留目录，以免留下无主的已安装文件
+            bool removable = !installResult.success || localMods->uninstallFromStore(modInfo).success;
+            deviceControl::CpuBoost::disable();
+            if (removable) fs::removeDirAll(modInfo.path);
             brls::sync([error = std::move(result.error), token] {
                 if (token.stop_requested()) return;
                 CustomDialog::show(error, {{brls::getStr("page/storeModDetail/ok"), [] { CustomDialog::close(); }}});
@@ -798,35 +936,54 @@ void StoreModDetail::startDownload(bool updateMode) {
             return;
         }
 
-        // ── 阶段四：安装 ──
-        std::string gameNameEn = info.gameNameEn;
-        brls::sync([this, updateMode, gameTid, gameNameEn, gameName, modDirName, tempPath, modName, token] {
+        StoreModDetailManager::placeDownloadedZip(modInfo, tempPath);
+        modInfo.fileCrc32 = result.fileCrc32;
+        // 服务器不支持边下载边读取，或下载期间文件被替换：按下载好的 zip 再安装一次
+        if (!source || source->failed()) {
+            showFinishing();
+            installResult = localMods->installFromStore(modInfo, nullptr, nullptr, token);
+        }
+        deviceControl::CpuBoost::disable();
+
+        // 下载完成后才取消：未装好的目录直接删除，已装好的保留，下次扫描时出现在模组列表中
+        if (token.stop_requested()) {
+            if (!installResult.success) fs::removeDirAll(modInfo.path);
+            return;
+        }
+
+        // ── 阶段四：加入模组列表 ──
+        brls::sync([this, gameTid, modName, modInfo = std::move(modInfo), installResult = std::move(installResult), token]() mutable {
             if (token.stop_requested()) return;
-            if (updateMode) finishUpdateOnMainThread(tempPath, modName);
-            else finishDownloadOnMainThread(gameTid, gameNameEn, gameName, modDirName, tempPath, modName);
+            finishInstallOnMainThread(gameTid, std::move(modInfo), installResult, modName);
         });
     }, dlToken);
 }
 
-void StoreModDetail::finishDownloadOnMainThread(const std::string& gameTid, const std::string& gameNameEn, const std::string& gameName, const std::string& modDirName, const std::string& tempPath, const std::string& modName) {
+void StoreModDetail::finishInstallOnMainThread(const std::string& gameTid, ModInfo modInfo, const ModInstaller::InstallResult& result, const std::string& modName) {
     ProgressDialog::hideButtons();
 
-    std::string gameDir;
-    if (m_localModManager) {
-        gameDir = m_gameManager.addExistingGameFromStore(m_localModManager->game().dirPath);
-        ModInfo modInfo = m_manager.createDownloadedMod(gameDir, modDirName, tempPath);
-        m_localModManager->setPendingFocus(modInfo.modID);
-        m_localModManager->addModFromStore(std::move(modInfo));
-    } else {
-        gameDir = m_gameManager.addNewGameFromStore(gameTid, gameNameEn, gameName);
-        m_manager.saveDownloadedMod(gameDir, modDirName, tempPath);
+    std::string gameDir = m_gameManager.addExistingGameFromStore(m_localModManager->game().dirPath);
+    int gameIndex = m_gameManager.findByDirPath(gameDir);
+    m_localModManager->setPendingFocus(modInfo.modID);
+    m_localModManager->addModFromStore(std::move(modInfo));
+    if (result.success) {
+        m_localModManager->setInstalled(static_cast<int>(m_localModManager->mods().size()) - 1, true);
+        m_gameManager.setHasInstalledMod(gameIndex, true);
     }
 
-    int gameIndex = m_gameManager.findByDirPath(gameDir);
+    auto& detail = m_manager.getDetail();
+    detail.downloaded = true;
+    detail.installed = result.success;
+
     loadGameMetadata(gameIndex, gameTid);
     m_gameManager.setPendingFocusPath(gameDir);
     m_installedIcon->setVisibility(brls::Visibility::VISIBLE);
-    showCompleteDialog(brls::getStr("page/storeModDetail/downloadComplete", modName));
+
+    std::string message;
+    if (result.success) message = brls::getStr("page/storeModDetail/downloadInstallComplete", modName);
+    else if (!result.conflictMod.empty()) message = brls::getStr("page/storeModDetail/downloadInstallConflict", modName, result.conflictMod, result.errorFile);
+    else message = brls::getStr("page/storeModDetail/downloadInstallFailed", modName, result.errorMsg, result.errorFile);
+    showCompleteDialog(message);
 }
 
 void StoreModDetail::loadGameMetadata(int gameIndex, const std::string& gameTid) {
@@ -839,36 +996,19 @@ void StoreModDetail::loadGameMetadata(int gameIndex, const std::string& gameTid)
     m_gameManager.setGameName(gameIndex, meta.name);
     m_gameManager.setVersion(gameIndex, meta.version);
 
-    auto& tc = brls::TextureCache::instance();
-    int iconId = tc.getCache(gameTid);
+    // Home 的游戏图标放在图集中，由 Home 永久持有这份引用
+    auto& atlas = IconAtlas::instance();
+    std::string key = format::appIdHex(game.appId);
+    int iconId = atlas.getCache(key);
     if (iconId == 0) {
-        auto* vg = brls::Application::getNVGContext();
-        iconId = nvgCreateImageMem(vg, 0, const_cast<unsigned char*>(meta.icon.data()), meta.icon.size());
-        if (iconId > 0) tc.addCache(gameTid, iconId);
+        auto image = iconCache::load(key, meta.version, [&meta] {
+            return imageDecoder::decodeJpeg(meta.icon.data(), meta.icon.size());
+        });
+        iconId = atlas.addCache(key, image);
     }
     if (iconId > 0) game.iconId = iconId;
 }
 
-void StoreModDetail::finishUpdateOnMainThread(const std::string& tempPath, const std::string& modName) {
-    ProgressDialog::hideButtons();
-
-    auto& detail = m_manager.getDetail();
-    int index = m_localModManager->findByModID(detail.modId);
-    auto& oldMod = m_localModManager->mods()[index];
-    ModInfo modInfo = m_manager.buildDownloadedModInfo(oldMod.dirName, oldMod.path);
-    if (!m_localModManager->updateModFromStore(index, std::move(modInfo), tempPath)) {
-        CustomDialog::show(brls::getStr("page/storeModDetail/updateFailed"), {{brls::getStr("page/storeModDetail/ok"), [] { CustomDialog::close(); }}});
-        return;
-    }
-
-    m_gameManager.setPendingFocusPath(m_localModManager->game().dirPath);
-    m_localModManager->setPendingFocus(detail.modId);
-    applyLocalState();
-    updateDetail();
-
-    showCompleteDialog(brls::getStr("page/storeModDetail/updateComplete", modName));
-}
-
 void StoreModDetail::showCompleteDialog(const std::string& message) {
     bool fromModList = m_fromModList;
     std::string backKey = fromModList ? "page/storeModDetail/backToModList" : "page/storeModDetail/backToHome";
@@ -6,6 +6,7 @@
 #include "common/config.hpp"
 #include "common/modInfo.hpp"
 #include "core/audio.hpp"
+#include "core/downloadManager.hpp"
 #include "core/frameQueue.hpp"
 #include "ui/core/pageHost.hpp"
 #include "ui/dataSource/storeModListDS.hpp"
@@ -99,6 +100,7 @@ StoreModList::StoreModList(std::string gameTid, std::string gameName, std::strin
 StoreModList::~StoreModList() {
     m_queryStopSource.request_stop();
     m_pageStopSource.request_stop();
+    if (m_pageModManager) DownloadManager::instance().detach(&m_pageModManager.value());
 }
 
 TitleState StoreModList::getHeaderTitle() const {
@@ -196,6 +198,8 @@ void StoreModList::prepareLocalModManager() {
 
 void StoreModList::onLocalModManagerReady() {
     m_localManagerReady = true;
+    // 详情页加入的下载完成时写入这份 ModManager，保持已下载状态一致
+    if (m_pageModManager) DownloadManager::instance().attach(&m_pageModManager.value());
     tryFinishInitialLoad();
 }
 
@@ -6,6 +6,7 @@
 #include "ui/view/gameCard.hpp"
 #include "core/audio.hpp"
 #include "core/device.hpp"
+#include "ui/core/iconAtlas.hpp"
 #include "utils/format.hpp"
 #include <borealis/core/i18n.hpp>
 #include <borealis/views/hint.hpp>
@@ -67,7 +68,9 @@ void GameCard::draw(NVGcontext* vg, float x, float y, float width, float height,
     nvgTranslate(vg, centerX, centerY);
     nvgScale(vg, scale, scale);
     nvgTranslate(vg, -centerX, -centerY);
-    m_icon->draw(vg, iconX, iconY, iconWidth, iconHeight, style, ctx);
+    // 游戏图标从图集子区域绘制，同一页上的图标共用一张纹理
+    if (m_atlasIconId <= 0 || !IconAtlas::instance().draw(vg, m_atlasIconId, iconX, iconY, iconWidth, iconHeight, ICON_CORNER_RADIUS, m_icon->getAlpha()))
+        m_icon->draw(vg, iconX, iconY, iconWidth, iconHeight, style, ctx);
     m_mask->draw(vg, m_mask->getX(), m_mask->getY(), m_mask->getWidth(), m_mask->getHeight(), style, ctx);
     nvgRestore(vg);
 
@@ -105,10 +108,10 @@ void GameCard::updateFocusVisuals(bool focused) {
     if (m_launchAvailable) updateLaunchHint(focused);
 }
 
-void GameCard::setGame(const std::string& name, const std::string& version, const std::string& modCount) {
+void GameCard::setGame(const std::string& name, const std::string& version, int modCount) {
     m_name->setText(name);
     m_version->setText(format::cleanVersion(version));
-    m_modCount->setText(modCount.empty() || modCount == "0" ? "0" : modCount);
+    m_modCount->setText(std::to_string(modCount));
 }
 
 void GameCard::setLaunchAvailable(bool available) {
@@ -121,7 +124,7 @@ void GameCard::setLaunchAction(std::function<void()> action) {
 
 void GameCard::setIcon(int iconId) {
     if (iconId <= 0) return;
-    m_icon->innerSetImage(iconId);
+    m_atlasIconId = iconId;
 }
 
 void GameCard::setFavorite(bool favorite) {
@@ -133,6 +136,7 @@ void GameCard::setNameColor(NVGcolor color) {
 }
 
 void GameCard::resetIcon() {
+    m_atlasIconId = 0;
     m_icon->innerSetImage(m_defaultIconId);
 }
 
@@ -444,6 +444,13 @@ float RecyclingGrid::getHeightByCellIndex(size_t index, size_t start) {
 
 void RecyclingGrid::setDefaultCellFocus(size_t index) { m_defaultCellFocus = index; }
 
+bool RecyclingGrid::getVisibleRange(size_t& first, size_t& last) const {
+    if (visibleMin > visibleMax) return false;
+    first = visibleMin;
+    last = visibleMax;
+    return true;
+}
+
 size_t RecyclingGrid::getDefaultCellFocus() const { return m_defaultCellFocus; }
 
 brls::View* RecyclingGrid::getDefaultFocus() {
@@ -5,6 +5,9 @@
 #include "ui/view/shell/globalHeader.hpp"
 #include "common/settings.hpp"
 #include "core/device.hpp"
+#include "core/downloadManager.hpp"
+#include "ui/core/iconAtlas.hpp"
+#include "utils/format.hpp"
 #include <borealis/core/cache_helper.hpp>
 #include <chrono>
 #include <ctime>
@@ -65,7 +68,7 @@ void GlobalHeader::applyTitleState(const std::optional<TitleState>& state) {
     if (!state) return;
 
     int textureId = 0;
-    if (!state->iconTextureKey.empty()) textureId = brls::TextureCache::instance().getCache(state->iconTextureKey);
+    if (!state->iconTextureKey.empty()) textureId = IconAtlas::instance().acquireTexture(state->iconTextureKey);
     if (textureId != 0 || !state->iconPath.empty()) {
         auto* icon = new brls::Image();
         icon->setWidth(TITLE_ICON_SIZE);
@@ -255,6 +258,7 @@ void GlobalHeader::updateStatusText() {
 
     updateTimeStatus(now);
     updateBatteryStatus(now);
+    updateDownloadStatus(now);
     if (m_showFps) updateFpsStatus(now);
     if (m_showMem) updateMemStatus(now);
 }
@@ -307,6 +311,20 @@ void GlobalHeader::updateMemStatus(brls::Time now) {
     m_memLabel->setText(std::to_string(heap.usedMB) + " / " + std::to_string(heap.totalMB) + " MB");
 }
 
+void GlobalHeader::updateDownloadStatus(brls::Time now) {
+    if (m_lastDownloadUpdateUs != 0 && now - m_lastDownloadUpdateUs < DOWNLOAD_UPDATE_INTERVAL_US) return;
+    m_lastDownloadUpdateUs = now;
+
+    auto throughput = DownloadManager::instance().throughput();
+    int active = throughput.running + throughput.queued;
+    std::string text = active > 0 ? brls::getStr("view/shell/downloadStatus", active, format::transferSpeed(throughput.speed)) : "";
+    if (text == m_downloadText) return;
+
+    m_downloadText = text;
+    m_downloadLabel->setText(text);
+    m_downloadLabel->setVisibility(text.empty() ? brls::Visibility::GONE : brls::Visibility::VISIBLE);
+}
+
 brls::View* GlobalHeader::create() {
     return new GlobalHeader();
 }
@@ -0,0 +1,56 @@
+/**
+ * binaryFile - 小端二进制持久化格式的公共读写实现
+ */
+
+#include "utils/binaryFile.hpp"
+#include "utils/crc32.hpp"
+#include "utils/fsHelper.hpp"
+
+namespace binaryFile {
+
+void Writer::putCrc(size_t start) {
+    put(crc::fromBuffer(0, buf.data() + start, buf.size() - start));
+}
+
+Reader openHeader(const std::vector<uint8_t>& data, const Magic& magic, uint32_t version) {
+    Reader reader{data.data(), data.size()};
+    const uint8_t* head = reader.skip(sizeof(Magic));
+    if (!head || std::memcmp(head, magic, sizeof(Magic)) != 0 || reader.get<uint32_t>() != version) reader.ok = false;
+    return reader;
+}
+
+Reader openFramed(const std::vector<uint8_t>& data, const Magic& magic, uint32_t version, bool verifyCrc) {
+    if (data.size() < headerSize + sizeof(uint32_t)) return Reader{nullptr, 0, 0, false};
+    if (verifyCrc && !crcMatches(data)) return Reader{nullptr, 0, 0, false};
+
+    Reader reader = openHeader(data, magic, version);
+    reader.size = data.size() - sizeof(uint32_t);
+    return reader;
+}
+
+bool crcMatches(const std::vector<uint8_t>& data) {
+    if (data.size() < sizeof(uint32_t)) return false;
+    size_t bodySize = data.size() - sizeof(uint32_t);
+    return crc::fromBuffer(0, data.data(), bodySize) == peek<uint32_t>(data.data() + bodySize);
+}
+
+bool saveFramed(const std::string& path, Writer& writer) {
+    writer.putCrc();
+    return fs::writeFile(path, writer.buf.data(), writer.buf.size()) == 0;
+}
+
+std::string tempPath(const std::string& path) {
+    return path + ".tmp";
+}
+
+bool writeAtomic(const std::string& path, const void* data, size_t size) {
+    std::string tmp = tempPath(path);
+    if (fs::writeFile(tmp, data, size) != 0) {
+        fs::deleteFile(tmp);
+        return false;
+    }
+    if (fs::fileExists(path)) fs::deleteFile(path);
+    return fs::moveFile(tmp, path);
+}
+
+} // namespace binaryFile
@@ -0,0 +1,166 @@
+/**
+ * crc32 - 软件 CRC32 与批量文件计算实现
+ */
+
+#include "utils/crc32.hpp"
+#include "utils/threadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <malloc.h>
+
+namespace crc {
+
+namespace {
+
+    constexpr uint32_t polynomial = 0xEDB88320u; // 反射多项式（与 zlib 一致）
+
+    /** @brief slicing-by-8 查表：tables[k][b] 为字节 b 之后再移入 k 个零字节的 CRC */
+    constexpr std::array<std::array<uint32_t, 256>, 8> makeTables() {
+        std::array<std::array<uint32_t, 256>, 8> tables{};
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t c = b;
+            for (int bit = 0; bit < 8; ++bit) c = (c & 1) ? (c >> 1) ^ polynomial : c >> 1;
+            tables[0][b] = c;
+        }
+        for (uint32_t b = 0; b < 256; ++b) {
+            for (int k = 1; k < 8; ++k) {
+                uint32_t prev = tables[k - 1][b];
+                tables[k][b] = (prev >> 8) ^ tables[0][prev & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    constexpr auto tables = makeTables();
+
+    /** @brief GF(2) 多项式乘法取模（反射表示，最高位为 x^0） */
+    constexpr uint32_t multModP(uint32_t a, uint32_t b) {
+        uint32_t m = 1u << 31;
+        uint32_t p = 0;
+        while (true) {
+            if (a & m) {
+                p ^= b;
+                if ((a & (m - 1)) == 0) break;
+            }
+            m >>= 1;
+            b = (b & 1) ? (b >> 1) ^ polynomial : b >> 1;
+        }
+        return p;
+    }
+
+    /** @brief x^(2^k) mod P，k = 0..31 */
+    constexpr std::array<uint32_t, 32> makePowers() {
+        std::array<uint32_t, 32> powers{};
+        uint32_t p = 1u << 30; // x^1
+        powers[0] = p;
+        for (int k = 1; k < 32; ++k) powers[k] = p = multModP(p, p);
+        return powers;
+    }
+
+    constexpr auto powers = makePowers();
+
+    /** @brief x^(n * 2^k) mod P */
+    uint32_t xPowModP(uint64_t n, int k) {
+        uint32_t p = 1u << 31; // x^0
+        while (n) {
+            if (n & 1) p = multModP(powers[k & 31], p);
+            n >>= 1;
+            k++;
+        }
+        return p;
+    }
+
+    /** @brief 小端读取 4 字节（不要求对齐） */
+    inline uint32_t load32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+    }
+
+} // namespace
+
+uint32_t software(uint32_t seed, const void* data, size_t len) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    uint32_t c = ~seed;
+
+    // 先逐字节处理到 8 字节对齐，主循环每次读取的 8 字节不跨对齐边界
+    while (len > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+        c = (c >> 8) ^ tables[0][(c ^ *p++) & 0xFF];
+        --len;
+    }
+
+    while (len >= 8) {
+        uint32_t lo = load32(p) ^ c;
+        uint32_t hi = load32(p + 4);
+        c = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF] ^ tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24] ^
+            tables[3][hi & 0xFF] ^ tables[2][(hi >> 8) & 0xFF] ^ tables[1][(hi >> 16) & 0xFF] ^ tables[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+
+    while (len-- > 0) c = (c >> 8) ^ tables[0][(c ^ *p++) & 0xFF];
+    return ~c;
+}
+
+uint32_t bytewise(uint32_t seed, const void* data, size_t len) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    uint32_t c = ~seed;
+    while (len-- > 0) c = (c >> 8) ^ tables[0][(c ^ *p++) & 0xFF];
+    return ~c;
+}
+
+uint32_t combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    // 把 crc1 后移 len2 个字节（乘以 x^(8 * len2)）再叠加 crc2，与 zlib 的 crc32_combine 相同
+    return multModP(xPowModP(len2, 3), crc1) ^ crc2;
+}
+
+BatchStats fromFiles(std::vector<FileTask>& tasks, std::stop_token token, int workers, std::function<void(int done, int total)> progressCb) {
+    BatchStats stats;
+    for (auto& task : tasks) {
+        task.crc = -1;
+        task.bytes = 0;
+    }
+    if (tasks.empty()) return stats;
+
+    const auto start = std::chrono::steady_clock::now();
+    const int total = static_cast<int>(tasks.size());
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+
+    // 每个工作者独占一个对齐缓冲区，从共享下标取下一个文件，直到取完或取消
+    auto worker = [&](std::stop_token tk) {
+        void* buf = memalign(0x1000, batchBufSize);
+        if (!buf) return;
+        while (!tk.stop_requested() && !token.stop_requested()) {
+            int i = next.fetch_add(1);
+            if (i >= total) break;
+            FileTask& task = tasks[i];
+            task.crc = fromFile(task.path.c_str(), buf, batchBufSize, &token, &task.bytes);
+            int finished = done.fetch_add(1) + 1;
+            if (progressCb) progressCb(finished, total);
+        }
+        free(buf);
+    };
+
+    // 调用线程也作为一个工作者：线程池繁忙时其余工作者可能晚启动，甚至在全部完成后才启动
+    std::vector<WaitableTask> helpers;
+    const int helperCount = std::min(workers, total) - 1;
+    for (int w = 0; w < helperCount; ++w) helpers.push_back(ThreadPool::instance().submitWaitable(worker, token));
+    worker(token);
+    helpers.clear();
+
+    for (auto& task : tasks) {
+        if (task.crc < 0) {
+            ++stats.failed;
+            continue;
+        }
+        ++stats.files;
+        stats.bytes += task.bytes;
+    }
+    stats.micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace crc
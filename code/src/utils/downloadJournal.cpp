@@ -0,0 +1,73 @@
+/**
+ * downloadJournal - 断点续传的下载记录实现
+ */
+
+#include "utils/downloadJournal.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+
+namespace downloadJournal {
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'D', 'J'};
+    constexpr uint32_t version = 2;
+
+} // namespace
+
+std::string pathOf(const std::string& filePath) {
+    return filePath + ".journal";
+}
+
+bool load(const std::string& filePath, Journal& journal) {
+    auto data = fs::readFile(pathOf(filePath));
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version);
+    if (!reader.ok) return false;
+
+    Journal result;
+    result.url = reader.getStr();
+    result.etag = reader.getStr();
+    result.lastModified = reader.getStr();
+    result.totalSize = reader.get<uint64_t>();
+    result.expectedCrc = reader.get<uint32_t>();
+    uint32_t count = reader.get<uint32_t>();
+    for (uint32_t i = 0; i < count && reader.ok; ++i) {
+        Segment segment;
+        segment.start = reader.get<uint64_t>();
+        segment.end = reader.get<uint64_t>();
+        segment.done = reader.get<uint64_t>();
+        segment.crc = reader.get<uint32_t>();
+        result.segments.push_back(segment);
+    }
+    if (!reader.finished()) return false;
+
+    journal = std::move(result);
+    return true;
+}
+
+bool save(const std::string& filePath, const Journal& journal) {
+    if (journal.url.size() > UINT16_MAX || journal.etag.size() > UINT16_MAX || journal.lastModified.size() > UINT16_MAX) return false;
+
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(64 + journal.segments.size() * 28 + journal.url.size() + journal.etag.size() + journal.lastModified.size());
+    writer.putStr(journal.url);
+    writer.putStr(journal.etag);
+    writer.putStr(journal.lastModified);
+    writer.put(journal.totalSize);
+    writer.put(journal.expectedCrc);
+    writer.put(static_cast<uint32_t>(journal.segments.size()));
+    for (const auto& segment : journal.segments) {
+        writer.put(segment.start);
+        writer.put(segment.end);
+        writer.put(segment.done);
+        writer.put(segment.crc);
+    }
+    return binaryFile::saveFramed(pathOf(filePath), writer);
+}
+
+void remove(const std::string& filePath) {
+    std::string path = pathOf(filePath);
+    if (fs::fileExists(path)) fs::deleteFile(path);
+}
+
+} // namespace downloadJournal
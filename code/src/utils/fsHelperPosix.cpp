@@ -0,0 +1,521 @@
+/**
+ * fsHelper - 文件系统操作封装（POSIX 后端）
+ * 供主机端构建与性能测试使用，以 rootDir() 作为 sdmc:/ 的映射
+ * 返回码与 libnx 后端保持相同语义：0 表示成功，非 0 为 errno
+ */
+
+#ifndef __SWITCH__
+
+#include "utils/fsHelper.hpp"
+#include "utils/format.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utility>
+
+namespace fs {
+
+namespace {
+
+    // 根目录（默认取环境变量 NXMM_SD_ROOT，未设置时为 ./sdmc）
+    std::string& rootStorage() {
+        static std::string s_root = [] {
+            const char* env = std::getenv("NXMM_SD_ROOT");
+            std::string root = (env && *env) ? env : "./sdmc";
+            while (root.size() > 1 && root.back() == '/') root.pop_back();
+            return root;
+        }();
+        return s_root;
+    }
+
+    // 后缀过滤（转小写比较），exts 为空时全部匹配
+    bool matchExts(const char* fileName, const std::vector<std::string>& exts) {
+        if (exts.empty()) return true;
+        std::string name(fileName);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (const auto& ext : exts) {
+            if (name.size() >= ext.size() && name.compare(name.size() - ext.size(), ext.size(), ext) == 0) return true;
+        }
+        return false;
+    }
+
+    // 判断 readdir 条目是否为目录（文件系统不提供 d_type 时回退 stat）
+    bool entryIsDir(const std::string& dirPath, const dirent* ent) {
+        if (ent->d_type == DT_DIR) return true;
+        if (ent->d_type != DT_UNKNOWN && ent->d_type != DT_LNK) return false;
+        struct stat st;
+        if (::stat((dirPath + "/" + ent->d_name).c_str(), &st) != 0) return false;
+        return S_ISDIR(st.st_mode);
+    }
+
+    bool isDotEntry(const char* name) {
+        return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+    }
+
+    uint32_t lastError() {
+        return errno ? static_cast<uint32_t>(errno) : static_cast<uint32_t>(-1);
+    }
+
+    /**
+     * @brief 遍历目录的一层条目（跳过 . 和 ..）
+     * @param path SD 卡内的目录路径
+     * @param onEntry 回调(条目, 是否为目录, 主机目录路径)
+     * @return 成功返回 0，打开失败返回 errno
+     */
+    template <typename Fn>
+    uint32_t forEachEntry(const FsPath& path, Fn&& onEntry) {
+        std::string hostPath = nativePath(path);
+        DIR* dir = ::opendir(hostPath.c_str());
+        if (!dir) return lastError();
+        while (dirent* ent = ::readdir(dir)) {
+            if (isDotEntry(ent->d_name)) continue;
+            onEntry(ent, entryIsDir(hostPath, ent), hostPath);
+        }
+        ::closedir(dir);
+        return 0;
+    }
+
+} // namespace
+
+void setRootDir(const std::string& dir) {
+    std::string root = dir.empty() ? "." : dir;
+    while (root.size() > 1 && root.back() == '/') root.pop_back();
+    rootStorage() = std::move(root);
+}
+
+const std::string& rootDir() {
+    return rootStorage();
+}
+
+std::string nativePath(const FsPath& path) {
+    const char* p = path;
+    if (p[0] == '/') return rootStorage() + p;
+    return rootStorage() + "/" + p;
+}
+
+bool dirExists(const FsPath& path) {
+    struct stat st;
+    if (::stat(nativePath(path).c_str(), &st) != 0) return false;
+    return S_ISDIR(st.st_mode);
+}
+
+bool fileExists(const FsPath& path) {
+    struct stat st;
+    if (::stat(nativePath(path).c_str(), &st) != 0) return false;
+    return S_ISREG(st.st_mode);
+}
+
+uint32_t createDir(const FsPath& path) {
+    if (::mkdir(nativePath(path).c_str(), 0755) == 0) return 0;
+    if (errno == EEXIST) return 0;  // already exists
+    return lastError();
+}
+
+bool ensureDir(const FsPath& path) {
+    if (dirExists(path)) return true;
+    /* 递归确保父目录存在 */
+    std::string parent(path);
+    auto pos = parent.rfind('/');
+    if (pos != 0 && pos != std::string::npos) {
+        parent.resize(pos);
+        if (!ensureDir(parent)) return false;
+    }
+    return ::mkdir(nativePath(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+std::vector<std::string> listSubDirs(const FsPath& path) {
+    std::vector<std::string> result;
+    forEachEntry(path, [&](const dirent* ent, bool isDir, const std::string&) {
+        if (isDir) result.emplace_back(ent->d_name);
+    });
+    return result;
+}
+
+std::vector<std::string> listSubFiles(const FsPath& path, const std::vector<std::string>& exts) {
+    std::vector<std::string> result;
+    forEachEntry(path, [&](const dirent* ent, bool isDir, const std::string&) {
+        if (!isDir && matchExts(ent->d_name, exts)) result.emplace_back(ent->d_name);
+    });
+    return result;
+}
+
+int countDirs(const FsPath& path) {
+    int count = 0;
+    forEachEntry(path, [&](const dirent*, bool isDir, const std::string&) {
+        if (isDir) count++;
+    });
+    return count;
+}
+
+int countItems(const FsPath& path, const std::vector<std::string>& exts) {
+    int count = 0;
+    forEachEntry(path, [&](const dirent* ent, bool isDir, const std::string&) {
+        if (isDir || matchExts(ent->d_name, exts)) count++;
+    });
+    return count;
+}
+
+std::vector<DirEntry> listItems(const FsPath& path, const std::vector<std::string>& exts) {
+    std::vector<DirEntry> result;
+    forEachEntry(path, [&](const dirent* ent, bool isDir, const std::string&) {
+        if (!isDir && !matchExts(ent->d_name, exts)) return;
+        result.push_back({std::string(ent->d_name), !isDir});
+    });
+    return result;
+}
+
+int64_t getFileSize(const FsPath& path) {
+    struct stat st;
+    if (::stat(nativePath(path).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return -1;
+    return static_cast<int64_t>(st.st_size);
+}
+
+bool statFile(const FsPath& path, FileStat& out) {
+    struct stat st;
+    if (::stat(nativePath(path).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return false;
+
+    out.size = static_cast<int64_t>(st.st_size);
+#ifdef __APPLE__
+    out.mtime = static_cast<uint64_t>(st.st_mtimespec.tv_sec) * 1000000000ull + static_cast<uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+    out.mtime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ull + static_cast<uint64_t>(st.st_mtim.tv_nsec);
+#endif
+    return true;
+}
+
+int64_t calcDirSize(const FsPath& path, std::stop_token* token) {
+    int64_t totalSize = 0;
+    std::vector<std::string> dirStack;
+    dirStack.push_back(std::string(path));
+
+    while (!dirStack.empty()) {
+        if (token && token->stop_requested()) return -1;
+        std::string curPath = std::move(dirStack.back());
+        dirStack.pop_back();
+
+        uint32_t rc = forEachEntry(curPath, [&](const dirent* ent, bool isDir, const std::string& hostDir) {
+            if (isDir) {
+                dirStack.push_back(curPath + "/" + ent->d_name);
+                return;
+            }
+            struct stat st;
+            if (::stat((hostDir + "/" + ent->d_name).c_str(), &st) == 0) totalSize += st.st_size;
+        });
+        if (rc != 0 && dirStack.empty() && totalSize == 0) return -1;
+    }
+
+    return totalSize;
+}
+
+bool removeDirAll(const FsPath& path) {
+    if (!dirExists(path)) return false;
+    if (!removeDirContents(path)) return false;
+    return ::rmdir(nativePath(path).c_str()) == 0;
+}
+
+bool removeDirContents(const FsPath& path) {
+    auto result = removeDirContentsWithProgress(path, std::stop_token{}, nullptr);
+    return result.status == RemoveResult::Completed;
+}
+
+RemoveResult removeDirContentsWithProgress(const FsPath& path, std::stop_token token, std::function<void(int deleted, int total, const char* fileName)> onProgress) {
+    using Clock = std::chrono::steady_clock;
+    auto startTime = Clock::now();
+
+    constexpr auto THROTTLE_INTERVAL = std::chrono::milliseconds(100);
+
+    // ── 阶段一：扫描 ──
+    // 与 libnx 后端一致：DFS 收集每个目录的条目，父目录先于子目录入列
+
+    std::vector<DirCollection> collections;
+    std::vector<std::string> dirStack;
+    dirStack.push_back(std::string(path));
+    int fileTotal = 0;
+    auto lastUpdate = Clock::now();
+
+    while (!dirStack.empty()) {
+        if (token.stop_requested()) return {RemoveResult::Cancelled, 0, fileTotal, "", ""};
+
+        std::string curPath = std::move(dirStack.back());
+        dirStack.pop_back();
+
+        DirCollection collection;
+        collection.path = curPath;
+
+        uint32_t rc = forEachEntry(curPath, [&](const dirent* ent, bool isDir, const std::string&) {
+            collection.entries.push_back({ent->d_name, !isDir});
+            if (isDir) dirStack.push_back(curPath + "/" + ent->d_name);
+            else fileTotal++;
+        });
+        if (rc != 0) return {RemoveResult::FsError, 0, fileTotal, curPath, format::resultHex(rc)};
+
+        collections.push_back(std::move(collection));
+
+        if (onProgress) {
+            auto now = Clock::now();
+            if (now - lastUpdate >= THROTTLE_INTERVAL) {
+                onProgress(0, fileTotal, nullptr);
+                lastUpdate = now;
+            }
+        }
+    }
+
+    // ── 阶段二：删除 ──
+    // 逆序遍历 collections，子目录先于父目录清空；根目录本身保留
+
+    int fileDeleted = 0;
+    lastUpdate = Clock::now();
+
+    for (int ci = static_cast<int>(collections.size()) - 1; ci >= 0; ci--) {
+        auto& collection = collections[ci];
+
+        for (auto& entry : collection.entries) {
+            if (!entry.isFile) continue;
+            if (token.stop_requested())
+                return {RemoveResult::Cancelled, fileDeleted, fileTotal, "", ""};
+
+            std::string fullPath = collection.path + "/" + entry.name;
+            if (::unlink(nativePath(fullPath).c_str()) != 0)
+                return {RemoveResult::FsError, fileDeleted, fileTotal, fullPath, format::resultHex(lastError())};
+
+            fileDeleted++;
+
+            if (onProgress) {
+                auto now = Clock::now();
+                if (now - lastUpdate >= THROTTLE_INTERVAL || fileDeleted == fileTotal) {
+                    onProgress(fileDeleted, fileTotal, entry.name.c_str());
+                    lastUpdate = now;
+                }
+            }
+        }
+
+        for (auto& entry : collection.entries) {
+            if (entry.isFile) continue;
+            std::string fullPath = collection.path + "/" + entry.name;
+            if (::rmdir(nativePath(fullPath).c_str()) != 0)
+                return {RemoveResult::FsError, fileDeleted, fileTotal, fullPath, format::resultHex(lastError())};
+        }
+    }
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count();
+    return {RemoveResult::Completed, fileDeleted, fileTotal, "", "", format::elapsed(elapsedMs)};
+}
+
+// libnx 的重命名在目标已存在时失败，POSIX rename 会覆盖，这里先检查保持一致
+bool moveDir(const FsPath& src, const FsPath& dest) {
+    if (!dirExists(src)) return false;
+    struct stat st;
+    if (::stat(nativePath(dest).c_str(), &st) == 0) return false;
+    return ::rename(nativePath(src).c_str(), nativePath(dest).c_str()) == 0;
+}
+
+bool moveFile(const FsPath& src, const FsPath& dest) {
+    if (!fileExists(src)) return false;
+    struct stat st;
+    if (::stat(nativePath(dest).c_str(), &st) == 0) return false;
+    return ::rename(nativePath(src).c_str(), nativePath(dest).c_str()) == 0;
+}
+
+bool deleteFile(const FsPath& path) {
+    return ::unlink(nativePath(path).c_str()) == 0;
+}
+
+bool deleteEmptyDir(const FsPath& path) {
+    return ::rmdir(nativePath(path).c_str()) == 0;
+}
+
+uint32_t writeFile(const FsPath& path, const void* data, size_t size) {
+    int fd = ::open(nativePath(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return lastError();
+
+    const char* p = static_cast<const char*>(data);
+    size_t remaining = size;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, p, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            uint32_t rc = lastError();
+            ::close(fd);
+            return rc;
+        }
+        p += n;
+        remaining -= static_cast<size_t>(n);
+    }
+
+    return ::close(fd) == 0 ? 0 : lastError();
+}
+
+uint32_t appendFile(const FsPath& path, const void* data, size_t size) {
+    int fd = ::open(nativePath(path).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return lastError();
+
+    const char* p = static_cast<const char*>(data);
+    size_t remaining = size;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, p, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            uint32_t rc = lastError();
+            ::close(fd);
+            return rc;
+        }
+        p += n;
+        remaining -= static_cast<size_t>(n);
+    }
+
+    if (::fsync(fd) != 0) {
+        uint32_t rc = lastError();
+        ::close(fd);
+        return rc;
+    }
+    return ::close(fd) == 0 ? 0 : lastError();
+}
+
+FileReader::~FileReader() {
+    if (m_open) ::close(m_fd);
+}
+
+uint32_t FileReader::open(const FsPath& path, int64_t fileSize) {
+    if (m_open) {
+        ::close(m_fd);
+        m_open = false;
+        m_offset = 0;
+        m_size = 0;
+    }
+
+    m_fd = ::open(nativePath(path).c_str(), O_RDONLY);
+    if (m_fd < 0) return lastError();
+
+    if (fileSize >= 0) {
+        m_size = fileSize;
+    } else {
+        struct stat st;
+        errno = 0;
+        if (::fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            uint32_t rc = errno ? lastError() : EISDIR;
+            ::close(m_fd);
+            m_fd = -1;
+            return rc;
+        }
+        m_size = static_cast<int64_t>(st.st_size);
+    }
+
+    m_open = true;
+    return 0;
+}
+
+size_t FileReader::read(void* buf, size_t bufSize) {
+    if (!m_open || m_offset >= m_size) return 0;
+
+    ssize_t bytesRead;
+    do {
+        bytesRead = ::pread(m_fd, buf, bufSize, static_cast<off_t>(m_offset));
+    } while (bytesRead < 0 && errno == EINTR);
+    if (bytesRead <= 0) return 0;
+
+    m_offset += static_cast<int64_t>(bytesRead);
+    return static_cast<size_t>(bytesRead);
+}
+
+FileWriter::~FileWriter() {
+    if (m_open) ::close(m_fd);
+}
+
+uint32_t FileWriter::open(const FsPath& path, int64_t fileSize) {
+    if (m_open) {
+        ::close(m_fd);
+        m_open = false;
+        m_offset = 0;
+    }
+
+    m_fd = ::open(nativePath(path).c_str(), O_WRONLY | O_CREAT, 0644);
+    if (m_fd < 0) return lastError();
+
+    // 与 libnx 创建文件时预设大小一致
+    if (::ftruncate(m_fd, static_cast<off_t>(fileSize)) != 0) {
+        uint32_t rc = lastError();
+        ::close(m_fd);
+        m_fd = -1;
+        return rc;
+    }
+
+    m_open = true;
+    return 0;
+}
+
+uint32_t FileWriter::write(const void* data, size_t size) {
+    if (!m_open) return -1;
+
+    const char* p = static_cast<const char*>(data);
+    size_t remaining = size;
+    while (remaining > 0) {
+        ssize_t n = ::pwrite(m_fd, p, remaining, static_cast<off_t>(m_offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return lastError();
+        }
+        p += n;
+        remaining -= static_cast<size_t>(n);
+        m_offset += static_cast<int64_t>(n);
+    }
+    return 0;
+}
+
+DirReader::~DirReader() {
+    if (m_open) ::closedir(m_dir);
+}
+
+uint32_t DirReader::open(const FsPath& path) {
+    if (m_open) {
+        ::closedir(m_dir);
+        m_open = false;
+    }
+
+    m_path = nativePath(path);
+    m_dir = ::opendir(m_path.c_str());
+    if (!m_dir) return lastError();
+
+    m_open = true;
+    return 0;
+}
+
+uint32_t DirReader::read(std::vector<DirEntry>& out, int batchSize) {
+    out.clear();
+    if (!m_open) return -1;
+
+    out.reserve(batchSize);
+    while (static_cast<int>(out.size()) < batchSize) {
+        errno = 0;
+        dirent* ent = ::readdir(m_dir);
+        if (!ent) {
+            if (errno != 0) return lastError();
+            break;
+        }
+        if (isDotEntry(ent->d_name)) continue;
+
+        struct stat st;
+        std::string fullPath = m_path + "/" + ent->d_name;
+        if (::stat(fullPath.c_str(), &st) != 0) continue;
+        bool isFile = !S_ISDIR(st.st_mode);
+        out.push_back({ent->d_name, isFile, isFile ? static_cast<int64_t>(st.st_size) : 0});
+    }
+    return 0;
+}
+
+void DirReader::close() {
+    if (m_open) {
+        ::closedir(m_dir);
+        m_dir = nullptr;
+        m_open = false;
+    }
+}
+
+} // namespace fs
+
+#endif // !__SWITCH__
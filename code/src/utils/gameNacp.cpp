@@ -3,6 +3,8 @@
  * 回退链：libnxtc 缓存 → libnx ns 服务
  */
 
+#ifdef __SWITCH__
+
 #include "utils/gameNacp.hpp"
 #include "utils/format.hpp"
 
@@ -209,3 +211,5 @@ std::vector<uint64_t> getInstalledGameTids() {
 }
 
 } // namespace gameNacp
+
+#endif // __SWITCH__
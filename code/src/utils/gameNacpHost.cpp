@@ -0,0 +1,34 @@
+/**
+ * gameNacp - 游戏 NACP 数据获取工具（主机端占位实现）
+ * 主机上没有 ns 服务，所有查询返回空结果，调用方按“查询失败”处理
+ */
+
+#ifndef __SWITCH__
+
+#include "utils/gameNacp.hpp"
+
+namespace gameNacp {
+
+void init() {}
+
+void cleanup() {}
+
+GameMetadata getGameNACP(uint64_t) {
+    return {};
+}
+
+std::string getEnglishName(uint64_t) {
+    return {};
+}
+
+std::string getVersion(uint64_t) {
+    return {};
+}
+
+std::vector<uint64_t> getInstalledGameTids() {
+    return {};
+}
+
+} // namespace gameNacp
+
+#endif // !__SWITCH__
@@ -3,13 +3,16 @@
  */
 
 #include "utils/http.hpp"
+#include "utils/segmentDownload.hpp"
 
 #include <algorithm>
 #include <cctype>
 #include <curl/curl.h>
 #include <mutex>
 #include <string>
+#ifdef __SWITCH__
 #include <switch.h>
+#endif
 #include <utility>
 #include <vector>
 
@@ -130,14 +133,16 @@ static CURL* getThreadHandle() {
  */
 
 void init() {
+#ifdef __SWITCH__
     // Borealis applet 模式默认 session=2/efficiency=1，不够并发 HTTP 下载
-    // 重置为 libnx 默认值 session=3/efficiency=4
+    // 每个阻塞中的套接字调用占用一个 BSD 会话：所有分段下载合计最多 maxTotalConnections 个连接，另留 4 个给接口与图片请求
     socketExit();
     SocketInitConfig cfg = *(socketGetDefaultInitConfig());
     cfg.tcp_rx_buf_max_size = 1024 * 512;  // 512KB, 2x libnx 默认值
-    cfg.num_bsd_sessions   = 3;
+    cfg.num_bsd_sessions   = segmentDownload::maxTotalConnections + 4;
     cfg.sb_efficiency      = 4;
     socketInitialize(&cfg);
+#endif
 
     curl_global_init(CURL_GLOBAL_DEFAULT);
 
@@ -195,12 +200,33 @@ static size_t writeMemoryCallback(void* ptr, size_t size, size_t nmemb, void* us
 
 struct StreamData {
     const std::function<bool(const uint8_t* data, size_t size)>* callback; // 流式数据回调
+    const Request* request;                                                // 请求参数（onResponse）
+    Response* response;                                                    // 已收到的响应头
+    CURL* curl = nullptr;                                                  // 当前使用的 easy handle
+    bool started = false;                                                  // 是否已收到响应体
 };
 
+/** @brief 从 easy handle 读取状态码与最终地址 */
+static void fillResponseInfo(CURL* curl, Response& response) {
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
+    char* url = nullptr;
+    if (curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url) == CURLE_OK && url) response.url = url;
+}
+
 /** @brief libcurl 数据回调：把响应体按块交给调用方 */
 static size_t writeStreamCallback(void* ptr, size_t size, size_t nmemb, void* userdata) {
     auto* data = static_cast<StreamData*>(userdata);
     auto bytes = size * nmemb;
+
+    // 跟随重定向时中间响应没有响应体，首块数据一定属于最终响应
+    if (!data->started) {
+        data->started = true;
+        if (data->request->onResponse) {
+            fillResponseInfo(data->curl, *data->response);
+            if (!data->request->onResponse(*data->response)) return 0;
+        }
+    }
+
     if (!data->callback || !*data->callback) return bytes;
     return (*data->callback)(static_cast<uint8_t*>(ptr), bytes) ? bytes : 0;
 }
@@ -306,13 +332,14 @@ static curl_slist* createHeaders(const std::vector<Header>& requestHeaders) {
 }
 
 /** @brief 执行一次 HTTP 请求，由调用方决定响应体写入内存还是流式回调 */
-static void performRequest(const Request& request, Response& response, void* writeData, size_t (*writeCallback)(void*, size_t, size_t, void*)) {
+static void performRequest(const Request& request, Response& response, void* writeData, size_t (*writeCallback)(void*, size_t, size_t, void*), StreamData* stream = nullptr) {
     CURL* curl = getThreadHandle();
     if (!curl) {
         response.networkCode = CURLE_FAILED_INIT;
         response.error = "curl handle unavailable";
         return;
     }
+    if (stream) stream->curl = curl;
 
     curl_easy_reset(curl);
 
@@ -340,7 +367,7 @@ static void performRequest(const Request& request, Response& response, void* wri
     }
 
     CURLcode res = curl_easy_perform(curl);
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
+    fillResponseInfo(curl, response);
 
     response.networkCode = static_cast<int>(res);
     response.cancelled = (res == CURLE_ABORTED_BY_CALLBACK && token.stop_requested());
@@ -361,8 +388,8 @@ Response requestToMemory(const Request& request) {
 
 Response requestStream(const Request& request, const std::function<bool(const uint8_t* data, size_t size)>& onData) {
     Response response;
-    StreamData data{&onData};
-    performRequest(request, response, &data, writeStreamCallback);
+    StreamData data{&onData, &request, &response};
+    performRequest(request, response, &data, writeStreamCallback, &data);
     return response;
 }
 
@@ -0,0 +1,174 @@
+/**
+ * iconCache - 已解码图标的磁盘缓存实现
+ */
+
+#include "utils/iconCache.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace iconCache {
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'I', 'C'};
+    constexpr uint32_t version = 1;
+
+    std::mutex s_mutex;       // 保护目录和统计
+    std::mutex s_writeMutex;  // 串行化写入（同一图标可能被两个页面同时写）
+    std::string s_dir;
+    Stats s_stats;
+
+    std::string dir() {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        return s_dir;
+    }
+
+    std::string pathOf(const std::string& dirPath, const std::string& key) {
+        return dirPath + "/" + key + ".rgba";
+    }
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool valid(const imageDecoder::DecodedImage& image) {
+        return image.width > 0 && image.height > 0 && image.pixels.size() == static_cast<size_t>(image.width) * image.height * 4;
+    }
+
+} // namespace
+
+void setDir(const std::string& dirPath) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_dir = dirPath;
+}
+
+imageDecoder::DecodedImage load(const std::string& key, const std::string& tag, const std::function<imageDecoder::DecodedImage()>& decode) {
+    auto start = std::chrono::steady_clock::now();
+    imageDecoder::DecodedImage image;
+    if (read(key, tag, image)) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_stats.hits++;
+        s_stats.readMs += msSince(start);
+        return image;
+    }
+
+    start = std::chrono::steady_clock::now();
+    image = downscale(decode());
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_stats.misses++;
+        s_stats.decodeMs += msSince(start);
+    }
+    if (valid(image)) write(key, tag, image);
+    return image;
+}
+
+bool read(const std::string& key, const std::string& tag, imageDecoder::DecodedImage& image) {
+    std::string dirPath = dir();
+    if (dirPath.empty() || key.empty()) return false;
+
+    auto data = fs::readFile(pathOf(dirPath, key));
+    binaryFile::Reader reader = binaryFile::openFramed(data, magic, version, false);
+    uint16_t tagLen = reader.get<uint16_t>();
+    const uint8_t* tagData = reader.skip(tagLen);
+    if (!reader.ok || tagLen != tag.size() || std::memcmp(tagData, tag.data(), tagLen) != 0) return false;
+
+    int width = reader.get<uint16_t>();
+    int height = reader.get<uint16_t>();
+    size_t pixelSize = static_cast<size_t>(width) * height * 4;
+    const uint8_t* pixels = reader.skip(pixelSize);
+    if (!reader.finished() || width == 0 || height == 0) return false;
+
+    // 标签一致后才校验整个文件
+    if (!binaryFile::crcMatches(data)) return false;
+
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(pixels, pixels + pixelSize);
+    return true;
+}
+
+bool write(const std::string& key, const std::string& tag, const imageDecoder::DecodedImage& image) {
+    std::string dirPath = dir();
+    if (dirPath.empty() || key.empty() || !valid(image)) return false;
+    if (image.width > UINT16_MAX || image.height > UINT16_MAX || tag.size() > UINT16_MAX) return false;
+
+    binaryFile::Writer writer(magic, version);
+    writer.buf.reserve(binaryFile::headerSize + 12 + tag.size() + image.pixels.size());
+    writer.putStr(tag);
+    writer.put(static_cast<uint16_t>(image.width));
+    writer.put(static_cast<uint16_t>(image.height));
+    writer.putBytes(image.pixels.data(), image.pixels.size());
+    writer.putCrc();
+
+    // 先完整写出临时文件再替换，读取方不会读到写了一半的文件
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    fs::ensureDir(dirPath);
+    return binaryFile::writeAtomic(pathOf(dirPath, key), writer.buf.data(), writer.buf.size());
+}
+
+imageDecoder::DecodedImage downscale(imageDecoder::DecodedImage image, int size) {
+    if (!valid(image) || size <= 0 || std::max(image.width, image.height) <= size) return image;
+
+    int srcW = image.width;
+    int srcH = image.height;
+    int dstW = std::max(1, srcW > srcH ? size : srcW * size / srcH);
+    int dstH = std::max(1, srcH >= srcW ? size : srcH * size / srcW);
+
+    // 每个目标像素取对应源区域的平均值
+    imageDecoder::DecodedImage result;
+    result.width = dstW;
+    result.height = dstH;
+    result.pixels.resize(static_cast<size_t>(dstW) * dstH * 4);
+    const uint8_t* src = image.pixels.data();
+    uint8_t* dst = result.pixels.data();
+    for (int dy = 0; dy < dstH; ++dy) {
+        int y0 = dy * srcH / dstH;
+        int y1 = std::max(y0 + 1, (dy + 1) * srcH / dstH);
+        for (int dx = 0; dx < dstW; ++dx) {
+            int x0 = dx * srcW / dstW;
+            int x1 = std::max(x0 + 1, (dx + 1) * srcW / dstW);
+            uint32_t sum[4] = {};
+            for (int y = y0; y < y1; ++y) {
+                const uint8_t* row = src + (static_cast<size_t>(y) * srcW + x0) * 4;
+                for (int x = x0; x < x1; ++x, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+            uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+            for (int c = 0; c < 4; ++c) *dst++ = static_cast<uint8_t>((sum[c] + count / 2) / count);
+        }
+    }
+    return result;
+}
+
+Stats stats() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_stats;
+}
+
+void clear() {
+    std::string dirPath = dir();
+    if (dirPath.empty()) return;
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    fs::removeDirAll(dirPath);
+}
+
+int64_t cacheSize(std::stop_token token) {
+    std::string dirPath = dir();
+    if (dirPath.empty()) return 0;
+    int64_t size = fs::calcDirSize(dirPath, &token);
+    if (token.stop_requested()) return -1;
+    return size > 0 ? size : 0;
+}
+
+} // namespace iconCache
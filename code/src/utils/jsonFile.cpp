@@ -4,38 +4,112 @@
 
 #include "utils/jsonFile.hpp"
 #include "utils/fsHelper.hpp"
+#include "utils/persistQueue.hpp"
 #include "yyjson.h"
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
 
-JsonFile::JsonFile() = default;
+namespace {
+
+    /** @brief 不可变 / 可变文档中的值（同一时间只有一个非空） */
+    struct Value {
+        yyjson_val* read = nullptr;    // 不可变文档中的值
+        yyjson_mut_val* mut = nullptr; // 可变文档中的值
+
+        explicit operator bool() const { return read || mut; }
+        bool isObj() const { return read ? yyjson_is_obj(read) : yyjson_mut_is_obj(mut); }
+        bool isArr() const { return read ? yyjson_is_arr(read) : yyjson_mut_is_arr(mut); }
+        bool isStr() const { return read ? yyjson_is_str(read) : yyjson_mut_is_str(mut); }
+        bool isBool() const { return read ? yyjson_is_bool(read) : yyjson_mut_is_bool(mut); }
+        bool isInt() const { return read ? yyjson_is_int(read) : yyjson_mut_is_int(mut); }
+        const char* str() const { return read ? yyjson_get_str(read) : yyjson_mut_get_str(mut); }
+        size_t len() const { return read ? yyjson_get_len(read) : yyjson_mut_get_len(mut); }
+        bool boolean() const { return read ? yyjson_get_bool(read) : yyjson_mut_get_bool(mut); }
+        int integer() const { return read ? yyjson_get_int(read) : yyjson_mut_get_int(mut); }
+        size_t arrSize() const { return read ? yyjson_arr_size(read) : yyjson_mut_arr_size(mut); }
+
+        /** @brief 对象中的子值（非对象或不存在时为空） */
+        Value child(const std::string& key) const {
+            Value val;
+            if (read && yyjson_is_obj(read)) val.read = yyjson_obj_getn(read, key.data(), key.size());
+            else if (mut && yyjson_mut_is_obj(mut)) val.mut = yyjson_mut_obj_getn(mut, key.data(), key.size());
+            return val;
+        }
+
+        /** @brief 字符串值是否与 text 相同 */
+        bool strEquals(const std::string& text) const {
+            return isStr() && len() == text.size() && std::memcmp(str(), text.data(), text.size()) == 0;
+        }
+    };
+
+    /** @brief 根对象（不存在或不是对象时为空） */
+    Value rootOf(yyjson_doc* readDoc, yyjson_mut_doc* doc) {
+        Value root;
+        if (doc) root.mut = yyjson_mut_doc_get_root(doc);
+        else if (readDoc) root.read = yyjson_doc_get_root(readDoc);
+        return root && root.isObj() ? root : Value{};
+    }
+
+    /** @brief 收集对象的全部键 */
+    void collectKeys(const Value& obj, std::vector<std::string>& result) {
+        if (!obj || !obj.isObj()) return;
+        if (obj.read) {
+            size_t idx, max;
+            yyjson_val* key;
+            yyjson_val* val;
+            yyjson_obj_foreach(obj.read, idx, max, key, val) {
+                if (yyjson_is_str(key)) result.emplace_back(yyjson_get_str(key), yyjson_get_len(key));
+            }
+            return;
+        }
+        size_t idx, max;
+        yyjson_mut_val* key;
+        yyjson_mut_val* val;
+        yyjson_mut_obj_foreach(obj.mut, idx, max, key, val) {
+            if (yyjson_mut_is_str(key)) result.emplace_back(yyjson_mut_get_str(key), yyjson_mut_get_len(key));
+        }
+    }
+
+} // namespace
+
+JsonFile::JsonFile(Format format) : m_format(format) {}
 
 JsonFile::~JsonFile() {
+    reset();
+}
+
+void JsonFile::reset() {
+    if (m_readDoc) yyjson_doc_free(m_readDoc);
     if (m_doc) yyjson_mut_doc_free(m_doc);
+    m_readDoc = nullptr;
+    m_doc = nullptr;
+    std::vector<char>().swap(m_buffer);
 }
 
-// 确保 m_doc 存在（空文档 + 空根对象）
+// 确保 m_doc 存在：有不可变文档时复制转换，否则创建空文档 + 空根对象
 yyjson_mut_doc* JsonFile::ensureDoc() {
-    if (!m_doc) {
-        m_doc = yyjson_mut_doc_new(nullptr);
-        if (m_doc) {
-            yyjson_mut_val* root = yyjson_mut_obj(m_doc);
-            if (root) yyjson_mut_doc_set_root(m_doc, root);
-        }
+    if (m_doc) return m_doc;
+
+    if (m_readDoc) {
+        m_doc = yyjson_doc_mut_copy(m_readDoc, nullptr);
+        yyjson_doc_free(m_readDoc);
+        m_readDoc = nullptr;
+        std::vector<char>().swap(m_buffer);
+    }
+    if (!m_doc) m_doc = yyjson_mut_doc_new(nullptr);
+    if (m_doc && !yyjson_mut_is_obj(yyjson_mut_doc_get_root(m_doc))) {
+        yyjson_mut_val* root = yyjson_mut_obj(m_doc);
+        if (root) yyjson_mut_doc_set_root(m_doc, root);
     }
     return m_doc;
 }
 
-// 查找 rootKey 对应的子对象，找不到返回 nullptr
+// 查找 rootKey 对应的子对象（可变文档），找不到返回 nullptr
 void* JsonFile::findRootObj(const std::string& rootKey) {
-    if (!m_doc) return nullptr;
-    yyjson_mut_val* root = yyjson_mut_doc_get_root(m_doc);
-    if (!root || !yyjson_mut_is_obj(root)) return nullptr;
-    yyjson_mut_val* obj = yyjson_mut_obj_get(root, rootKey.c_str());
-    if (!obj || !yyjson_mut_is_obj(obj)) return nullptr;
-    return obj;
+    Value obj = rootOf(nullptr, m_doc).child(rootKey);
+    return obj && obj.isObj() ? obj.mut : nullptr;
 }
 
 // 查找或创建 rootKey 对应的子对象
@@ -44,29 +118,43 @@ void* JsonFile::findOrCreateRootObj(const std::string& rootKey) {
     yyjson_mut_val* root = yyjson_mut_doc_get_root(m_doc);
     if (!root) return nullptr;
 
-    yyjson_mut_val* obj = yyjson_mut_obj_get(root, rootKey.c_str());
-    if (obj && yyjson_mut_is_obj(obj)) return obj;
+    yyjson_mut_val* obj = yyjson_mut_obj_getn(root, rootKey.data(), rootKey.size());
+    if (obj) {
+        // 已存在但不是对象：原地改为空对象
+        if (!yyjson_mut_is_obj(obj)) yyjson_mut_set_obj(obj);
+        return obj;
+    }
 
-    // 不存在或不是对象，创建新的
     obj = yyjson_mut_obj(m_doc);
-    if (!obj) return nullptr;
-    yyjson_mut_val* keyVal = yyjson_mut_strcpy(m_doc, rootKey.c_str());
-    if (!keyVal) return nullptr;
-    yyjson_mut_obj_put(root, keyVal, obj);
+    yyjson_mut_val* keyVal = yyjson_mut_strncpy(m_doc, rootKey.data(), rootKey.size());
+    if (!obj || !keyVal) return nullptr;
+    yyjson_mut_obj_add(root, keyVal, obj);
     return obj;
 }
 
-// 读取文件到内存
+// 读取文件并原地解析为不可变文档
 bool JsonFile::load(const std::string& path) {
     m_path = path;
-
-    // 释放旧文档
-    if (m_doc) {
-        yyjson_mut_doc_free(m_doc);
-        m_doc = nullptr;
+    m_dirty = false;
+    reset();
+
+    // 还在写入队列中的内容比文件更新
+    std::string queued;
+    if (persistQueue::pending(path, queued)) {
+        m_buffer.assign(queued.size() + YYJSON_PADDING_SIZE, '\0');
+        std::memcpy(m_buffer.data(), queued.data(), queued.size());
+        return parseBuffer(queued.size());
     }
 
-    FILE* file = fopen(path.c_str(), "rb");
+    // 原文件缺失或损坏（替换中途断电）时回退到临时文件
+    return readFile(path) || readFile(persistQueue::tempPath(path));
+}
+
+// 读取整个文件到 m_buffer 并解析
+bool JsonFile::readFile(const std::string& path) {
+    reset();
+
+    FILE* file = fopen(fs::nativePath(path).c_str(), "rb");
     if (!file) return false;
 
     fseek(file, 0, SEEK_END);
@@ -78,211 +166,237 @@ bool JsonFile::load(const std::string& path) {
         return false;
     }
 
-    std::vector<char> buffer(fileSize + 1);
-    size_t readSize = fread(buffer.data(), 1, fileSize, file);
+    // 原地解析要求缓冲区末尾留出 YYJSON_PADDING_SIZE 个 0
+    m_buffer.assign(fileSize + YYJSON_PADDING_SIZE, '\0');
+    size_t readSize = fread(m_buffer.data(), 1, fileSize, file);
     fclose(file);
 
-    if (readSize != static_cast<size_t>(fileSize)) return false;
-    buffer[fileSize] = '\0';
-
-    // 解析为不可变文档，再转为可变文档
-    yyjson_doc* doc = yyjson_read(buffer.data(), fileSize, 0);
-    if (!doc) return false;
-
-    m_doc = yyjson_doc_mut_copy(doc, nullptr);
-    yyjson_doc_free(doc);
+    if (readSize != static_cast<size_t>(fileSize)) {
+        reset();
+        return false;
+    }
+    return parseBuffer(readSize);
+}
 
-    return m_doc != nullptr;
+// 原地解析 m_buffer 的前 size 字节
+bool JsonFile::parseBuffer(size_t size) {
+    m_readDoc = yyjson_read_opts(m_buffer.data(), size, YYJSON_READ_INSITU, nullptr, nullptr);
+    if (!m_readDoc) {
+        reset();
+        return false;
+    }
+    return true;
 }
 
-// 写回文件
-bool JsonFile::save() {
-    if (m_path.empty()) return false;
-    if (!ensureDoc()) return false;
+// 序列化当前文档，并确保父目录存在
+bool JsonFile::serialize(std::string& out) {
+    if (m_path.empty() || !ensureDoc()) return false;
 
-    // 确保父目录存在
     auto pos = m_path.rfind('/');
     if (pos != std::string::npos && pos != 0) {
         fs::ensureDir(m_path.substr(0, pos));
     }
 
-    const char* jsonStr = yyjson_mut_write(m_doc, YYJSON_WRITE_PRETTY, nullptr);
+    yyjson_write_flag flags = m_format == Format::Pretty ? YYJSON_WRITE_PRETTY : YYJSON_WRITE_NOFLAG;
+    size_t jsonLen = 0;
+    char* jsonStr = yyjson_mut_write(m_doc, flags, &jsonLen);
     if (!jsonStr) return false;
+    out.assign(jsonStr, jsonLen);
+    free(jsonStr);
+    return true;
+}
 
-    FILE* file = fopen(m_path.c_str(), "wb");
-    if (!file) {
-        free((void*)jsonStr);
-        return false;
-    }
+// 写回文件（没有修改时跳过），排在已提交的延迟写入之后
+bool JsonFile::save() {
+    if (m_path.empty()) return false;
+    if (!m_dirty) return true;
 
-    size_t jsonLen = strlen(jsonStr);
-    size_t written = fwrite(jsonStr, 1, jsonLen, file);
-    fclose(file);
-    free((void*)jsonStr);
+    std::string json;
+    if (!serialize(json)) return false;
+    if (!persistQueue::write(m_path, std::move(json))) return false;
+    m_dirty = false;
+    return true;
+}
 
-    return written == jsonLen;
+// 交给写入队列后立即返回（没有修改时跳过）
+void JsonFile::saveDeferred() {
+    if (m_path.empty() || !m_dirty) return;
+
+    std::string json;
+    if (!serialize(json)) return;
+    persistQueue::submit(m_path, std::move(json));
+    m_dirty = false;
+}
+
+bool JsonFile::isDirty() const {
+    return m_dirty;
 }
 
 // 读取字符串
 std::string JsonFile::getString(const std::string& rootKey, const std::string& key, const std::string& defaultVal) {
-    yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findRootObj(rootKey));
-    if (!obj) return defaultVal;
-
-    yyjson_mut_val* val = yyjson_mut_obj_get(obj, key.c_str());
-    if (!val || !yyjson_mut_is_str(val)) return defaultVal;
-
-    const char* str = yyjson_mut_get_str(val);
-    return str ? std::string(str) : defaultVal;
+    Value val = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (!val || !val.isStr()) return defaultVal;
+    return std::string(val.str(), val.len());
 }
 
 // 读取布尔值
 bool JsonFile::getBool(const std::string& rootKey, const std::string& key, bool defaultVal) {
-    yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findRootObj(rootKey));
-    if (!obj) return defaultVal;
-
-    yyjson_mut_val* val = yyjson_mut_obj_get(obj, key.c_str());
-    if (!val || !yyjson_mut_is_bool(val)) return defaultVal;
-
-    return yyjson_mut_get_bool(val);
+    Value val = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (!val || !val.isBool()) return defaultVal;
+    return val.boolean();
 }
 
 // 读取整数
 int JsonFile::getInt(const std::string& rootKey, const std::string& key, int defaultVal) {
-    yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findRootObj(rootKey));
-    if (!obj) return defaultVal;
-
-    yyjson_mut_val* val = yyjson_mut_obj_get(obj, key.c_str());
-    if (!val || !yyjson_mut_is_int(val)) return defaultVal;
-
-    return yyjson_mut_get_int(val);
+    Value val = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (!val || !val.isInt()) return defaultVal;
+    return val.integer();
 }
 
-// 写入字符串
+// 写入字符串（与原值相同时不修改）
 void JsonFile::setString(const std::string& rootKey, const std::string& key, const std::string& value) {
+    if (rootOf(m_readDoc, m_doc).child(rootKey).child(key).strEquals(value)) return;
+
     yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findOrCreateRootObj(rootKey));
     if (!obj) return;
 
-    yyjson_mut_val* keyVal = yyjson_mut_strcpy(m_doc, key.c_str());
-    yyjson_mut_val* valVal = yyjson_mut_strcpy(m_doc, value.c_str());
-    if (keyVal && valVal) yyjson_mut_obj_put(obj, keyVal, valVal);
+    yyjson_mut_val* valVal = yyjson_mut_strncpy(m_doc, value.data(), value.size());
+    if (!valVal) return;
+    if (yyjson_mut_val* existing = yyjson_mut_obj_getn(obj, key.data(), key.size())) {
+        yyjson_mut_set_strn(existing, yyjson_mut_get_str(valVal), value.size());
+    } else {
+        yyjson_mut_val* keyVal = yyjson_mut_strncpy(m_doc, key.data(), key.size());
+        if (!keyVal) return;
+        yyjson_mut_obj_add(obj, keyVal, valVal);
+    }
+    m_dirty = true;
 }
 
-// 写入布尔值
+// 写入布尔值（与原值相同时不修改）
 void JsonFile::setBool(const std::string& rootKey, const std::string& key, bool value) {
+    Value current = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (current && current.isBool() && current.boolean() == value) return;
+
     yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findOrCreateRootObj(rootKey));
     if (!obj) return;
 
-    yyjson_mut_val* keyVal = yyjson_mut_strcpy(m_doc, key.c_str());
-    yyjson_mut_val* valVal = yyjson_mut_bool(m_doc, value);
-    if (keyVal && valVal) yyjson_mut_obj_put(obj, keyVal, valVal);
+    if (yyjson_mut_val* existing = yyjson_mut_obj_getn(obj, key.data(), key.size())) {
+        yyjson_mut_set_bool(existing, value);
+    } else {
+        yyjson_mut_val* keyVal = yyjson_mut_strncpy(m_doc, key.data(), key.size());
+        yyjson_mut_val* valVal = yyjson_mut_bool(m_doc, value);
+        if (!keyVal || !valVal) return;
+        yyjson_mut_obj_add(obj, keyVal, valVal);
+    }
+    m_dirty = true;
 }
 
-// 写入整数
+// 写入整数（与原值相同时不修改）
 void JsonFile::setInt(const std::string& rootKey, const std::string& key, int value) {
+    Value current = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (current && current.isInt() && current.integer() == value) return;
+
     yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findOrCreateRootObj(rootKey));
     if (!obj) return;
 
-    yyjson_mut_val* keyVal = yyjson_mut_strcpy(m_doc, key.c_str());
-    yyjson_mut_val* valVal = yyjson_mut_int(m_doc, value);
-    if (keyVal && valVal) yyjson_mut_obj_put(obj, keyVal, valVal);
+    if (yyjson_mut_val* existing = yyjson_mut_obj_getn(obj, key.data(), key.size())) {
+        yyjson_mut_set_int(existing, value);
+    } else {
+        yyjson_mut_val* keyVal = yyjson_mut_strncpy(m_doc, key.data(), key.size());
+        yyjson_mut_val* valVal = yyjson_mut_int(m_doc, value);
+        if (!keyVal || !valVal) return;
+        yyjson_mut_obj_add(obj, keyVal, valVal);
+    }
+    m_dirty = true;
 }
 
 // 读取字符串数组
 std::vector<std::string> JsonFile::getStringArray(const std::string& rootKey, const std::string& key) {
     std::vector<std::string> result;
-    yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findRootObj(rootKey));
-    if (!obj) return result;
-
-    yyjson_mut_val* val = yyjson_mut_obj_get(obj, key.c_str());
-    if (!val || !yyjson_mut_is_arr(val)) return result;
+    Value val = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (!val || !val.isArr()) return result;
+
+    if (val.read) {
+        size_t idx, max;
+        yyjson_val* item;
+        yyjson_arr_foreach(val.read, idx, max, item) {
+            if (yyjson_is_str(item)) result.emplace_back(yyjson_get_str(item), yyjson_get_len(item));
+        }
+        return result;
+    }
 
     size_t idx, max;
     yyjson_mut_val* item;
-    yyjson_mut_arr_foreach(val, idx, max, item) {
-        if (yyjson_mut_is_str(item)) {
-            const char* str = yyjson_mut_get_str(item);
-            if (str) result.emplace_back(str);
-        }
+    yyjson_mut_arr_foreach(val.mut, idx, max, item) {
+        if (yyjson_mut_is_str(item)) result.emplace_back(yyjson_mut_get_str(item), yyjson_mut_get_len(item));
     }
     return result;
 }
 
-// 写入字符串数组
+// 写入字符串数组（与原数组相同时不修改）
 void JsonFile::setStringArray(const std::string& rootKey, const std::string& key, const std::vector<std::string>& values) {
+    // 原数组元素全部是字符串（数量一致）且逐项相同
+    Value current = rootOf(m_readDoc, m_doc).child(rootKey).child(key);
+    if (current && current.isArr() && current.arrSize() == values.size() && getStringArray(rootKey, key) == values) return;
+
     yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findOrCreateRootObj(rootKey));
     if (!obj) return;
 
-    yyjson_mut_val* arr = yyjson_mut_arr(m_doc);
-    if (!arr) return;
+    yyjson_mut_val* arr = yyjson_mut_obj_getn(obj, key.data(), key.size());
+    if (arr) {
+        yyjson_mut_set_arr(arr);
+    } else {
+        yyjson_mut_val* keyVal = yyjson_mut_strncpy(m_doc, key.data(), key.size());
+        arr = yyjson_mut_arr(m_doc);
+        if (!keyVal || !arr) return;
+        yyjson_mut_obj_add(obj, keyVal, arr);
+    }
 
     for (const auto& s : values) {
-        yyjson_mut_val* item = yyjson_mut_strcpy(m_doc, s.c_str());
+        yyjson_mut_val* item = yyjson_mut_strncpy(m_doc, s.data(), s.size());
         if (item) yyjson_mut_arr_append(arr, item);
     }
-
-    yyjson_mut_val* keyVal = yyjson_mut_strcpy(m_doc, key.c_str());
-    if (keyVal) yyjson_mut_obj_put(obj, keyVal, arr);
+    m_dirty = true;
 }
 
 // 查询根键是否存在
 bool JsonFile::hasRootKey(const std::string& rootKey) {
-    return findRootObj(rootKey) != nullptr;
+    Value obj = rootOf(m_readDoc, m_doc).child(rootKey);
+    return obj && obj.isObj();
 }
 
 // 获取所有根键
 std::vector<std::string> JsonFile::getRootKeys() const {
     std::vector<std::string> result;
-    if (!m_doc) return result;
-
-    yyjson_mut_val* root = yyjson_mut_doc_get_root(m_doc);
-    if (!root || !yyjson_mut_is_obj(root)) return result;
-
-    size_t idx, max;
-    yyjson_mut_val* key;
-    yyjson_mut_val* val;
-    yyjson_mut_obj_foreach(root, idx, max, key, val) {
-        if (yyjson_mut_is_str(key)) {
-            const char* str = yyjson_mut_get_str(key);
-            if (str) result.emplace_back(str);
-        }
-    }
+    collectKeys(rootOf(m_readDoc, m_doc), result);
     return result;
 }
 
 // 获取指定根键下的所有子键
 std::vector<std::string> JsonFile::getKeys(const std::string& rootKey) const {
     std::vector<std::string> result;
-    if (!m_doc) return result;
-
-    yyjson_mut_val* root = yyjson_mut_doc_get_root(m_doc);
-    if (!root || !yyjson_mut_is_obj(root)) return result;
-
-    yyjson_mut_val* obj = yyjson_mut_obj_get(root, rootKey.c_str());
-    if (!obj || !yyjson_mut_is_obj(obj)) return result;
-
-    size_t idx, max;
-    yyjson_mut_val* key;
-    yyjson_mut_val* val;
-    yyjson_mut_obj_foreach(obj, idx, max, key, val) {
-        if (yyjson_mut_is_str(key)) {
-            const char* str = yyjson_mut_get_str(key);
-            if (str) result.emplace_back(str);
-        }
-    }
+    collectKeys(rootOf(m_readDoc, m_doc).child(rootKey), result);
     return result;
 }
 
-// 删除子键
+// 删除子键（不存在时不修改）
 void JsonFile::removeKey(const std::string& rootKey, const std::string& key) {
+    if (!rootOf(m_readDoc, m_doc).child(rootKey).child(key)) return;
+    if (!ensureDoc()) return;
+
     yyjson_mut_val* obj = static_cast<yyjson_mut_val*>(findRootObj(rootKey));
     if (!obj) return;
-    yyjson_mut_obj_remove_str(obj, key.c_str());
+    yyjson_mut_obj_remove_keyn(obj, key.data(), key.size());
+    m_dirty = true;
 }
 
-// 删除根键
+// 删除根键（不存在时不修改）
 void JsonFile::removeRootKey(const std::string& rootKey) {
-    if (!m_doc) return;
+    if (!rootOf(m_readDoc, m_doc).child(rootKey)) return;
+    if (!ensureDoc()) return;
+
     yyjson_mut_val* root = yyjson_mut_doc_get_root(m_doc);
-    if (!root || !yyjson_mut_is_obj(root)) return;
-    yyjson_mut_obj_remove_str(root, rootKey.c_str());
+    if (!root) return;
+    yyjson_mut_obj_remove_keyn(root, rootKey.data(), rootKey.size());
+    m_dirty = true;
 }
@@ -0,0 +1,107 @@
+/**
+ * PartialFile - 正在下载中的文件的只读视图实现
+ */
+
+#include "utils/partialFile.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+PartialFile::PartialFile(std::string path, uint64_t size) : m_path(std::move(path)), m_size(size) {}
+
+PartialFile::~PartialFile() {
+    if (m_fp) std::fclose(m_fp);
+}
+
+void PartialFile::preload(uint64_t offset, std::vector<uint8_t> data) {
+    m_preloadOffset = offset;
+    m_preload = std::move(data);
+}
+
+void PartialFile::markWritten(uint64_t start, uint64_t end) {
+    if (start >= end) return;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = std::lower_bound(m_ranges.begin(), m_ranges.end(), std::make_pair(start, end));
+        it = m_ranges.insert(it, {start, end});
+
+        // 与前一个区间相接或重叠时并入前一个
+        if (it != m_ranges.begin() && std::prev(it)->second >= it->first) {
+            auto prev = std::prev(it);
+            prev->second = std::max(prev->second, it->second);
+            it = m_ranges.erase(it);
+            it = prev;
+        }
+        // 吞并后面所有相接或重叠的区间
+        auto next = std::next(it);
+        while (next != m_ranges.end() && next->first <= it->second) {
+            it->second = std::max(it->second, next->second);
+            next = m_ranges.erase(next);
+        }
+    }
+    m_written.notify_all();
+}
+
+void PartialFile::finish(bool success) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_finished = true;
+        m_failed = m_failed || !success; // 下载中途已判定失败的，结束时不再恢复
+    }
+    m_written.notify_all();
+}
+
+bool PartialFile::failed() const {
+    std::lock_guard lock(m_mutex);
+    return m_failed;
+}
+
+bool PartialFile::readyLocked(uint64_t start, uint64_t end) const {
+    // 预先放入的内容位于文件尾部，只需检查它之前的部分
+    if (!m_preload.empty()) end = std::min(end, m_preloadOffset);
+    if (start >= end) return true;
+
+    auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), std::make_pair(start, UINT64_MAX));
+    if (it == m_ranges.begin()) return false;
+    --it;
+    return it->first <= start && it->second >= end;
+}
+
+size_t PartialFile::read(uint64_t offset, void* buf, size_t size) {
+    if (offset >= m_size) return 0;
+    size = static_cast<size_t>(std::min<uint64_t>(size, m_size - offset));
+    uint64_t end = offset + size;
+
+    {
+        std::unique_lock lock(m_mutex);
+        m_written.wait(lock, [&] { return m_finished || readyLocked(offset, end); });
+        if (m_failed) return 0;
+    }
+
+    // 预先放入的部分从内存复制，之前的部分从磁盘读取
+    uint64_t diskEnd = m_preload.empty() ? end : std::min(end, m_preloadOffset);
+    size_t done = 0;
+    if (offset < diskEnd) {
+        size_t want = static_cast<size_t>(diskEnd - offset);
+        if (readDisk(offset, buf, want) != want) return 0;
+        done = want;
+    }
+    if (done < size) {
+        uint64_t from = offset + done;
+        std::memcpy(static_cast<uint8_t*>(buf) + done, m_preload.data() + (from - m_preloadOffset), size - done);
+    }
+    return size;
+}
+
+size_t PartialFile::readDisk(uint64_t offset, void* buf, size_t size) {
+    std::lock_guard lock(m_readMutex);
+    if (!m_fp) {
+        m_fp = std::fopen(fs::nativePath(m_path).c_str(), "rb");
+        if (!m_fp) return 0;
+        std::setvbuf(m_fp, nullptr, _IONBF, 0);
+    }
+    if (std::fseek(m_fp, static_cast<long>(offset), SEEK_SET) != 0) return 0;
+    return std::fread(buf, 1, size, m_fp);
+}
@@ -0,0 +1,201 @@
+/**
+ * persistQueue - 元数据文件的合并写入队列
+ */
+
+#include "utils/persistQueue.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace persistQueue {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+        using Data = std::shared_ptr<const std::string>;
+
+        /** @brief 队列状态（全部成员由 mutex 保护） */
+        struct State {
+            std::mutex mutex;
+            std::condition_variable wake;                  // 唤醒后台线程
+            std::condition_variable done;                  // 有文件写出完成
+            std::deque<std::string> order;                 // 待写路径（首次进入队列的顺序）
+            std::unordered_map<std::string, Data> pending; // 路径 → 最新待写内容
+            std::string inFlightPath;                      // 正在写出的路径
+            Data inFlightData;                             // 正在写出的内容
+            std::unordered_map<std::string, bool> lastOk;  // 路径 → 最近一次写出是否成功
+            Clock::time_point lastSubmit;                  // 最近一次提交时间
+            int writes = 0;                                // 累计写出的文件数
+            bool urgent = false;                           // 跳过等待，立即写出
+            bool stopping = false;                         // 写完剩余内容后退出
+            bool stopped = false;                          // 后台线程已退出
+            std::thread worker;                            // 后台写线程（首次提交时启动）
+
+            ~State() {
+                // 未调用 shutdown() 就退出进程时，仍然写完剩余内容
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                if (worker.joinable()) worker.join();
+            }
+        };
+
+        State& state() {
+            static State s;
+            return s;
+        }
+
+        /** @brief 后台写出单个文件：父目录已被删除时放弃 */
+        bool writeEntry(const std::string& path, const std::string& data) {
+            auto pos = path.rfind('/');
+            if (pos != std::string::npos && pos != 0 && !fs::dirExists(path.substr(0, pos))) return false;
+            return writeAtomic(path, data);
+        }
+
+        void run() {
+            State& s = state();
+            std::unique_lock<std::mutex> lock(s.mutex);
+            while (true) {
+                if (s.order.empty()) {
+                    s.urgent = false;
+                    if (s.stopping) break;
+                    s.wake.wait(lock);
+                    continue;
+                }
+
+                // 连续提交时一直推迟，直到静默 debounceMs
+                if (!s.urgent && !s.stopping) {
+                    auto due = s.lastSubmit + std::chrono::milliseconds(debounceMs);
+                    if (Clock::now() < due) {
+                        s.wake.wait_until(lock, due);
+                        continue;
+                    }
+                }
+
+                s.inFlightPath = std::move(s.order.front());
+                s.order.pop_front();
+                auto it = s.pending.find(s.inFlightPath);
+                s.inFlightData = std::move(it->second);
+                s.pending.erase(it);
+
+                std::string path = s.inFlightPath;
+                Data data = s.inFlightData;
+                lock.unlock();
+                bool ok = writeEntry(path, *data);
+                lock.lock();
+
+                s.lastOk[path] = ok;
+                s.writes++;
+                s.inFlightPath.clear();
+                s.inFlightData.reset();
+                s.done.notify_all();
+            }
+            s.stopped = true;
+            s.done.notify_all();
+        }
+
+        /** @brief 放入队列（调用方持有锁，队列已停止时返回 false 且不取走 data） */
+        bool enqueue(State& s, const std::string& path, std::string& data) {
+            if (s.stopping) return false;
+            if (!s.worker.joinable()) s.worker = std::thread(run);
+
+            auto ptr = std::make_shared<const std::string>(std::move(data));
+            auto it = s.pending.find(path);
+            if (it != s.pending.end()) {
+                it->second = std::move(ptr);
+            } else {
+                s.pending.emplace(path, std::move(ptr));
+                s.order.push_back(path);
+            }
+            s.lastSubmit = Clock::now();
+            return true;
+        }
+
+    } // namespace
+
+    std::string tempPath(const std::string& path) {
+        return binaryFile::tempPath(path);
+    }
+
+    bool writeAtomic(const std::string& path, const std::string& data) {
+        return binaryFile::writeAtomic(path, data.data(), data.size());
+    }
+
+    void submit(const std::string& path, std::string data) {
+        State& s = state();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        if (!enqueue(s, path, data)) {
+            lock.unlock();
+            writeAtomic(path, data);
+            return;
+        }
+        s.wake.notify_one();
+    }
+
+    bool write(const std::string& path, std::string data) {
+        State& s = state();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        if (!enqueue(s, path, data)) {
+            lock.unlock();
+            return writeAtomic(path, data);
+        }
+
+        // 队列中排在前面的文件一并立即写出，保证顺序
+        s.urgent = true;
+        s.wake.notify_one();
+        s.done.wait(lock, [&] { return s.stopped || (!s.pending.count(path) && s.inFlightPath != path); });
+        auto it = s.lastOk.find(path);
+        return it != s.lastOk.end() && it->second;
+    }
+
+    bool pending(const std::string& path, std::string& data) {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.pending.find(path);
+        if (it != s.pending.end()) {
+            data = *it->second;
+            return true;
+        }
+        if (s.inFlightData && s.inFlightPath == path) {
+            data = *s.inFlightData;
+            return true;
+        }
+        return false;
+    }
+
+    void flush(bool wait) {
+        State& s = state();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        if (s.order.empty() && s.inFlightPath.empty()) return;
+
+        s.urgent = true;
+        s.wake.notify_one();
+        if (wait) s.done.wait(lock, [&] { return s.stopped || (s.order.empty() && s.inFlightPath.empty()); });
+    }
+
+    int writeCount() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.writes;
+    }
+
+    void shutdown() {
+        State& s = state();
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.stopping = true;
+        }
+        s.wake.notify_all();
+        if (s.worker.joinable()) s.worker.join();
+    }
+
+} // namespace persistQueue
@@ -0,0 +1,204 @@
+/**
+ * pinYinCache - 拼音转换结果的持久化缓存实现
+ */
+
+#include "utils/pinYinCache.hpp"
+#include "utils/binaryFile.hpp"
+#include "utils/crc32.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/pinYinCvt.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace pinYinCache {
+
+namespace {
+
+    constexpr char magic[4] = {'N', 'X', 'P', 'Y'};
+    constexpr uint32_t version = 1;
+    constexpr size_t maxFileEntries = 8192;  // 文件条目上限，超出后只保留本次启动用到的名称
+
+    /** @brief 内存中的缓存条目 */
+    struct Slot {
+        Entry entry;            // 转换结果
+        bool used = false;      // 本次启动是否查询过
+        bool transient = false; // 引擎未初始化时的原样结果，只留在内存
+    };
+
+    std::mutex s_mutex;
+    std::string s_path;
+    bool s_loaded = false;        // 是否已读取缓存文件
+    bool s_hasHeader = false;     // 文件是否已有有效文件头（可直接追加）
+    bool s_needRewrite = false;   // 文件尾残缺或版本不符，下次写入时整体重写
+    size_t s_fileEntries = 0;     // 文件中的记录数
+    std::unordered_map<uint64_t, Slot> s_entries;
+    std::vector<uint64_t> s_pending;  // 尚未写入文件的名称哈希
+
+    /** @brief FNV-1a 64 位哈希 */
+    uint64_t hashOf(const std::string& text) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char ch : text) {
+            hash ^= ch;
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    /** @brief 追加一条记录（含记录自身的 CRC） */
+    void putRecord(binaryFile::Writer& writer, uint64_t hash, const Entry& entry) {
+        size_t start = writer.buf.size();
+        writer.put(hash);
+        writer.putStr<uint16_t>(entry.sortKey);
+        size_t count = std::min<size_t>(entry.tokens.size(), UINT8_MAX);
+        writer.put(static_cast<uint8_t>(count));
+        for (size_t i = 0; i < count; ++i) writer.putStr<uint8_t>(entry.tokens[i]);
+        writer.putCrc(start);
+    }
+
+    /** @brief 一次拼音转换同时生成排序键和搜索 token */
+    Entry convert(const std::string& text) {
+        Entry entry;
+        if (text.empty()) return entry;
+
+        // toPinyin 返回空格分隔的拼音字符串（如 "sai er da Zelda"），未初始化时原样返回
+        std::string pinyin = pinYinCvt::toPinyin(text);
+        if (pinYinCvt::isReady()) {
+            entry.sortKey = pinyin;
+            std::transform(entry.sortKey.begin(), entry.sortKey.end(), entry.sortKey.begin(), [](unsigned char ch) { return std::toupper(ch); });
+        } else {
+            entry.sortKey = text;
+        }
+
+        // 按空格分词，每个 token 仅保留字母和数字后转大写
+        std::istringstream stream(pinyin);
+        std::string rawToken;
+        while (stream >> rawToken) {
+            std::string cleanToken;
+            for (char ch : rawToken) {
+                if (std::isalnum(static_cast<unsigned char>(ch))) {
+                    cleanToken += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+                }
+            }
+            if (!cleanToken.empty()) entry.tokens.push_back(std::move(cleanToken));
+        }
+        return entry;
+    }
+
+    /** @brief 读取缓存文件（调用方持锁） */
+    void loadLocked() {
+        s_loaded = true;
+        if (s_path.empty()) return;
+
+        auto data = fs::readFile(s_path);
+        if (data.empty()) return;
+        binaryFile::Reader reader = binaryFile::openHeader(data, magic, version);
+        if (!reader.ok) {
+            s_needRewrite = true;
+            return;
+        }
+        s_hasHeader = true;
+
+        while (reader.pos < data.size()) {
+            size_t start = reader.pos;
+            uint64_t hash = reader.get<uint64_t>();
+            Slot slot;
+            slot.entry.sortKey = reader.getStr<uint16_t>();
+            uint8_t count = reader.get<uint8_t>();
+            for (uint8_t i = 0; i < count && reader.ok; ++i) slot.entry.tokens.push_back(reader.getStr<uint8_t>());
+            size_t end = reader.pos;
+            uint32_t storedCrc = reader.get<uint32_t>();
+            if (!reader.ok || crc::fromBuffer(0, data.data() + start, end - start) != storedCrc) {
+                s_needRewrite = true;
+                break;
+            }
+            s_entries.emplace(hash, std::move(slot));
+            ++s_fileEntries;
+        }
+    }
+
+    /** @brief 整体重写缓存文件（调用方持锁） */
+    bool rewriteLocked(bool usedOnly) {
+        binaryFile::Writer writer(magic, version);
+        writer.buf.reserve(binaryFile::headerSize + s_entries.size() * 48);
+        size_t count = 0;
+        for (const auto& [hash, slot] : s_entries) {
+            if (slot.transient || (usedOnly && !slot.used)) continue;
+            putRecord(writer, hash, slot.entry);
+            ++count;
+        }
+
+        auto pos = s_path.rfind('/');
+        if (pos != std::string::npos && pos > 0) fs::ensureDir(s_path.substr(0, pos));
+        if (fs::writeFile(s_path, writer.buf.data(), writer.buf.size()) != 0) return false;
+
+        s_hasHeader = true;
+        s_needRewrite = false;
+        s_fileEntries = count;
+        s_pending.clear();
+        return true;
+    }
+
+} // namespace
+
+void setPath(const std::string& path) {
+    std::lock_guard lock(s_mutex);
+    s_path = path;
+}
+
+const Entry& get(const std::string& text) {
+    uint64_t hash = hashOf(text);
+    {
+        std::lock_guard lock(s_mutex);
+        if (!s_loaded) loadLocked();
+        auto it = s_entries.find(hash);
+        if (it != s_entries.end()) {
+            it->second.used = true;
+            return it->second.entry;
+        }
+    }
+
+    // 转换较慢，不持锁；并发转换同一名称时保留先插入的结果
+    Entry entry = convert(text);
+
+    bool transient = !pinYinCvt::isReady();
+    std::lock_guard lock(s_mutex);
+    auto [it, inserted] = s_entries.emplace(hash, Slot{std::move(entry), true, transient});
+    if (inserted && !transient) s_pending.push_back(hash);
+    return it->second.entry;
+}
+
+bool flush() {
+    std::lock_guard lock(s_mutex);
+    if (s_path.empty() || !s_loaded) return true;
+    if (s_pending.empty() && !s_needRewrite) return true;
+
+    if (s_fileEntries + s_pending.size() > maxFileEntries) return rewriteLocked(true);
+    if (s_needRewrite || !s_hasHeader) return rewriteLocked(false);
+
+    binaryFile::Writer writer;
+    for (uint64_t hash : s_pending) putRecord(writer, hash, s_entries[hash].entry);
+    if (fs::appendFile(s_path, writer.buf.data(), writer.buf.size()) != 0) {
+        // 追加失败时文件尾可能残缺，改为全量重写
+        return rewriteLocked(false);
+    }
+    s_fileEntries += s_pending.size();
+    s_pending.clear();
+    return true;
+}
+
+void unload() {
+    std::lock_guard lock(s_mutex);
+    s_loaded = false;
+    s_hasHeader = false;
+    s_needRewrite = false;
+    s_fileEntries = 0;
+    s_entries.clear();
+    s_pending.clear();
+}
+
+} // namespace pinYinCache
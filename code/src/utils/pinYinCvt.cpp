@@ -16,10 +16,18 @@ static std::unique_ptr<Pinyin::Pinyin> s_pinyin;
 
 void init() {
     if (s_pinyin) return;
+#ifdef __SWITCH__
     Pinyin::setDictionaryPath("romfs:/dict");
+#else
+    Pinyin::setDictionaryPath(PINYIN_DICT_DIR);  // 主机端构建由 CMake 传入
+#endif
     s_pinyin = std::make_unique<Pinyin::Pinyin>();
 }
 
+bool isReady() {
+    return s_pinyin != nullptr;
+}
+
 std::string toPinyin(const std::string& text) {
     if (!s_pinyin || text.empty()) return text;
     auto res = s_pinyin->hanziToPinyin(text, Pinyin::ManTone::Style::NORMAL);
@@ -1,131 +1,181 @@
 /**
  * SearchEngine - 通用搜索引擎实现
- * 支持原文匹配和拼音混合匹配（全拼/首字母可任意组合）
+ * 支持原文匹配和拼音混合匹配（首字母 / 全拼 / 部分拼写可任意组合）
  */
 
 #include "utils/searchEngine.hpp"
+#include "utils/pinYinCache.hpp"
 #include "utils/pinYinCvt.hpp"
 #include <algorithm>
 #include <cctype>
-#include <sstream>
-#include <utility>
-
-std::vector<SearchEngine::Result> SearchEngine::search(const std::string& keyword, const std::vector<std::string>& items, int maxResults)
-{
-    std::vector<Result> results;
-
-    if (keyword.empty()) return results;
-
-    // keyword 统一转大写（用于原文匹配）
-    std::string upperKeyword = keyword;
-    std::transform(upperKeyword.begin(), upperKeyword.end(), upperKeyword.begin(), [](unsigned char ch) { return std::toupper(ch); });
+#include <climits>
+#include <numeric>
+
+namespace {
+
+    /** @brief 匹配质量，越小越靠前 */
+    enum Rank : uint8_t {
+        RankExact = 0,       // 原文完全相同
+        RankPrefix,          // 原文开头
+        RankWordStart,       // 原文某个单词开头
+        RankSubstring,       // 原文其他位置
+        RankPinyinStart,     // 拼音从第一个 token 开始
+        RankPinyinInner,     // 拼音从中间 token 开始
+        RankNone = UINT8_MAX // 不匹配
+    };
+
+    std::string toUpper(const std::string& text) {
+        std::string upper = text;
+        std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char ch) { return std::toupper(ch); });
+        return upper;
+    }
 
-    // keyword 转拼音后清洗（用于混合拼音匹配，支持中文+拼音混合输入）
-    std::string pinyinKeyword;
-    {
-        std::string rawPinyin = pinYinCvt::toPinyin(keyword);
-        for (char ch : rawPinyin) {
+    /** @brief 关键词转拼音后只保留字母数字并大写（支持中文 + 拼音混合输入） */
+    std::string toPinyinKeyword(const std::string& keyword) {
+        std::string pinyin;
+        for (char ch : pinYinCvt::toPinyin(keyword)) {
             if (std::isalnum(static_cast<unsigned char>(ch))) {
-                pinyinKeyword += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+                pinyin += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
             }
         }
+        return pinyin;
     }
 
-    for (int i = 0; i < static_cast<int>(items.size()); ++i) {
-        const std::string& name = items[i];
-        if (name.empty()) continue;
-
-        // 原文匹配：名称转大写后子串查找
-        std::string upperName = name;
-        std::transform(upperName.begin(), upperName.end(), upperName.begin(), [](unsigned char ch) { return std::toupper(ch); });
-        if (upperName.find(upperKeyword) != std::string::npos) {
-            results.push_back({i, name});
-            if (static_cast<int>(results.size()) >= maxResults) break;
-            continue;
-        }
+    bool startsWith(const std::string& text, const std::string& prefix) {
+        return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+    }
 
-        // 拼音混合匹配（按需计算并缓存）
-        if (pinyinKeyword.empty()) continue;
-        const PinyinCache& cache = getPinyinCache(name);
-        const auto& tokens = cache.tokens;
-
-        // 从每个 token 位置尝试混合匹配（支持子串语义）
-        bool matched = false;
-        for (size_t startToken = 0; startToken < tokens.size(); ++startToken) {
-            if (mixedMatch(pinyinKeyword, tokens, 0, startToken)) {
-                matched = true;
-                break;
-            }
-        }
+    /** @brief 单词分隔符：ASCII 非字母数字（UTF-8 多字节字符不算） */
+    bool isSeparator(char ch) {
+        auto uch = static_cast<unsigned char>(ch);
+        return uch < 0x80 && !std::isalnum(uch);
+    }
 
-        if (matched) {
-            results.push_back({i, name});
-            if (static_cast<int>(results.size()) >= maxResults) break;
+} // namespace
+
+void SearchEngine::setItems(std::vector<std::string> items) {
+    m_items = std::move(items);
+    m_levels.clear();
+    m_entries.clear();
+    m_entries.reserve(m_items.size());
+
+    for (const auto& name : m_items) {
+        Entry entry;
+        entry.upperName = toUpper(name);
+        for (const auto& token : pinYinCache::tokens(name)) {
+            if (entry.pinyin.size() + token.size() > UINT16_MAX) break;
+            entry.initials += token[0];
+            entry.pinyin += token;
+            entry.tokenEnds.push_back(static_cast<uint16_t>(entry.pinyin.size()));
         }
+        m_entries.push_back(std::move(entry));
     }
+}
 
+std::vector<SearchEngine::Result> SearchEngine::search(const std::string& keyword, int maxResults) {
+    std::vector<Result> results;
+    if (keyword.empty() || maxResults == 0) return results;
+
+    const Level& level = match(keyword);
+
+    // 只对前 maxResults 条做部分排序：质量优先，同质量保持数据源顺序
+    std::vector<size_t> order(level.hits.size());
+    std::iota(order.begin(), order.end(), 0);
+    size_t count = maxResults < 0 ? order.size() : std::min(order.size(), static_cast<size_t>(maxResults));
+    std::partial_sort(order.begin(), order.begin() + count, order.end(), [&level](size_t a, size_t b) {
+        if (level.ranks[a] != level.ranks[b]) return level.ranks[a] < level.ranks[b];
+        return level.hits[a] < level.hits[b];
+    });
+
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int index = level.hits[order[i]];
+        results.push_back({index, m_items[index]});
+    }
     return results;
 }
 
-const SearchEngine::PinyinCache& SearchEngine::getPinyinCache(const std::string& name) {
-    auto it = m_cache.find(name);
-    if (it != m_cache.end()) return it->second;
+const SearchEngine::Level& SearchEngine::match(const std::string& keyword) {
+    Level level;
+    level.upperKeyword = toUpper(keyword);
+    level.pinyinKeyword = toPinyinKeyword(keyword);
+
+    // 回退到可复用的上一级：原文与拼音关键词都须是新关键词的前缀；
+    // 上一级未做拼音匹配（拼音关键词为空）时，其命中集合不含拼音命中，不能复用
+    while (!m_levels.empty()) {
+        const Level& top = m_levels.back();
+        if (top.upperKeyword == level.upperKeyword && top.pinyinKeyword == level.pinyinKeyword) return top;
+        bool pinyinReusable = top.pinyinKeyword.empty() ? level.pinyinKeyword.empty() : startsWith(level.pinyinKeyword, top.pinyinKeyword);
+        if (pinyinReusable && startsWith(level.upperKeyword, top.upperKeyword)) break;
+        m_levels.pop_back();
+    }
 
-    // toPinyin 返回空格分隔的拼音字符串（如 "sai er da Zelda"）
-    std::string pinyin = pinYinCvt::toPinyin(name);
+    auto check = [&](int index) {
+        if (m_items[index].empty()) return;
+        uint8_t rank = rankOf(m_entries[index], level);
+        if (rank == RankNone) return;
+        level.hits.push_back(index);
+        level.ranks.push_back(rank);
+    };
+    if (!m_levels.empty()) {
+        for (int index : m_levels.back().hits) check(index);
+    } else {
+        for (int index = 0; index < static_cast<int>(m_items.size()); ++index) check(index);
+    }
 
-    PinyinCache entry;
+    m_levels.push_back(std::move(level));
+    return m_levels.back();
+}
 
-    // 按空格分词，每个 token 仅保留字母和数字后转大写
-    std::istringstream stream(pinyin);
-    std::string rawToken;
-    while (stream >> rawToken) {
-        std::string cleanToken;
-        for (char ch : rawToken) {
-            if (std::isalnum(static_cast<unsigned char>(ch))) {
-                cleanToken += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
-            }
-        }
-        if (!cleanToken.empty()) {
-            entry.tokens.push_back(std::move(cleanToken));
+uint8_t SearchEngine::rankOf(const Entry& entry, const Level& level) {
+    // 原文匹配：大写名称中的子串，按出现位置区分质量
+    const std::string& keyword = level.upperKeyword;
+    size_t pos = entry.upperName.find(keyword);
+    if (pos != std::string::npos) {
+        if (pos == 0) return entry.upperName.size() == keyword.size() ? RankExact : RankPrefix;
+        for (; pos != std::string::npos; pos = entry.upperName.find(keyword, pos + 1)) {
+            if (isSeparator(entry.upperName[pos - 1])) return RankWordStart;
         }
+        return RankSubstring;
     }
 
-    auto [inserted, success] = m_cache.emplace(name, std::move(entry));
-    return inserted->second;
+    if (level.pinyinKeyword.empty()) return RankNone;
+    int start = pinyinMatch(entry, level.pinyinKeyword);
+    if (start < 0) return RankNone;
+    return start == 0 ? RankPinyinStart : RankPinyinInner;
 }
 
-bool SearchEngine::mixedMatch(const std::string& keyword, const std::vector<std::string>& tokens, size_t keywordPos, size_t tokenPos)
-{
-    // keyword 已完全消费 → 匹配成功
-    if (keywordPos >= keyword.size()) return true;
-
-    // tokens 耗尽但 keyword 未消费完 → 匹配失败
-    if (tokenPos >= tokens.size()) return false;
-
-    const std::string& token = tokens[tokenPos];
-
-    // 尝试首字母匹配：keyword 当前字符 == token 首字母
-    if (keyword[keywordPos] == token[0]) {
-        if (mixedMatch(keyword, tokens, keywordPos + 1, tokenPos + 1))
-            return true;
-    }
-
-    // 尝试全拼匹配：keyword 从当前位置以 token 全拼开头
-    size_t remaining = keyword.size() - keywordPos;
-    if (remaining >= token.size()) {
-        bool prefixMatch = true;
-        for (size_t j = 0; j < token.size(); ++j) {
-            if (keyword[keywordPos + j] != token[j]) {
-                prefixMatch = false;
-                break;
+int SearchEngine::pinyinMatch(const Entry& entry, const std::string& keyword) {
+    // 关键词首字符必须是某个 token 的首字母，从第一个这样的 token 开始即可
+    size_t first = entry.initials.find(keyword[0]);
+    if (first == std::string::npos) return -1;
+
+    // cur[j] / next[j]：消费关键词前 j 个字符、停在 token 边界时最早的起始 token（INT_MAX 为不可达）
+    size_t size = keyword.size();
+    m_reach.assign(2 * (size + 1), INT_MAX);
+    int* cur = m_reach.data();
+    int* next = cur + size + 1;
+
+    int best = INT_MAX;
+    size_t tokenStart = first == 0 ? 0 : entry.tokenEnds[first - 1];
+    for (size_t t = first; t < entry.tokenEnds.size(); ++t) {
+        size_t tokenEnd = entry.tokenEnds[t];
+        cur[0] = static_cast<int>(t);  // 任何 token 都可以作为起点
+        std::fill(next, next + size + 1, INT_MAX);
+
+        // 每个可达位置消费本 token 的任意非空前缀（受公共前缀长度限制）
+        for (size_t j = 0; j < size; ++j) {
+            if (cur[j] == INT_MAX) continue;
+            size_t limit = std::min(size - j, tokenEnd - tokenStart);
+            for (size_t len = 1; len <= limit && keyword[j + len - 1] == entry.pinyin[tokenStart + len - 1]; ++len) {
+                next[j + len] = std::min(next[j + len], cur[j]);
             }
         }
-        if (prefixMatch) {
-            if (mixedMatch(keyword, tokens, keywordPos + token.size(), tokenPos + 1))
-                return true;
-        }
-    }
 
-    return false;
+        best = std::min(best, next[size]);
+        if (best == static_cast<int>(first)) break;  // 不可能更早
+        std::swap(cur, next);
+        tokenStart = tokenEnd;
+    }
+    return best == INT_MAX ? -1 : best;
 }
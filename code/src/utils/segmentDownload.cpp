@@ -0,0 +1,683 @@
+/**
+ * segmentDownload - 分段并发、可断点续传的文件下载实现
+ */
+
+#include "utils/segmentDownload.hpp"
+#include "utils/async.hpp"
+#include "utils/crc32.hpp"
+#include "utils/downloadJournal.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace segmentDownload {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t writeBufferSize = 256 * 1024;               // 每个连接攒够这么多数据再写文件
+    constexpr uint64_t journalInterval = 4 * 1024 * 1024;        // 每写入这么多字节确认一次进度
+    constexpr auto warmupTime = std::chrono::milliseconds(1000); // 单连接测速时长
+    constexpr auto sampleTime = std::chrono::milliseconds(1500); // 每次加连接后的测速时长
+    constexpr double minGain = 1.15;                             // 加连接后吞吐至少提升的比例
+    constexpr auto idleInterval = std::chrono::milliseconds(50); // 调用线程等待其他连接时的进度刷新间隔
+
+    std::atomic<int> s_connections{0}; // 进程内所有下载正在使用的连接数
+
+    /** @brief 为新增连接占用名额，所有下载合计已达 maxTotalConnections 时返回 false */
+    bool reserveConnection() {
+        int current = s_connections.load();
+        while (current < maxTotalConnections) {
+            if (s_connections.compare_exchange_weak(current, current + 1)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 解析 Content-Range（"bytes 起点-终点/总大小"）
+     * @param value 响应头值
+     * @param start 输出：起点
+     * @param total 输出：总大小，"*" 时为 0
+     * @return 格式正确时返回 true
+     */
+    bool parseContentRange(const std::string& value, uint64_t& start, uint64_t& total) {
+        unsigned long long first = 0, last = 0, size = 0;
+        if (std::sscanf(value.c_str(), "bytes %llu-%llu/%llu", &first, &last, &size) == 3) {
+            start = first;
+            total = size;
+            return true;
+        }
+        if (std::sscanf(value.c_str(), "bytes %llu-%llu/*", &first, &last) == 2) {
+            start = first;
+            total = 0;
+            return true;
+        }
+        return false;
+    }
+
+    std::string headerOf(const http::Response& response, const char* name) {
+        for (const auto& header : response.headers) {
+            if (header.name == name) return header.value;
+        }
+        return "";
+    }
+
+    /** @brief 设置请求头（同名的替换） */
+    void setHeader(std::vector<http::Header>& headers, const std::string& name, const std::string& value) {
+        for (auto& header : headers) {
+            if (header.name == name) {
+                header.value = value;
+                return;
+            }
+        }
+        headers.push_back({name, value});
+    }
+
+    bool isSuccess(const http::Response& response) {
+        return response.networkCode == 0 && response.statusCode >= 200 && response.statusCode < 300;
+    }
+
+    /** @brief 一次请求的结果 */
+    enum class Fetch {
+        Done,         // 分段下完（总大小未知时读到结尾）
+        NetworkError, // 网络中断或提前结束，可从已写入的位置重试
+        Fatal,        // HTTP 错误、写文件失败或取消，整次下载结束
+        Restart,      // 分段偏移不被接受（服务器不支持 Range 或文件已变化），需要从头下载
+    };
+
+    /** @brief 运行中的分段 */
+    struct Part {
+        downloadJournal::Segment range; // 区间与已写入进度
+        uint64_t received = 0;          // 已收到（含尚未写入文件）的字节数
+        int owner = -1;                 // 负责下载的连接编号，-1 表示空闲
+    };
+
+    /** @brief 单个连接的状态 */
+    struct Connection {
+        int id = 0;                  // 连接编号（0 为调用线程）
+        int part = -1;               // 正在下载的分段
+        std::vector<uint8_t> buffer; // 待写入文件的数据
+        uint32_t crc = 0;            // 分段已写入部分的 CRC32
+        bool accepted = false;       // 本次响应可以写入文件
+        bool reachedEnd = false;     // 已写到分段终点
+    };
+
+    /** @brief 一轮下载：调用线程是 0 号连接，其余连接按吞吐逐个启动 */
+    class Downloader {
+    public:
+        Downloader(const http::Request& request, const std::string& path, FILE* fp, downloadJournal::Journal& journal, int connections, bool resume, const WrittenCallback& onWritten, const RestartCallback& onRestart)
+            : m_request(request), m_path(path), m_fp(fp), m_journal(journal), m_maxConnections(std::max(1, connections)), m_onWritten(onWritten), m_onRestart(onRestart), m_resumable(resume) {
+            m_progress = std::move(m_request.progress);
+            m_request.progress = nullptr;
+            m_rangeUrl = m_request.url;
+            for (const auto& segment : journal.segments) {
+                Part part;
+                part.range = segment;
+                part.received = segment.done;
+                m_received += segment.done;
+                m_parts.push_back(part);
+                if (m_onWritten) m_onWritten(segment.start, segment.start + segment.done);
+            }
+            if (m_parts.empty()) m_parts.emplace_back();
+        }
+
+        /** @brief 执行下载，返回时所有连接都已结束 */
+        http::Response run() {
+            std::stop_callback onCancel(m_request.token, [this] {
+                m_cancelled = true;
+                m_stop.request_stop();
+            });
+
+            // 调用线程的连接不受名额限制，只计入总数
+            s_connections++;
+            Connection connection;
+            int failures = 0;
+            while (true) {
+                int part = claim(0);
+                if (part >= 0) {
+                    Fetch result = fetch(connection, part);
+                    if (result == Fetch::Done) {
+                        failures = 0;
+                        continue;
+                    }
+                    if (result == Fetch::NetworkError && ++failures < maxAttempts && backoff(connection, failures)) continue;
+                    m_stop.request_stop();
+                    break;
+                }
+                if (m_running == 0) break;
+                std::this_thread::sleep_for(idleInterval);
+                if (!tick()) break;
+            }
+            m_workers.clear();
+            s_connections--;
+
+            std::lock_guard lock(m_mutex);
+            commitLocked();
+            m_stats.segments = static_cast<int>(m_parts.size());
+            if (completeLocked()) {
+                http::Response response = m_accepted;
+                response.networkCode = 0;
+                response.error.clear();
+                return response;
+            }
+            http::Response response = m_failure;
+            if (m_cancelled) response.cancelled = true;
+            return response;
+        }
+
+        /** @brief 是否需要从头重新下载 */
+        bool restartRequested() const { return m_restart; }
+
+        /** @brief 服务器是否支持续传（失败时据此决定是否保留文件） */
+        bool resumable() const { return m_resumable; }
+
+        /** @brief 已写入文件的字节数 */
+        uint64_t written() const {
+            uint64_t total = 0;
+            for (const auto& part : m_parts) total += part.range.done;
+            return total;
+        }
+
+        /** @brief 整个文件的 CRC32：按起点顺序合并各分段边写边算的 CRC32（下载完成后调用） */
+        uint32_t crc() const {
+            std::vector<downloadJournal::Segment> ranges;
+            for (const auto& part : m_parts) ranges.push_back(part.range);
+            std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) { return a.start < b.start; });
+
+            uint32_t crc = 0;
+            for (const auto& range : ranges) crc = crc::combine(crc, range.crc, range.done);
+            return crc;
+        }
+
+        const Stats& stats() const { return m_stats; }
+
+    private:
+        http::Request m_request;                                  // 请求模板（不含进度回调）
+        std::function<bool(size_t total, size_t now)> m_progress; // 调用方的进度回调
+        std::string m_path;                                       // 保存路径（记录文件以此定位）
+        FILE* m_fp;                                               // 目标文件
+        downloadJournal::Journal& m_journal;                      // 续传记录
+        int m_maxConnections;                                     // 最大并发连接数
+        const WrittenCallback& m_onWritten;                       // 区间落盘回调
+        const RestartCallback& m_onRestart;                       // 从头重新下载回调
+
+        std::stop_source m_stop;                                  // 停止所有连接
+        std::mutex m_mutex;                                       // 保护分段、文件写入与记录
+        std::vector<Part> m_parts;                                // 全部分段（只追加，下标即分段编号）
+        std::string m_rangeUrl;                                   // 分段请求使用的地址
+        http::Response m_accepted;                                // 首个被接受的响应
+        http::Response m_failure;                                 // 最近一次失败的响应
+        uint64_t m_sinceCommit = 0;                               // 上次确认后写入的字节数
+        int m_target = 1;                                         // 当前允许的连接数
+        bool m_rangesOk = false;                                  // 服务器已用 206 响应过 Range
+        bool m_resumable;                                         // 有校验标识且内容未压缩，可以续传 / 分段
+        bool m_preallocated = false;                              // 文件已扩展到总大小
+        bool m_restart = false;                                   // 需要从头下载
+        bool m_fatal = false;                                     // 出现不可重试的错误
+        bool m_emptyBody = false;                                 // 服务器返回了空文件
+        std::atomic<bool> m_bodyStarted{false};                   // 已接受文件内容的响应（此前不汇报进度）
+        std::atomic<bool> m_cancelled{false};                     // 调用方取消
+        std::atomic<uint64_t> m_received{0};                      // 所有连接已收到的字节数
+        std::atomic<int> m_running{0};                            // 仍在运行的其他连接数
+        Stats m_stats;                                            // 统计
+
+        // 以下只在调用线程访问
+        std::vector<util::AsyncFurture<void>> m_workers;          // 其他连接
+        int m_nextId = 1;                                         // 下一个连接编号
+        bool m_sampling = false;                                  // 已开始测速
+        bool m_growthDone = false;                                // 不再增加连接
+        bool m_slotPending = false;                               // 上一轮应增加连接但名额已满
+        Clock::time_point m_sampleStart;                          // 本轮测速开始时间
+        uint64_t m_sampleBytes = 0;                               // 本轮测速开始时已收到的字节数
+        double m_lastRate = 0;                                    // 上一轮测速的吞吐
+
+        /** @brief 其他连接的工作循环 */
+        void work(int id) {
+            Connection connection;
+            connection.id = id;
+            int failures = 0;
+            while (true) {
+                int part = claim(id);
+                if (part < 0) break;
+                Fetch result = fetch(connection, part);
+                if (result == Fetch::Done) {
+                    failures = 0;
+                    continue;
+                }
+                if (result == Fetch::NetworkError) {
+                    // 放弃时分段变为空闲，由其他连接接手
+                    if (++failures < maxAttempts && backoff(connection, failures)) continue;
+                    break;
+                }
+                m_stop.request_stop();
+                break;
+            }
+            s_connections--;
+            m_running--;
+        }
+
+        /**
+         * @brief 为连接分配分段：优先空闲的未完成分段，其次拆分剩余最多的分段
+         * @param id 连接编号
+         * @return 分段编号，没有可做的工作时返回 -1
+         */
+        int claim(int id) {
+            std::lock_guard lock(m_mutex);
+            if (m_fatal || m_restart || m_stop.stop_requested()) return -1;
+
+            int active = 0;
+            for (const auto& part : m_parts) {
+                if (part.owner >= 0) active++;
+            }
+
+            for (size_t i = 0; i < m_parts.size(); ++i) {
+                Part& part = m_parts[i];
+                if (part.owner < 0 && !part.range.complete()) {
+                    part.owner = id;
+                    m_stats.connections = std::max(m_stats.connections, active + 1);
+                    return static_cast<int>(i);
+                }
+            }
+
+            if (!m_rangesOk || !m_resumable || active >= m_target) return -1;
+
+            int best = -1;
+            uint64_t bestLeft = 0;
+            for (size_t i = 0; i < m_parts.size(); ++i) {
+                const Part& part = m_parts[i];
+                if (part.owner < 0 || part.range.end == 0) continue;
+                uint64_t pos = part.range.start + part.received;
+                uint64_t left = part.range.end > pos ? part.range.end - pos : 0;
+                if (left > bestLeft) {
+                    best = static_cast<int>(i);
+                    bestLeft = left;
+                }
+            }
+            if (best < 0 || bestLeft < 2 * minSegmentSize) return -1;
+
+            // 原分段的连接写到新终点时自行断开
+            Part split;
+            split.range.start = m_parts[best].range.start + m_parts[best].received + bestLeft / 2;
+            split.range.end = m_parts[best].range.end;
+            split.owner = id;
+            m_parts[best].range.end = split.range.start;
+            m_parts.push_back(split);
+            m_stats.connections = std::max(m_stats.connections, active + 1);
+            return static_cast<int>(m_parts.size()) - 1;
+        }
+
+        /** @brief 下载一个分段，从已写入的位置开始 */
+        Fetch fetch(Connection& connection, int part) {
+            http::Request request = m_request;
+            uint64_t pos;
+            {
+                std::lock_guard lock(m_mutex);
+                Part& current = m_parts[part];
+                m_received -= current.received - current.range.done;
+                current.received = current.range.done;
+                pos = current.range.start + current.range.done;
+                connection.crc = current.range.crc;
+                request.url = m_rangeUrl;
+                // 压缩后的偏移与文件偏移不一致，只接收原始内容
+                setHeader(request.headers, "Accept-Encoding", "identity");
+                // 终点已知时带上终点，服务器不会多发；被拆分的连接仍按原终点请求，写到新终点时断开
+                std::string range = "bytes=" + std::to_string(pos) + "-";
+                if (current.range.end > 0) range += std::to_string(current.range.end - 1);
+                setHeader(request.headers, "Range", range);
+                if (pos > 0 && !m_journal.validator().empty()) setHeader(request.headers, "If-Range", m_journal.validator());
+                m_stats.requests++;
+            }
+            connection.part = part;
+            connection.buffer.clear();
+            connection.accepted = false;
+            connection.reachedEnd = false;
+
+            request.token = m_stop.get_token();
+            if (connection.id == 0) request.progress = [this](size_t, size_t) { return tick(); };
+            request.onResponse = [this, &connection, pos](const http::Response& response) {
+                return accept(connection, pos, response);
+            };
+            auto response = http::requestStream(request, [this, &connection](const uint8_t* data, size_t size) {
+                return receive(connection, data, size);
+            });
+            bool flushed = flush(connection);
+
+            std::lock_guard lock(m_mutex);
+            Part& current = m_parts[connection.part];
+            if (connection.accepted && isSuccess(response) && current.range.end == 0) {
+                // 总大小未知：读到结尾即完成
+                current.range.end = current.range.start + current.range.done;
+                m_journal.totalSize = current.range.end;
+            }
+            if (!connection.accepted && isSuccess(response) && pos == 0 && m_parts.size() == 1) {
+                m_emptyBody = true; // 响应体为空，没有触发 onResponse
+                m_accepted = response;
+            }
+            bool done = current.range.complete() || m_emptyBody;
+            current.owner = -1;
+            m_received -= current.received - current.range.done;
+            current.received = current.range.done;
+
+            if (done) return Fetch::Done;
+            if (m_restart) return Fetch::Restart;
+            if (!flushed || m_fatal || m_stop.stop_requested()) return Fetch::Fatal;
+            if (response.networkCode == 0 && (response.statusCode < 200 || response.statusCode >= 300)) {
+                // 重定向后的地址可能已过期，先退回原地址重试
+                if (request.url != m_request.url) {
+                    m_rangeUrl = m_request.url;
+                    return Fetch::NetworkError;
+                }
+                m_failure = response;
+                m_fatal = true;
+                return Fetch::Fatal;
+            }
+            m_failure = response;
+            return Fetch::NetworkError;
+        }
+
+        /** @brief 检查最终响应，决定接续写入、从头写入还是丢弃 */
+        bool accept(Connection& connection, uint64_t pos, const http::Response& response) {
+            std::lock_guard lock(m_mutex);
+            long status = response.statusCode;
+            if (status == 206) {
+                uint64_t start = 0, total = 0;
+                if (!parseContentRange(headerOf(response, "content-range"), start, total) || start != pos ||
+                    (m_journal.totalSize > 0 && total > 0 && total != m_journal.totalSize)) {
+                    m_restart = true;
+                    return false;
+                }
+                if (m_journal.totalSize == 0) m_journal.totalSize = total;
+                Part& current = m_parts[connection.part];
+                if (current.range.end == 0) current.range.end = total;
+                if (!m_rangesOk && !response.url.empty()) m_rangeUrl = response.url;
+                m_rangesOk = true;
+            } else if (status >= 200 && status < 300) {
+                // 服务器忽略 Range 或 If-Range 不匹配，返回完整内容：只剩这一个连接时就地从头写，否则整轮重来
+                if (pos > 0 || m_parts.size() > 1) {
+                    for (size_t i = 0; i < m_parts.size(); ++i) {
+                        if (m_parts[i].owner >= 0 && static_cast<int>(i) != connection.part) {
+                            m_restart = true;
+                            return false;
+                        }
+                    }
+                    if (m_onRestart) m_onRestart();
+                    m_parts.assign(1, Part{});
+                    m_parts[0].owner = connection.id;
+                    connection.part = 0;
+                    connection.crc = 0;
+                    m_received = 0;
+                    m_preallocated = false;
+                }
+                std::string length = headerOf(response, "content-length");
+                m_journal.totalSize = length.empty() ? 0 : std::strtoull(length.c_str(), nullptr, 10);
+                m_parts[connection.part].range.end = m_journal.totalSize;
+                m_rangesOk = false;
+            } else {
+                return true; // 错误响应体不写入文件
+            }
+
+            std::string etag = headerOf(response, "etag");
+            std::string lastModified = headerOf(response, "last-modified");
+            if (status != 206 || !etag.empty() || !lastModified.empty()) {
+                m_journal.etag = etag;
+                m_journal.lastModified = lastModified;
+            }
+            std::string encoding = headerOf(response, "content-encoding");
+            m_resumable = !m_journal.validator().empty() && (encoding.empty() || encoding == "identity") && headerOf(response, "accept-ranges") != "none";
+
+            // 分段写入前把文件扩展到总大小，避免各段写入时反复扩展
+            if (m_rangesOk && m_resumable && !m_preallocated && m_maxConnections > 1 && m_journal.totalSize >= 2 * minSegmentSize) {
+                std::fflush(m_fp);
+                if (ftruncate(fileno(m_fp), static_cast<off_t>(m_journal.totalSize)) == 0) m_preallocated = true;
+            }
+
+            if (m_accepted.statusCode == 0) {
+                m_accepted = response;
+                m_accepted.body.clear();
+            }
+            connection.accepted = true;
+            m_bodyStarted = true;
+            return true;
+        }
+
+        /** @brief 接收数据，写到分段终点时返回 false 断开连接 */
+        bool receive(Connection& connection, const uint8_t* data, size_t size) {
+            if (!connection.accepted) return true;
+
+            size_t take = size;
+            {
+                std::lock_guard lock(m_mutex);
+                Part& current = m_parts[connection.part];
+                uint64_t pos = current.range.start + current.received;
+                if (current.range.end > 0) {
+                    uint64_t left = current.range.end > pos ? current.range.end - pos : 0;
+                    if (left <= size) {
+                        take = static_cast<size_t>(left);
+                        connection.reachedEnd = true;
+                    }
+                }
+                current.received += take;
+            }
+            m_received += take;
+
+            connection.buffer.insert(connection.buffer.end(), data, data + take);
+            if (connection.buffer.size() >= writeBufferSize || connection.reachedEnd) {
+                if (!flush(connection)) return false;
+            }
+            return !connection.reachedEnd;
+        }
+
+        /** @brief 把连接缓冲的数据写到分段对应的偏移 */
+        bool flush(Connection& connection) {
+            if (connection.buffer.empty()) return true;
+            size_t size = connection.buffer.size();
+            uint32_t crc = crc::fromBuffer(connection.crc, connection.buffer.data(), size);
+
+            std::lock_guard lock(m_mutex);
+            Part& current = m_parts[connection.part];
+            uint64_t offset = current.range.start + current.range.done;
+            if (std::fseek(m_fp, static_cast<long>(offset), SEEK_SET) != 0 || std::fwrite(connection.buffer.data(), 1, size, m_fp) != size) {
+                m_fatal = true;
+                m_stop.request_stop();
+                connection.buffer.clear();
+                return false;
+            }
+            current.range.done += size;
+            current.range.crc = crc;
+            connection.crc = crc;
+            connection.buffer.clear();
+
+            // 读取方使用另一个文件句柄，登记前先刷出缓冲
+            if (m_onWritten) {
+                std::fflush(m_fp);
+                m_onWritten(offset, offset + size);
+            }
+
+            m_sinceCommit += size;
+            if (m_sinceCommit >= journalInterval) commitLocked();
+            return true;
+        }
+
+        /** @brief 把已写入的数据刷到文件并更新记录 */
+        void commitLocked() {
+            std::fflush(m_fp);
+            m_sinceCommit = 0;
+            if (!m_resumable) return;
+
+            m_journal.segments.clear();
+            for (const auto& part : m_parts) m_journal.segments.push_back(part.range);
+            std::sort(m_journal.segments.begin(), m_journal.segments.end(), [](const auto& a, const auto& b) { return a.start < b.start; });
+            downloadJournal::save(m_path, m_journal);
+        }
+
+        bool completeLocked() const {
+            if (m_emptyBody) return true;
+            return std::all_of(m_parts.begin(), m_parts.end(), [](const Part& part) { return part.range.complete(); });
+        }
+
+        /**
+         * @brief 调用线程的定时工作：汇报合并后的进度，按吞吐决定是否增加连接
+         * @return 调用方取消时返回 false
+         */
+        bool tick() {
+            uint64_t total;
+            bool splittable;
+            {
+                std::lock_guard lock(m_mutex);
+                total = m_journal.totalSize;
+                splittable = m_rangesOk && m_resumable && total >= 2 * minSegmentSize;
+            }
+            uint64_t received = m_received;
+            // 重定向等前置阶段 curl 也会回调，总大小和字节数都不是文件本身的，不汇报
+            if (m_progress && m_bodyStarted && !m_progress(static_cast<size_t>(total), static_cast<size_t>(received))) {
+                m_cancelled = true;
+                m_stop.request_stop();
+                return false;
+            }
+            if (!splittable || m_maxConnections <= 1 || m_growthDone || m_stop.stop_requested()) return true;
+
+            auto now = Clock::now();
+            if (!m_sampling) {
+                m_sampling = true;
+                m_sampleStart = now;
+                m_sampleBytes = received;
+                return true;
+            }
+            auto elapsed = now - m_sampleStart;
+            if (elapsed < (m_workers.empty() ? warmupTime : sampleTime)) return true;
+
+            double rate = (received - m_sampleBytes) / std::chrono::duration<double>(elapsed).count();
+            if (!m_slotPending && !m_workers.empty() && rate < m_lastRate * minGain) {
+                // 新连接没有带来明显提升：不再增加，吞吐反而下降时撤回一个
+                m_growthDone = true;
+                if (rate < m_lastRate) {
+                    std::lock_guard lock(m_mutex);
+                    m_target = std::max(1, m_target - 1);
+                }
+                return true;
+            }
+            if (m_target >= m_maxConnections) {
+                m_growthDone = true;
+                return true;
+            }
+
+            m_lastRate = rate;
+            m_sampleStart = now;
+            m_sampleBytes = received;
+            // 其他下载占满了名额：等名额空出后再加，期间没有新连接，不做增益判断
+            m_slotPending = !reserveConnection();
+            if (m_slotPending) return true;
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_target++;
+            }
+            int id = m_nextId++;
+            m_running++;
+            m_workers.push_back(util::async([this, id](std::stop_token) { work(id); }));
+            return true;
+        }
+
+        /** @brief 等待重试间隔，停止时提前返回 false */
+        bool backoff(Connection& connection, int failures) {
+            auto deadline = Clock::now() + std::chrono::seconds(failures);
+            while (Clock::now() < deadline) {
+                if (m_stop.stop_requested()) return false;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (connection.id == 0 && !tick()) return false;
+            }
+            return !m_stop.stop_requested();
+        }
+    };
+
+    /** @brief 记录中已写入的最远位置 */
+    uint64_t writtenEnd(const downloadJournal::Journal& journal) {
+        uint64_t end = 0;
+        for (const auto& segment : journal.segments) end = std::max(end, segment.start + segment.done);
+        return end;
+    }
+
+} // namespace
+
+http::Response toFile(const http::Request& request, const std::string& path, int connections, Stats* stats, const WrittenCallback& onWritten, uint32_t expectedCrc, const RestartCallback& onRestart) {
+    http::Response response;
+
+    auto slashPos = path.rfind('/');
+    if (slashPos != std::string::npos && slashPos != 0) fs::ensureDir(path.substr(0, slashPos));
+
+    // 同一地址、同一期望 CRC32、有校验标识且文件不短于记录时续传，否则从头下载
+    downloadJournal::Journal journal;
+    bool resume = downloadJournal::load(path, journal) && journal.url == request.url && journal.expectedCrc == expectedCrc && !journal.validator().empty() &&
+                  writtenEnd(journal) > 0 && fs::getFileSize(path) >= static_cast<int64_t>(writtenEnd(journal));
+    if (!resume) downloadJournal::remove(path);
+
+    std::string hostPath = fs::nativePath(path);
+    FILE* fp = std::fopen(hostPath.c_str(), resume ? "r+b" : "wb");
+    if (!fp) return response;
+    std::setvbuf(fp, nullptr, _IOFBF, 512 * 1024);
+
+    bool resumable = false;
+    uint64_t written = 0;
+    uint32_t crc = 0;
+    for (int round = 0; round < 2; ++round) {
+        if (round > 0 || !resume) {
+            // 续传时开头登记的区间和上一轮写入的区间都随截断作废
+            if (round > 0 && onRestart) onRestart();
+            std::string url = journal.url.empty() ? request.url : journal.url;
+            journal = {};
+            journal.url = url;
+            journal.expectedCrc = expectedCrc;
+            ftruncate(fileno(fp), 0);
+        }
+
+        Downloader downloader(request, path, fp, journal, connections, resume && round == 0, onWritten, onRestart);
+        response = downloader.run();
+        resumable = downloader.resumable();
+        written = downloader.written();
+        crc = downloader.crc();
+        if (stats) {
+            stats->connections = std::max(stats->connections, downloader.stats().connections);
+            stats->requests += downloader.stats().requests;
+            stats->segments = downloader.stats().segments;
+        }
+        // 分段偏移不被接受：从头再来一轮（单连接或服务器已换成新文件）
+        if (!downloader.restartRequested() || request.token.stop_requested()) break;
+    }
+
+    bool ok = isSuccess(response);
+    if (stats) stats->crc32 = ok ? crc : 0;
+    if (ok && expectedCrc != 0 && crc != expectedCrc) {
+        // 内容损坏：不保留文件和记录，下次从头下载
+        ok = false;
+        resumable = false;
+        response.networkCode = checksumMismatch;
+        response.error = "CRC32 mismatch";
+    }
+    if (ok) {
+        // 续传的文件可能比最终内容长
+        std::fflush(fp);
+        ftruncate(fileno(fp), static_cast<off_t>(journal.totalSize));
+    }
+    std::fclose(fp);
+
+    if (ok) {
+        downloadJournal::remove(path);
+    } else if (response.statusCode == 416 || !resumable || written == 0) {
+        std::remove(hostPath.c_str());
+        downloadJournal::remove(path);
+    }
+    // 其余情况（网络中断、取消）保留文件和记录，下次调用时续传
+
+    return response;
+}
+
+} // namespace segmentDownload
@@ -4,20 +4,104 @@
  */
 
 #include "utils/zipReader.hpp"
+#include "utils/fsHelper.hpp"
+#include "utils/partialFile.hpp"
 #include "utils/textClean.hpp"
 #include <cstring>
 #include <set>
 
+namespace {
+
+    size_t extractToMem(mz_zip_archive* archive, const ZipEntry& entry, void* buf, size_t bufSize) {
+        size_t size = static_cast<size_t>(entry.uncompressedSize);
+        if (size == 0 || size > bufSize) return 0;
+
+        mz_bool ok = mz_zip_reader_extract_to_mem(archive, entry.index, buf, size, 0);
+        return ok ? size : 0;
+    }
+
+    size_t readSource(void* opaque, mz_uint64 offset, void* buf, size_t size) {
+        return static_cast<PartialFile*>(opaque)->read(offset, buf, size);
+    }
+
+    /** @brief 以 PartialFile 为数据源初始化 miniz 句柄 */
+    bool initFromSource(mz_zip_archive* archive, PartialFile* source, mz_uint flags) {
+        archive->m_pRead = readSource;
+        archive->m_pIO_opaque = source;
+        return mz_zip_reader_init(archive, source->size(), flags);
+    }
+
+} // namespace
+
+// ============================================================================
+// ZipCursor
+// ============================================================================
+
+ZipCursor::ZipCursor(const std::string& zipPath) {
+    memset(&m_archive, 0, sizeof(m_archive));
+    m_open = mz_zip_reader_init_file(&m_archive, fs::nativePath(zipPath).c_str(), MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY);
+}
+
+ZipCursor::ZipCursor(std::shared_ptr<PartialFile> source) : m_source(std::move(source)) {
+    memset(&m_archive, 0, sizeof(m_archive));
+    m_open = initFromSource(&m_archive, m_source.get(), MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY);
+}
+
+ZipCursor::~ZipCursor() {
+    endRead();
+    mz_zip_reader_end(&m_archive);
+}
+
+bool ZipCursor::isOpen() const {
+    return m_open;
+}
+
+size_t ZipCursor::readFile(const ZipEntry& entry, void* buf, size_t bufSize) {
+    if (!m_open) return 0;
+    return extractToMem(&m_archive, entry, buf, bufSize);
+}
+
+bool ZipCursor::beginRead(const ZipEntry& entry) {
+    if (!m_open) return false;
+    endRead();
+
+    m_iter = mz_zip_reader_extract_iter_new(&m_archive, entry.index, 0);
+    return m_iter != nullptr;
+}
+
+size_t ZipCursor::read(void* buf, size_t bufSize) {
+    if (!m_iter) return 0;
+    return mz_zip_reader_extract_iter_read(m_iter, buf, bufSize);
+}
+
+void ZipCursor::endRead() {
+    if (m_iter) {
+        mz_zip_reader_extract_iter_free(m_iter);
+        m_iter = nullptr;
+    }
+}
+
 // ============================================================================
 // 构造 / 析构
 // ============================================================================
 
-ZipReader::ZipReader(const std::string& zipPath) {
+ZipReader::ZipReader(const std::string& zipPath) : m_path(zipPath) {
     memset(&m_archive, 0, sizeof(m_archive));
 
-    if (!mz_zip_reader_init_file(&m_archive, zipPath.c_str(), 0)) return;
+    if (!mz_zip_reader_init_file(&m_archive, fs::nativePath(zipPath).c_str(), 0)) return;
     m_open = true;
+    loadEntries();
+}
 
+ZipReader::ZipReader(std::shared_ptr<PartialFile> source) : m_path(source->path()), m_source(std::move(source)) {
+    memset(&m_archive, 0, sizeof(m_archive));
+
+    if (!initFromSource(&m_archive, m_source.get(), 0)) return;
+    m_open = true;
+    loadEntries();
+}
+
+void ZipReader::loadEntries() {
     int numEntries = static_cast<int>(mz_zip_reader_get_num_files(&m_archive));
 
     std::set<std::string> dirSet;
@@ -75,18 +159,18 @@ const std::vector<std::string>& ZipReader::dirs() const {
     return m_dirs;
 }
 
+std::unique_ptr<ZipCursor> ZipReader::openCursor() const {
+    if (m_source) return std::make_unique<ZipCursor>(m_source);
+    return std::make_unique<ZipCursor>(m_path);
+}
+
 // ============================================================================
 // 一次性读取（小文件）
 // ============================================================================
 
 size_t ZipReader::readFile(const ZipEntry& entry, void* buf, size_t bufSize) {
     if (!m_open) return 0;
-
-    size_t size = static_cast<size_t>(entry.uncompressedSize);
-    if (size == 0 || size > bufSize) return 0;
-
-    mz_bool ok = mz_zip_reader_extract_to_mem(&m_archive, entry.index, buf, size, 0);
-    return ok ? size : 0;
+    return extractToMem(&m_archive, entry, buf, bufSize);
 }
 
 // ============================================================================
@@ -0,0 +1,195 @@
+/**
+ * zipStream - 边下载边读取的 ZIP 下载实现
+ */
+
+#include "utils/zipStream.hpp"
+#include "utils/fsHelper.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace zipStream {
+
+namespace {
+
+    constexpr uint32_t eocdSignature = 0x06054b50;        // End of central directory record
+    constexpr uint32_t zip64LocatorSignature = 0x07064b50; // ZIP64 end of central directory locator
+    constexpr uint32_t zip64EocdSignature = 0x06064b50;    // ZIP64 end of central directory record
+    constexpr size_t eocdSize = 22;                         // EOCD 固定部分长度
+    constexpr size_t zip64LocatorSize = 20;                 // ZIP64 定位记录长度
+    constexpr size_t zip64EocdSize = 56;                    // ZIP64 EOCD 固定部分长度
+    constexpr int maxFetches = 3;                           // 尾部、ZIP64 EOCD、中央目录最多各取一次
+
+    uint16_t readLe16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t readLe32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint64_t readLe64(const uint8_t* p) {
+        return static_cast<uint64_t>(readLe32(p)) | (static_cast<uint64_t>(readLe32(p + 4)) << 32);
+    }
+
+    bool isSuccess(const http::Response& response) {
+        return response.networkCode == 0 && response.statusCode >= 200 && response.statusCode < 300;
+    }
+
+    std::string headerOf(const http::Response& response, const char* name) {
+        for (const auto& header : response.headers) {
+            if (header.name == name) return header.value;
+        }
+        return "";
+    }
+
+    /** @brief 请求一个区间，服务器不返回 206（忽略 Range 或文件已变化）时不接收响应体 */
+    http::Response fetchRange(const http::Request& request) {
+        std::vector<uint8_t> body;
+        http::Request rangeRequest = request;
+        rangeRequest.onResponse = [](const http::Response& head) { return head.statusCode == 206; };
+        auto response = http::requestStream(rangeRequest, [&body](const uint8_t* data, size_t size) {
+            body.insert(body.end(), data, data + size);
+            return true;
+        });
+        response.body = std::move(body);
+        return response;
+    }
+
+    /**
+     * @brief 在已取回的尾部中查找中央目录
+     * @param tail 尾部内容
+     * @param tailStart 尾部在文件中的起点
+     * @param fileSize 文件总大小
+     * @param need 输出：还需要从哪个偏移开始的内容（ZIP64 EOCD 或中央目录起点）
+     * @return 不是 ZIP 或记录损坏时返回 false
+     */
+    bool locate(const std::vector<uint8_t>& tail, uint64_t tailStart, uint64_t fileSize, uint64_t& need) {
+        if (tail.size() < eocdSize) return false;
+
+        // EOCD 在文件末尾，后面只跟注释
+        size_t eocd = tail.size() - eocdSize;
+        while (true) {
+            if (readLe32(&tail[eocd]) == eocdSignature && eocd + eocdSize + readLe16(&tail[eocd + 20]) == tail.size()) break;
+            if (eocd == 0) return false;
+            --eocd;
+        }
+
+        uint64_t entries = readLe16(&tail[eocd + 10]);
+        uint64_t cdSize = readLe32(&tail[eocd + 12]);
+        uint64_t cdOffset = readLe32(&tail[eocd + 16]);
+
+        bool zip64 = entries == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF;
+        if (zip64) {
+            if (eocd < zip64LocatorSize || readLe32(&tail[eocd - zip64LocatorSize]) != zip64LocatorSignature) return false;
+            uint64_t recordOffset = readLe64(&tail[eocd - zip64LocatorSize + 8]);
+            if (recordOffset < tailStart) {
+                need = recordOffset;
+                return recordOffset + zip64EocdSize <= fileSize;
+            }
+            size_t record = static_cast<size_t>(recordOffset - tailStart);
+            if (record + zip64EocdSize > tail.size() || readLe32(&tail[record]) != zip64EocdSignature) return false;
+            cdSize = readLe64(&tail[record + 40]);
+            cdOffset = readLe64(&tail[record + 48]);
+        }
+
+        if (cdOffset + cdSize > fileSize || cdSize > maxCentralDirectory) return false;
+        need = cdOffset;
+        return true;
+    }
+
+    /**
+     * @brief 取回 ZIP 尾部直到包含整个中央目录
+     * @return 包含中央目录的 PartialFile，不支持时返回空
+     */
+    std::shared_ptr<PartialFile> fetchCentralDirectory(const http::Request& request, const std::string& path) {
+        http::Request tailRequest = request;
+        tailRequest.progress = nullptr;
+        tailRequest.onResponse = nullptr;
+        tailRequest.headers.push_back({"Accept-Encoding", "identity"});
+        tailRequest.headers.push_back({"Range", "bytes=-" + std::to_string(tailSize)});
+
+        // 206 传输中断时重试；其他状态码说明服务器不支持，不再重试
+        http::Response response;
+        for (int attempt = 0; attempt < segmentDownload::maxAttempts; ++attempt) {
+            response = fetchRange(tailRequest);
+            if (response.networkCode == 0 || (response.statusCode != 0 && response.statusCode != 206) || tailRequest.token.stop_requested()) break;
+        }
+        if (response.networkCode != 0 || response.statusCode != 206) return nullptr;
+
+        unsigned long long first = 0, last = 0, size = 0;
+        if (std::sscanf(headerOf(response, "content-range").c_str(), "bytes %llu-%llu/%llu", &first, &last, &size) != 3) return nullptr;
+        if (last + 1 != size || response.body.size() != last + 1 - first) return nullptr;
+
+        uint64_t fileSize = size;
+        uint64_t tailStart = first;
+        std::vector<uint8_t> tail = std::move(response.body);
+        std::string validator = headerOf(response, "etag");
+        if (validator.empty()) validator = headerOf(response, "last-modified");
+
+        // 后续补取的内容必须来自同一个文件：带 If-Range，文件已变化时服务器返回 200
+        if (!response.url.empty()) tailRequest.url = response.url;
+        for (int fetches = 1;; ++fetches) {
+            uint64_t need = 0;
+            if (!locate(tail, tailStart, fileSize, need)) return nullptr;
+            if (need >= tailStart) break;
+            if (fetches >= maxFetches || validator.empty()) return nullptr;
+
+            tailRequest.headers.pop_back();
+            tailRequest.headers.push_back({"Range", "bytes=" + std::to_string(need) + "-" + std::to_string(tailStart - 1)});
+            tailRequest.headers.push_back({"If-Range", validator});
+            auto more = fetchRange(tailRequest);
+            tailRequest.headers.pop_back();
+            if (more.networkCode != 0 || more.statusCode != 206 || more.body.size() != tailStart - need) return nullptr;
+
+            more.body.insert(more.body.end(), tail.begin(), tail.end());
+            tail = std::move(more.body);
+            tailStart = need;
+        }
+
+        auto file = std::make_shared<PartialFile>(path, fileSize);
+        file->preload(tailStart, std::move(tail));
+        return file;
+    }
+
+    /** @brief 下载完成的文件尾部与预先取回的内容是否一致 */
+    bool tailMatches(const PartialFile& file) {
+        FILE* fp = std::fopen(fs::nativePath(file.path()).c_str(), "rb");
+        if (!fp) return false;
+
+        const auto& expected = file.preloaded();
+        std::vector<uint8_t> actual(expected.size());
+        bool ok = std::fseek(fp, static_cast<long>(file.preloadOffset()), SEEK_SET) == 0 &&
+                  std::fread(actual.data(), 1, actual.size(), fp) == actual.size() &&
+                  std::memcmp(actual.data(), expected.data(), actual.size()) == 0;
+        std::fclose(fp);
+        return ok;
+    }
+
+} // namespace
+
+http::Response toFile(const http::Request& request, const std::string& path, const OpenedCallback& onOpened, int connections, segmentDownload::Stats* stats, uint32_t expectedCrc) {
+    std::shared_ptr<PartialFile> file;
+    if (onOpened) file = fetchCentralDirectory(request, path);
+    if (request.token.stop_requested()) {
+        http::Response response;
+        response.cancelled = true;
+        return response;
+    }
+    if (file) onOpened(file);
+
+    segmentDownload::WrittenCallback onWritten;
+    segmentDownload::RestartCallback onRestart;
+    if (file) {
+        onWritten = [&file](uint64_t start, uint64_t end) { file->markWritten(start, end); };
+        // 已登记的区间即将被覆盖，读取方可能已读到旧内容：按失败通知，由调用方在下载完成后重新安装
+        onRestart = [&file] { file->finish(false); };
+    }
+
+    auto response = segmentDownload::toFile(request, path, connections, stats, onWritten, expectedCrc, onRestart);
+    if (file) file->finish(isSuccess(response) && tailMatches(*file));
+    return response;
+}
+
+} // namespace zipStream
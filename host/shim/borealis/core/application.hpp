@@ -0,0 +1,22 @@
+/**
+ * borealis Application 主机端替身
+ * 只提供非 UI 代码用到的主题查询，固定为浅色主题
+ */
+
+#pragma once
+
+namespace brls {
+
+/** @brief 主题变体 */
+enum class ThemeVariant {
+    LIGHT, // 浅色
+    DARK,  // 深色
+};
+
+class Application {
+public:
+    /** @brief 当前主题（主机端固定浅色） */
+    static ThemeVariant getThemeVariant() { return ThemeVariant::LIGHT; }
+};
+
+} // namespace brls
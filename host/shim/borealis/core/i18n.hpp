@@ -0,0 +1,24 @@
+/**
+ * borealis i18n 主机端替身
+ * 主机构建不加载翻译资源，getStr 直接返回键名（附带参数），仅用于日志与错误信息
+ */
+
+#pragma once
+
+#include <string>
+
+namespace brls {
+
+/**
+ * @brief 返回键名及参数拼接后的字符串
+ * @param stringName 翻译键名
+ * @param args 格式化参数
+ */
+template <typename... Args>
+inline std::string getStr(const std::string& stringName, Args&&... args) {
+    std::string result = stringName;
+    ((result += " ", result += std::string(args)), ...);
+    return result;
+}
+
+} // namespace brls